@@ -1,12 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 #include "help.h"
-
-#define REAR_OFFSET     21
-#define LOWER_LEG_LEN   40
-#define UPPER_LEG_LEN   24
-#define PI              3.14159
+#include "kinematics.h"
 
 typedef struct {
     int id;
@@ -14,22 +9,17 @@ typedef struct {
     char letter;
 } fun_data_t;
 
+// Servo angles for a foot target, same math and geometry as the firmware
 void calc_leg_angles(int x, int y, int* angle1, int* angle2) {
     double front_angle, rear_angle;
-    double a1, a2, b1, b2;     // angles
-    double hypo1, hypo2;
-
-    // Calc hypotenuse assuming 0, 0 is on the front servo axis
-    hypo1 = sqrt(pow(x, 2) + pow(y, 2));
-    hypo2 = sqrt(pow(x - REAR_OFFSET, 2) + pow(y, 2));
 
-    a1 = acos(x / hypo1);
-    a2 = acos((REAR_OFFSET - x)/hypo2);
-    b1 = acos((pow(UPPER_LEG_LEN, 2) - pow(LOWER_LEG_LEN, 2) - pow(hypo1, 2))/(-2*LOWER_LEG_LEN*hypo1));
-    b2 = acos((pow(UPPER_LEG_LEN, 2) - pow(LOWER_LEG_LEN, 2) - pow(hypo2, 2))/(-2*LOWER_LEG_LEN*hypo2));
+    if(ik_solve_deg(x, y, &front_angle, &rear_angle) != 0) {
+        printf("(%d, %d) is out of reach\n", x, y);
+        exit(1);
+    }
 
-    *angle1 = (180*(a1 + b1) / PI) - 135;
-    *angle2 = 135 - (180*(a2 + b2) / PI);
+    *angle1 = front_angle - SERVO_HORN_OFFSET;
+    *angle2 = SERVO_HORN_OFFSET - rear_angle;
 }
 
 int main(int argc, char* argv[]) {
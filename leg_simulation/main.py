@@ -1,9 +1,22 @@
+import os
+import re
 import numpy as np
 import matplotlib.pyplot as plt
 import matplotlib.animation as animation
 
-# Link lengths
-l1, l2, l3, l4, l5 = 2, 2, 2, 2, 1.5
+# Leg geometry comes from the firmware kinematics header so the two can't drift apart
+KINEMATICS_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "robo_ware",
+                            "components", "kinematics", "include", "kinematics.h")
+geometry = {}
+with open(KINEMATICS_H) as f:
+    for line in f:
+        m = re.match(r"#define\s+(\w+)\s+(-?\d+)\b", line)
+        if m:
+            geometry[m.group(1)] = int(m.group(2))
+
+# Link lengths, servo links are LOWER_LEG_LEN and the links meeting at the foot UPPER_LEG_LEN
+l1 = l2 = geometry["LOWER_LEG_LEN"]
+l3 = l4 = geometry["UPPER_LEG_LEN"]
 
 # User input
 x_target = float(input("Enter X coordinate of end effector: "))
@@ -12,7 +25,7 @@ ground_orientation = input("Enter ground beam orientation (in-in, in-out, out-in
 
 # Ground positions
 ground1 = np.array([0, 0])
-ground2 = np.array([4, 0])
+ground2 = np.array([geometry["REAR_OFFSET"], 0])
 
 def inverse_kinematics(x, y, orientation):
     """Compute the angles required to position the end effector at (x, y)."""
@@ -58,8 +71,9 @@ if theta1 is None or theta2 is None:
     exit()
 
 fig, ax = plt.subplots()
-ax.set_xlim(-1, 5)
-ax.set_ylim(-1, 3)
+reach = l1 + l3
+ax.set_xlim(-reach, ground2[0] + reach)
+ax.set_ylim(-reach, reach)
 ax.set_aspect('equal')
 ax.grid()
 
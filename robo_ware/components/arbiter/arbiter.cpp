@@ -0,0 +1,283 @@
+#include <string.h>
+
+#include "arbiter.h"
+
+#define NO_KIND     0xFF
+
+// Servos 1 and 2 are the right leg, 3 and 4 the left
+static inline int servo_leg(int servo) {
+    return servo <= 2 ? LEG_RIGHT : LEG_LEFT;
+}
+
+static inline uint8_t leg_servos(int leg) {
+    return leg == LEG_RIGHT ? 0x3 : 0xC;
+}
+
+static inline int16_t clamp_q4(int32_t v) {
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+static inline void note_oldest(arb_setpoint_t *out, uint32_t timestamp_us) {
+    if (!out->fresh || (int32_t)(timestamp_us - out->oldest_us) < 0) {
+        out->oldest_us = timestamp_us;
+        out->fresh = true;
+    }
+}
+
+CommandArbiter::CommandArbiter() {
+    count = 0;
+    owner[LEG_LEFT] = ARB_NONE;
+    owner[LEG_RIGHT] = ARB_NONE;
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        offset_x[leg] = 0;
+        offset_y[leg] = 0;
+    }
+}
+
+int CommandArbiter::add_source(const arb_source_config_t &cfg) {
+    if (count >= ARB_MAX_SOURCES) {
+        return -1;
+    }
+    source_t *s = &sources[count];
+    s->cfg = cfg;
+    s->live = false;
+    s->last_us = 0;
+    s->held = 0;
+    s->kind[LEG_LEFT] = NO_KIND;
+    s->kind[LEG_RIGHT] = NO_KIND;
+    s->servo_set = 0;
+    s->fresh_feet = 0;
+    s->fresh_servos = 0;
+    memset(s->x_q4, 0, sizeof(s->x_q4));
+    memset(s->y_q4, 0, sizeof(s->y_q4));
+    memset(s->angle, 0, sizeof(s->angle));
+    memset(s->foot_us, 0, sizeof(s->foot_us));
+    memset(s->angle_us, 0, sizeof(s->angle_us));
+    memset(&s->stats, 0, sizeof(s->stats));
+    return count++;
+}
+
+bool CommandArbiter::push(int source, const setpoint_t &sp) {
+    return sources[source].ring.push(sp);
+}
+
+void CommandArbiter::offer(int source, const setpoint_t &sp, uint32_t now) {
+    take(&sources[source], sp, now);
+}
+
+void CommandArbiter::claim(int source, uint32_t now) {
+    sources[source].live = true;
+    sources[source].last_us = now;
+}
+
+void CommandArbiter::expire(int source) {
+    source_t *s = &sources[source];
+    if (s->live) {
+        s->live = false;
+        s->held = 0;
+        s->stats.expired++;
+    }
+}
+
+// The newest command per leg is kept, even for a leg the source doesn't own,
+// so it is what goes out once the leg comes back to it
+void CommandArbiter::take(source_t *s, const setpoint_t &sp, uint32_t now) {
+    s->stats.commands++;
+    int leg;
+    if (sp.kind == SETPOINT_FOOT && sp.leg <= LEG_RIGHT) {
+        leg = sp.leg;
+        s->x_q4[leg] = sp.x_q4;
+        s->y_q4[leg] = sp.y_q4;
+        s->foot_us[leg] = sp.timestamp_us;
+        s->fresh_feet |= 1u << leg;
+        s->fresh_servos &= ~leg_servos(leg);
+    } else if (sp.kind == SETPOINT_SERVO && sp.leg >= 1 && sp.leg <= 4) {
+        leg = servo_leg(sp.leg);
+        s->angle[sp.leg - 1] = sp.angle;
+        s->angle_us[sp.leg - 1] = sp.timestamp_us;
+        s->servo_set |= 1u << (sp.leg - 1);
+        s->fresh_servos |= 1u << (sp.leg - 1);
+        s->fresh_feet &= ~(1u << leg);
+    } else {
+        s->stats.invalid++;
+        return;
+    }
+    s->kind[leg] = sp.kind;
+    s->held |= 1u << leg;
+    s->live = true;
+    s->last_us = sp.timestamp_us;
+    int32_t age = (int32_t)(now - sp.timestamp_us);
+    if (age > (int32_t)s->stats.age_max) {
+        s->stats.age_max = age;
+    }
+}
+
+void CommandArbiter::drain(source_t *s, uint32_t now) {
+    setpoint_t sp;
+    if (s->cfg.input == ARB_INPUT_NEWEST) {
+        while (s->ring.pop(&sp)) {
+            take(s, sp, now);
+        }
+        return;
+    }
+    // Same rule as a single queue: one foot target per leg and one angle per
+    // servo a tick, and a leg doesn't mix the two, so nothing is skipped
+    while (s->ring.peek(&sp)) {
+        uint32_t feet = s->fresh_feet;
+        uint32_t servos = s->fresh_servos;
+        if (sp.kind == SETPOINT_FOOT && sp.leg <= LEG_RIGHT) {
+            if ((feet & (1u << sp.leg)) || (servos & leg_servos(sp.leg))) {
+                break;
+            }
+        } else if (sp.kind == SETPOINT_SERVO && sp.leg >= 1 && sp.leg <= 4) {
+            if ((servos & (1u << (sp.leg - 1))) || (feet & (1u << servo_leg(sp.leg)))) {
+                break;
+            }
+        }
+        s->ring.pop(&sp);
+        take(s, sp, now);
+    }
+}
+
+bool CommandArbiter::holds(const source_t *s, int leg) const {
+    if (!s->live || s->cfg.merge == ARB_MERGE_OFFSET) {
+        return false;
+    }
+    return s->cfg.merge == ARB_MERGE_EXCLUSIVE || (s->held & (1u << leg));
+}
+
+// Only commands taken this tick count towards oldest_us, an older one going
+// out on a takeover isn't late, it was held back
+void CommandArbiter::emit(source_t *s, int leg, bool fresh_only, arb_setpoint_t *out) {
+    if (s->kind[leg] == SETPOINT_FOOT && (!fresh_only || (s->fresh_feet & (1u << leg)))) {
+        if (s->fresh_feet & (1u << leg)) {
+            note_oldest(out, s->foot_us[leg]);
+        }
+        out->feet |= 1u << leg;
+        out->x_q4[leg] = s->x_q4[leg];
+        out->y_q4[leg] = s->y_q4[leg];
+        s->stats.applied++;
+    } else if (s->kind[leg] == SETPOINT_SERVO) {
+        uint8_t servos = leg_servos(leg) & (fresh_only ? s->fresh_servos : s->servo_set);
+        for (int i = 0; i < 4; i++) {
+            if (servos & (1u << i)) {
+                if (s->fresh_servos & (1u << i)) {
+                    note_oldest(out, s->angle_us[i]);
+                }
+                out->angle[i] = s->angle[i];
+                s->stats.applied++;
+            }
+        }
+        out->servos |= servos;
+    }
+}
+
+void CommandArbiter::tick(uint32_t now, arb_setpoint_t *out) {
+    memset(out, 0, sizeof(*out));
+
+    // Whatever offer() brought since the last tick is fresh as well
+    for (int i = 0; i < count; i++) {
+        source_t *s = &sources[i];
+        drain(s, now);
+        s->stats.overflows = s->ring.drops();
+    }
+
+    // Lapsed leases before ownership, a source can't keep a leg past its lease
+    uint8_t lapsed = 0;
+    for (int i = 0; i < count; i++) {
+        source_t *s = &sources[i];
+        if (s->live && s->cfg.lease_us != 0 && (int32_t)(now - s->last_us) > (int32_t)s->cfg.lease_us) {
+            s->live = false;
+            s->held = 0;
+            s->stats.expired++;
+        }
+        if (!s->live) {
+            lapsed |= 1u << i;
+        }
+    }
+
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        uint8_t prev = owner[leg];
+        // The owner keeps the leg on a tie, otherwise the lowest id wins one
+        int best = prev != ARB_NONE && holds(&sources[prev], leg) ? prev : -1;
+        for (int i = 0; i < count; i++) {
+            if (i != best && holds(&sources[i], leg) &&
+                (best < 0 || sources[i].cfg.priority > sources[best].cfg.priority)) {
+                best = i;
+            }
+        }
+
+        if (best < 0) {
+            owner[leg] = ARB_NONE;
+            if (prev != ARB_NONE && sources[prev].cfg.park_on_expiry && (lapsed & (1u << prev))) {
+                out->park |= 1u << leg;
+            }
+        } else if (best != prev) {
+            // Taking over: the new owner's last command for the leg, whenever it came
+            owner[leg] = best;
+            sources[best].stats.takeovers++;
+            emit(&sources[best], leg, false, out);
+        } else {
+            emit(&sources[best], leg, true, out);
+        }
+
+        for (int i = 0; i < count; i++) {
+            source_t *s = &sources[i];
+            uint8_t fresh = (s->fresh_feet & (1u << leg)) | (s->fresh_servos & leg_servos(leg));
+            if (i != best && s->cfg.merge != ARB_MERGE_OFFSET && fresh) {
+                s->stats.preempted++;
+            }
+        }
+
+        // Offsets ride on the owner's foot target, a change rewrites the target
+        int32_t dx = 0, dy = 0;
+        for (int i = 0; i < count; i++) {
+            source_t *s = &sources[i];
+            if (s->live && s->cfg.merge == ARB_MERGE_OFFSET && (s->held & (1u << leg)) &&
+                s->kind[leg] == SETPOINT_FOOT) {
+                dx += s->x_q4[leg];
+                dy += s->y_q4[leg];
+                if (best >= 0 && (s->fresh_feet & (1u << leg))) {
+                    note_oldest(out, s->foot_us[leg]);
+                    s->stats.applied++;
+                }
+            }
+        }
+        if (best >= 0 && sources[best].kind[leg] == SETPOINT_FOOT) {
+            if (!(out->feet & (1u << leg)) && (dx != offset_x[leg] || dy != offset_y[leg])) {
+                out->feet |= 1u << leg;
+                out->x_q4[leg] = sources[best].x_q4[leg];
+                out->y_q4[leg] = sources[best].y_q4[leg];
+            }
+            if (out->feet & (1u << leg)) {
+                out->x_q4[leg] = clamp_q4(out->x_q4[leg] + dx);
+                out->y_q4[leg] = clamp_q4(out->y_q4[leg] + dy);
+                offset_x[leg] = dx;
+                offset_y[leg] = dy;
+            }
+        }
+    }
+
+    out->owner[LEG_LEFT] = owner[LEG_LEFT];
+    out->owner[LEG_RIGHT] = owner[LEG_RIGHT];
+    for (int i = 0; i < count; i++) {
+        sources[i].fresh_feet = 0;
+        sources[i].fresh_servos = 0;
+    }
+}
+
+uint8_t CommandArbiter::owner_of(int leg) const {
+    return owner[leg];
+}
+
+int CommandArbiter::sources_count() const {
+    return count;
+}
+
+const char *CommandArbiter::source_name(int source) const {
+    return sources[source].cfg.name;
+}
+
+void CommandArbiter::get_stats(int source, arb_source_stats_t *out) const {
+    *out = sources[source].stats;
+}
@@ -0,0 +1,147 @@
+#ifndef ARBITER_H
+#define ARBITER_H
+
+#include <stdint.h>
+
+#include "setpoint.h"
+
+#define ARB_MAX_SOURCES         8
+#define ARB_NONE                0xFF        // no source, in arb_setpoint_t::owner
+
+// Priorities of the firmware's sources, higher preempts lower
+#define ARB_PRIO_TCP            10
+#define ARB_PRIO_GAIT           20
+#define ARB_PRIO_TELEOP         30
+
+// A TCP client keeps the legs it commanded this long after its last command
+#define ARB_LEASE_TCP_US        2000000
+
+typedef enum {
+    ARB_MERGE_OVERRIDE = 0,     // owns each leg it commands while no live source outranks it
+    ARB_MERGE_EXCLUSIVE,        // owns both legs while live, one it sends nothing for holds its pose
+    ARB_MERGE_OFFSET,           // owns nothing, its foot targets are added to the owner's
+} arb_merge_t;
+
+typedef enum {
+    ARB_INPUT_QUEUE = 0,        // every command in order, at most one per leg and servo per tick
+    ARB_INPUT_NEWEST,           // all that queued up is taken each tick, the newest per leg wins
+} arb_input_t;
+
+typedef struct {
+    const char *name;
+    uint8_t priority;           // higher preempts lower, the current owner keeps a leg on a tie
+    uint8_t merge;              // arb_merge_t
+    uint8_t input;              // arb_input_t
+    bool park_on_expiry;        // legs it owned are parked when it lapses and no one takes over
+    uint32_t lease_us;          // live this long after its newest command, 0 until expire()
+} arb_source_config_t;
+
+typedef struct {
+    uint32_t commands;          // taken from the input
+    uint32_t invalid;           // leg or servo number out of range
+    uint32_t applied;           // went out in a tick's setpoint
+    uint32_t preempted;         // dropped, the leg belonged to another source
+    uint32_t takeovers;         // legs it took from another source or from none
+    uint32_t expired;           // leases that ran out
+    uint32_t overflows;         // commands the full input ring refused
+    uint32_t age_max;           // command timestamp to the tick that took it, us
+} arb_source_stats_t;
+
+// What the control loop applies in one tick
+typedef struct {
+    uint8_t feet;               // bit (1 << leg_id_t) for every new foot target
+    uint8_t servos;             // bit (1 << (servo - 1)) for every new servo angle
+    uint8_t park;               // legs to park, their owner lapsed and no source took over
+    uint8_t owner[2];           // source holding each leg after this tick, ARB_NONE if none
+    int16_t x_q4[2];            // by leg_id_t, offsets included
+    int16_t y_q4[2];
+    int16_t angle[4];           // degrees, by servo - 1
+    bool fresh;                 // commands taken this tick went out, oldest_us is set
+    uint32_t oldest_us;         // timestamp of the oldest of them
+} arb_setpoint_t;
+
+// Decides which of several command sources drives each leg and merges their
+// setpoints into one per control tick.
+//
+// Each source has its own SPSC setpoint ring, so every producer task (the
+// network task for the TCP clients, a UART reader) pushes without locks and
+// the control task drains them without ever blocking. Sources that live on
+// the control task itself (the gait engine, the teleop mailbox) skip the ring
+// with offer() and claim().
+//
+// A source is live from its newest command until its lease runs out. A leg
+// belongs to the highest priority live source that holds it (exclusive
+// sources hold both legs, override sources the legs they commanded). When
+// the owner changes the new owner's last command for the leg goes out, so a
+// lapsed or preempted source hands the legs back to whoever is still live
+// below it. Commands for a leg its source doesn't own are dropped.
+//
+// add_source() before the control task starts, push() from the source's
+// single producer, everything else control task only. No allocation.
+class CommandArbiter {
+private:
+    typedef struct {
+        arb_source_config_t cfg;
+        SetpointRing ring;
+        bool live;
+        uint32_t last_us;           // newest command's timestamp
+        uint8_t held;               // legs commanded since it went live
+        uint8_t kind[2];            // setpoint_kind_t of the newest command per leg, 0xFF none
+        uint8_t servo_set;          // servos it sent an angle for, bit (servo - 1)
+        uint8_t fresh_feet;         // taken this tick
+        uint8_t fresh_servos;
+        int16_t x_q4[2];
+        int16_t y_q4[2];
+        int16_t angle[4];
+        uint32_t foot_us[2];        // timestamps of the newest commands, as x_q4 and angle
+        uint32_t angle_us[4];
+        arb_source_stats_t stats;
+    } source_t;
+
+    source_t sources[ARB_MAX_SOURCES];
+    int count;
+    uint8_t owner[2];
+    int32_t offset_x[2], offset_y[2];   // of the offset sources, as last applied
+
+    void take(source_t *s, const setpoint_t &sp, uint32_t now);
+
+    void drain(source_t *s, uint32_t now);
+
+    bool holds(const source_t *s, int leg) const;
+
+    // The source's last command for the leg, fresh_only: just what came this tick
+    void emit(source_t *s, int leg, bool fresh_only, arb_setpoint_t *out);
+
+public:
+    CommandArbiter();
+
+    // Before the control task starts. Returns the source id, -1 when full.
+    int add_source(const arb_source_config_t &cfg);
+
+    // The source's producer task only. False when its ring is full.
+    bool push(int source, const setpoint_t &sp);
+
+    // Control task. A command from a source that runs on the control task.
+    void offer(int source, const setpoint_t &sp, uint32_t now);
+
+    // Control task. Keeps a source live without a command (an exclusive
+    // source playing its own trajectory).
+    void claim(int source, uint32_t now);
+
+    // Control task. Ends the source's lease now.
+    void expire(int source);
+
+    // Control task, once per tick. now on the clock of the command timestamps.
+    void tick(uint32_t now, arb_setpoint_t *out);
+
+    // Source holding the leg since the last tick, ARB_NONE if none
+    uint8_t owner_of(int leg) const;
+
+    int sources_count() const;
+
+    const char *source_name(int source) const;
+
+    void get_stats(int source, arb_source_stats_t *out) const;
+};
+
+#endif // ARBITER_H
@@ -0,0 +1,267 @@
+#include "attitude.h"
+
+#include <math.h>
+
+#define DEG_TO_RAD      0.017453292519943f
+#define RAD_TO_DEG      57.295779513082f
+#define Q30_ONE         (1 << 30)
+
+euler_t attitude_euler(const float q[4]) {
+    euler_t e;
+    float w = q[0], x = q[1], y = q[2], z = q[3];
+    float sp = 2.0f * (w * y - z * x);
+    sp = sp > 1.0f ? 1.0f : (sp < -1.0f ? -1.0f : sp);
+    e.roll = atan2f(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y)) * RAD_TO_DEG;
+    e.pitch = asinf(sp) * RAD_TO_DEG;
+    e.yaw = atan2f(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z)) * RAD_TO_DEG;
+    return e;
+}
+
+// Roll and pitch from gravity alone, yaw 0. Identity if the accel reads nothing.
+static void seed_quaternion(const imu_sample_t *s, float q[4]) {
+    float ax = s->accel[0], ay = s->accel[1], az = s->accel[2];
+    if (ax == 0 && ay == 0 && az == 0) {
+        q[0] = 1;
+        q[1] = q[2] = q[3] = 0;
+        return;
+    }
+    float roll = atan2f(ay, az);
+    float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+    float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    q[0] = cr * cp;
+    q[1] = sr * cp;
+    q[2] = cr * sp;
+    q[3] = -sr * sp;
+}
+
+static uint64_t isqrt64(uint64_t n) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+MahonyFilter::MahonyFilter(float kp, float ki) {
+    this->kp = kp;
+    this->ki = ki;
+    gyro_scale = 0;
+    accel_lsb = 1;
+    reset();
+}
+
+void MahonyFilter::set_scale(float accel_lsb_per_g, float gyro_lsb_per_dps) {
+    accel_lsb = accel_lsb_per_g;
+    gyro_scale = DEG_TO_RAD / gyro_lsb_per_dps;
+}
+
+void MahonyFilter::reset() {
+    q[0] = 1;
+    q[1] = q[2] = q[3] = 0;
+    bias[0] = bias[1] = bias[2] = 0;
+    rate[0] = rate[1] = rate[2] = 0;
+    last_us = 0;
+    started = false;
+}
+
+void MahonyFilter::update(const imu_sample_t *s) {
+    if (!started) {
+        seed_quaternion(s, q);
+        last_us = s->timestamp_us;
+        started = true;
+        return;
+    }
+    uint32_t dt_us = s->timestamp_us - last_us;
+    last_us = s->timestamp_us;
+    if (dt_us == 0 || dt_us > ATTITUDE_MAX_DT_US) {
+        return;
+    }
+    float dt = dt_us * 1e-6f;
+
+    float gx = s->gyro[0] * gyro_scale;
+    float gy = s->gyro[1] * gyro_scale;
+    float gz = s->gyro[2] * gyro_scale;
+
+    float ax = s->accel[0], ay = s->accel[1], az = s->accel[2];
+    float n2 = ax * ax + ay * ay + az * az;
+    float lo = (1.0f - ATTITUDE_ACCEL_GATE) * accel_lsb;
+    float hi = (1.0f + ATTITUDE_ACCEL_GATE) * accel_lsb;
+    // Only trust the accel as a gravity reference when it reads about 1g
+    if (n2 >= lo * lo && n2 <= hi * hi) {
+        float inv = 1.0f / sqrtf(n2);
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+        // Gravity direction the quaternion predicts, in the body frame
+        float vx = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+        float vy = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+        float vz = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+        float ex = ay * vz - az * vy;
+        float ey = az * vx - ax * vz;
+        float ez = ax * vy - ay * vx;
+        bias[0] += ki * ex * dt;
+        bias[1] += ki * ey * dt;
+        bias[2] += ki * ez * dt;
+        gx += kp * ex;
+        gy += kp * ey;
+        gz += kp * ez;
+    }
+    rate[0] = s->gyro[0] * gyro_scale + bias[0];
+    rate[1] = s->gyro[1] * gyro_scale + bias[1];
+    rate[2] = s->gyro[2] * gyro_scale + bias[2];
+    gx = (gx + bias[0]) * 0.5f * dt;
+    gy = (gy + bias[1]) * 0.5f * dt;
+    gz = (gz + bias[2]) * 0.5f * dt;
+
+    float qa = q[0], qb = q[1], qc = q[2];
+    q[0] += -qb * gx - qc * gy - q[3] * gz;
+    q[1] += qa * gx + qc * gz - q[3] * gy;
+    q[2] += qa * gy - qb * gz + q[3] * gx;
+    q[3] += qa * gz + qb * gy - qc * gx;
+
+    float inv = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] *= inv;
+    }
+}
+
+void MahonyFilter::quaternion(float out[4]) const {
+    for (int i = 0; i < 4; i++) {
+        out[i] = q[i];
+    }
+}
+
+euler_t MahonyFilter::euler() const {
+    return attitude_euler(q);
+}
+
+void MahonyFilter::rates(float out[3]) const {
+    for (int i = 0; i < 3; i++) {
+        out[i] = rate[i] * RAD_TO_DEG;
+    }
+}
+
+MahonyFilterQ::MahonyFilterQ(float kp, float ki) {
+    this->kp = (int32_t)lrintf(kp * 65536.0f);
+    this->ki = (int32_t)lrintf(ki * 65536.0f);
+    gyro_scale = 0;
+    accel_lo2 = 0;
+    accel_hi2 = INT64_MAX;
+    reset();
+}
+
+void MahonyFilterQ::set_scale(float accel_lsb_per_g, float gyro_lsb_per_dps) {
+    gyro_scale = (int32_t)lrintf(DEG_TO_RAD / gyro_lsb_per_dps * 16777216.0f);
+    float lo = (1.0f - ATTITUDE_ACCEL_GATE) * accel_lsb_per_g;
+    float hi = (1.0f + ATTITUDE_ACCEL_GATE) * accel_lsb_per_g;
+    accel_lo2 = (int64_t)(lo * lo);
+    accel_hi2 = (int64_t)(hi * hi);
+}
+
+void MahonyFilterQ::reset() {
+    q[0] = Q30_ONE;
+    q[1] = q[2] = q[3] = 0;
+    bias[0] = bias[1] = bias[2] = 0;
+    rate[0] = rate[1] = rate[2] = 0;
+    last_us = 0;
+    started = false;
+}
+
+void MahonyFilterQ::seed(const imu_sample_t *s) {
+    float f[4];
+    seed_quaternion(s, f);
+    for (int i = 0; i < 4; i++) {
+        q[i] = (int32_t)lrintf(f[i] * Q30_ONE);
+    }
+}
+
+void MahonyFilterQ::update(const imu_sample_t *s) {
+    if (!started) {
+        seed(s);
+        last_us = s->timestamp_us;
+        started = true;
+        return;
+    }
+    uint32_t dt_us = s->timestamp_us - last_us;
+    last_us = s->timestamp_us;
+    if (dt_us == 0 || dt_us > ATTITUDE_MAX_DT_US) {
+        return;
+    }
+
+    // Q24 * LSB -> Q30 rad/s
+    int64_t g[3];
+    for (int i = 0; i < 3; i++) {
+        g[i] = ((int64_t)s->gyro[i] * gyro_scale) << 6;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        rate[i] = g[i] + bias[i];
+    }
+
+    int64_t n2 = (int64_t)s->accel[0] * s->accel[0] + (int64_t)s->accel[1] * s->accel[1] +
+                 (int64_t)s->accel[2] * s->accel[2];
+    if (n2 >= accel_lo2 && n2 <= accel_hi2) {
+        int64_t norm = (int64_t)isqrt64((uint64_t)n2);
+        int64_t ax = ((int64_t)s->accel[0] << 30) / norm;
+        int64_t ay = ((int64_t)s->accel[1] << 30) / norm;
+        int64_t az = ((int64_t)s->accel[2] << 30) / norm;
+        int64_t vx = ((int64_t)q[1] * q[3] - (int64_t)q[0] * q[2]) >> 29;
+        int64_t vy = ((int64_t)q[0] * q[1] + (int64_t)q[2] * q[3]) >> 29;
+        int64_t vz = ((int64_t)q[0] * q[0] - (int64_t)q[1] * q[1] - (int64_t)q[2] * q[2] +
+                      (int64_t)q[3] * q[3]) >> 30;
+        int64_t e[3];
+        e[0] = (ay * vz - az * vy) >> 30;
+        e[1] = (az * vx - ax * vz) >> 30;
+        e[2] = (ax * vy - ay * vx) >> 30;
+        for (int i = 0; i < 3; i++) {
+            bias[i] += ((ki * e[i]) >> 16) * dt_us / 1000000;
+            g[i] += (kp * e[i]) >> 16;
+        }
+    }
+    // Half the rotation angle over dt, Q30
+    int64_t h[3];
+    for (int i = 0; i < 3; i++) {
+        h[i] = (g[i] + bias[i]) * dt_us / 2000000;
+    }
+
+    int64_t qa = q[0], qb = q[1], qc = q[2], qd = q[3];
+    int64_t n[4];
+    n[0] = qa + ((-qb * h[0] - qc * h[1] - qd * h[2]) >> 30);
+    n[1] = qb + ((qa * h[0] + qc * h[2] - qd * h[1]) >> 30);
+    n[2] = qc + ((qa * h[1] - qb * h[2] + qd * h[0]) >> 30);
+    n[3] = qd + ((qa * h[2] + qb * h[1] - qc * h[0]) >> 30);
+
+    int64_t len = (int64_t)isqrt64((uint64_t)(n[0] * n[0] + n[1] * n[1] + n[2] * n[2] + n[3] * n[3]));
+    for (int i = 0; i < 4; i++) {
+        q[i] = (int32_t)((n[i] << 30) / len);
+    }
+}
+
+void MahonyFilterQ::quaternion(float out[4]) const {
+    for (int i = 0; i < 4; i++) {
+        out[i] = q[i] * (1.0f / Q30_ONE);
+    }
+}
+
+euler_t MahonyFilterQ::euler() const {
+    float f[4];
+    quaternion(f);
+    return attitude_euler(f);
+}
+
+void MahonyFilterQ::rates(float out[3]) const {
+    for (int i = 0; i < 3; i++) {
+        out[i] = rate[i] * (RAD_TO_DEG / Q30_ONE);
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef ATTITUDE_H
+#define ATTITUDE_H
+
+#include <stdint.h>
+
+#include "imu_sample.h"
+#include "seqlock.h"
+
+#define ATTITUDE_KP             2.0f        // accel correction, rad/s per rad of tilt error
+#define ATTITUDE_KI             0.2f        // gyro bias learning, rad/s^2 per rad
+#define ATTITUDE_MAX_DT_US      50000       // longer gaps restart integration
+#define ATTITUDE_ACCEL_GATE     0.25f       // skip the accel correction beyond 1g +- this
+
+// Degrees, Z-Y-X (yaw, pitch, roll) order. Yaw is gyro only and drifts.
+typedef struct {
+    float roll;
+    float pitch;
+    float yaw;
+} euler_t;
+
+// What the estimator publishes once per IMU sample
+typedef struct {
+    uint32_t timestamp_us;      // of the IMU sample
+    euler_t euler;
+    float rate[3];              // body rates x, y, z in deg/s, gyro bias removed
+} attitude_t;
+
+typedef Seqlock<attitude_t> AttitudeMailbox;
+
+// Unit quaternion w, x, y, z to Euler angles
+euler_t attitude_euler(const float q[4]);
+
+// Mahony complementary filter on the quaternion. The gyro is integrated with
+// the sample period taken from the IMU timestamps, the accel direction pulls
+// roll and pitch back towards gravity (proportional term) and learns the gyro
+// bias (integral term). Raw samples go in, sensitivities are set once.
+class MahonyFilter {
+private:
+    float q[4];
+    float bias[3];              // integral term, rad/s
+    float rate[3];              // last gyro reading with bias removed, rad/s
+    float kp, ki;
+    float gyro_scale;           // LSB to rad/s
+    float accel_lsb;            // LSB per g
+    uint32_t last_us;
+    bool started;
+
+public:
+    MahonyFilter(float kp = ATTITUDE_KP, float ki = ATTITUDE_KI);
+
+    void set_scale(float accel_lsb_per_g, float gyro_lsb_per_dps);
+
+    // Next attitude is seeded from the accel of the next sample
+    void reset();
+
+    void update(const imu_sample_t *s);
+
+    void quaternion(float out[4]) const;
+
+    euler_t euler() const;
+
+    // Body rates of the last update in deg/s
+    void rates(float out[3]) const;
+};
+
+// The same filter in integer arithmetic for targets without an FPU.
+// Quaternion and accel direction are Q30, rates Q30 rad/s in 64 bit, so a
+// 1kHz update with a slow rotation still moves the quaternion by many LSBs.
+// Floats are only used once in set_scale() and when seeding from the accel.
+class MahonyFilterQ {
+private:
+    int32_t q[4];
+    int64_t bias[3];            // Q30 rad/s
+    int64_t rate[3];            // Q30 rad/s, bias removed
+    int32_t kp, ki;             // Q16
+    int32_t gyro_scale;         // Q24 rad/s per LSB
+    int64_t accel_lo2, accel_hi2;   // accel gate on the squared norm, LSB^2
+    uint32_t last_us;
+    bool started;
+
+    void seed(const imu_sample_t *s);
+
+public:
+    MahonyFilterQ(float kp = ATTITUDE_KP, float ki = ATTITUDE_KI);
+
+    void set_scale(float accel_lsb_per_g, float gyro_lsb_per_dps);
+
+    void reset();
+
+    void update(const imu_sample_t *s);
+
+    void quaternion(float out[4]) const;
+
+    euler_t euler() const;
+
+    void rates(float out[3]) const;
+};
+
+#endif // ATTITUDE_H
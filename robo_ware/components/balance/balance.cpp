@@ -0,0 +1,69 @@
+#include "balance.h"
+
+static inline float clampf(float v, float limit) {
+    return v > limit ? limit : (v < -limit ? -limit : v);
+}
+
+static inline int32_t to_q4(float mm) {
+    float v = mm * 16.0f;
+    return (int32_t)(v >= 0 ? v + 0.5f : v - 0.5f);
+}
+
+BalanceController::BalanceController(const balance_gains_t &pitch, const balance_gains_t &roll) {
+    set_gains(pitch, roll);
+    pitch_ref = 0;
+    roll_ref = 0;
+    reset();
+}
+
+void BalanceController::set_gains(const balance_gains_t &pitch, const balance_gains_t &roll) {
+    pitch_gains = pitch;
+    roll_gains = roll;
+}
+
+void BalanceController::set_reference(float pitch_deg, float roll_deg) {
+    pitch_ref = pitch_deg;
+    roll_ref = roll_deg;
+}
+
+void BalanceController::reset() {
+    pitch_i = 0;
+    roll_i = 0;
+    last_us = 0;
+    have_last = false;
+}
+
+float BalanceController::axis(const balance_gains_t *g, float error, float rate, float dt, float *integral) {
+    float p = g->kp * error;
+    float d = g->kd * rate;
+    // Conditional integration: stop growing the integral once the output saturates the same way
+    float i = clampf(*integral + g->ki * error * dt, g->limit_mm);
+    float u = p + i + d;
+    if ((u > g->limit_mm && error > 0) || (u < -g->limit_mm && error < 0)) {
+        i = *integral;
+        u = p + i + d;
+    }
+    *integral = i;
+    return clampf(u, g->limit_mm);
+}
+
+bool BalanceController::update(const attitude_t *att, uint32_t now_us, balance_offset_t *out) {
+    if (att == NULL || (int32_t)(now_us - att->timestamp_us) > BALANCE_STALE_US) {
+        reset();
+        out->dx_q4 = 0;
+        out->dy_q4[LEG_LEFT] = 0;
+        out->dy_q4[LEG_RIGHT] = 0;
+        return false;
+    }
+    // Same attitude as last tick gives dt 0, the output is recomputed but nothing integrates
+    float dt = have_last ? (att->timestamp_us - last_us) * 1e-6f : 0.0f;
+    last_us = att->timestamp_us;
+    have_last = true;
+
+    float dx = axis(&pitch_gains, att->euler.pitch - pitch_ref, att->rate[1], dt, &pitch_i);
+    float dy = axis(&roll_gains, att->euler.roll - roll_ref, att->rate[0], dt, &roll_i);
+    out->dx_q4 = to_q4(dx);
+    out->dy_q4[LEG_LEFT] = to_q4(-dy);
+    out->dy_q4[LEG_RIGHT] = to_q4(dy);
+    return true;
+}
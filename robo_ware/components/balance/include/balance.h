@@ -0,0 +1,74 @@
+#ifndef BALANCE_H
+#define BALANCE_H
+
+#include <stdint.h>
+
+#include "attitude.h"
+#include "setpoint.h"
+
+#define BALANCE_STALE_US        100000      // attitude older than this disables the correction
+
+// Pitch defaults from host/sil_sim --sweep, the firmware's control tick on a
+// body standing on flat soles: the soles carry most of a push, and a gyro D
+// term tips the body over (a fast foot move pushes it the other way). sil_sim
+// checks them as they are. sim_balance's line contact pendulum wants far more
+// gain and is no reference for pitch. The SIL has no roll, roll defaults come
+// from sim_balance --sweep.
+#define BALANCE_PITCH_KP        0.25f
+#define BALANCE_PITCH_KI        0.25f
+#define BALANCE_PITCH_KD        0.0f
+#define BALANCE_PITCH_LIMIT     20.0f
+#define BALANCE_ROLL_KP         0.8f
+#define BALANCE_ROLL_KI         2.0f
+#define BALANCE_ROLL_KD         0.02f
+#define BALANCE_ROLL_LIMIT      6.0f
+
+// One axis. Output in mm of foot offset per degree of tilt.
+typedef struct {
+    float kp;           // mm per deg
+    float ki;           // mm per deg s
+    float kd;           // mm per deg/s, on the gyro rate
+    float limit_mm;     // output clamp, the integral term is held inside it too
+} balance_gains_t;
+
+// Added to the commanded foot targets before IK, Q4 mm like the targets
+typedef struct {
+    int32_t dx_q4;          // both feet, positive forward
+    int32_t dy_q4[2];       // by leg_id_t, positive extends the leg
+} balance_offset_t;
+
+// PID on body pitch and roll from the attitude estimator, run once per control
+// tick. Pitch (nose down positive) moves both feet forward under the body,
+// roll (right side down positive) extends the right leg and shortens the left
+// by the same amount. The D term uses the estimator's bias corrected gyro rate
+// rather than differencing angles, and the integral advances with the IMU
+// timestamps, so ticks that see no new attitude don't wind it up.
+//
+// No allocation, no libm: a few dozen float operations per update.
+class BalanceController {
+private:
+    balance_gains_t pitch_gains;
+    balance_gains_t roll_gains;
+    float pitch_ref, roll_ref;      // deg, the attitude to hold
+    float pitch_i, roll_i;          // integral terms, mm
+    uint32_t last_us;               // attitude timestamp of the previous update
+    bool have_last;
+
+    static float axis(const balance_gains_t *g, float error, float rate, float dt, float *integral);
+
+public:
+    BalanceController(const balance_gains_t &pitch, const balance_gains_t &roll);
+
+    void set_gains(const balance_gains_t &pitch, const balance_gains_t &roll);
+
+    // Trim for an IMU that isn't mounted level
+    void set_reference(float pitch_deg, float roll_deg);
+
+    void reset();
+
+    // now_us on the attitude clock. Returns false with a zero offset (and a
+    // reset integral) when the attitude is missing or stale.
+    bool update(const attitude_t *att, uint32_t now_us, balance_offset_t *out);
+};
+
+#endif // BALANCE_H
@@ -0,0 +1,62 @@
+#ifndef SERVO_CALIB_H
+#define SERVO_CALIB_H
+
+#include <stdint.h>
+
+#include "kinematics.h"
+#include "seqlock.h"
+
+#define CALIB_POINTS        9       // nominal angles -90, -67.5, .. 90
+#define CALIB_SERVOS        4       // body_ticks_t order: left front, left rear, right front, right rear
+#define CALIB_STEP_TICKS    ((SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / (CALIB_POINTS - 1))
+
+// Whole ticks between points, so the identity curve maps every value onto itself
+static_assert((SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) % (CALIB_POINTS - 1) == 0,
+              "calibration points must fall on whole ticks");
+
+// Pulse widths measured for one servo at evenly spaced nominal angles. In
+// between the curve is linear, so a servo that is off center, scaled or a
+// little bent is corrected everywhere from nine measurements.
+typedef struct {
+    uint16_t pulse_us[CALIB_POINTS];
+} calib_curve_t;
+
+// Every servo's curve in one flat block: the control task reads the whole
+// table in a single mailbox read, NVS stores it as a single blob
+typedef struct {
+    calib_curve_t servo[CALIB_SERVOS];
+} calib_table_t;
+
+// Single writer (app_main at boot, then the command task), read by the control task
+typedef Seqlock<calib_table_t> CalibMailbox;
+
+// The ideal servo: pulse_us is the nominal compare value of each point
+void calib_identity(calib_curve_t *curve);
+
+void calib_identity_table(calib_table_t *table);
+
+// Strictly increasing and within min_us..max_us, the pulse limits of the servo model
+bool calib_valid(const calib_curve_t *curve, uint16_t min_us, uint16_t max_us);
+
+// Nominal compare value, as IK and the gait tables produce it, to the pulse
+// width this servo needs for the same angle. No search: the segment follows
+// from the value, then one multiply and one constant divide.
+static inline uint16_t calib_apply(const calib_curve_t *curve, uint16_t ticks) {
+    int32_t off = (int32_t)ticks - SERVO_MIN_PULSEWIDTH_US;
+    if (off < 0) {
+        off = 0;
+    }
+    int32_t i = off / CALIB_STEP_TICKS;
+    if (i > CALIB_POINTS - 2) {
+        i = CALIB_POINTS - 2;
+    }
+    int32_t rem = off - i * CALIB_STEP_TICKS;
+    if (rem > CALIB_STEP_TICKS) {
+        rem = CALIB_STEP_TICKS;
+    }
+    int32_t a = curve->pulse_us[i];
+    int32_t b = curve->pulse_us[i + 1];
+    return (uint16_t)(a + ((b - a) * rem + CALIB_STEP_TICKS / 2) / CALIB_STEP_TICKS);
+}
+
+#endif // SERVO_CALIB_H
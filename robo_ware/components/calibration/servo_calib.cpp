@@ -0,0 +1,25 @@
+#include "servo_calib.h"
+
+void calib_identity(calib_curve_t *curve) {
+    for (int i = 0; i < CALIB_POINTS; i++) {
+        curve->pulse_us[i] = (uint16_t)(SERVO_MIN_PULSEWIDTH_US + i * CALIB_STEP_TICKS);
+    }
+}
+
+void calib_identity_table(calib_table_t *table) {
+    for (int s = 0; s < CALIB_SERVOS; s++) {
+        calib_identity(&table->servo[s]);
+    }
+}
+
+bool calib_valid(const calib_curve_t *curve, uint16_t min_us, uint16_t max_us) {
+    if (curve->pulse_us[0] < min_us || curve->pulse_us[CALIB_POINTS - 1] > max_us) {
+        return false;
+    }
+    for (int i = 1; i < CALIB_POINTS; i++) {
+        if (curve->pulse_us[i] <= curve->pulse_us[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,211 @@
+#include "gait.h"
+
+#include <math.h>
+
+#define TWO_PI      6.283185307179586f
+
+// Fraction of a table step, from the phase bits below the table index
+#define GAIT_FRAC_SHIFT     (16 - GAIT_TABLE_BITS)
+
+static inline uint16_t lerp_ticks(uint16_t a, uint16_t b, int32_t frac) {
+    return (uint16_t)(a + (((int32_t)b - a) * frac >> 16));
+}
+
+static inline body_ticks_t lerp_body(const body_ticks_t &a, const body_ticks_t &b, int32_t frac) {
+    body_ticks_t out;
+    out.left_front = lerp_ticks(a.left_front, b.left_front, frac);
+    out.left_rear = lerp_ticks(a.left_rear, b.left_rear, frac);
+    out.right_front = lerp_ticks(a.right_front, b.right_front, frac);
+    out.right_rear = lerp_ticks(a.right_rear, b.right_rear, frac);
+    return out;
+}
+
+static inline body_ticks_t sample(const body_ticks_t *table, uint32_t phase) {
+    uint32_t i = phase >> (32 - GAIT_TABLE_BITS);
+    int32_t frac = (int32_t)((phase >> GAIT_FRAC_SHIFT) & 0xFFFF);
+    return lerp_body(table[i], table[(i + 1) & (GAIT_TABLE_LEN - 1)], frac);
+}
+
+static inline int16_t to_q4(float v) {
+    return (int16_t)lrintf(v);
+}
+
+GaitEngine::GaitEngine(const GaitMailbox *requests, uint32_t tick_us) {
+    this->requests = requests;
+    this->tick_us = tick_us;
+    seen = 0;
+    active = 0;
+    params = {};
+    next_params = {};
+    build_pos = 0;
+    build_invalid = 0;
+    building = false;
+    playing = false;
+    phase = 0;
+    rate = 0;
+    rate_from = 0;
+    blend_pos = 0;
+    blend_len = 0;
+    stats = {};
+}
+
+bool GaitEngine::is_stand(const gait_params_t *p) {
+    return p->step_length_q4 == 0 && p->step_height_q4 == 0;
+}
+
+bool GaitEngine::params_valid(const gait_params_t *p) {
+    return p->period_us >= GAIT_PERIOD_MIN_US && p->period_us <= GAIT_PERIOD_MAX_US &&
+           p->stance_pct >= GAIT_STANCE_MIN_PCT && p->stance_pct <= GAIT_STANCE_MAX_PCT &&
+           p->step_length_q4 >= 0 && p->step_height_q4 >= 0;
+}
+
+void GaitEngine::foot_path(const gait_params_t *p, uint32_t phase, int16_t *x_q4, int16_t *y_q4) {
+    float u = phase * (1.0f / 4294967296.0f);
+    float stance = p->stance_pct * 0.01f;
+    float half = p->step_length_q4 * 0.5f;
+    if (u < stance) {
+        // On the ground, front to back at constant speed
+        float s = u / stance;
+        *x_q4 = to_q4(p->center_x_q4 + half - 2.0f * half * s);
+        *y_q4 = p->stand_y_q4;
+    } else {
+        // Cycloid back to the front, lift (smaller y) peaks halfway
+        float s = (u - stance) / (1.0f - stance);
+        float c = s - sinf(TWO_PI * s) / TWO_PI;
+        *x_q4 = to_q4(p->center_x_q4 - half + 2.0f * half * c);
+        *y_q4 = to_q4(p->stand_y_q4 - p->step_height_q4 * 0.5f * (1.0f - cosf(TWO_PI * s)));
+    }
+}
+
+uint32_t GaitEngine::phase_rate(uint32_t period_us) const {
+    return (uint32_t)(((uint64_t)tick_us << 32) / period_us);
+}
+
+// A new table is only started when the spare one is free: not mid build, not
+// mid blend. The mailbox keeps the newest request until then.
+void GaitEngine::poll_request() {
+    if (building || blend_len != 0) {
+        return;
+    }
+    uint32_t writes = requests->writes();
+    gait_params_t p;
+    if (writes == seen || !requests->read(&p)) {
+        return;
+    }
+    seen = writes;
+    stats.requests++;
+    if (!params_valid(&p)) {
+        stats.rejected++;
+        return;
+    }
+    if (!playing && is_stand(&p)) {
+        return;
+    }
+    next_params = p;
+    build_pos = 0;
+    build_invalid = 0;
+    building = true;
+}
+
+void GaitEngine::build_block() {
+    int16_t lx[IK_BATCH_BLOCK], ly[IK_BATCH_BLOCK], rx[IK_BATCH_BLOCK], ry[IK_BATCH_BLOCK];
+    uint32_t n = GAIT_TABLE_LEN - build_pos;
+    if (n > IK_BATCH_BLOCK) {
+        n = IK_BATCH_BLOCK;
+    }
+    uint32_t offset = (uint32_t)next_params.phase_offset << 16;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t ph = (build_pos + i) << (32 - GAIT_TABLE_BITS);
+        foot_path(&next_params, ph, &lx[i], &ly[i]);
+        foot_path(&next_params, ph + offset, &rx[i], &ry[i]);
+    }
+    gait_targets_t targets = {lx, ly, rx, ry, n};
+    build_invalid += ik_solve_batch(&targets, &tables[active ^ 1][build_pos]);
+    build_pos += n;
+}
+
+void GaitEngine::start_blend(const uint16_t current[4]) {
+    uint32_t next_rate = phase_rate(next_params.period_us);
+    if (!playing) {
+        // Fade in from where the servos are. A servo that was never written
+        // has nothing to fade from, the gait then starts on its own first point.
+        bool known = current[0] != IK_TICKS_INVALID && current[1] != IK_TICKS_INVALID &&
+                     current[2] != IK_TICKS_INVALID && current[3] != IK_TICKS_INVALID;
+        body_ticks_t hold = {current[0], current[1], current[2], current[3]};
+        for (uint32_t i = 0; i < GAIT_TABLE_LEN; i++) {
+            tables[active][i] = known ? hold : tables[active ^ 1][0];
+        }
+        phase = 0;
+        rate = next_rate;
+        playing = true;
+    }
+    rate_from = rate;
+    rate = next_rate;
+    params = next_params;
+    blend_pos = 0;
+    blend_len = next_params.period_us / tick_us;
+    if (blend_len == 0) {
+        blend_len = 1;
+    }
+    stats.blends++;
+}
+
+bool GaitEngine::tick(const uint16_t current[4], body_ticks_t *out) {
+    poll_request();
+    if (building) {
+        build_block();
+        if (build_pos == GAIT_TABLE_LEN) {
+            building = false;
+            if (build_invalid != 0) {
+                stats.rejected++;
+            } else if (playing || !is_stand(&next_params)) {
+                start_blend(current);
+            }
+        }
+    }
+    if (!playing) {
+        return false;
+    }
+
+    uint32_t step = rate;
+    *out = sample(tables[active], phase);
+    if (blend_len != 0) {
+        // Last blend tick lands exactly on the new table
+        blend_pos++;
+        int32_t w = (int32_t)(((uint64_t)blend_pos << 16) / blend_len);
+        *out = lerp_body(*out, sample(tables[active ^ 1], phase), w);
+        step = (uint32_t)(rate_from + (((int64_t)rate - rate_from) * w >> 16));
+        if (blend_pos >= blend_len) {
+            *out = sample(tables[active ^ 1], phase);
+            active ^= 1;
+            blend_len = 0;
+            if (is_stand(&params)) {
+                playing = false;
+            }
+        }
+    }
+
+    uint32_t prev = phase;
+    phase += step;
+    if (phase < prev) {
+        stats.cycles++;
+    }
+    return true;
+}
+
+void GaitEngine::halt() {
+    if (playing || building) {
+        stats.halted++;
+    }
+    playing = false;
+    building = false;
+    blend_len = 0;
+}
+
+bool GaitEngine::running() const {
+    return playing;
+}
+
+void GaitEngine::get_stats(gait_stats_t *out) const {
+    *out = stats;
+}
@@ -0,0 +1,107 @@
+#ifndef GAIT_H
+#define GAIT_H
+
+#include <stdint.h>
+
+#include "ik_batch.h"
+#include "seqlock.h"
+
+#define GAIT_TABLE_BITS         7
+#define GAIT_TABLE_LEN          (1 << GAIT_TABLE_BITS)     // points per cycle, 1 KiB per table
+#define GAIT_PERIOD_MIN_US      200000
+#define GAIT_PERIOD_MAX_US      10000000
+#define GAIT_STANCE_MIN_PCT     50
+#define GAIT_STANCE_MAX_PCT     90
+
+// One walking cycle. A step length and height of 0 is the stand request: the
+// running gait blends into standing still on its stance point and stops.
+typedef struct {
+    uint32_t period_us;         // one full cycle
+    int16_t step_length_q4;     // mm, foot travel along x while on the ground
+    int16_t step_height_q4;     // mm, lift at the top of the swing
+    int16_t center_x_q4;        // mm, middle of the stride
+    int16_t stand_y_q4;         // mm, hip to ground while on the ground
+    uint16_t phase_offset;      // right leg ahead of the left, 65536 is one cycle
+    uint8_t stance_pct;         // share of the cycle on the ground
+} gait_params_t;
+
+// Single writer (the command task), read by the control task
+typedef Seqlock<gait_params_t> GaitMailbox;
+
+typedef struct {
+    uint32_t requests;          // parameter sets picked up
+    uint32_t rejected;          // out of range, or a point of the path out of reach
+    uint32_t blends;            // table changes started
+    uint32_t cycles;            // full cycles played
+    uint32_t halted;            // stopped by halt() mid motion
+} gait_stats_t;
+
+// Plays one cycle of foot paths from a table of compare values. A new
+// parameter set is turned into foot targets and solved with ik_solve_batch()
+// into the spare table, one IK_BATCH_BLOCK per tick so no tick pays for the
+// whole cycle. Playback then crossfades from the old table to the new one
+// over one cycle of the new period, compare values and phase rate alike, so
+// speed, stride and height changes never jump. Starting from rest fades in
+// from the pose the servos hold.
+//
+// Foot path: a straight line backwards along the ground during stance, a
+// cycloid forwards during swing, which lifts and sets the foot down with zero
+// vertical speed. Between table points the compare values are interpolated
+// linearly on the 32 bit phase.
+//
+// Control task only apart from the mailbox. No allocation, 2 KiB of tables.
+class GaitEngine {
+private:
+    const GaitMailbox *requests;
+    uint32_t tick_us;
+    uint32_t seen;                  // mailbox writes already picked up
+
+    body_ticks_t tables[2][GAIT_TABLE_LEN];
+    uint8_t active;                 // table playing, or being faded out of
+    gait_params_t params;           // of the active table, or of the one faded into
+    gait_params_t next_params;      // of the table being built
+    uint32_t build_pos;             // points built into the spare table
+    uint32_t build_invalid;
+    bool building;
+    bool playing;
+
+    uint32_t phase;                 // 2^32 is one cycle, the left leg's phase
+    uint32_t rate;                  // phase per tick
+    uint32_t rate_from;             // while blending
+    uint32_t blend_pos, blend_len;  // ticks, blend_len 0 when not blending
+    gait_stats_t stats;
+
+    static bool is_stand(const gait_params_t *p);
+
+    uint32_t phase_rate(uint32_t period_us) const;
+
+    void poll_request();
+
+    void build_block();
+
+    void start_blend(const uint16_t current[4]);
+
+public:
+    // tick_us: the control period tick() is called at
+    GaitEngine(const GaitMailbox *requests, uint32_t tick_us);
+
+    static bool params_valid(const gait_params_t *p);
+
+    // Foot targets of one point of the cycle, phase as in the table
+    static void foot_path(const gait_params_t *p, uint32_t phase, int16_t *x_q4, int16_t *y_q4);
+
+    // Once per control tick. current: compare values the servos hold, in
+    // body_ticks_t order, used as the starting pose. Returns true with the
+    // ticks to write while a gait is playing, false when at rest.
+    bool tick(const uint16_t current[4], body_ticks_t *out);
+
+    // Stops dead where the last tick left the servos, dropping a blend or a
+    // build in progress. The next request fades in from rest again.
+    void halt();
+
+    bool running() const;
+
+    void get_stats(gait_stats_t *out) const;
+};
+
+#endif // GAIT_H
@@ -0,0 +1,131 @@
+// ESP-IDF backend: MCPWM for the PWM timers, the legacy I2C master driver
+// (the one the mpu6050 component talks through) for I2C.
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "driver/i2c.h"
+#include "driver/mcpwm_prelude.h"
+
+#include "hal_i2c.h"
+#include "hal_pwm.h"
+
+static const char *HAL_TAG = "HAL";
+
+#define PWM_RESOLUTION_HZ   1000000     // 1MHz, 1us per tick
+
+// The TEZ interrupt writes compare values while NVS writes have the flash
+// cache off, so the MCPWM ISR and its comparator calls must live in IRAM
+#if !CONFIG_MCPWM_ISR_IRAM_SAFE || !CONFIG_MCPWM_CTRL_FUNC_IN_IRAM
+#error "Enable CONFIG_MCPWM_ISR_IRAM_SAFE and CONFIG_MCPWM_CTRL_FUNC_IN_IRAM"
+#endif
+
+typedef struct {
+    int index;
+    mcpwm_timer_handle_t timer;
+    mcpwm_oper_handle_t oper[HAL_PWM_CHANNELS];
+    mcpwm_cmpr_handle_t comparator[HAL_PWM_CHANNELS];
+    mcpwm_gen_handle_t generator[HAL_PWM_CHANNELS];
+    hal_pwm_period_cb_t on_period;
+    void *ctx;
+} pwm_timer_t;
+
+static pwm_timer_t pwm[HAL_PWM_TIMERS];
+
+static bool IRAM_ATTR on_empty(mcpwm_timer_handle_t timer, const mcpwm_timer_event_data_t *edata, void *user_ctx) {
+    pwm_timer_t *t = (pwm_timer_t *)user_ctx;
+    return t->on_period(t->index, t->ctx);
+}
+
+int hal_pwm_timer_init(int timer, uint32_t period_us) {
+    if (timer < 0 || timer >= HAL_PWM_TIMERS || pwm[timer].timer != NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pwm[timer].index = timer;
+    mcpwm_timer_config_t config = {};
+    config.group_id = timer;
+    config.clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT;
+    config.resolution_hz = PWM_RESOLUTION_HZ;
+    config.count_mode = MCPWM_TIMER_COUNT_MODE_UP;
+    config.period_ticks = period_us * (PWM_RESOLUTION_HZ / 1000000);
+    return mcpwm_new_timer(&config, &pwm[timer].timer);
+}
+
+int hal_pwm_channel_init(int timer, int channel, int gpio, uint32_t compare_us) {
+    if (timer < 0 || timer >= HAL_PWM_TIMERS || pwm[timer].timer == NULL || channel < 0 ||
+        channel >= HAL_PWM_CHANNELS || pwm[timer].oper[channel] != NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pwm_timer_t *t = &pwm[timer];
+
+    // The operator must be in the same group as the timer
+    mcpwm_operator_config_t oper_config = {};
+    oper_config.group_id = timer;
+    ESP_RETURN_ON_ERROR(mcpwm_new_operator(&oper_config, &t->oper[channel]), HAL_TAG, "operator");
+    ESP_RETURN_ON_ERROR(mcpwm_operator_connect_timer(t->oper[channel], t->timer), HAL_TAG, "connect timer");
+
+    mcpwm_comparator_config_t comparator_config = {};
+    comparator_config.flags.update_cmp_on_tez = true;
+    ESP_RETURN_ON_ERROR(mcpwm_new_comparator(t->oper[channel], &comparator_config, &t->comparator[channel]),
+                        HAL_TAG, "comparator");
+    mcpwm_generator_config_t generator_config = {};
+    generator_config.gen_gpio_num = gpio;
+    ESP_RETURN_ON_ERROR(mcpwm_new_generator(t->oper[channel], &generator_config, &t->generator[channel]),
+                        HAL_TAG, "generator");
+    ESP_RETURN_ON_ERROR(mcpwm_comparator_set_compare_value(t->comparator[channel], compare_us), HAL_TAG,
+                        "compare");
+
+    // High on counter empty, low on the compare threshold
+    ESP_RETURN_ON_ERROR(mcpwm_generator_set_action_on_timer_event(t->generator[channel],
+                            MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_EVENT_EMPTY,
+                                                         MCPWM_GEN_ACTION_HIGH)), HAL_TAG, "timer action");
+    ESP_RETURN_ON_ERROR(mcpwm_generator_set_action_on_compare_event(t->generator[channel],
+                            MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, t->comparator[channel],
+                                                           MCPWM_GEN_ACTION_LOW)), HAL_TAG, "compare action");
+    return ESP_OK;
+}
+
+int hal_pwm_set_period_callback(int timer, hal_pwm_period_cb_t cb, void *ctx) {
+    if (timer < 0 || timer >= HAL_PWM_TIMERS || pwm[timer].timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Event callbacks can only be registered while the timer is disabled
+    pwm[timer].on_period = cb;
+    pwm[timer].ctx = ctx;
+    mcpwm_timer_event_callbacks_t cbs = {};
+    cbs.on_empty = cb != NULL ? on_empty : NULL;
+    return mcpwm_timer_register_event_callbacks(pwm[timer].timer, &cbs, &pwm[timer]);
+}
+
+int hal_pwm_start(int timer) {
+    if (timer < 0 || timer >= HAL_PWM_TIMERS || pwm[timer].timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ESP_RETURN_ON_ERROR(mcpwm_timer_enable(pwm[timer].timer), HAL_TAG, "enable");
+    return mcpwm_timer_start_stop(pwm[timer].timer, MCPWM_TIMER_START_NO_STOP);
+}
+
+void IRAM_ATTR hal_pwm_set_compare(int timer, int channel, uint32_t compare_us) {
+    mcpwm_comparator_set_compare_value(pwm[timer].comparator[channel], compare_us);
+}
+
+int hal_i2c_init(int port, int sda_gpio, int scl_gpio, uint32_t clock_hz) {
+    i2c_config_t bus = {};
+    bus.mode = I2C_MODE_MASTER;
+    bus.sda_io_num = sda_gpio;
+    bus.scl_io_num = scl_gpio;
+    bus.sda_pullup_en = GPIO_PULLUP_ENABLE;
+    bus.scl_pullup_en = GPIO_PULLUP_ENABLE;
+    bus.master.clk_speed = clock_hz;
+    ESP_RETURN_ON_ERROR(i2c_param_config((i2c_port_t)port, &bus), HAL_TAG, "i2c config");
+    return i2c_driver_install((i2c_port_t)port, I2C_MODE_MASTER, 0, 0, 0);
+}
+
+int hal_i2c_read_regs(int port, uint8_t addr, uint8_t reg, uint8_t *buf, size_t len, uint32_t timeout_ms) {
+    return i2c_master_write_read_device((i2c_port_t)port, addr, &reg, 1, buf, len, pdMS_TO_TICKS(timeout_ms));
+}
+
+int hal_i2c_write_reg(int port, uint8_t addr, uint8_t reg, uint8_t value, uint32_t timeout_ms) {
+    uint8_t buf[2] = {reg, value};
+    return i2c_master_write_to_device((i2c_port_t)port, addr, buf, sizeof(buf), pdMS_TO_TICKS(timeout_ms));
+}
@@ -0,0 +1,19 @@
+#ifndef HAL_CLOCK_H
+#define HAL_CLOCK_H
+
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#include "esp_timer.h"
+
+// Microseconds since boot, callable from ISRs
+FORCE_INLINE_ATTR uint64_t hal_clock_us() {
+    return (uint64_t)esp_timer_get_time();
+}
+#else
+// CLOCK_MONOTONIC, or the simulated time set with hal_sim_clock_set()
+uint64_t hal_clock_us();
+#endif
+
+#endif // HAL_CLOCK_H
@@ -0,0 +1,21 @@
+#ifndef HAL_I2C_H
+#define HAL_I2C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HAL_I2C_PORTS           2
+
+// I2C master with 8 bit register addressing. Every call returns 0 or an
+// error (esp_err_t on the ESP32, -1 on Linux); a missing device or a
+// timeout is an error, never a short read.
+
+// Pull-ups on both lines enabled
+int hal_i2c_init(int port, int sda_gpio, int scl_gpio, uint32_t clock_hz);
+
+// len bytes from reg onwards in one transaction, the device auto-increments
+int hal_i2c_read_regs(int port, uint8_t addr, uint8_t reg, uint8_t *buf, size_t len, uint32_t timeout_ms);
+
+int hal_i2c_write_reg(int port, uint8_t addr, uint8_t reg, uint8_t value, uint32_t timeout_ms);
+
+#endif // HAL_I2C_H
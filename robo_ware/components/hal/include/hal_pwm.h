@@ -0,0 +1,33 @@
+#ifndef HAL_PWM_H
+#define HAL_PWM_H
+
+#include <stdint.h>
+
+#define HAL_PWM_TIMERS          2       // one per MCPWM group
+#define HAL_PWM_CHANNELS        3       // operators of a group
+
+// Runs on every period start (TEZ) of timer, in ISR context on the ESP32.
+// Returns true if it woke a task of higher priority.
+typedef bool (*hal_pwm_period_cb_t)(int timer, void *ctx);
+
+// Servo style PWM with a 1us time base: every channel of a timer goes high
+// at the period start and low at its compare value. Compare values are
+// shadowed, whatever was set last before a period start is what that period
+// outputs, so all channels written in one period change together.
+//
+// Setup calls return 0 or an error (esp_err_t on the ESP32, -1 on Linux).
+
+int hal_pwm_timer_init(int timer, uint32_t period_us);
+
+// Connects gpio to the timer with compare_us as its first pulse width
+int hal_pwm_channel_init(int timer, int channel, int gpio, uint32_t compare_us);
+
+// Before hal_pwm_start()
+int hal_pwm_set_period_callback(int timer, hal_pwm_period_cb_t cb, void *ctx);
+
+int hal_pwm_start(int timer);
+
+// Any context, the period callback included
+void hal_pwm_set_compare(int timer, int channel, uint32_t compare_us);
+
+#endif // HAL_PWM_H
@@ -0,0 +1,33 @@
+#ifndef HAL_SOCKET_H
+#define HAL_SOCKET_H
+
+// BSD sockets and eventfd: lwIP and the eventfd VFS on the ESP32, the libc
+// ones on Linux. Everything past hal_eventfd() is the plain socket API.
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_vfs_eventfd.h"
+#include "lwip/sockets.h"
+
+// A counting eventfd, the VFS driver is registered on first use
+static inline int hal_eventfd() {
+    // Fails harmlessly with ESP_ERR_INVALID_STATE if already registered
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_vfs_eventfd_register(&config);
+    return eventfd(0, 0);
+}
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+
+static inline int hal_eventfd() {
+    return eventfd(0, 0);
+}
+#endif
+
+#endif // HAL_SOCKET_H
@@ -0,0 +1,107 @@
+#ifndef HAL_SYNC_H
+#define HAL_SYNC_H
+
+#include <stdint.h>
+
+#define HAL_WAIT_FOREVER    UINT32_MAX
+
+// hal_lock_t: a short critical section shared between tasks and interrupts,
+// the spinlock of a FreeRTOS critical section on the ESP32. The _isr variants
+// are for interrupt context, on Linux both are the same mutex.
+//
+// hal_flag_t: one level triggered flag any task can block on until it is set.
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_attr.h"
+
+#define HAL_FLAG_BIT    BIT0
+
+typedef portMUX_TYPE hal_lock_t;
+
+typedef struct {
+    StaticEventGroup_t buffer;
+    EventGroupHandle_t group;
+} hal_flag_t;
+
+FORCE_INLINE_ATTR void hal_lock_init(hal_lock_t *lock) {
+    portMUX_INITIALIZE(lock);
+}
+
+FORCE_INLINE_ATTR void hal_lock(hal_lock_t *lock) {
+    portENTER_CRITICAL(lock);
+}
+
+FORCE_INLINE_ATTR void hal_unlock(hal_lock_t *lock) {
+    portEXIT_CRITICAL(lock);
+}
+
+FORCE_INLINE_ATTR void hal_lock_isr(hal_lock_t *lock) {
+    portENTER_CRITICAL_ISR(lock);
+}
+
+FORCE_INLINE_ATTR void hal_unlock_isr(hal_lock_t *lock) {
+    portEXIT_CRITICAL_ISR(lock);
+}
+
+static inline void hal_flag_init(hal_flag_t *flag, bool set) {
+    flag->group = xEventGroupCreateStatic(&flag->buffer);
+    if (set) {
+        xEventGroupSetBits(flag->group, HAL_FLAG_BIT);
+    }
+}
+
+static inline void hal_flag_set(hal_flag_t *flag) {
+    xEventGroupSetBits(flag->group, HAL_FLAG_BIT);
+}
+
+static inline void hal_flag_clear(hal_flag_t *flag) {
+    xEventGroupClearBits(flag->group, HAL_FLAG_BIT);
+}
+
+static inline bool hal_flag_is_set(hal_flag_t *flag) {
+    return (xEventGroupGetBits(flag->group) & HAL_FLAG_BIT) != 0;
+}
+
+// True once the flag is set, false after timeout_ms
+static inline bool hal_flag_wait(hal_flag_t *flag, uint32_t timeout_ms) {
+    TickType_t ticks = timeout_ms == HAL_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return (xEventGroupWaitBits(flag->group, HAL_FLAG_BIT, pdFALSE, pdTRUE, ticks) & HAL_FLAG_BIT) != 0;
+}
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t hal_lock_t;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool set;
+} hal_flag_t;
+
+void hal_lock_init(hal_lock_t *lock);
+
+void hal_lock(hal_lock_t *lock);
+
+void hal_unlock(hal_lock_t *lock);
+
+static inline void hal_lock_isr(hal_lock_t *lock) {
+    hal_lock(lock);
+}
+
+static inline void hal_unlock_isr(hal_lock_t *lock) {
+    hal_unlock(lock);
+}
+
+void hal_flag_init(hal_flag_t *flag, bool set);
+
+void hal_flag_set(hal_flag_t *flag);
+
+void hal_flag_clear(hal_flag_t *flag);
+
+bool hal_flag_is_set(hal_flag_t *flag);
+
+bool hal_flag_wait(hal_flag_t *flag, uint32_t timeout_ms);
+#endif
+
+#endif // HAL_SYNC_H
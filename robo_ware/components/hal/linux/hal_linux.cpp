@@ -0,0 +1,474 @@
+// Linux backend: simulated PWM timers that log every compare write, an I2C
+// bus of register files and recorded replays, the monotonic clock and
+// pthread locks. See hal_sim.h for the controls.
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_clock.h"
+#include "hal_i2c.h"
+#include "hal_pwm.h"
+#include "hal_sim.h"
+#include "hal_sync.h"
+
+static_assert((HAL_SIM_PWM_LOG & (HAL_SIM_PWM_LOG - 1)) == 0, "HAL_SIM_PWM_LOG must be a power of two");
+
+// Everything simulated lives in one of these per thread
+typedef struct {
+    bool init;
+    uint32_t period_us;
+    bool channel_init[HAL_PWM_CHANNELS];
+    std::atomic<uint32_t> shadow[HAL_PWM_CHANNELS];
+    std::atomic<uint32_t> output[HAL_PWM_CHANNELS];
+    std::atomic<uint32_t> periods;
+    hal_pwm_period_cb_t on_period;
+    void *ctx;
+    std::thread runner;
+} sim_timer_t;
+
+typedef struct {
+    uint8_t reg;
+    size_t frame_len;
+    std::vector<uint8_t> frames;
+    size_t next;        // byte offset of the next frame
+} sim_replay_t;
+
+typedef struct {
+    bool present;
+    uint8_t addr;
+    uint8_t regs[256];
+    std::vector<sim_replay_t> replays;
+} sim_device_t;
+
+typedef struct {
+    bool init;
+    sim_device_t devices[HAL_SIM_I2C_DEVICES];
+} sim_bus_t;
+
+struct sim_hw_t {
+    std::atomic<bool> clock_frozen;
+    std::atomic<uint64_t> clock_now;
+
+    sim_timer_t pwm[HAL_PWM_TIMERS];
+    hal_pwm_write_t pwm_log[HAL_SIM_PWM_LOG];
+    std::atomic<uint32_t> pwm_log_head;
+    std::atomic<bool> free_run;
+    std::atomic<bool> stopping;
+
+    std::mutex i2c_mutex;
+    sim_bus_t buses[HAL_I2C_PORTS];
+    hal_i2c_write_t i2c_log[HAL_SIM_I2C_LOG];
+    size_t i2c_log_count;
+
+    sim_hw_t() : clock_frozen(false), clock_now(0), pwm(), pwm_log(), pwm_log_head(0), free_run(false),
+                 stopping(false), buses(), i2c_log(), i2c_log_count(0) {}
+};
+
+// Free running timer threads borrow the hardware of the thread that started them
+static thread_local std::unique_ptr<sim_hw_t> owned_hw;
+static thread_local sim_hw_t *current_hw;
+
+static sim_hw_t *hw() {
+    if (current_hw == NULL) {
+        owned_hw.reset(new sim_hw_t());
+        current_hw = owned_hw.get();
+    }
+    return current_hw;
+}
+
+// Clock
+
+static uint64_t real_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+uint64_t hal_clock_us() {
+    sim_hw_t *h = hw();
+    return h->clock_frozen.load(std::memory_order_acquire) ? h->clock_now.load(std::memory_order_relaxed) : real_us();
+}
+
+void hal_sim_clock_set(uint64_t us) {
+    sim_hw_t *h = hw();
+    h->clock_now.store(us, std::memory_order_relaxed);
+    h->clock_frozen.store(true, std::memory_order_release);
+}
+
+void hal_sim_clock_advance(uint64_t us) {
+    hal_sim_clock_set(hal_clock_us() + us);
+}
+
+void hal_sim_clock_real() {
+    hw()->clock_frozen.store(false, std::memory_order_release);
+}
+
+// Locks
+
+void hal_lock_init(hal_lock_t *lock) {
+    pthread_mutex_init(lock, NULL);
+}
+
+void hal_lock(hal_lock_t *lock) {
+    pthread_mutex_lock(lock);
+}
+
+void hal_unlock(hal_lock_t *lock) {
+    pthread_mutex_unlock(lock);
+}
+
+void hal_flag_init(hal_flag_t *flag, bool set) {
+    pthread_mutex_init(&flag->mutex, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&flag->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    flag->set = set;
+}
+
+void hal_flag_set(hal_flag_t *flag) {
+    pthread_mutex_lock(&flag->mutex);
+    flag->set = true;
+    pthread_cond_broadcast(&flag->cond);
+    pthread_mutex_unlock(&flag->mutex);
+}
+
+void hal_flag_clear(hal_flag_t *flag) {
+    pthread_mutex_lock(&flag->mutex);
+    flag->set = false;
+    pthread_mutex_unlock(&flag->mutex);
+}
+
+bool hal_flag_is_set(hal_flag_t *flag) {
+    pthread_mutex_lock(&flag->mutex);
+    bool set = flag->set;
+    pthread_mutex_unlock(&flag->mutex);
+    return set;
+}
+
+bool hal_flag_wait(hal_flag_t *flag, uint32_t timeout_ms) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    pthread_mutex_lock(&flag->mutex);
+    while (!flag->set) {
+        int ret = timeout_ms == HAL_WAIT_FOREVER ? pthread_cond_wait(&flag->cond, &flag->mutex)
+                                                 : pthread_cond_timedwait(&flag->cond, &flag->mutex, &deadline);
+        if (ret == ETIMEDOUT) {
+            break;
+        }
+    }
+    bool set = flag->set;
+    pthread_mutex_unlock(&flag->mutex);
+    return set;
+}
+
+// PWM
+
+static bool pwm_valid(int timer) {
+    return timer >= 0 && timer < HAL_PWM_TIMERS && hw()->pwm[timer].init;
+}
+
+int hal_pwm_timer_init(int timer, uint32_t period_us) {
+    if (timer < 0 || timer >= HAL_PWM_TIMERS || hw()->pwm[timer].init || period_us == 0) {
+        return -1;
+    }
+    hw()->pwm[timer].init = true;
+    hw()->pwm[timer].period_us = period_us;
+    return 0;
+}
+
+int hal_pwm_channel_init(int timer, int channel, int gpio, uint32_t compare_us) {
+    if (!pwm_valid(timer) || channel < 0 || channel >= HAL_PWM_CHANNELS || hw()->pwm[timer].channel_init[channel] ||
+        gpio < 0) {
+        return -1;
+    }
+    sim_timer_t *t = &hw()->pwm[timer];
+    t->channel_init[channel] = true;
+    // The first period already outputs it, the timer isn't running yet
+    t->shadow[channel].store(compare_us, std::memory_order_relaxed);
+    t->output[channel].store(compare_us, std::memory_order_relaxed);
+    return 0;
+}
+
+int hal_pwm_set_period_callback(int timer, hal_pwm_period_cb_t cb, void *ctx) {
+    if (!pwm_valid(timer) || hw()->pwm[timer].runner.joinable()) {
+        return -1;
+    }
+    hw()->pwm[timer].on_period = cb;
+    hw()->pwm[timer].ctx = ctx;
+    return 0;
+}
+
+static void run_timer(sim_hw_t *h, int timer) {
+    current_hw = h;
+    uint64_t next = real_us() + h->pwm[timer].period_us;
+    while (!h->stopping.load(std::memory_order_relaxed)) {
+        uint64_t now = real_us();
+        if (now < next) {
+            struct timespec ts = {(time_t)((next - now) / 1000000), (long)((next - now) % 1000000) * 1000};
+            nanosleep(&ts, NULL);
+            continue;
+        }
+        hal_sim_pwm_period(timer);
+        next += h->pwm[timer].period_us;
+    }
+}
+
+int hal_pwm_start(int timer) {
+    if (!pwm_valid(timer)) {
+        return -1;
+    }
+    sim_hw_t *h = hw();
+    if (h->free_run.load(std::memory_order_relaxed) && !h->pwm[timer].runner.joinable()) {
+        h->pwm[timer].runner = std::thread(run_timer, h, timer);
+    }
+    return 0;
+}
+
+void hal_pwm_set_compare(int timer, int channel, uint32_t compare_us) {
+    sim_hw_t *h = hw();
+    h->pwm[timer].shadow[channel].store(compare_us, std::memory_order_relaxed);
+    hal_pwm_write_t *w = &h->pwm_log[h->pwm_log_head.fetch_add(1, std::memory_order_relaxed) & (HAL_SIM_PWM_LOG - 1)];
+    w->time_us = hal_clock_us();
+    w->timer = (uint8_t)timer;
+    w->channel = (uint8_t)channel;
+    w->compare_us = compare_us;
+}
+
+bool hal_sim_pwm_period(int timer) {
+    sim_timer_t *t = &hw()->pwm[timer];
+    for (int c = 0; c < HAL_PWM_CHANNELS; c++) {
+        t->output[c].store(t->shadow[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    t->periods.fetch_add(1, std::memory_order_relaxed);
+    return t->on_period != NULL ? t->on_period(timer, t->ctx) : false;
+}
+
+void hal_sim_pwm_free_run(bool on) {
+    hw()->free_run.store(on, std::memory_order_relaxed);
+}
+
+uint32_t hal_sim_pwm_output(int timer, int channel) {
+    return hw()->pwm[timer].output[channel].load(std::memory_order_relaxed);
+}
+
+uint32_t hal_sim_pwm_shadow(int timer, int channel) {
+    return hw()->pwm[timer].shadow[channel].load(std::memory_order_relaxed);
+}
+
+uint32_t hal_sim_pwm_periods(int timer) {
+    return hw()->pwm[timer].periods.load(std::memory_order_relaxed);
+}
+
+size_t hal_sim_pwm_write_count() {
+    return hw()->pwm_log_head.load(std::memory_order_relaxed);
+}
+
+size_t hal_sim_pwm_writes(hal_pwm_write_t *out, size_t max) {
+    sim_hw_t *h = hw();
+    uint32_t head = h->pwm_log_head.load(std::memory_order_acquire);
+    size_t kept = head < HAL_SIM_PWM_LOG ? head : HAL_SIM_PWM_LOG;
+    size_t count = kept < max ? kept : max;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = h->pwm_log[(head - count + i) & (HAL_SIM_PWM_LOG - 1)];
+    }
+    return count;
+}
+
+// I2C
+
+// With i2c_mutex held. NULL if the device isn't there and create is false or the bus is full.
+static sim_device_t *find_device(sim_hw_t *h, int port, uint8_t addr, bool create) {
+    if (port < 0 || port >= HAL_I2C_PORTS) {
+        return NULL;
+    }
+    sim_device_t *free_slot = NULL;
+    for (int i = 0; i < HAL_SIM_I2C_DEVICES; i++) {
+        sim_device_t *d = &h->buses[port].devices[i];
+        if (d->present && d->addr == addr) {
+            return d;
+        }
+        if (!d->present && free_slot == NULL) {
+            free_slot = d;
+        }
+    }
+    if (!create || free_slot == NULL) {
+        return NULL;
+    }
+    free_slot->present = true;
+    free_slot->addr = addr;
+    memset(free_slot->regs, 0, sizeof(free_slot->regs));
+    free_slot->replays.clear();
+    return free_slot;
+}
+
+int hal_i2c_init(int port, int sda_gpio, int scl_gpio, uint32_t clock_hz) {
+    if (port < 0 || port >= HAL_I2C_PORTS || sda_gpio < 0 || scl_gpio < 0 || clock_hz == 0) {
+        return -1;
+    }
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    if (h->buses[port].init) {
+        return -1;
+    }
+    h->buses[port].init = true;
+    return 0;
+}
+
+int hal_i2c_read_regs(int port, uint8_t addr, uint8_t reg, uint8_t *buf, size_t len, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    sim_device_t *d = find_device(h, port, addr, false);
+    if (d == NULL || !h->buses[port].init) {
+        return -1;
+    }
+    for (size_t i = 0; i < d->replays.size(); i++) {
+        sim_replay_t *r = &d->replays[i];
+        if (r->reg == reg && r->frame_len == len) {
+            if (r->next >= r->frames.size()) {
+                return -1;
+            }
+            memcpy(buf, &r->frames[r->next], len);
+            r->next += len;
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = d->regs[(uint8_t)(reg + i)];
+    }
+    return 0;
+}
+
+int hal_i2c_write_reg(int port, uint8_t addr, uint8_t reg, uint8_t value, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    sim_device_t *d = find_device(h, port, addr, false);
+    if (d == NULL || !h->buses[port].init) {
+        return -1;
+    }
+    d->regs[reg] = value;
+    hal_i2c_write_t *w = &h->i2c_log[h->i2c_log_count++ % HAL_SIM_I2C_LOG];
+    w->port = (uint8_t)port;
+    w->addr = addr;
+    w->reg = reg;
+    w->value = value;
+    return 0;
+}
+
+void hal_sim_i2c_set_reg(int port, uint8_t addr, uint8_t reg, uint8_t value) {
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    sim_device_t *d = find_device(h, port, addr, true);
+    if (d != NULL) {
+        d->regs[reg] = value;
+    }
+}
+
+int hal_sim_i2c_replay(int port, uint8_t addr, uint8_t reg, const uint8_t *frames, size_t frame_len, size_t count) {
+    if (frame_len == 0) {
+        return -1;
+    }
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    sim_device_t *d = find_device(h, port, addr, true);
+    if (d == NULL) {
+        return -1;
+    }
+    sim_replay_t r;
+    r.reg = reg;
+    r.frame_len = frame_len;
+    r.frames.assign(frames, frames + frame_len * count);
+    r.next = 0;
+    // A new replay of the same read replaces the old one
+    for (size_t i = 0; i < d->replays.size(); i++) {
+        if (d->replays[i].reg == reg && d->replays[i].frame_len == frame_len) {
+            d->replays[i] = r;
+            return 0;
+        }
+    }
+    d->replays.push_back(r);
+    return 0;
+}
+
+size_t hal_sim_i2c_replay_left(int port, uint8_t addr, uint8_t reg) {
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    sim_device_t *d = find_device(h, port, addr, false);
+    size_t left = 0;
+    for (size_t i = 0; d != NULL && i < d->replays.size(); i++) {
+        const sim_replay_t *r = &d->replays[i];
+        if (r->reg == reg) {
+            left += (r->frames.size() - r->next) / r->frame_len;
+        }
+    }
+    return left;
+}
+
+size_t hal_sim_i2c_write_count() {
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    return h->i2c_log_count;
+}
+
+size_t hal_sim_i2c_writes(hal_i2c_write_t *out, size_t max) {
+    sim_hw_t *h = hw();
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    size_t kept = h->i2c_log_count < HAL_SIM_I2C_LOG ? h->i2c_log_count : HAL_SIM_I2C_LOG;
+    size_t count = kept < max ? kept : max;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = h->i2c_log[(h->i2c_log_count - count + i) % HAL_SIM_I2C_LOG];
+    }
+    return count;
+}
+
+void hal_sim_reset() {
+    sim_hw_t *h = hw();
+    h->stopping.store(true, std::memory_order_relaxed);
+    for (int t = 0; t < HAL_PWM_TIMERS; t++) {
+        if (h->pwm[t].runner.joinable()) {
+            h->pwm[t].runner.join();
+        }
+    }
+    h->stopping.store(false, std::memory_order_relaxed);
+    h->free_run.store(false, std::memory_order_relaxed);
+    for (int t = 0; t < HAL_PWM_TIMERS; t++) {
+        sim_timer_t *p = &h->pwm[t];
+        p->init = false;
+        p->period_us = 0;
+        for (int c = 0; c < HAL_PWM_CHANNELS; c++) {
+            p->channel_init[c] = false;
+            p->shadow[c].store(0, std::memory_order_relaxed);
+            p->output[c].store(0, std::memory_order_relaxed);
+        }
+        p->periods.store(0, std::memory_order_relaxed);
+        p->on_period = NULL;
+        p->ctx = NULL;
+    }
+    h->pwm_log_head.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> guard(h->i2c_mutex);
+    for (int port = 0; port < HAL_I2C_PORTS; port++) {
+        h->buses[port].init = false;
+        for (int i = 0; i < HAL_SIM_I2C_DEVICES; i++) {
+            h->buses[port].devices[i].present = false;
+            h->buses[port].devices[i].replays.clear();
+        }
+    }
+    h->i2c_log_count = 0;
+    h->clock_frozen.store(false, std::memory_order_release);
+}
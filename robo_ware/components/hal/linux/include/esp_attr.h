@@ -0,0 +1,9 @@
+#ifndef HAL_COMPAT_ESP_ATTR_H
+#define HAL_COMPAT_ESP_ATTR_H
+
+// Placement attributes mean nothing on the host
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define FORCE_INLINE_ATTR static inline __attribute__((always_inline))
+
+#endif // HAL_COMPAT_ESP_ATTR_H
@@ -0,0 +1,36 @@
+#ifndef HAL_COMPAT_ESP_LOG_H
+#define HAL_COMPAT_ESP_LOG_H
+
+// Host stand-in for esp_log.h, everything to stderr. The level is global,
+// esp_log_level_set() ignores the tag.
+#include <stdio.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+inline esp_log_level_t esp_log_host_level = ESP_LOG_INFO;
+
+static inline void esp_log_level_set(const char *tag, esp_log_level_t level) {
+    (void)tag;
+    esp_log_host_level = level;
+}
+
+#define ESP_LOG_HOST(level, letter, tag, fmt, ...) do { \
+    if (esp_log_host_level >= level) { \
+        fprintf(stderr, letter " %s: " fmt "\n", tag, ##__VA_ARGS__); \
+    } \
+} while (0)
+
+#define ESP_LOGE(tag, fmt, ...) ESP_LOG_HOST(ESP_LOG_ERROR, "E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) ESP_LOG_HOST(ESP_LOG_WARN, "W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) ESP_LOG_HOST(ESP_LOG_INFO, "I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) ESP_LOG_HOST(ESP_LOG_DEBUG, "D", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) ESP_LOG_HOST(ESP_LOG_VERBOSE, "V", tag, fmt, ##__VA_ARGS__)
+
+#endif // HAL_COMPAT_ESP_LOG_H
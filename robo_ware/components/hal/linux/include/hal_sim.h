@@ -0,0 +1,82 @@
+#ifndef HAL_SIM_H
+#define HAL_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Controls of the Linux backend, for host harnesses and benchmarks.
+//
+// Every thread gets its own simulated hardware, clock included, so
+// simulations can run side by side in one process. A free running timer's
+// thread works on the hardware of the thread that started it.
+//
+// PWM: timers don't run by themselves unless hal_sim_pwm_free_run() was
+// called before hal_pwm_start(); otherwise hal_sim_pwm_period() is the TEZ.
+// Every hal_pwm_set_compare() is logged with the time it happened.
+//
+// I2C: a device exists once a register of it is set or a replay loaded.
+// Reads start in its 256 byte register file, a register with a replay
+// returns the next recorded frame instead and fails once they ran out.
+
+#define HAL_SIM_PWM_LOG         4096    // compare writes kept, a power of two
+#define HAL_SIM_I2C_LOG         256     // register writes kept
+#define HAL_SIM_I2C_DEVICES     4       // per port
+
+typedef struct {
+    uint64_t time_us;
+    uint8_t timer;
+    uint8_t channel;
+    uint32_t compare_us;
+} hal_pwm_write_t;
+
+typedef struct {
+    uint8_t port;
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t value;
+} hal_i2c_write_t;
+
+// Stops free running timers and forgets every timer, device and log
+void hal_sim_reset();
+
+// Freezes hal_clock_us() at us until the next set, advance or real call
+void hal_sim_clock_set(uint64_t us);
+
+void hal_sim_clock_advance(uint64_t us);
+
+void hal_sim_clock_real();
+
+// Latches the shadow compare values of timer, then runs its period
+// callback. Returns what the callback returned.
+bool hal_sim_pwm_period(int timer);
+
+// Timers started from now on get a thread that calls hal_sim_pwm_period()
+// every period on the real clock
+void hal_sim_pwm_free_run(bool on);
+
+// Compare value the channel outputs this period, and the one it will latch
+uint32_t hal_sim_pwm_output(int timer, int channel);
+
+uint32_t hal_sim_pwm_shadow(int timer, int channel);
+
+uint32_t hal_sim_pwm_periods(int timer);
+
+// Number of compare writes since reset, the newest HAL_SIM_PWM_LOG are kept
+size_t hal_sim_pwm_write_count();
+
+// Copies the newest writes, at most max and oldest first. Not while writing.
+size_t hal_sim_pwm_writes(hal_pwm_write_t *out, size_t max);
+
+void hal_sim_i2c_set_reg(int port, uint8_t addr, uint8_t reg, uint8_t value);
+
+// count frames of frame_len bytes, one per read of reg with len frame_len
+int hal_sim_i2c_replay(int port, uint8_t addr, uint8_t reg, const uint8_t *frames, size_t frame_len, size_t count);
+
+// Frames of the replay on reg not read yet
+size_t hal_sim_i2c_replay_left(int port, uint8_t addr, uint8_t reg);
+
+size_t hal_sim_i2c_write_count();
+
+size_t hal_sim_i2c_writes(hal_i2c_write_t *out, size_t max);
+
+#endif // HAL_SIM_H
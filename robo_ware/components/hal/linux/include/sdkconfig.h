@@ -0,0 +1,9 @@
+#ifndef HAL_COMPAT_SDKCONFIG_H
+#define HAL_COMPAT_SDKCONFIG_H
+
+// Kconfig defaults of the options the host builds of firmware sources read
+#define CONFIG_BIPED_SERVO_SPEED_DPS    600
+#define CONFIG_BIPED_SERVO_ACCEL_DPS2   10000
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 160
+
+#endif // HAL_COMPAT_SDKCONFIG_H
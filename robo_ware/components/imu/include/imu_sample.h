@@ -0,0 +1,30 @@
+#ifndef IMU_SAMPLE_H
+#define IMU_SAMPLE_H
+
+#include <stdint.h>
+#include "spsc_ring.h"
+
+#define IMU_RING_SIZE       64
+#define IMU_BURST_LEN       14      // ACCEL_XOUT_H..GYRO_ZOUT_L
+
+// One raw MPU6050 reading, sensor counts as read from ACCEL_XOUT_H onwards
+typedef struct {
+    uint32_t timestamp_us;
+    int16_t accel[3];
+    int16_t gyro[3];
+    int16_t temp;
+} imu_sample_t;
+
+// One burst read from ACCEL_XOUT_H: accel, temperature, gyro, big endian
+static inline void imu_unpack_burst(const uint8_t raw[IMU_BURST_LEN], imu_sample_t *s) {
+    for (int i = 0; i < 3; i++) {
+        s->accel[i] = (int16_t)((raw[2 * i] << 8) | raw[2 * i + 1]);
+        s->gyro[i] = (int16_t)((raw[8 + 2 * i] << 8) | raw[8 + 2 * i + 1]);
+    }
+    s->temp = (int16_t)((raw[6] << 8) | raw[7]);
+}
+
+// IMU reader -> its one consumer
+typedef SpscRing<imu_sample_t, IMU_RING_SIZE> ImuRing;
+
+#endif // IMU_SAMPLE_H
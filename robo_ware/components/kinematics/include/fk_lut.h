@@ -0,0 +1,50 @@
+#ifndef FK_LUT_H
+#define FK_LUT_H
+
+#include <stdint.h>
+#include "fk_table.h"
+
+#define FK_GRID_ONE             (1 << FK_TABLE_STEP_SHIFT)
+
+// Integer only forward kinematics, the inverse of ik_lookup_ticks(). Left leg
+// compare ticks to the foot position in Q4 mm, bilinear between table cells.
+// Returns -1 off the table or next to a pose the upper links can't close.
+static inline int fk_lookup_q4(uint16_t front_ticks, uint16_t rear_ticks, int32_t *x_q4, int32_t *y_q4)
+{
+    int32_t gf = (int32_t)front_ticks - FK_TABLE_FRONT_MIN;
+    int32_t gr = (int32_t)rear_ticks - FK_TABLE_REAR_MIN;
+    if (gf < 0 || gr < 0) {
+        return -1;
+    }
+    int32_t col = gf >> FK_TABLE_STEP_SHIFT;
+    int32_t row = gr >> FK_TABLE_STEP_SHIFT;
+    int32_t ff = gf & (FK_GRID_ONE - 1);
+    int32_t fr = gr & (FK_GRID_ONE - 1);
+    int32_t next_col = ff != 0;
+    int32_t next_row = fr != 0;
+    if (col + next_col >= FK_TABLE_COLS || row + next_row >= FK_TABLE_ROWS) {
+        return -1;
+    }
+
+    const fk_cell_t *c00 = &fk_table[row * FK_TABLE_COLS + col];
+    const fk_cell_t *c01 = c00 + next_col;
+    const fk_cell_t *c10 = c00 + next_row * FK_TABLE_COLS;
+    const fk_cell_t *c11 = c10 + next_col;
+    if (c00->x_q4 == FK_TABLE_INVALID || c01->x_q4 == FK_TABLE_INVALID ||
+        c10->x_q4 == FK_TABLE_INVALID || c11->x_q4 == FK_TABLE_INVALID) {
+        return -1;
+    }
+
+    const int32_t shift = 2 * FK_TABLE_STEP_SHIFT;
+    const int32_t round = 1 << (shift - 1);
+    int32_t top = c00->x_q4 * (FK_GRID_ONE - ff) + c01->x_q4 * ff;
+    int32_t bot = c10->x_q4 * (FK_GRID_ONE - ff) + c11->x_q4 * ff;
+    *x_q4 = (top * (FK_GRID_ONE - fr) + bot * fr + round) >> shift;
+
+    top = c00->y_q4 * (FK_GRID_ONE - ff) + c01->y_q4 * ff;
+    bot = c10->y_q4 * (FK_GRID_ONE - ff) + c11->y_q4 * ff;
+    *y_q4 = (top * (FK_GRID_ONE - fr) + bot * fr + round) >> shift;
+    return 0;
+}
+
+#endif // FK_LUT_H
@@ -0,0 +1,165 @@
+// Generated by tools/gen_ik_table.py, do not edit by hand.
+#ifndef FK_TABLE_H
+#define FK_TABLE_H
+
+#include <stdint.h>
+#include "kinematics.h"
+
+static_assert(UPPER_LEG_LEN == 40 && LOWER_LEG_LEN == 24 && REAR_OFFSET == 21 &&
+              SERVO_HORN_OFFSET == 135, "fk_table.h is stale, rerun tools/gen_ik_table.py");
+
+#define FK_TABLE_FRONT_MIN      500
+#define FK_TABLE_REAR_MIN       500
+#define FK_TABLE_STEP_SHIFT     6
+#define FK_TABLE_COLS           33     // front ticks
+#define FK_TABLE_ROWS           33     // rear ticks
+#define FK_TABLE_INVALID        (-32768)
+
+// Foot position (Q4 mm) per grid point of left leg compare ticks, 904 of 1089 cells are poses the IK
+// solves back to, the rest FK_TABLE_INVALID
+typedef struct {
+    int16_t x_q4;
+    int16_t y_q4;
+} fk_cell_t;
+
+static const fk_cell_t fk_table[FK_TABLE_ROWS * FK_TABLE_COLS] = {
+    {911,292},{883,306},{852,320},{819,333},{783,344},{747,353},{709,360},{671,365},
+    {633,368},{594,368},{556,366},{519,362},{483,356},{449,348},{416,339},{385,328},
+    {356,317},{329,305},{305,293},{283,280},{264,268},{246,257},{231,246},{218,236},
+    {206,227},{197,219},{189,212},{182,206},{177,202},{173,198},{170,195},{168,194},
+    {-32768,-32768},{908,335},{881,347},{851,359},{818,370},{783,379},{747,387},{709,393},
+    {671,396},{633,397},{594,396},{556,392},{519,387},{482,379},{448,370},{415,359},
+    {383,346},{354,333},{328,319},{303,305},{281,291},{261,278},{244,265},{229,253},
+    {216,242},{204,232},{195,223},{187,215},{180,209},{175,204},{171,200},{169,197},
+    {167,195},{166,195},{902,379},{876,389},{847,399},{815,408},{781,416},{745,422},
+    {708,426},{670,428},{631,428},{593,425},{555,420},{517,413},{481,404},{446,393},
+    {413,380},{381,366},{352,351},{325,336},{301,320},{278,305},{259,290},{241,275},
+    {226,262},{213,249},{201,238},{192,229},{184,220},{178,213},{173,207},{169,203},
+    {166,200},{164,198},{164,197},{893,423},{869,432},{841,440},{810,447},{776,453},
+    {741,458},{704,461},{666,461},{628,460},{590,456},{552,449},{514,441},{478,430},
+    {443,418},{410,403},{378,388},{349,371},{322,354},{297,337},{275,320},{255,303},
+    {237,287},{222,273},{209,259},{198,247},{188,236},{180,226},{174,219},{169,212},
+    {165,207},{162,203},{161,201},{160,200},{881,468},{858,475},{831,481},{801,487},
+    {769,492},{735,495},{698,496},{661,496},{623,493},{585,487},{548,480},{510,470},
+    {474,458},{439,444},{406,429},{374,412},{345,394},{317,375},{292,356},{270,338},
+    {250,319},{233,302},{217,285},{204,270},{193,257},{183,245},{176,234},{169,226},
+    {164,218},{160,213},{158,208},{156,206},{155,204},{864,513},{844,518},{819,523},
+    {791,527},{759,531},{726,533},{691,533},{654,531},{617,527},{579,520},{541,512},
+    {504,501},{468,488},{433,472},{400,456},{368,437},{339,418},{312,398},{287,377},
+    {264,357},{244,337},{227,318},{211,300},{198,284},{187,269},{177,256},{170,244},
+    {163,234},{158,226},{154,220},{152,215},{150,211},{148,209},{844,557},{826,560},
+    {804,564},{777,567},{747,570},{715,570},{680,570},{644,567},{608,562},{570,554},
+    {533,544},{497,532},{461,518},{426,502},{393,484},{361,465},{332,444},{304,423},
+    {280,401},{257,379},{237,357},{219,337},{204,317},{191,299},{179,283},{170,268},
+    {162,255},{156,244},{151,235},{147,228},{144,222},{142,218},{141,216},{820,601},
+    {805,603},{785,605},{760,607},{732,609},{701,608},{667,607},{632,603},{596,597},
+    {560,589},{523,578},{487,565},{451,550},{417,533},{384,514},{352,493},{323,472},
+    {296,449},{271,426},{248,402},{228,380},{210,357},{195,336},{182,317},{171,299},
+    {161,283},{153,269},{147,256},{142,246},{138,238},{135,231},{133,226},{131,223},
+    {793,643},{781,644},{763,646},{740,647},{714,647},{684,646},{652,644},{618,639},
+    {583,632},{547,623},{511,612},{475,598},{440,583},{405,565},{372,545},{341,523},
+    {312,500},{285,477},{260,452},{237,428},{217,403},{200,380},{184,357},{171,336},
+    {160,317},{150,299},{143,284},{136,270},{131,258},{127,249},{124,241},{122,235},
+    {120,231},{761,684},{752,685},{737,685},{717,686},{692,685},{664,684},{634,680},
+    {601,675},{566,668},{531,658},{496,646},{460,632},{426,615},{392,597},{359,576},
+    {328,554},{299,530},{272,505},{247,480},{225,454},{205,429},{187,404},{172,380},
+    {158,357},{147,336},{138,317},{130,300},{124,285},{119,272},{115,261},{111,252},
+    {109,245},{107,240},{725,724},{720,724},{709,724},{691,723},{668,722},{642,720},
+    {613,716},{581,710},{548,703},{513,693},{479,680},{444,665},{409,648},{376,629},
+    {344,608},{313,585},{284,561},{257,535},{232,509},{210,482},{190,456},{172,429},
+    {157,404},{143,380},{132,357},{123,337},{115,318},{109,301},{104,287},{100,274},
+    {97,264},{94,256},{93,249},{-32768,-32768},{684,761},{676,761},{662,760},{642,758},
+    {617,755},{589,751},{559,745},{527,737},{493,726},{459,714},{425,699},{391,681},
+    {358,662},{326,640},{295,616},{267,591},{240,565},{215,538},{193,511},{173,483},
+    {155,456},{140,429},{126,404},{115,380},{106,357},{98,337},{92,319},{87,303},
+    {83,289},{80,277},{77,267},{76,260},{-32768,-32768},{-32768,-32768},{641,795},{629,794},
+    {612,793},{589,790},{563,785},{534,779},{503,770},{471,759},{437,746},{404,731},
+    {370,713},{338,693},{306,671},{276,648},{247,622},{220,595},{196,568},{173,539},
+    {153,511},{135,482},{120,455},{107,428},{96,403},{86,379},{79,357},{72,337},
+    {68,320},{64,304},{61,291},{58,280},{57,270},{-32768,-32768},{-32768,-32768},{602,828},
+    {594,827},{579,825},{559,822},{535,817},{507,811},{477,802},{446,791},{413,778},
+    {380,762},{347,745},{315,724},{284,702},{253,678},{225,652},{198,625},{174,597},
+    {151,568},{131,539},{114,509},{98,481},{85,453},{74,426},{64,401},{57,378},
+    {51,357},{46,337},{42,320},{39,305},{37,292},{35,282},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{556,857},{544,855},{527,852},{504,847},{478,841},{450,832},{419,821},
+    {387,808},{355,793},{322,775},{290,754},{259,732},{229,708},{201,682},{174,654},
+    {150,625},{127,596},{107,566},{89,536},{74,506},{61,478},{49,450},{40,423},
+    {32,399},{26,376},{22,355},{18,336},{15,320},{13,305},{12,293},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{515,885},{507,883},{492,880},{472,876},{447,869},{420,861},
+    {390,850},{359,837},{327,821},{295,803},{264,783},{233,760},{203,736},{175,710},
+    {148,682},{124,653},{101,623},{81,593},{63,562},{47,532},{34,502},{23,473},
+    {13,445},{6,419},{0,395},{-5,373},{-8,352},{-11,334},{-13,318},{-14,304},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{467,908},{455,906},{437,901},{415,895},
+    {389,887},{360,876},{330,863},{299,848},{267,830},{236,810},{205,787},{175,763},
+    {147,736},{120,709},{96,679},{73,649},{53,618},{35,587},{19,556},{5,525},
+    {-6,495},{-16,467},{-23,439},{-29,413},{-34,390},{-37,368},{-39,348},{-41,330},
+    {-42,314},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{426,930},{417,929},{402,925},
+    {381,919},{356,911},{329,900},{299,887},{269,872},{237,855},{206,835},{176,812},
+    {146,788},{118,761},{91,733},{66,704},{43,673},{23,642},{4,610},{-12,579},
+    {-25,547},{-37,516},{-47,487},{-54,458},{-60,431},{-65,406},{-68,382},{-70,361},
+    {-72,341},{-72,324},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{383,950},{378,948},
+    {366,945},{347,940},{323,932},{297,922},{268,909},{238,894},{207,877},{176,857},
+    {145,835},{115,811},{87,784},{60,756},{35,727},{12,696},{-9,664},{-28,632},
+    {-44,600},{-58,568},{-70,536},{-79,505},{-87,476},{-93,447},{-98,421},{-101,396},
+    {-103,372},{-104,351},{-104,332},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {339,965},{329,963},{312,958},{290,951},{265,941},{236,929},{207,914},{176,897},
+    {145,878},{114,856},{84,831},{55,805},{28,777},{3,747},{-20,716},{-42,685},
+    {-61,652},{-77,619},{-92,586},{-104,554},{-114,522},{-122,491},{-128,462},{-132,434},
+    {-135,407},{-137,383},{-138,360},{-138,339},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{299,979},{293,977},{278,973},{258,966},{233,957},{205,946},{176,932},
+    {145,915},{114,896},{83,874},{53,850},{24,824},{-4,796},{-30,766},{-54,735},
+    {-75,703},{-95,670},{-112,636},{-127,603},{-139,570},{-149,537},{-157,505},{-164,475},
+    {-168,445},{-171,417},{-173,391},{-174,367},{-174,344},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{258,989},{246,986},{227,980},{203,971},{175,960},
+    {146,946},{115,930},{83,911},{52,890},{21,866},{-8,840},{-36,812},{-63,782},
+    {-87,751},{-109,718},{-129,685},{-147,651},{-162,617},{-175,583},{-186,550},{-194,517},
+    {-201,485},{-206,455},{-209,426},{-210,398},{-211,372},{-210,348},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{226,998},{216,996},{198,990},{175,982},
+    {147,972},{117,958},{86,943},{54,924},{22,903},{-9,879},{-39,853},{-68,826},
+    {-95,796},{-120,764},{-143,732},{-164,698},{-182,664},{-198,629},{-212,595},{-223,560},
+    {-232,527},{-238,494},{-243,462},{-247,431},{-248,402},{-249,375},{-248,349},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{198,1005},{190,1003},{173,998},
+    {150,991},{122,981},{92,968},{60,953},{27,935},{-6,914},{-38,890},{-69,865},
+    {-99,837},{-127,807},{-153,776},{-177,743},{-198,709},{-217,674},{-234,639},{-248,604},
+    {-260,569},{-269,534},{-276,500},{-282,467},{-285,435},{-287,404},{-287,375},{-286,348},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{171,1007},
+    {155,1003},{131,996},{102,987},{71,975},{37,960},{3,943},{-31,922},{-64,899},
+    {-97,874},{-128,846},{-157,816},{-184,785},{-209,752},{-232,717},{-252,682},{-269,647},
+    {-284,611},{-296,575},{-307,539},{-314,504},{-320,470},{-324,436},{-325,404},{-326,374},
+    {-325,344},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {162,1009},{145,1006},{119,1000},{88,991},{55,980},{20,966},{-16,949},{-52,929},
+    {-88,906},{-122,881},{-154,853},{-185,823},{-213,792},{-240,758},{-263,724},{-285,688},
+    {-303,652},{-319,615},{-332,578},{-343,542},{-352,505},{-358,470},{-362,435},{-364,402},
+    {-364,370},{-363,339},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{47,982},{9,969},{-30,952},
+    {-69,933},{-106,911},{-143,886},{-177,858},{-210,829},{-240,797},{-268,763},{-293,728},
+    {-316,692},{-335,655},{-353,618},{-367,580},{-379,542},{-388,505},{-394,468},{-399,432},
+    {-401,397},{-402,363},{-401,331},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-36,954},{-78,935},{-119,914},{-158,889},{-195,862},{-230,832},{-263,800},{-293,766},
+    {-320,731},{-344,694},{-366,657},{-384,618},{-400,580},{-412,541},{-423,502},{-430,464},
+    {-435,427},{-438,390},{-439,355},{-437,321},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-124,915},{-167,891},{-208,864},{-246,834},{-281,802},
+    {-313,768},{-343,732},{-369,695},{-393,657},{-413,618},{-430,578},{-444,538},{-455,498},
+    {-464,459},{-470,420},{-473,382},{-474,345},{-473,309},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-213,865},{-255,835},
+    {-293,803},{-329,769},{-361,733},{-390,695},{-416,656},{-438,616},{-457,575},{-473,534},
+    {-485,493},{-495,452},{-502,411},{-506,372},{-508,333},{-507,295},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-298,804},{-338,770},{-374,733},{-406,695},{-434,655},{-459,614},{-480,572},
+    {-498,529},{-513,487},{-524,444},{-532,402},{-537,361},{-539,320},{-539,280},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-379,733},{-415,694},{-447,654},{-475,612},
+    {-499,569},{-519,525},{-536,481},{-549,436},{-558,392},{-565,349},{-568,306},{-568,264},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},
+    {-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-32768,-32768},{-453,653},
+    {-484,610},{-512,566},{-535,521},{-554,475},{-570,429},{-581,383},{-589,337},{-594,292},
+    {-595,248},
+};
+
+#endif // FK_TABLE_H
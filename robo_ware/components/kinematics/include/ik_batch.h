@@ -0,0 +1,115 @@
+#ifndef IK_BATCH_H
+#define IK_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "kinematics.h"
+#include "ik_lut.h"
+
+// Marks an unreachable point in a solved trajectory, never a valid pulse width
+#define IK_TICKS_INVALID        0
+
+// Points are solved in blocks so the scratch arrays stay on the stack and in L1
+#define IK_BATCH_BLOCK          32
+
+// Struct of arrays of foot targets for both legs, Q4 mm like ik_lookup_ticks()
+typedef struct {
+    const int16_t *left_x;
+    const int16_t *left_y;
+    const int16_t *right_x;
+    const int16_t *right_y;
+    size_t count;
+} gait_targets_t;
+
+// Compare values of all four servos for one point of a trajectory
+typedef struct {
+    uint16_t left_front;
+    uint16_t left_rear;
+    uint16_t right_front;
+    uint16_t right_rear;
+} body_ticks_t;
+
+// Solves up to IK_BATCH_BLOCK targets of one leg into left leg ticks. Every
+// pass is a straight loop without branches so the compiler can vectorize the
+// index math and the blend, only the table gather stays scalar.
+static inline void ik_batch_block(const int16_t *x_q4, const int16_t *y_q4, size_t n,
+                                  uint16_t *front, uint16_t *rear)
+{
+    int32_t index[IK_BATCH_BLOCK];
+    int32_t fx[IK_BATCH_BLOCK], fy[IK_BATCH_BLOCK];
+    int32_t dc[IK_BATCH_BLOCK], dr[IK_BATCH_BLOCK];
+    int32_t ok[IK_BATCH_BLOCK];
+
+    // Grid cell, fraction and bounds. Off-table points are pointed at cell 0 and
+    // masked out at the end so the gather below never reads out of bounds.
+    for (size_t i = 0; i < n; i++) {
+        int32_t gx = x_q4[i] - IK_TABLE_X_MIN * (1 << IK_FRAC_BITS);
+        int32_t gy = y_q4[i] - IK_TABLE_Y_MIN * (1 << IK_FRAC_BITS);
+        int32_t col = gx >> IK_GRID_FRAC_BITS;
+        int32_t row = gy >> IK_GRID_FRAC_BITS;
+        fx[i] = gx & (IK_GRID_ONE - 1);
+        fy[i] = gy & (IK_GRID_ONE - 1);
+        dc[i] = fx[i] != 0;
+        dr[i] = (fy[i] != 0) * IK_TABLE_COLS;
+        ok[i] = (gx >= 0) & (gy >= 0) & (col + dc[i] < IK_TABLE_COLS) & (row + (fy[i] != 0) < IK_TABLE_ROWS);
+        index[i] = ok[i] ? row * IK_TABLE_COLS + col : 0;
+    }
+
+    // Whole cells are copied so each corner is a single 32 bit load
+    ik_cell_t c00[IK_BATCH_BLOCK], c01[IK_BATCH_BLOCK], c10[IK_BATCH_BLOCK], c11[IK_BATCH_BLOCK];
+    for (size_t i = 0; i < n; i++) {
+        const ik_cell_t *c = &ik_table[index[i]];
+        c00[i] = c[0];
+        c01[i] = c[dc[i]];
+        c10[i] = c[dr[i]];
+        c11[i] = c[dr[i] + dc[i]];
+    }
+
+    const int32_t round = 1 << (IK_INTERP_SHIFT - 1);
+    for (size_t i = 0; i < n; i++) {
+        int32_t wx = IK_GRID_ONE - fx[i];
+        int32_t wy = IK_GRID_ONE - fy[i];
+        int32_t f = ((c00[i].front * wx + c01[i].front * fx[i]) * wy +
+                     (c10[i].front * wx + c11[i].front * fx[i]) * fy[i] + round) >> IK_INTERP_SHIFT;
+        int32_t r = ((c00[i].rear * wx + c01[i].rear * fx[i]) * wy +
+                     (c10[i].rear * wx + c11[i].rear * fx[i]) * fy[i] + round) >> IK_INTERP_SHIFT;
+        int32_t valid = ok[i] &
+                        (c00[i].front != IK_TABLE_INVALID) & (c01[i].front != IK_TABLE_INVALID) &
+                        (c10[i].front != IK_TABLE_INVALID) & (c11[i].front != IK_TABLE_INVALID) &
+                        (f >= SERVO_MIN_PULSEWIDTH_US) & (f <= SERVO_MAX_PULSEWIDTH_US) &
+                        (r >= SERVO_MIN_PULSEWIDTH_US) & (r <= SERVO_MAX_PULSEWIDTH_US);
+        front[i] = (uint16_t)(valid ? f : IK_TICKS_INVALID);
+        rear[i] = (uint16_t)(valid ? r : IK_TICKS_INVALID);
+    }
+}
+
+// Solves a whole trajectory for both legs in one pass. Unreachable points get
+// IK_TICKS_INVALID for that leg's servos. Returns the number of such points.
+static inline size_t ik_solve_batch(const gait_targets_t *targets, body_ticks_t *out)
+{
+    uint16_t lf[IK_BATCH_BLOCK], lr[IK_BATCH_BLOCK], rf[IK_BATCH_BLOCK], rr[IK_BATCH_BLOCK];
+    size_t invalid = 0;
+
+    for (size_t start = 0; start < targets->count; start += IK_BATCH_BLOCK) {
+        size_t n = targets->count - start;
+        if (n > IK_BATCH_BLOCK) {
+            n = IK_BATCH_BLOCK;
+        }
+        ik_batch_block(targets->left_x + start, targets->left_y + start, n, lf, lr);
+        ik_batch_block(targets->right_x + start, targets->right_y + start, n, rf, rr);
+
+        body_ticks_t *o = out + start;
+        for (size_t i = 0; i < n; i++) {
+            int32_t right_ok = rf[i] != IK_TICKS_INVALID;
+            o[i].left_front = lf[i];
+            o[i].left_rear = lr[i];
+            // Right leg servos are mirrored
+            o[i].right_front = (uint16_t)(right_ok ? SERVO_MIRROR_TICKS - rf[i] : IK_TICKS_INVALID);
+            o[i].right_rear = (uint16_t)(right_ok ? SERVO_MIRROR_TICKS - rr[i] : IK_TICKS_INVALID);
+            invalid += (lf[i] == IK_TICKS_INVALID) | !right_ok;
+        }
+    }
+    return invalid;
+}
+
+#endif // IK_BATCH_H
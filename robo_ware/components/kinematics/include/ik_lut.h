@@ -0,0 +1,63 @@
+#ifndef IK_LUT_H
+#define IK_LUT_H
+
+#include <stdint.h>
+#include "kinematics.h"
+#include "ik_table.h"
+
+// Foot targets for the table lookup are Q4 fixed point mm (1/16 mm)
+#define IK_FRAC_BITS            4
+
+#define IK_GRID_FRAC_BITS       (IK_FRAC_BITS + IK_TABLE_STEP_SHIFT)
+#define IK_GRID_ONE             (1 << IK_GRID_FRAC_BITS)
+#define IK_INTERP_SHIFT         (2 * IK_GRID_FRAC_BITS + IK_TABLE_TICK_FRAC_BITS)
+
+// Integer only IK. Bilinear interpolation between the four surrounding table
+// cells, straight to left leg compare ticks. Returns -1 if the target is off the
+// table, touches an unreachable cell or lands outside the servo pulse range.
+static inline int ik_lookup_ticks(int32_t x_q4, int32_t y_q4, uint16_t *front_ticks, uint16_t *rear_ticks)
+{
+    int32_t gx = x_q4 - IK_TABLE_X_MIN * (1 << IK_FRAC_BITS);
+    int32_t gy = y_q4 - IK_TABLE_Y_MIN * (1 << IK_FRAC_BITS);
+    if (gx < 0 || gy < 0) {
+        return -1;
+    }
+    int32_t col = gx >> IK_GRID_FRAC_BITS;
+    int32_t row = gy >> IK_GRID_FRAC_BITS;
+    int32_t fx = gx & (IK_GRID_ONE - 1);
+    int32_t fy = gy & (IK_GRID_ONE - 1);
+    // Targets right on a grid line don't need the cells past it
+    int32_t next_col = fx != 0;
+    int32_t next_row = fy != 0;
+    if (col + next_col >= IK_TABLE_COLS || row + next_row >= IK_TABLE_ROWS) {
+        return -1;
+    }
+
+    const ik_cell_t *c00 = &ik_table[row * IK_TABLE_COLS + col];
+    const ik_cell_t *c01 = c00 + next_col;
+    const ik_cell_t *c10 = c00 + next_row * IK_TABLE_COLS;
+    const ik_cell_t *c11 = c10 + next_col;
+    if (c00->front == IK_TABLE_INVALID || c01->front == IK_TABLE_INVALID ||
+        c10->front == IK_TABLE_INVALID || c11->front == IK_TABLE_INVALID) {
+        return -1;
+    }
+
+    const int32_t round = 1 << (IK_INTERP_SHIFT - 1);
+    int32_t top = c00->front * (IK_GRID_ONE - fx) + c01->front * fx;
+    int32_t bot = c10->front * (IK_GRID_ONE - fx) + c11->front * fx;
+    int32_t front = (top * (IK_GRID_ONE - fy) + bot * fy + round) >> IK_INTERP_SHIFT;
+
+    top = c00->rear * (IK_GRID_ONE - fx) + c01->rear * fx;
+    bot = c10->rear * (IK_GRID_ONE - fx) + c11->rear * fx;
+    int32_t rear = (top * (IK_GRID_ONE - fy) + bot * fy + round) >> IK_INTERP_SHIFT;
+
+    if (front < SERVO_MIN_PULSEWIDTH_US || front > SERVO_MAX_PULSEWIDTH_US ||
+        rear < SERVO_MIN_PULSEWIDTH_US || rear > SERVO_MAX_PULSEWIDTH_US) {
+        return -1;
+    }
+    *front_ticks = (uint16_t)front;
+    *rear_ticks = (uint16_t)rear;
+    return 0;
+}
+
+#endif // IK_LUT_H
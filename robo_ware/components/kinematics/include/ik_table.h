@@ -0,0 +1,664 @@
+// Generated by tools/gen_ik_table.py, do not edit by hand.
+#ifndef IK_TABLE_H
+#define IK_TABLE_H
+
+#include <stdint.h>
+#include "kinematics.h"
+
+static_assert(UPPER_LEG_LEN == 40 && LOWER_LEG_LEN == 24 && REAR_OFFSET == 21 &&
+              SERVO_HORN_OFFSET == 135, "ik_table.h is stale, rerun tools/gen_ik_table.py");
+
+#define IK_TABLE_X_MIN          -36
+#define IK_TABLE_Y_MIN          12
+#define IK_TABLE_STEP_SHIFT     0
+#define IK_TABLE_COLS           95
+#define IK_TABLE_ROWS           53
+#define IK_TABLE_TICK_FRAC_BITS 4
+#define IK_TABLE_INVALID        0xFFFF
+
+// Left leg compare ticks (Q4) per grid point, 3652 of 5035 cells reachable
+typedef struct {
+    uint16_t front;
+    uint16_t rear;
+} ik_cell_t;
+
+static const ik_cell_t ik_table[IK_TABLE_ROWS * IK_TABLE_COLS] = {
+    {42376,40183},{42644,39654},{42913,39153},{43181,38673},{43450,38211},{43721,37761},{43993,37323},{44267,36894},
+    {44545,36471},{44827,36054},{45113,35641},{45405,35231},{45704,34823},{46012,34415},{46331,34007},{46662,33598},
+    {47009,33187},{47375,32773},{47766,32356},{48188,31933},{48653,31505},{49174,31070},{49779,30627},{50514,30175},
+    {51489,29714},{53113,29241},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{18759,    0},{18286,    0},{17825,    0},{17373,    0},
+    {16930,    0},{16495,    0},{16067,    0},{15644,  234},{15227,  625},{14813,  991},{14402, 1338},{13993, 1669},
+    {13585, 1988},{13177, 2296},{12769, 2595},{12359, 2887},{11946, 3173},{11529, 3455},{11106, 3733},{10677, 4007},
+    {10239, 4279},{ 9789, 4550},{ 9327, 4819},{ 8847, 5087},{ 8346, 5356},{ 7817, 5624},{ 7252, 5894},
+    {42001,40125},{42259,39588},{42517,39080},{42773,38594},{43029,38126},{43286,37673},{43543,37230},{43801,36797},
+    {44061,36371},{44323,35950},{44588,35534},{44856,35121},{45129,34710},{45408,34300},{45694,33890},{45988,33478},
+    {46292,33065},{46609,32649},{46941,32229},{47294,31805},{47673,31375},{48085,30939},{48544,30496},{49070,30044},
+    {49700,29582},{50512,29110},{51753,28625},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{38395,11795},{36205, 9605},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{19375,    0},{18890,    0},{18418,    0},{17956,    0},{17504,    0},
+    {17061,    0},{16625,  327},{16195,  706},{15771, 1059},{15351, 1391},{14935, 1708},{14522, 2012},{14110, 2306},
+    {13700, 2592},{13290, 2871},{12879, 3144},{12466, 3412},{12050, 3677},{11629, 3939},{11203, 4199},{10770, 4457},
+    {10327, 4714},{ 9874, 4971},{ 9406, 5227},{ 8920, 5483},{ 8412, 5741},{ 7875, 5999},{ 7300, 6259},
+    {41623,40079},{41871,39533},{42117,39017},{42362,38525},{42606,38052},{42849,37594},{43091,37147},{43333,36710},
+    {43576,36280},{43819,35856},{44063,35437},{44309,35021},{44557,34607},{44808,34195},{45063,33782},{45323,33369},
+    {45588,32953},{45860,32536},{46141,32114},{46433,31689},{46739,31258},{47063,30821},{47410,30377},{47790,29925},
+    {48215,29464},{48707,28993},{49310,28510},{50129,28014},{51651,27504},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{41075,15456},{38489,14221},{36674,12860},{35140,11326},
+    {33779, 9511},{32544, 6925},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{20496,    0},{19986,    0},{19490,    0},{19007,    0},{18536,    0},{18075,  210},{17623,  590},
+    {17179,  937},{16742, 1261},{16311, 1567},{15886, 1859},{15464, 2140},{15047, 2412},{14631, 2677},{14218, 2937},
+    {13805, 3192},{13393, 3443},{12979, 3691},{12563, 3937},{12144, 4181},{11720, 4424},{11290, 4667},{10853, 4909},
+    {10406, 5151},{ 9948, 5394},{ 9475, 5638},{ 8983, 5883},{ 8467, 6129},{ 7921, 6377},{ 7335, 6627},
+    {41242,40045},{41480,39489},{41715,38966},{41949,38467},{42180,37988},{42410,37524},{42638,37073},{42865,36632},
+    {43091,36199},{43316,35772},{43541,35350},{43765,34931},{43990,34515},{44215,34099},{44441,33685},{44669,33269},
+    {44898,32853},{45130,32433},{45365,32011},{45604,31584},{45849,31153},{46100,30716},{46361,30272},{46633,29820},
+    {46920,29360},{47229,28890},{47568,28409},{47953,27917},{48414,27411},{49021,26890},{50047,26354},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{42295,17900},{40126,16937},{38432,15915},{36944,14826},{35589,13661},{34339,12411},
+    {33174,11056},{32085, 9568},{31063, 7874},{30100, 5705},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{21646,    0},
+    {21110,    0},{20589,    0},{20083,   47},{19591,  432},{19110,  771},{18640, 1080},{18180, 1367},{17728, 1639},
+    {17284, 1900},{16847, 2151},{16416, 2396},{15989, 2635},{15567, 2870},{15147, 3102},{14731, 3331},{14315, 3559},
+    {13901, 3785},{13485, 4010},{13069, 4235},{12650, 4459},{12228, 4684},{11801, 4909},{11368, 5135},{10927, 5362},
+    {10476, 5590},{10012, 5820},{ 9533, 6051},{ 9034, 6285},{ 8511, 6520},{ 7955, 6758},{ 7356, 6999},
+    {40858,40024},{41086,39457},{41311,38925},{41534,38419},{41753,37934},{41970,37465},{42185,37010},{42397,36564},
+    {42607,36127},{42815,35697},{43021,35272},{43225,34851},{43428,34432},{43629,34014},{43828,33598},{44027,33181},
+    {44224,32762},{44419,32342},{44614,31919},{44808,31491},{45000,31060},{45192,30622},{45383,30179},{45573,29728},
+    {45762,29269},{45951,28801},{46139,28323},{46326,27834},{46514,27332},{46700,26817},{46887,26287},{47073,25741},
+    {47258,25177},{47444,24594},{47629,23989},{47815,23362},{48000,22710},{46543,22031},{45096,21323},{43668,20583},
+    {42268,19810},{40902,19000},{39578,18151},{38299,17261},{37068,16327},{35888,15347},{34759,14319},{33681,13241},
+    {32653,12112},{31673,10932},{30739, 9701},{29849, 8422},{29000, 7098},{28190, 5732},{27417, 4332},{26677, 2904},
+    {25969, 1457},{25290,    0},{24638,  185},{24011,  371},{23406,  556},{22823,  742},{22259,  927},{21713, 1113},
+    {21183, 1300},{20668, 1486},{20166, 1674},{19677, 1861},{19199, 2049},{18731, 2238},{18272, 2427},{17821, 2617},
+    {17378, 2808},{16940, 3000},{16509, 3192},{16081, 3386},{15658, 3581},{15238, 3776},{14819, 3973},{14402, 4172},
+    {13986, 4371},{13568, 4572},{13149, 4775},{12728, 4979},{12303, 5185},{11873, 5393},{11436, 5603},{10990, 5815},
+    {10535, 6030},{10066, 6247},{ 9581, 6466},{ 9075, 6689},{ 8543, 6914},{ 7976, 7142},{ 7362, 7374},
+    {40471,40018},{40690,39438},{40906,38897},{41117,38383},{41326,37891},{41530,37417},{41732,36956},{41930,36507},
+    {42125,36066},{42316,35632},{42505,35204},{42690,34780},{42872,34359},{43051,33940},{43226,33521},{43398,33102},
+    {43565,32683},{43729,32261},{43888,31837},{44042,31410},{44190,30978},{44332,30541},{44467,30098},{44594,29649},
+    {44710,29192},{44815,28726},{44905,28251},{44977,27766},{45027,27269},{45049,26759},{45035,26236},{44974,25698},
+    {44853,25144},{44656,24573},{44364,23982},{43957,23372},{43423,22739},{42760,22083},{41978,21402},{41098,20694},
+    {40146,19958},{39147,19192},{38123,18396},{37092,17567},{36067,16706},{35058,15812},{34073,14885},{33115,13927},
+    {32188,12942},{31294,11933},{30433,10908},{29604, 9877},{28808, 8853},{28042, 7854},{27306, 6902},{26598, 6022},
+    {25917, 5240},{25261, 4577},{24628, 4043},{24018, 3636},{23427, 3344},{22856, 3147},{22302, 3026},{21764, 2965},
+    {21241, 2951},{20731, 2973},{20234, 3023},{19749, 3095},{19274, 3185},{18808, 3290},{18351, 3406},{17902, 3533},
+    {17459, 3668},{17022, 3810},{16590, 3958},{16163, 4112},{15739, 4271},{15317, 4435},{14898, 4602},{14479, 4774},
+    {14060, 4949},{13641, 5128},{13220, 5310},{12796, 5495},{12368, 5684},{11934, 5875},{11493, 6070},{11044, 6268},
+    {10583, 6470},{10109, 6674},{ 9617, 6883},{ 9103, 7094},{ 8562, 7310},{ 7982, 7529},{ 7351, 7752},
+    {40083,40026},{40293,39433},{40499,38880},{40700,38358},{40897,37859},{41090,37379},{41279,36913},{41464,36459},
+    {41645,36015},{41821,35578},{41993,35147},{42161,34720},{42324,34296},{42482,33875},{42635,33455},{42782,33035},
+    {42923,32614},{43058,32192},{43186,31767},{43306,31340},{43417,30908},{43518,30472},{43607,30030},{43684,29582},
+    {43745,29127},{43788,28664},{43810,28193},{43807,27711},{43775,27220},{43708,26716},{43599,26200},{43441,25671},
+    {43224,25127},{42941,24567},{42583,23991},{42144,23396},{41620,22782},{41013,22148},{40329,21492},{39577,20814},
+    {38770,20112},{37921,19386},{37044,18635},{36152,17859},{35255,17059},{34362,16234},{33479,15387},{32613,14521},
+    {31766,13638},{30941,12745},{30141,11848},{29365,10956},{28614,10079},{27888, 9230},{27186, 8423},{26508, 7671},
+    {25852, 6987},{25218, 6380},{24604, 5856},{24009, 5417},{23433, 5059},{22873, 4776},{22329, 4559},{21800, 4401},
+    {21284, 4292},{20780, 4225},{20289, 4193},{19807, 4190},{19336, 4212},{18873, 4255},{18418, 4316},{17970, 4393},
+    {17528, 4482},{17092, 4583},{16660, 4694},{16233, 4814},{15808, 4942},{15386, 5077},{14965, 5218},{14545, 5365},
+    {14125, 5518},{13704, 5676},{13280, 5839},{12853, 6007},{12422, 6179},{11985, 6355},{11541, 6536},{11087, 6721},
+    {10621, 6910},{10141, 7103},{ 9642, 7300},{ 9120, 7501},{ 8567, 7707},{ 7974, 7917},{ 7323, 8132},
+    {39693,40051},{39895,39442},{40091,38877},{40283,38346},{40470,37839},{40651,37352},{40828,36881},{41001,36423},
+    {41168,35974},{41330,35534},{41486,35099},{41637,34670},{41783,34244},{41922,33821},{42054,33399},{42180,32978},
+    {42298,32556},{42407,32133},{42508,31708},{42598,31281},{42677,30849},{42744,30414},{42796,29974},{42833,29528},
+    {42851,29075},{42848,28615},{42821,28147},{42767,27670},{42682,27184},{42561,26687},{42398,26178},{42190,25658},
+    {41929,25124},{41613,24576},{41235,24013},{40795,23434},{40290,22838},{39724,22224},{39099,21593},{38423,20942},
+    {37702,20271},{36947,19581},{36167,18870},{35369,18140},{34563,17391},{33755,16625},{32952,15843},{32157,15048},
+    {31375,14245},{30609,13437},{29860,12631},{29130,11833},{28419,11053},{27729,10298},{27058, 9577},{26407, 8901},
+    {25776, 8276},{25162, 7710},{24566, 7205},{23987, 6765},{23424, 6387},{22876, 6071},{22342, 5810},{21822, 5602},
+    {21313, 5439},{20816, 5318},{20330, 5233},{19853, 5179},{19385, 5152},{18925, 5149},{18472, 5167},{18026, 5204},
+    {17586, 5256},{17151, 5323},{16719, 5402},{16292, 5492},{15867, 5593},{15444, 5702},{15022, 5820},{14601, 5946},
+    {14179, 6078},{13756, 6217},{13330, 6363},{12901, 6514},{12466, 6670},{12026, 6832},{11577, 6999},{11119, 7172},
+    {10648, 7349},{10161, 7530},{ 9654, 7717},{ 9123, 7909},{ 8558, 8105},{ 7949, 8307},{ 7275, 8514},
+    {39302,40094},{39495,39466},{39683,38888},{39865,38346},{40042,37831},{40213,37337},{40379,36860},{40539,36397},
+    {40694,35944},{40842,35500},{40985,35062},{41121,34630},{41250,34202},{41371,33777},{41486,33354},{41591,32931},
+    {41688,32508},{41776,32085},{41852,31660},{41917,31233},{41969,30802},{42007,30368},{42029,29929},{42034,29485},
+    {42018,29035},{41980,28578},{41918,28114},{41827,27642},{41706,27161},{41549,26670},{41355,26170},{41118,25658},
+    {40836,25134},{40505,24597},{40124,24048},{39691,23484},{39207,22905},{38674,22312},{38094,21702},{37472,21077},
+    {36815,20435},{36127,19776},{35417,19102},{34691,18412},{33954,17708},{33213,16991},{32473,16263},{31737,15527},
+    {31009,14787},{30292,14046},{29588,13309},{28898,12583},{28224,11873},{27565,11185},{26923,10528},{26298, 9906},
+    {25688, 9326},{25095, 8793},{24516, 8309},{23952, 7876},{23403, 7495},{22866, 7164},{22342, 6882},{21830, 6645},
+    {21330, 6451},{20839, 6294},{20358, 6173},{19886, 6082},{19422, 6020},{18965, 5982},{18515, 5966},{18071, 5971},
+    {17632, 5993},{17198, 6031},{16767, 6083},{16340, 6148},{15915, 6224},{15492, 6312},{15069, 6409},{14646, 6514},
+    {14223, 6629},{13798, 6750},{13370, 6879},{12938, 7015},{12500, 7158},{12056, 7306},{11603, 7461},{11140, 7621},
+    {10663, 7787},{10169, 7958},{ 9654, 8135},{ 9112, 8317},{ 8534, 8505},{ 7906, 8698},{ 7204, 8897},
+    {38909,40158},{39095,39508},{39274,38913},{39448,38359},{39615,37835},{39777,37334},{39932,36850},{40081,36382},
+    {40224,35924},{40360,35476},{40489,35036},{40610,34601},{40725,34171},{40831,33743},{40928,33319},{41016,32895},
+    {41095,32472},{41162,32048},{41218,31623},{41261,31196},{41290,30766},{41304,30333},{41301,29896},{41280,29454},
+    {41238,29007},{41173,28554},{41084,28094},{40967,27626},{40820,27151},{40641,26667},{40426,26174},{40173,25670},
+    {39880,25157},{39546,24631},{39168,24095},{38746,23546},{38282,22984},{37777,22409},{37233,21820},{36655,21218},
+    {36046,20602},{35412,19973},{34757,19331},{34086,18677},{33406,18012},{32719,17338},{32030,16656},{31344,15970},
+    {30662,15281},{29988,14594},{29323,13914},{28669,13243},{28027,12588},{27398,11954},{26782,11345},{26180,10767},
+    {25591,10223},{25016, 9718},{24454, 9254},{23905, 8832},{23369, 8454},{22843, 8120},{22330, 7827},{21826, 7574},
+    {21333, 7359},{20849, 7180},{20374, 7033},{19906, 6916},{19446, 6827},{18993, 6762},{18546, 6720},{18104, 6699},
+    {17667, 6696},{17234, 6710},{16804, 6739},{16377, 6782},{15952, 6838},{15528, 6905},{15105, 6984},{14681, 7072},
+    {14257, 7169},{13829, 7275},{13399, 7390},{12964, 7511},{12524, 7640},{12076, 7776},{11618, 7919},{11150, 8068},
+    {10666, 8223},{10165, 8385},{ 9641, 8552},{ 9087, 8726},{ 8492, 8905},{ 7842, 9091},{ 7107, 9283},
+    {38516,40244},{38694,39567},{38866,38955},{39031,38387},{39190,37852},{39342,37343},{39487,36852},{39626,36378},
+    {39757,35916},{39882,35464},{39999,35020},{40107,34582},{40208,34149},{40300,33720},{40382,33294},{40454,32869},
+    {40516,32445},{40566,32021},{40604,31596},{40628,31170},{40638,30741},{40632,30309},{40609,29874},{40566,29435},
+    {40503,28990},{40418,28541},{40309,28085},{40173,27623},{40008,27153},{39813,26676},{39586,26190},{39324,25695},
+    {39027,25191},{38693,24677},{38321,24153},{37913,23618},{37468,23072},{36987,22514},{36475,21946},{35932,21365},
+    {35363,20774},{34772,20172},{34162,19559},{33538,18937},{32903,18306},{32262,17669},{31617,17027},{30973,16383},
+    {30331,15738},{29694,15097},{29063,14462},{28441,13838},{27828,13228},{27226,12637},{26635,12068},{26054,11525},
+    {25486,11013},{24928,10532},{24382,10087},{23847, 9679},{23323, 9307},{22809, 8973},{22305, 8676},{21810, 8414},
+    {21324, 8187},{20847, 7992},{20377, 7827},{19915, 7691},{19459, 7582},{19010, 7497},{18565, 7434},{18126, 7391},
+    {17691, 7368},{17259, 7362},{16830, 7372},{16404, 7396},{15979, 7434},{15555, 7484},{15131, 7546},{14706, 7618},
+    {14280, 7700},{13851, 7792},{13418, 7893},{12980, 8001},{12536, 8118},{12084, 8243},{11622, 8374},{11148, 8513},
+    {10657, 8658},{10148, 8810},{ 9613, 8969},{ 9045, 9134},{ 8433, 9306},{ 7756, 9484},{ 6978, 9669},
+    {38121,40356},{38293,39648},{38457,39014},{38615,38430},{38765,37884},{38908,37364},{39045,36867},{39174,36386},
+    {39295,35919},{39409,35462},{39514,35015},{39611,34574},{39699,34139},{39778,33708},{39847,33280},{39905,32854},
+    {39952,32430},{39987,32005},{40009,31581},{40018,31155},{40011,30727},{39988,30297},{39948,29863},{39888,29427},
+    {39809,28985},{39708,28539},{39583,28088},{39433,27630},{39256,27167},{39051,26696},{38816,26218},{38551,25732},
+    {38253,25237},{37922,24734},{37559,24222},{37163,23700},{36736,23169},{36278,22629},{35792,22078},{35280,21518},
+    {34745,20949},{34190,20371},{33618,19785},{33033,19192},{32437,18592},{31834,17988},{31228,17380},{30620,16772},
+    {30012,16166},{29408,15563},{28808,14967},{28215,14382},{27629,13810},{27051,13255},{26482,12720},{25922,12208},
+    {25371,11722},{24831,11264},{24300,10837},{23778,10441},{23266,10078},{22763, 9747},{22268, 9449},{21782, 9184},
+    {21304, 8949},{20833, 8744},{20370, 8567},{19912, 8417},{19461, 8292},{19015, 8191},{18573, 8112},{18137, 8052},
+    {17703, 8012},{17273, 7989},{16845, 7982},{16419, 7991},{15995, 8013},{15570, 8048},{15146, 8095},{14720, 8153},
+    {14292, 8222},{13861, 8301},{13426, 8389},{12985, 8486},{12538, 8591},{12081, 8705},{11614, 8826},{11133, 8955},
+    {10636, 9092},{10116, 9235},{ 9570, 9385},{ 8986, 9543},{ 8352, 9707},{ 7644, 9879},{ 6810,10057},
+    {37726,40501},{37891,39752},{38049,39092},{38199,38490},{38342,37930},{38477,37400},{38605,36894},{38725,36406},
+    {38837,35933},{38941,35472},{39036,35021},{39122,34577},{39199,34139},{39266,33706},{39323,33277},{39369,32850},
+    {39403,32425},{39424,32000},{39433,31575},{39427,31150},{39406,30724},{39369,30295},{39315,29864},{39242,29429},
+    {39150,28991},{39036,28549},{38900,28102},{38740,27649},{38555,27191},{38343,26727},{38104,26256},{37837,25779},
+    {37542,25294},{37217,24801},{36862,24301},{36479,23792},{36069,23275},{35631,22750},{35169,22217},{34683,21676},
+    {34177,21128},{33653,20572},{33114,20010},{32562,19443},{32000,18871},{31431,18296},{30857,17719},{30281,17143},
+    {29704,16569},{29129,16000},{28557,15438},{27990,14886},{27428,14347},{26872,13823},{26324,13317},{25783,12831},
+    {25250,12369},{24725,11931},{24208,11521},{23699,11138},{23199,10783},{22706,10458},{22221,10163},{21744, 9896},
+    {21273, 9657},{20809, 9445},{20351, 9260},{19898, 9100},{19451, 8964},{19009, 8850},{18571, 8758},{18136, 8685},
+    {17705, 8631},{17276, 8594},{16850, 8573},{16425, 8567},{16000, 8576},{15575, 8597},{15150, 8631},{14723, 8677},
+    {14294, 8734},{13861, 8801},{13423, 8878},{12979, 8964},{12528, 9059},{12067, 9163},{11594, 9275},{11106, 9395},
+    {10600, 9523},{10070, 9658},{ 9510, 9801},{ 8908, 9951},{ 8248,10109},{ 7499,10274},{ 6587,10446},
+    {37331,40687},{37490,39883},{37641,39191},{37784,38568},{37920,37992},{38048,37450},{38167,36935},{38279,36439},
+    {38383,35960},{38477,35494},{38563,35038},{38639,34591},{38706,34150},{38763,33715},{38809,33284},{38843,32856},
+    {38866,32430},{38876,32005},{38873,31581},{38856,31156},{38823,30731},{38774,30304},{38709,29875},{38625,29443},
+    {38522,29008},{38399,28569},{38254,28127},{38087,27679},{37896,27227},{37681,26769},{37440,26306},{37174,25836},
+    {36882,25361},{36563,24878},{36218,24389},{35848,23893},{35453,23390},{35033,22879},{34592,22363},{34130,21839},
+    {33650,21310},{33153,20775},{32642,20235},{32119,19691},{31587,19144},{31047,18595},{30502,18046},{29954,17498},
+    {29405,16953},{28856,16413},{28309,15881},{27765,15358},{27225,14847},{26690,14350},{26161,13870},{25637,13408},
+    {25121,12967},{24610,12547},{24107,12152},{23611,11782},{23122,11437},{22639,11118},{22164,10826},{21694,10560},
+    {21231,10319},{20773,10104},{20321, 9913},{19873, 9746},{19431, 9601},{18992, 9478},{18557, 9375},{18125, 9291},
+    {17696, 9226},{17269, 9177},{16844, 9144},{16419, 9127},{15995, 9124},{15570, 9134},{15144, 9157},{14716, 9191},
+    {14285, 9237},{13850, 9294},{13409, 9361},{12962, 9437},{12506, 9523},{12040, 9617},{11561, 9721},{11065, 9833},
+    {10550, 9952},{10008,10080},{ 9432,10216},{ 8809,10359},{ 8117,10510},{ 7313,10669},{ 6285,10836},
+    {36934,40926},{37088,40049},{37233,39316},{37370,38667},{37499,38072},{37620,37516},{37733,36990},{37837,36486},
+    {37932,36000},{38019,35528},{38096,35067},{38164,34616},{38221,34173},{38268,33735},{38305,33302},{38330,32873},
+    {38342,32446},{38342,32021},{38329,31597},{38302,31173},{38259,30749},{38201,30323},{38126,29896},{38033,29467},
+    {37922,29036},{37791,28601},{37640,28162},{37468,27720},{37274,27273},{37057,26822},{36817,26366},{36553,25904},
+    {36265,25437},{35953,24964},{35618,24486},{35259,24001},{34878,23511},{34476,23015},{34054,22514},{33613,22007},
+    {33155,21495},{32682,20979},{32196,20459},{31699,19937},{31193,19412},{30679,18887},{30160,18362},{29638,17840},
+    {29113,17321},{28588,16807},{28063,16301},{27541,15804},{27021,15318},{26505,14845},{25993,14387},{25486,13946},
+    {24985,13524},{24489,13122},{23999,12741},{23514,12382},{23036,12047},{22563,11735},{22096,11447},{21634,11183},
+    {21178,10943},{20727,10726},{20280,10532},{19838,10360},{19399,10209},{18964,10078},{18533, 9967},{18104, 9874},
+    {17677, 9799},{17251, 9741},{16827, 9698},{16403, 9671},{15979, 9658},{15554, 9658},{15127, 9670},{14698, 9695},
+    {14265, 9732},{13827, 9779},{13384, 9836},{12933, 9904},{12472, 9981},{12000,10068},{11514,10163},{11010,10267},
+    {10484,10380},{ 9928,10501},{ 9333,10630},{ 8684,10767},{ 7951,10912},{ 7074,11066},{ 5835,11227},
+    {36537,41246},{36686,40256},{36826,39470},{36957,38788},{37080,38171},{37195,37599},{37301,37060},{37398,36546},
+    {37486,36052},{37565,35574},{37634,35109},{37694,34654},{37744,34207},{37782,33766},{37810,33332},{37826,32901},
+    {37830,32473},{37822,32048},{37800,31624},{37764,31201},{37713,30777},{37646,30354},{37564,29929},{37464,29502},
+    {37347,29073},{37210,28642},{37055,28208},{36880,27771},{36683,27330},{36466,26884},{36227,26435},{35967,25981},
+    {35684,25523},{35380,25059},{35054,24591},{34706,24118},{34339,23640},{33952,23158},{33547,22670},{33125,22179},
+    {32688,21684},{32236,21185},{31773,20684},{31298,20181},{30815,19677},{30325,19173},{29829,18671},{29329,18171},
+    {28827,17675},{28323,17185},{27819,16702},{27316,16227},{26815,15764},{26316,15312},{25821,14875},{25330,14453},
+    {24842,14048},{24360,13661},{23882,13294},{23409,12946},{22941,12620},{22477,12316},{22019,12033},{21565,11773},
+    {21116,11534},{20670,11317},{20229,11120},{19792,10945},{19358,10790},{18927,10653},{18498,10536},{18071,10436},
+    {17646,10354},{17223,10287},{16799,10236},{16376,10200},{15952,10178},{15527,10170},{15099,10174},{14668,10190},
+    {14234,10218},{13793,10256},{13346,10306},{12891,10366},{12426,10435},{11948,10514},{11454,10602},{10940,10699},
+    {10401,10805},{ 9829,10920},{ 9212,11043},{ 8530,11174},{ 7744,11314},{ 6754,11463},{ 4794,11620},
+    {36139,41712},{36283,40522},{36418,39660},{36545,38936},{36662,38292},{36771,37700},{36871,37147},{36962,36622},
+    {37043,36119},{37116,35634},{37178,35163},{37231,34703},{37273,34252},{37304,33809},{37324,33372},{37333,32940},
+    {37330,32511},{37313,32085},{37284,31661},{37241,31238},{37183,30816},{37110,30394},{37021,29971},{36916,29547},
+    {36793,29122},{36653,28694},{36495,28264},{36317,27831},{36121,27396},{35904,26957},{35668,26514},{35411,26068},
+    {35134,25617},{34837,25163},{34520,24705},{34183,24243},{33829,23776},{33456,23306},{33067,22832},{32662,22355},
+    {32243,21875},{31811,21393},{31367,20909},{30913,20424},{30451,19939},{29982,19455},{29507,18973},{29027,18493},
+    {28545,18018},{28061,17549},{27576,17087},{27091,16633},{26607,16189},{26125,15757},{25645,15338},{25168,14933},
+    {24694,14544},{24224,14171},{23757,13817},{23295,13480},{22837,13163},{22383,12866},{21932,12589},{21486,12332},
+    {21043,12096},{20604,11879},{20169,11683},{19736,11505},{19306,11347},{18878,11207},{18453,11084},{18029,10979},
+    {17606,10890},{17184,10817},{16762,10759},{16339,10716},{15915,10687},{15489,10670},{15060,10667},{14628,10676},
+    {14191,10696},{13748,10727},{13297,10769},{12837,10822},{12366,10884},{11881,10957},{11378,11038},{10853,11129},
+    {10300,11229},{ 9708,11338},{ 9064,11455},{ 8340,11582},{ 7478,11717},{ 6288,11861},{0xFFFF,0xFFFF},
+    {35741,42703},{35880,40875},{36011,39897},{36133,39116},{36245,38437},{36349,37822},{36443,37252},{36529,36714},
+    {36604,36201},{36670,35707},{36727,35230},{36773,34765},{36809,34310},{36833,33863},{36847,33424},{36849,32990},
+    {36839,32560},{36816,32133},{36780,31709},{36731,31287},{36668,30866},{36589,30445},{36496,30024},{36386,29602},
+    {36260,29180},{36117,28756},{35957,28330},{35779,27902},{35582,27471},{35367,27038},{35133,26602},{34881,26163},
+    {34610,25721},{34320,25275},{34012,24826},{33686,24374},{33343,23919},{32984,23461},{32609,22999},{32220,22536},
+    {31817,22070},{31403,21603},{30977,21135},{30542,20667},{30099,20199},{29648,19733},{29192,19269},{28731,18808},
+    {28267,18352},{27801,17901},{27333,17458},{26865,17023},{26397,16597},{25930,16183},{25464,15780},{25001,15391},
+    {24539,15016},{24081,14657},{23626,14314},{23174,13988},{22725,13680},{22279,13390},{21837,13119},{21398,12867},
+    {20962,12633},{20529,12418},{20098,12221},{19670,12043},{19244,11883},{18820,11740},{18398,11614},{17976,11504},
+    {17555,11411},{17134,11332},{16713,11269},{16291,11220},{15867,11184},{15440,11161},{15010,11151},{14576,11153},
+    {14137,11167},{13690,11191},{13235,11227},{12770,11273},{12293,11330},{11799,11396},{11286,11471},{10748,11557},
+    {10178,11651},{ 9563,11755},{ 8884,11867},{ 8103,11989},{ 7125,12120},{ 5297,12259},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{35477,41393},{35604,40199},{35721,39337},{35829,38612},{35928,37968},{36018,37377},{36098,36823},
+    {36169,36298},{36229,35796},{36280,35311},{36321,34840},{36351,34380},{36370,33930},{36377,33487},{36374,33051},
+    {36358,32620},{36330,32192},{36289,31768},{36234,31346},{36166,30926},{36083,30506},{35986,30087},{35873,29668},
+    {35744,29248},{35600,28827},{35438,28406},{35260,27982},{35065,27557},{34852,27129},{34621,26699},{34373,26267},
+    {34108,25833},{33825,25395},{33526,24955},{33210,24513},{32878,24068},{32531,23621},{32170,23172},{31795,22721},
+    {31408,22268},{31009,21815},{30600,21362},{30182,20909},{29756,20457},{29323,20007},{28884,19560},{28440,19116},
+    {27993,18677},{27543,18244},{27091,17818},{26638,17400},{26185,16991},{25732,16592},{25279,16205},{24828,15830},
+    {24379,15469},{23932,15122},{23487,14790},{23045,14474},{22605,14175},{22167,13892},{21733,13627},{21301,13379},
+    {20871,13148},{20443,12935},{20018,12740},{19594,12562},{19173,12400},{18752,12256},{18332,12127},{17913,12014},
+    {17494,11917},{17074,11834},{16654,11766},{16232,11711},{15808,11670},{15380,11642},{14949,11626},{14513,11623},
+    {14070,11630},{13620,11649},{13160,11679},{12689,11720},{12204,11771},{11702,11831},{11177,11902},{10623,11982},
+    {10032,12072},{ 9388,12171},{ 8663,12279},{ 7801,12396},{ 6607,12523},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{35196,40603},{35310,39610},{35414,38823},{35509,38141},{35594,37524},{35670,36952},
+    {35736,36413},{35792,35900},{35838,35406},{35873,34928},{35898,34463},{35912,34009},{35915,33563},{35906,33124},
+    {35886,32691},{35853,32263},{35807,31838},{35749,31416},{35677,30996},{35591,30578},{35490,30160},{35375,29743},
+    {35245,29326},{35099,28909},{34937,28491},{34760,28072},{34566,27651},{34356,27229},{34129,26805},{33886,26380},
+    {33626,25952},{33351,25523},{33059,25092},{32753,24658},{32431,24223},{32096,23787},{31747,23349},{31385,22910},
+    {31012,22470},{30628,22030},{30234,21590},{29831,21151},{29421,20714},{29004,20279},{28580,19847},{28153,19420},
+    {27721,18996},{27286,18579},{26849,18169},{26410,17766},{25970,17372},{25530,16988},{25090,16615},{24651,16253},
+    {24213,15904},{23777,15569},{23342,15247},{22908,14941},{22477,14649},{22048,14374},{21620,14114},{21195,13871},
+    {20771,13644},{20349,13434},{19928,13240},{19509,13063},{19091,12901},{18674,12755},{18257,12625},{17840,12510},
+    {17422,12409},{17004,12323},{16584,12251},{16162,12193},{15737,12147},{15309,12114},{14876,12094},{14437,12085},
+    {13991,12088},{13537,12102},{13072,12127},{12594,12162},{12100,12208},{11587,12264},{11048,12330},{10476,12406},
+    { 9859,12491},{ 9177,12586},{ 8390,12690},{ 7397,12804},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{34788,41220},{34899,39960},{35000,39081},{35091,38348},{35173,37698},{35244,37103},
+    {35306,36548},{35358,36021},{35399,35518},{35431,35032},{35451,34561},{35461,34101},{35459,33651},{35446,33209},
+    {35422,32774},{35385,32344},{35336,31919},{35274,31497},{35199,31077},{35110,30660},{35007,30244},{34890,29829},
+    {34759,29414},{34613,29000},{34452,28586},{34275,28171},{34083,27755},{33876,27338},{33653,26920},{33415,26501},
+    {33161,26080},{32893,25658},{32609,25235},{32312,24810},{32000,24385},{31675,23958},{31338,23530},{30988,23103},
+    {30628,22674},{30257,22247},{29877,21820},{29489,21394},{29093,20971},{28690,20550},{28281,20132},{27868,19719},
+    {27450,19310},{27029,18907},{26606,18511},{26180,18123},{25753,17743},{25326,17372},{24897,17012},{24470,16662},
+    {24042,16325},{23615,16000},{23190,15688},{22765,15391},{22342,15107},{21920,14839},{21499,14585},{21080,14347},
+    {20662,14124},{20245,13917},{19829,13725},{19414,13548},{19000,13387},{18586,13241},{18171,13110},{17756,12993},
+    {17340,12890},{16923,12801},{16503,12726},{16081,12664},{15656,12615},{15226,12578},{14791,12554},{14349,12541},
+    {13899,12539},{13439,12549},{12968,12569},{12482,12601},{11979,12642},{11452,12694},{10897,12756},{10302,12827},
+    { 9652,12909},{ 8919,13000},{ 8040,13101},{ 6780,13212},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{34488,40442},{34586,39401},{34674,38596},{34752,37903},{34820,37280},
+    {34878,36704},{34927,36162},{34964,35646},{34992,35151},{35009,34672},{35015,34207},{35010,33753},{34993,33307},
+    {34965,32869},{34925,32438},{34873,32011},{34808,31588},{34731,31169},{34640,30752},{34536,30338},{34418,29925},
+    {34286,29512},{34140,29101},{33980,28690},{33805,28279},{33616,27867},{33411,27455},{33193,27043},{32959,26630},
+    {32711,26216},{32449,25801},{32174,25385},{31884,24969},{31582,24552},{31267,24135},{30940,23717},{30602,23300},
+    {30254,22883},{29896,22466},{29529,22051},{29153,21638},{28770,21227},{28381,20819},{27986,20414},{27586,20014},
+    {27181,19619},{26773,19230},{26362,18847},{25949,18471},{25534,18104},{25117,17746},{24700,17398},{24283,17060},
+    {23865,16733},{23448,16418},{23031,16116},{22615,15826},{22199,15551},{21784,15289},{21370,15041},{20957,14807},
+    {20545,14589},{20133,14384},{19721,14195},{19310,14020},{18899,13860},{18488,13714},{18075,13582},{17662,13464},
+    {17248,13360},{16831,13269},{16412,13192},{15989,13127},{15562,13075},{15131,13035},{14693,13007},{14247,12990},
+    {13793,12985},{13328,12991},{12849,13008},{12354,13036},{11838,13073},{11296,13122},{10720,13180},{10097,13248},
+    { 9404,13326},{ 8599,13414},{ 7558,13512},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{34075,41268},{34171,39820},{34257,38899},{34332,38147},{34398,37486},
+    {34453,36884},{34498,36323},{34533,35793},{34557,35287},{34571,34800},{34573,34328},{34565,33868},{34546,33418},
+    {34515,32977},{34472,32543},{34418,32115},{34351,31691},{34272,31272},{34180,30856},{34075,30442},{33956,30031},
+    {33825,29621},{33679,29212},{33520,28804},{33347,28396},{33160,27989},{32960,27582},{32745,27174},{32516,26767},
+    {32274,26359},{32019,25951},{31750,25543},{31469,25134},{31175,24726},{30870,24317},{30553,23909},{30226,23501},
+    {29888,23094},{29542,22689},{29186,22285},{28823,21883},{28453,21483},{28076,21087},{27693,20695},{27305,20307},
+    {26913,19924},{26517,19547},{26117,19177},{25715,18814},{25311,18458},{24906,18112},{24499,17774},{24091,17447},
+    {23683,17130},{23274,16825},{22866,16531},{22457,16250},{22049,15981},{21641,15726},{21233,15484},{20826,15255},
+    {20418,15040},{20011,14840},{19604,14653},{19196,14480},{18788,14321},{18379,14175},{17969,14044},{17558,13925},
+    {17144,13820},{16728,13728},{16309,13649},{15885,13582},{15457,13528},{15023,13485},{14582,13454},{14132,13435},
+    {13672,13427},{13200,13429},{12713,13443},{12207,13467},{11677,13502},{11116,13547},{10514,13602},{ 9853,13668},
+    { 9101,13743},{ 8180,13829},{ 6732,13925},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{33756,40431},{33840,39283},{33913,38441},{33976,37729},
+    {34029,37093},{34071,36509},{34104,35962},{34125,35442},{34136,34944},{34137,34464},{34126,33998},{34104,33543},
+    {34071,33098},{34026,32661},{33970,32231},{33902,31806},{33821,31386},{33728,30970},{33623,30557},{33504,30147},
+    {33373,29739},{33229,29332},{33071,28927},{32900,28523},{32716,28120},{32519,27717},{32308,27314},{32085,26912},
+    {31848,26510},{31599,26109},{31337,25707},{31064,25306},{30778,24905},{30482,24505},{30175,24105},{29857,23707},
+    {29530,23310},{29194,22914},{28850,22520},{28498,22129},{28139,21741},{27773,21356},{27402,20975},{27025,20598},
+    {26644,20227},{26259,19861},{25871,19502},{25480,19150},{25086,18806},{24690,18470},{24293,18143},{23895,17825},
+    {23495,17518},{23095,17222},{22694,16936},{22293,16663},{21891,16401},{21490,16152},{21088,15915},{20686,15692},
+    {20283,15481},{19880,15284},{19477,15100},{19073,14929},{18668,14771},{18261,14627},{17853,14496},{17443,14377},
+    {17030,14272},{16614,14179},{16194,14098},{15769,14030},{15339,13974},{14902,13929},{14457,13896},{14002,13874},
+    {13536,13863},{13056,13864},{12558,13875},{12038,13896},{11491,13929},{10907,13971},{10271,14024},{ 9559,14087},
+    { 8717,14160},{ 7569,14244},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{33422,39807},{33494,38805},{33555,38018},
+    {33606,37338},{33646,36723},{33677,36154},{33696,35618},{33705,35107},{33703,34617},{33691,34143},{33667,33683},
+    {33632,33233},{33586,32792},{33528,32360},{33459,31933},{33378,31512},{33284,31096},{33179,30683},{33061,30274},
+    {32930,29867},{32787,29463},{32632,29060},{32463,28659},{32282,28259},{32088,27861},{31882,27463},{31663,27066},
+    {31432,26669},{31189,26274},{30934,25879},{30667,25484},{30390,25091},{30102,24698},{29803,24307},{29495,23917},
+    {29178,23529},{28852,23142},{28518,22758},{28176,22377},{27827,21999},{27473,21624},{27112,21254},{26746,20888},
+    {26376,20527},{26001,20173},{25623,19824},{25242,19482},{24858,19148},{24471,18822},{24083,18505},{23693,18197},
+    {23302,17898},{22909,17610},{22516,17333},{22121,17066},{21726,16811},{21331,16568},{20934,16337},{20537,16118},
+    {20139,15912},{19741,15718},{19341,15537},{18940,15368},{18537,15213},{18133,15070},{17726,14939},{17317,14821},
+    {16904,14716},{16488,14622},{16067,14541},{15640,14472},{15208,14414},{14767,14368},{14317,14333},{13857,14309},
+    {13383,14297},{12893,14295},{12382,14304},{11846,14323},{11277,14354},{10662,14394},{ 9982,14445},{ 9195,14506},
+    { 8193,14578},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{33004,40714},{33074,39283},{33134,38372},
+    {33184,37627},{33223,36971},{33251,36374},{33269,35817},{33276,35292},{33273,34789},{33259,34306},{33234,33838},
+    {33198,33383},{33151,32938},{33092,32502},{33022,32073},{32940,31650},{32847,31233},{32742,30820},{32625,30412},
+    {32495,30006},{32354,29603},{32200,29203},{32034,28805},{31856,28408},{31666,28013},{31464,27620},{31250,27227},
+    {31024,26836},{30787,26446},{30538,26057},{30279,25669},{30009,25283},{29728,24897},{29438,24514},{29139,24132},
+    {28830,23752},{28514,23374},{28189,22999},{27857,22627},{27518,22259},{27173,21894},{26823,21533},{26467,21177},
+    {26106,20827},{25741,20482},{25373,20143},{25001,19811},{24626,19486},{24248,19170},{23868,18861},{23486,18562},
+    {23103,18272},{22717,17991},{22331,17721},{21943,17462},{21554,17213},{21164,16976},{20773,16750},{20380,16536},
+    {19987,16334},{19592,16144},{19195,15966},{18797,15800},{18397,15646},{17994,15505},{17588,15375},{17180,15258},
+    {16767,15153},{16350,15060},{15927,14978},{15498,14908},{15062,14849},{14617,14802},{14162,14766},{13694,14741},
+    {13211,14727},{12708,14724},{12183,14731},{11626,14749},{11029,14777},{10373,14816},{ 9628,14866},{ 8717,14926},
+    { 7286,14996},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{32654,40006},{32713,38824},
+    {32762,37975},{32799,37262},{32827,36627},{32844,36045},{32850,35500},{32845,34983},{32830,34488},{32804,34011},
+    {32767,33549},{32719,33098},{32660,32658},{32590,32226},{32509,31801},{32416,31383},{32311,30970},{32195,30561},
+    {32067,30156},{31927,29755},{31776,29356},{31613,28960},{31438,28567},{31252,28175},{31054,27785},{30844,27397},
+    {30623,27011},{30392,26626},{30149,26243},{29896,25861},{29633,25481},{29360,25102},{29078,24726},{28787,24352},
+    {28487,23979},{28179,23610},{27863,23243},{27540,22880},{27211,22520},{26875,22164},{26534,21813},{26187,21466},
+    {25836,21125},{25480,20789},{25120,20460},{24757,20137},{24390,19821},{24021,19513},{23648,19213},{23274,18922},
+    {22898,18640},{22519,18367},{22139,18104},{21757,17851},{21374,17608},{20989,17377},{20603,17156},{20215,16946},
+    {19825,16748},{19433,16562},{19040,16387},{18644,16224},{18245,16073},{17844,15933},{17439,15805},{17030,15689},
+    {16617,15584},{16199,15491},{15774,15410},{15342,15340},{14902,15281},{14451,15233},{13989,15196},{13512,15170},
+    {13017,15155},{12500,15150},{11955,15156},{11373,15173},{10738,15201},{10025,15238},{ 9176,15287},{ 7994,15346},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{32291,39465},
+    {32339,38413},{32376,37611},{32403,36923},{32419,36306},{32425,35735},{32419,35200},{32404,34691},{32377,34203},
+    {32340,33732},{32292,33275},{32233,32829},{32163,32393},{32081,31966},{31989,31545},{31886,31131},{31771,30722},
+    {31644,30317},{31507,29917},{31358,29520},{31197,29126},{31026,28735},{30843,28346},{30649,27960},{30444,27576},
+    {30229,27194},{30002,26814},{29766,26436},{29519,26059},{29263,25685},{28997,25313},{28722,24944},{28439,24576},
+    {28147,24211},{27847,23850},{27539,23491},{27225,23136},{26904,22784},{26577,22437},{26244,22094},{25906,21756},
+    {25563,21423},{25216,21096},{24864,20775},{24509,20461},{24150,20153},{23789,19853},{23424,19561},{23056,19278},
+    {22687,19003},{22315,18737},{21941,18481},{21564,18234},{21186,17998},{20806,17771},{20424,17556},{20040,17351},
+    {19654,17157},{19265,16974},{18874,16803},{18480,16642},{18083,16493},{17683,16356},{17278,16229},{16869,16114},
+    {16455,16011},{16034,15919},{15607,15837},{15171,15767},{14725,15708},{14268,15660},{13797,15623},{13309,15596},
+    {12800,15581},{12265,15575},{11694,15581},{11077,15597},{10389,15624},{ 9587,15661},{ 8535,15709},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {31915,39012},{31952,38043},{31979,37275},{31995,36608},{32000,36004},{31995,35445},{31979,34918},{31952,34416},
+    {31915,33935},{31867,33469},{31808,33017},{31739,32576},{31658,32144},{31567,31721},{31464,31305},{31351,30895},
+    {31227,30490},{31091,30090},{30945,29694},{30787,29302},{30619,28913},{30440,28527},{30250,28144},{30050,27763},
+    {29839,27385},{29618,27009},{29387,26636},{29146,26265},{28896,25897},{28637,25530},{28369,25167},{28093,24806},
+    {27808,24448},{27516,24094},{27217,23742},{26911,23394},{26598,23051},{26279,22711},{25954,22376},{25624,22046},
+    {25289,21721},{24949,21402},{24606,21089},{24258,20783},{23906,20484},{23552,20192},{23194,19907},{22833,19631},
+    {22470,19363},{22103,19104},{21735,18854},{21364,18613},{20991,18382},{20615,18161},{20237,17950},{19856,17750},
+    {19473,17560},{19087,17381},{18698,17213},{18306,17055},{17910,16909},{17510,16773},{17105,16649},{16695,16536},
+    {16279,16433},{15856,16342},{15424,16261},{14983,16192},{14531,16133},{14065,16085},{13584,16048},{13082,16021},
+    {12555,16005},{11996,16000},{11392,16005},{10725,16021},{ 9957,16048},{ 8988,16085},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {31489,40134},{31527,38620},{31554,37707},{31570,36966},{31575,36315},{31570,35724},{31555,35174},{31528,34654},
+    {31492,34159},{31444,33683},{31386,33223},{31317,32775},{31238,32339},{31147,31912},{31047,31493},{30935,31081},
+    {30813,30676},{30679,30275},{30536,29880},{30381,29488},{30216,29101},{30041,28717},{29855,28337},{29659,27959},
+    {29453,27585},{29237,27213},{29012,26844},{28777,26478},{28533,26115},{28280,25754},{28019,25396},{27749,25042},
+    {27472,24690},{27187,24342},{26895,23997},{26596,23657},{26291,23320},{25979,22988},{25662,22660},{25340,22338},
+    {25012,22021},{24680,21709},{24343,21404},{24003,21105},{23658,20813},{23310,20528},{22958,20251},{22604,19981},
+    {22246,19720},{21885,19467},{21522,19223},{21156,18988},{20787,18763},{20415,18547},{20041,18341},{19663,18145},
+    {19283,17959},{18899,17784},{18512,17619},{18120,17464},{17725,17321},{17324,17187},{16919,17065},{16507,16953},
+    {16088,16853},{15661,16762},{15225,16683},{14777,16614},{14317,16556},{13841,16508},{13346,16472},{12826,16445},
+    {12276,16430},{11685,16425},{11034,16430},{10293,16446},{ 9380,16473},{ 7866,16511},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{31099,39589},{31127,38276},{31144,37403},{31150,36682},{31146,36045},{31131,35464},{31105,34922},
+    {31069,34409},{31022,33920},{30965,33449},{30898,32993},{30819,32551},{30731,32119},{30631,31696},{30522,31282},
+    {30402,30874},{30271,30473},{30130,30077},{29978,29687},{29817,29300},{29645,28918},{29463,28540},{29272,28165},
+    {29070,27794},{28859,27426},{28639,27061},{28410,26699},{28172,26340},{27925,25985},{27670,25632},{27407,25283},
+    {27136,24938},{26858,24596},{26573,24257},{26281,23923},{25982,23593},{25678,23268},{25368,22947},{25053,22632},
+    {24732,22322},{24407,22018},{24077,21719},{23743,21427},{23404,21142},{23062,20864},{22717,20593},{22368,20330},
+    {22015,20075},{21660,19828},{21301,19590},{20939,19361},{20574,19141},{20206,18930},{19835,18728},{19460,18537},
+    {19082,18355},{18700,18183},{18313,18022},{17923,17870},{17527,17729},{17126,17598},{16718,17478},{16304,17369},
+    {15881,17269},{15449,17181},{15007,17102},{14551,17035},{14080,16978},{13591,16931},{13078,16895},{12536,16869},
+    {11955,16854},{11318,16850},{10597,16856},{ 9724,16873},{ 8411,16901},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{30698,39183},{30716,37973},{30723,37128},{30720,36423},{30706,35797},{30681,35224},
+    {30646,34689},{30601,34182},{30545,33698},{30479,33232},{30402,32781},{30315,32343},{30218,31916},{30110,31497},
+    {29993,31087},{29864,30685},{29726,30288},{29578,29897},{29420,29511},{29252,29130},{29074,28754},{28886,28381},
+    {28690,28013},{28483,27647},{28268,27286},{28044,26928},{27812,26574},{27571,26222},{27321,25875},{27064,25531},
+    {26800,25191},{26528,24855},{26250,24522},{25964,24194},{25673,23871},{25375,23552},{25071,23237},{24763,22929},
+    {24448,22625},{24129,22327},{23806,22036},{23478,21750},{23145,21472},{22809,21200},{22469,20936},{22125,20679},
+    {21778,20429},{21426,20188},{21072,19956},{20714,19732},{20353,19517},{19987,19310},{19619,19114},{19246,18926},
+    {18870,18748},{18489,18580},{18103,18422},{17712,18274},{17315,18136},{16913,18007},{16503,17890},{16084,17782},
+    {15657,17685},{15219,17598},{14768,17521},{14302,17455},{13818,17399},{13311,17354},{12776,17319},{12203,17294},
+    {11577,17280},{10872,17277},{10027,17284},{ 8817,17302},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{30285,38860},{30294,37707},{30292,36882},{30280,36189},{30257,35572},
+    {30223,35005},{30179,34476},{30125,33974},{30060,33495},{29986,33033},{29901,32587},{29805,32153},{29700,31730},
+    {29585,31316},{29459,30911},{29324,30513},{29179,30121},{29024,29735},{28860,29354},{28686,28979},{28503,28608},
+    {28310,28241},{28109,27879},{27898,27520},{27679,27166},{27452,26815},{27216,26468},{26973,26125},{26722,25786},
+    {26463,25451},{26197,25120},{25925,24793},{25646,24470},{25360,24152},{25069,23839},{24772,23531},{24469,23228},
+    {24161,22931},{23848,22640},{23530,22354},{23207,22075},{22880,21803},{22549,21537},{22214,21278},{21875,21027},
+    {21532,20784},{21185,20548},{20834,20321},{20480,20102},{20121,19891},{19759,19690},{19392,19497},{19021,19314},
+    {18646,19140},{18265,18976},{17879,18821},{17487,18676},{17089,18541},{16684,18415},{16270,18300},{15847,18195},
+    {15413,18099},{14967,18014},{14505,17940},{14026,17875},{13524,17821},{12995,17777},{12428,17743},{11811,17720},
+    {11118,17708},{10293,17706},{ 9140,17715},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{29861,38603},{29861,37479},{29851,36665},{29829,35980},
+    {29798,35369},{29756,34808},{29704,34283},{29641,33786},{29568,33310},{29485,32853},{29393,32411},{29290,31981},
+    {29177,31563},{29055,31153},{28922,30752},{28781,30359},{28629,29972},{28468,29591},{28298,29216},{28119,28846},
+    {27931,28481},{27734,28121},{27528,27765},{27314,27413},{27092,27065},{26862,26722},{26623,26383},{26378,26048},
+    {26125,25717},{25865,25391},{25598,25069},{25325,24752},{25045,24439},{24759,24132},{24468,23829},{24171,23532},
+    {23868,23241},{23561,22955},{23248,22675},{22931,22402},{22609,22135},{22283,21875},{21952,21622},{21617,21377},
+    {21278,21138},{20935,20908},{20587,20686},{20235,20472},{19879,20266},{19519,20069},{19154,19881},{18784,19702},
+    {18409,19532},{18028,19371},{17641,19219},{17248,19078},{16847,18945},{16437,18823},{16019,18710},{15589,18607},
+    {15147,18515},{14690,18432},{14214,18359},{13717,18296},{13192,18244},{12631,18202},{12020,18171},{11335,18149},
+    {10521,18139},{ 9397,18139},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{29426,38407},{29418,37286},{29399,36477},
+    {29370,35796},{29330,35189},{29280,34632},{29220,34110},{29149,33617},{29069,33146},{28979,32692},{28879,32254},
+    {28769,31828},{28649,31414},{28520,31009},{28382,30613},{28234,30224},{28077,29842},{27910,29466},{27735,29097},
+    {27551,28733},{27358,28374},{27157,28019},{26948,27670},{26730,27325},{26505,26985},{26272,26650},{26032,26318},
+    {25784,25992},{25529,25670},{25268,25352},{25000,25040},{24726,24732},{24446,24430},{24159,24132},{23868,23841},
+    {23570,23554},{23268,23274},{22960,23000},{22648,22732},{22330,22471},{22008,22216},{21682,21968},{21350,21728},
+    {21015,21495},{20675,21270},{20330,21052},{19981,20843},{19626,20642},{19267,20449},{18903,20265},{18534,20090},
+    {18158,19923},{17776,19766},{17387,19618},{16991,19480},{16586,19351},{16172,19231},{15746,19121},{15308,19021},
+    {14854,18931},{14383,18851},{13890,18780},{13368,18720},{12811,18670},{12204,18630},{11523,18601},{10714,18582},
+    { 9593,18574},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{28980,38278},{28964,37133},
+    {28938,36320},{28901,35639},{28853,35034},{28796,34478},{28728,33960},{28650,33470},{28563,33001},{28466,32551},
+    {28359,32117},{28242,31695},{28116,31285},{27981,30884},{27837,30492},{27683,30108},{27521,29731},{27350,29361},
+    {27170,28997},{26981,28639},{26785,28286},{26580,27938},{26367,27596},{26146,27258},{25918,26926},{25683,26598},
+    {25440,26275},{25190,25956},{24934,25643},{24671,25335},{24402,25032},{24127,24734},{23846,24441},{23559,24154},
+    {23266,23873},{22968,23598},{22665,23329},{22357,23066},{22044,22810},{21725,22560},{21402,22317},{21074,22082},
+    {20742,21854},{20404,21633},{20062,21420},{19714,21215},{19361,21019},{19003,20830},{18639,20650},{18269,20479},
+    {17892,20317},{17508,20163},{17116,20019},{16715,19884},{16305,19758},{15883,19641},{15449,19534},{14999,19437},
+    {14530,19350},{14040,19272},{13522,19204},{12966,19147},{12361,19099},{11680,19062},{10867,19036},{ 9722,19020},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{28524,38233},
+    {28500,37021},{28466,36196},{28422,35511},{28368,34904},{28303,34349},{28228,33832},{28144,33344},{28050,32878},
+    {27946,32431},{27833,32000},{27710,31582},{27578,31175},{27437,30779},{27287,30392},{27129,30012},{26962,29641},
+    {26786,29276},{26601,28918},{26409,28565},{26209,28219},{26000,27878},{25784,27542},{25561,27212},{25330,26887},
+    {25092,26567},{24847,26252},{24596,25942},{24337,25638},{24073,25339},{23802,25045},{23526,24757},{23243,24474},
+    {22955,24198},{22661,23927},{22362,23663},{22058,23404},{21748,23153},{21433,22908},{21113,22670},{20788,22439},
+    {20458,22216},{20122,22000},{19781,21791},{19435,21591},{19082,21399},{18724,21214},{18359,21038},{17988,20871},
+    {17608,20713},{17221,20563},{16825,20422},{16418,20290},{16000,20167},{15569,20054},{15122,19950},{14656,19856},
+    {14168,19772},{13651,19697},{13096,19632},{12489,19578},{11804,19534},{10979,19500},{ 9767,19476},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {28056,38328},{28026,36959},{27985,36108},{27934,35413},{27873,34802},{27801,34246},{27720,33729},{27629,33242},
+    {27529,32778},{27419,32333},{27300,31905},{27172,31490},{27034,31087},{26888,30695},{26733,30312},{26570,29938},
+    {26398,29571},{26218,29212},{26030,28859},{25833,28513},{25629,28173},{25418,27838},{25198,27510},{24972,27187},
+    {24739,26869},{24498,26557},{24251,26251},{23997,25949},{23737,25654},{23471,25364},{23199,25080},{22920,24801},
+    {22636,24529},{22346,24263},{22051,24003},{21749,23749},{21443,23502},{21131,23261},{20813,23028},{20490,22802},
+    {20162,22582},{19827,22371},{19487,22167},{19141,21970},{18788,21782},{18429,21602},{18062,21430},{17688,21267},
+    {17305,21112},{16913,20966},{16510,20828},{16095,20700},{15667,20581},{15222,20471},{14758,20371},{14271,20280},
+    {13754,20199},{13198,20127},{12587,20066},{11892,20015},{11041,19974},{ 9672,19944},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{27541,36960},{27493,36063},{27436,35350},{27368,34731},{27290,34170},{27203,33652},
+    {27106,33164},{27000,32701},{26885,32259},{26760,31833},{26626,31421},{26484,31021},{26333,30633},{26173,30254},
+    {26005,29885},{25829,29523},{25645,29169},{25453,28822},{25253,28482},{25046,28148},{24831,27821},{24608,27499},
+    {24379,27183},{24143,26874},{23900,26570},{23650,26271},{23394,25979},{23132,25692},{22863,25411},{22589,25137},
+    {22308,24868},{22021,24606},{21729,24350},{21430,24100},{21126,23857},{20817,23621},{20501,23392},{20179,23169},
+    {19852,22954},{19518,22747},{19178,22547},{18831,22355},{18477,22171},{18115,21995},{17746,21827},{17367,21667},
+    {16979,21516},{16579,21374},{16167,21240},{15741,21115},{15299,21000},{14836,20894},{14348,20797},{13830,20710},
+    {13269,20632},{12650,20564},{11937,20507},{11040,20459},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{27044,37051},{26990,36069},{26927,35327},{26853,34694},{26770,34126},
+    {26677,33603},{26574,33114},{26463,32651},{26342,32209},{26212,31784},{26074,31375},{25926,30979},{25771,30594},
+    {25607,30219},{25434,29854},{25254,29498},{25066,29149},{24870,28808},{24667,28474},{24456,28146},{24238,27825},
+    {24012,27511},{23780,27203},{23541,26901},{23295,26605},{23042,26315},{22784,26031},{22518,25753},{22247,25482},
+    {21969,25216},{21685,24958},{21395,24705},{21099,24459},{20797,24220},{20489,23988},{20175,23762},{19854,23544},
+    {19526,23333},{19192,23130},{18851,22934},{18502,22746},{18146,22566},{17781,22393},{17406,22229},{17021,22074},
+    {16625,21926},{16216,21788},{15791,21658},{15349,21537},{14886,21426},{14397,21323},{13874,21230},{13306,21147},
+    {12673,21073},{11931,21010},{10949,20956},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{26535,37313},{26476,36143},{26406,35352},{26327,34696},
+    {26239,34116},{26140,33586},{26033,33093},{25916,32628},{25790,32186},{25655,31763},{25512,31355},{25360,30961},
+    {25200,30580},{25032,30209},{24855,29848},{24671,29496},{24479,29153},{24279,28817},{24072,28489},{23858,28168},
+    {23636,27854},{23408,27546},{23172,27246},{22929,26951},{22680,26663},{22425,26382},{22162,26107},{21893,25838},
+    {21618,25575},{21337,25320},{21049,25071},{20754,24828},{20454,24592},{20146,24364},{19832,24142},{19511,23928},
+    {19183,23721},{18847,23521},{18504,23329},{18152,23145},{17791,22968},{17420,22800},{17039,22640},{16645,22488},
+    {16237,22345},{15814,22210},{15372,22084},{14907,21967},{14414,21860},{13884,21761},{13304,21673},{12648,21594},
+    {11857,21524},{10687,21465},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{25948,36321},{25874,35439},
+    {25789,34746},{25696,34146},{25592,33605},{25480,33105},{25358,32637},{25228,32193},{25088,31769},{24940,31363},
+    {24784,30971},{24620,30592},{24447,30225},{24267,29868},{24078,29520},{23882,29182},{23679,28852},{23468,28529},
+    {23250,28214},{23024,27907},{22792,27607},{22552,27313},{22306,27026},{22053,26747},{21793,26473},{21527,26207},
+    {21253,25947},{20974,25694},{20687,25448},{20393,25208},{20093,24976},{19786,24750},{19471,24532},{19148,24321},
+    {18818,24118},{18480,23922},{18132,23733},{17775,23553},{17408,23380},{17029,23216},{16637,23060},{16231,22912},
+    {15807,22772},{15363,22642},{14895,22520},{14395,22408},{13854,22304},{13254,22211},{12561,22126},{11679,22052},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{25406,36716},
+    {25327,35617},{25238,34858},{25139,34227},{25031,33667},{24914,33156},{24788,32681},{24652,32233},{24509,31808},
+    {24356,31401},{24196,31010},{24027,30633},{23850,30269},{23666,29915},{23473,29572},{23273,29238},{23065,28913},
+    {22850,28596},{22628,28288},{22398,27987},{22161,27693},{21918,27407},{21667,27128},{21409,26856},{21144,26591},
+    {20872,26333},{20593,26082},{20307,25839},{20013,25602},{19712,25372},{19404,25150},{19087,24935},{18762,24727},
+    {18428,24527},{18085,24334},{17731,24150},{17367,23973},{16990,23804},{16599,23644},{16192,23491},{15767,23348},
+    {15319,23212},{14844,23086},{14333,22969},{13773,22861},{13142,22762},{12383,22673},{11284,22594},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{24763,35955},{24670,35059},{24567,34371},{24455,33782},{24333,33253},{24202,32767},{24063,32312},
+    {23914,31883},{23758,31474},{23593,31083},{23420,30706},{23238,30344},{23049,29993},{22852,29653},{22648,29324},
+    {22435,29004},{22216,28692},{21989,28390},{21754,28095},{21512,27808},{21263,27529},{21006,27258},{20742,26994},
+    {20471,26737},{20192,26488},{19905,26246},{19610,26011},{19308,25784},{18996,25565},{18676,25352},{18347,25148},
+    {18007,24951},{17656,24762},{17294,24580},{16917,24407},{16526,24242},{16117,24086},{15688,23937},{15233,23798},
+    {14747,23667},{14218,23545},{13629,23433},{12941,23330},{12045,23237},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{24084,35412},{23976,34610},{23860,33967},{23734,33409},{23599,32904},
+    {23455,32437},{23302,32000},{23141,31587},{22971,31193},{22793,30816},{22608,30454},{22414,30106},{22212,29769},
+    {22002,29443},{21784,29127},{21559,28821},{21326,28523},{21086,28235},{20837,27955},{20581,27683},{20317,27419},
+    {20045,27163},{19765,26914},{19477,26674},{19179,26441},{18873,26216},{18557,25998},{18231,25788},{17894,25586},
+    {17546,25392},{17184,25207},{16807,25029},{16413,24859},{16000,24698},{15563,24545},{15096,24401},{14591,24266},
+    {14033,24140},{13390,24024},{12588,23916},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{23475,36290},{23363,35014},{23242,34258},{23112,33644},
+    {22973,33107},{22824,32620},{22667,32170},{22501,31748},{22327,31349},{22144,30969},{21953,30606},{21753,30258},
+    {21545,29922},{21330,29599},{21106,29287},{20874,28985},{20634,28693},{20386,28410},{20129,28136},{19864,27871},
+    {19590,27614},{19307,27366},{19015,27126},{18713,26894},{18401,26670},{18078,26455},{17742,26247},{17394,26047},
+    {17031,25856},{16651,25673},{16252,25499},{15830,25333},{15380,25176},{14893,25027},{14356,24888},{13742,24758},
+    {12986,24637},{11710,24525},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{22722,36082},{22597,34750},
+    {22463,34006},{22319,33406},{22166,32881},{22003,32407},{21832,31970},{21652,31561},{21463,31174},{21266,30807},
+    {21060,30457},{20845,30122},{20622,29800},{20390,29490},{20150,29192},{19900,28904},{19642,28626},{19374,28358},
+    {19096,28100},{18808,27850},{18510,27610},{18200,27378},{17878,27155},{17543,26940},{17193,26734},{16826,26537},
+    {16439,26348},{16030,26168},{15593,25997},{15119,25834},{14594,25681},{13994,25537},{13250,25403},{11918,25278},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{21777,34649},{21628,33871},{21469,33265},{21301,32744},{21124,32276},{20938,31847},{20742,31448},
+    {20537,31072},{20322,30716},{20099,30378},{19866,30055},{19623,29746},{19371,29450},{19108,29165},{18835,28892},
+    {18550,28629},{18254,28377},{17945,28134},{17622,27901},{17284,27678},{16928,27463},{16552,27258},{16153,27062},
+    {15724,26876},{15256,26699},{14735,26531},{14129,26372},{13351,26223},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{20887,34868},{20722,33901},{20547,33252},{20363,32717},{20168,32246},
+    {19962,31818},{19747,31424},{19521,31056},{19285,30709},{19038,30382},{18780,30070},{18509,29774},{18226,29491},
+    {17930,29220},{17618,28962},{17291,28715},{16944,28479},{16576,28253},{16182,28038},{15754,27832},{15283,27637},
+    {14748,27453},{14099,27278},{13132,27113},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{19716,34306},{19521,33451},
+    {19314,32853},{19096,32355},{18865,31917},{18622,31519},{18366,31152},{18096,30811},{17810,30491},{17509,30190},
+    {17189,29904},{16848,29634},{16481,29378},{16083,29135},{15645,28904},{15147,28686},{14549,28479},{13694,28284},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{18077,33349},{17819,32719},{17543,32224},{17247,31798},{16928,31418},{16582,31072},
+    {16202,30753},{15776,30457},{15281,30181},{14651,29923},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{15466,33257},{14743,32534},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+    {0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},{0xFFFF,0xFFFF},
+};
+
+#endif // IK_TABLE_H
@@ -0,0 +1,174 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Five-bar leg geometry in mm. (0, 0) sits on the front servo axis, the rear
+// servo is REAR_OFFSET along +x and y grows towards the ground.
+#define UPPER_LEG_LEN           40
+#define LOWER_LEG_LEN           24
+#define REAR_OFFSET             21
+#define SERVO_HORN_OFFSET       135   // IK angle where the servo horn is centered
+
+// Please consult the datasheet of your servo before changing the following parameters
+#define SERVO_MIN_PULSEWIDTH_US 500   // Minimum pulse width in microsecond
+#define SERVO_MAX_PULSEWIDTH_US 2500  // Maximum pulse width in microsecond
+#define SERVO_MIN_DEGREE        -90   // Minimum angle
+#define SERVO_MAX_DEGREE        90    // Maximum angle
+
+// Compare ticks are 1us at the 1MHz servo timebase. The mapping is symmetric
+// around the center pulse, so a mirrored servo is simply SERVO_MIRROR_TICKS - ticks.
+#define SERVO_CENTER_TICKS      ((SERVO_MIN_PULSEWIDTH_US + SERVO_MAX_PULSEWIDTH_US) / 2)
+#define SERVO_MIRROR_TICKS      (SERVO_MIN_PULSEWIDTH_US + SERVO_MAX_PULSEWIDTH_US)
+
+// Reference double precision solver. Gives the raw IK angles (degrees, before
+// the horn offset) of the front and rear servo for a foot target at (x, y).
+// Returns -1 when the target is outside the linkage triangle.
+static inline int ik_solve_deg(double x, double y, double *front_deg, double *rear_deg)
+{
+    double hypo1 = sqrt(x * x + y * y);
+    double hypo2 = sqrt((x - REAR_OFFSET) * (x - REAR_OFFSET) + y * y);
+    if (hypo1 == 0 || hypo2 == 0) {
+        return -1;
+    }
+
+    const double k = (double)UPPER_LEG_LEN * UPPER_LEG_LEN - (double)LOWER_LEG_LEN * LOWER_LEG_LEN;
+    double c1 = (k - hypo1 * hypo1) / (-2 * LOWER_LEG_LEN * hypo1);
+    double c2 = (k - hypo2 * hypo2) / (-2 * LOWER_LEG_LEN * hypo2);
+    if (c1 < -1 || c1 > 1 || c2 < -1 || c2 > 1) {
+        return -1;
+    }
+
+    *front_deg = (acos(x / hypo1) + acos(c1)) * 180 / M_PI;
+    *rear_deg = (acos((REAR_OFFSET - x) / hypo2) + acos(c2)) * 180 / M_PI;
+    return 0;
+}
+
+// Reference forward solve, the inverse of ik_solve_deg(): foot position for
+// raw IK angles. Of the two points where the upper links can meet, the foot
+// is the one further from the servos (larger y). Returns -1 when the knees
+// are too far apart for the upper links.
+static inline int fk_solve_deg(double front_deg, double rear_deg, double *x, double *y)
+{
+    double a1 = front_deg * M_PI / 180, a2 = rear_deg * M_PI / 180;
+    double kx1 = LOWER_LEG_LEN * cos(a1), ky1 = LOWER_LEG_LEN * sin(a1);
+    double kx2 = REAR_OFFSET - LOWER_LEG_LEN * cos(a2), ky2 = LOWER_LEG_LEN * sin(a2);
+    double dx = kx2 - kx1, dy = ky2 - ky1;
+    double d2 = dx * dx + dy * dy;
+    double h2 = (double)UPPER_LEG_LEN * UPPER_LEG_LEN - d2 / 4;
+    if (d2 == 0 || h2 < 0) {
+        return -1;
+    }
+    // Both upper links are the same length, the foot sits on the knees' bisector
+    double s = sqrt(h2 / d2);
+    double mx = (kx1 + kx2) / 2, my = (ky1 + ky2) / 2;
+    double fx = mx - dy * s, fy = my + dx * s;
+    double gx = mx + dy * s, gy = my - dx * s;
+    *x = fy >= gy ? fx : gx;
+    *y = fy >= gy ? fy : gy;
+    return 0;
+}
+
+// Single precision version of ik_solve_deg(), the ESP32 FPU only does float
+static inline int ik_solve_degf(float x, float y, float *front_deg, float *rear_deg)
+{
+    float hypo1 = sqrtf(x * x + y * y);
+    float hypo2 = sqrtf((x - REAR_OFFSET) * (x - REAR_OFFSET) + y * y);
+    if (hypo1 == 0 || hypo2 == 0) {
+        return -1;
+    }
+
+    const float k = (float)UPPER_LEG_LEN * UPPER_LEG_LEN - (float)LOWER_LEG_LEN * LOWER_LEG_LEN;
+    float c1 = (k - hypo1 * hypo1) / (-2 * LOWER_LEG_LEN * hypo1);
+    float c2 = (k - hypo2 * hypo2) / (-2 * LOWER_LEG_LEN * hypo2);
+    if (c1 < -1 || c1 > 1 || c2 < -1 || c2 > 1) {
+        return -1;
+    }
+
+    *front_deg = (acosf(x / hypo1) + acosf(c1)) * (180 / (float)M_PI);
+    *rear_deg = (acosf((REAR_OFFSET - x) / hypo2) + acosf(c2)) * (180 / (float)M_PI);
+    return 0;
+}
+
+// Single precision version of fk_solve_deg()
+static inline int fk_solve_degf(float front_deg, float rear_deg, float *x, float *y)
+{
+    float a1 = front_deg * ((float)M_PI / 180), a2 = rear_deg * ((float)M_PI / 180);
+    float kx1 = LOWER_LEG_LEN * cosf(a1), ky1 = LOWER_LEG_LEN * sinf(a1);
+    float kx2 = REAR_OFFSET - LOWER_LEG_LEN * cosf(a2), ky2 = LOWER_LEG_LEN * sinf(a2);
+    float dx = kx2 - kx1, dy = ky2 - ky1;
+    float d2 = dx * dx + dy * dy;
+    float h2 = (float)UPPER_LEG_LEN * UPPER_LEG_LEN - d2 / 4;
+    if (d2 == 0 || h2 < 0) {
+        return -1;
+    }
+    float s = sqrtf(h2 / d2);
+    float mx = (kx1 + kx2) / 2, my = (ky1 + ky2) / 2;
+    float fx = mx - dy * s, fy = my + dx * s;
+    float gx = mx + dy * s, gy = my - dx * s;
+    *x = fy >= gy ? fx : gx;
+    *y = fy >= gy ? fy : gy;
+    return 0;
+}
+
+// Servo angle (degrees, horn offset already applied) to compare ticks
+static inline double servo_deg_to_ticks(double angle)
+{
+    return (angle - SERVO_MIN_DEGREE) * (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) /
+           (SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) + SERVO_MIN_PULSEWIDTH_US;
+}
+
+// Left leg compare ticks for raw IK angles. The right leg is mirrored.
+static inline void ik_deg_to_ticks(double front_deg, double rear_deg, double *front_ticks, double *rear_ticks)
+{
+    *front_ticks = servo_deg_to_ticks(front_deg - SERVO_HORN_OFFSET);
+    *rear_ticks = servo_deg_to_ticks(SERVO_HORN_OFFSET - rear_deg);
+}
+
+// Inverse of ik_deg_to_ticks(), left leg compare ticks to raw IK angles
+static inline void ik_ticks_to_deg(double front_ticks, double rear_ticks, double *front_deg, double *rear_deg)
+{
+    const double deg_per_tick = (double)(SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) /
+                                (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US);
+    *front_deg = (front_ticks - SERVO_MIN_PULSEWIDTH_US) * deg_per_tick + SERVO_MIN_DEGREE + SERVO_HORN_OFFSET;
+    *rear_deg = SERVO_HORN_OFFSET - ((rear_ticks - SERVO_MIN_PULSEWIDTH_US) * deg_per_tick + SERVO_MIN_DEGREE);
+}
+
+// Full solve to left leg compare ticks, same contract as ik_lookup_ticks().
+// Returns -1 if unreachable or outside the servo pulse range.
+static inline int ik_solve_ticks(double x, double y, uint16_t *front_ticks, uint16_t *rear_ticks)
+{
+    double front_deg, rear_deg, front, rear;
+    if (ik_solve_deg(x, y, &front_deg, &rear_deg) != 0) {
+        return -1;
+    }
+    ik_deg_to_ticks(front_deg, rear_deg, &front, &rear);
+    if (front < SERVO_MIN_PULSEWIDTH_US || front > SERVO_MAX_PULSEWIDTH_US ||
+        rear < SERVO_MIN_PULSEWIDTH_US || rear > SERVO_MAX_PULSEWIDTH_US) {
+        return -1;
+    }
+    *front_ticks = (uint16_t)(front + 0.5);
+    *rear_ticks = (uint16_t)(rear + 0.5);
+    return 0;
+}
+
+static inline int ik_solve_ticksf(float x, float y, uint16_t *front_ticks, uint16_t *rear_ticks)
+{
+    const float scale = (float)(SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / (SERVO_MAX_DEGREE - SERVO_MIN_DEGREE);
+    float front_deg, rear_deg;
+    if (ik_solve_degf(x, y, &front_deg, &rear_deg) != 0) {
+        return -1;
+    }
+    float front = (front_deg - SERVO_HORN_OFFSET) * scale + SERVO_CENTER_TICKS;
+    float rear = (SERVO_HORN_OFFSET - rear_deg) * scale + SERVO_CENTER_TICKS;
+    if (front < SERVO_MIN_PULSEWIDTH_US || front > SERVO_MAX_PULSEWIDTH_US ||
+        rear < SERVO_MIN_PULSEWIDTH_US || rear > SERVO_MAX_PULSEWIDTH_US) {
+        return -1;
+    }
+    *front_ticks = (uint16_t)(front + 0.5f);
+    *rear_ticks = (uint16_t)(rear + 0.5f);
+    return 0;
+}
+
+#endif // KINEMATICS_H
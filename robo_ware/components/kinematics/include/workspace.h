@@ -0,0 +1,107 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <math.h>
+#include <stdint.h>
+#include "ik_lut.h"
+#include "workspace_table.h"
+
+// Distance a target has to keep from the edge, Q4 mm. Covers the error of
+// interpolating the distance table between grid points, host/workspace_check
+// verifies that every target it passes is one ik_lookup_ticks() accepts.
+#define WORKSPACE_MARGIN_Q4     8
+
+// Tries of workspace_project_q4() before giving up
+#define WORKSPACE_PROJECT_STEPS 4
+
+#define WORKSPACE_X_MAX_Q4      ((IK_TABLE_X_MIN + ((IK_TABLE_COLS - 1) << IK_TABLE_STEP_SHIFT)) * (1 << IK_FRAC_BITS))
+#define WORKSPACE_Y_MAX_Q4      ((IK_TABLE_Y_MIN + ((IK_TABLE_ROWS - 1) << IK_TABLE_STEP_SHIFT)) * (1 << IK_FRAC_BITS))
+
+// Signed distance of a Q4 mm foot target to the edge of the reachable
+// workspace, Q4 mm, positive inside. Bilinear between table points; off the
+// table it is the edge value less the way to the edge, which errs outwards.
+// Optionally the gradient, Q4 mm per grid step.
+static inline int32_t workspace_distance_q4(int32_t x_q4, int32_t y_q4, int32_t *grad_x, int32_t *grad_y)
+{
+    int32_t gx = x_q4 - IK_TABLE_X_MIN * (1 << IK_FRAC_BITS);
+    int32_t gy = y_q4 - IK_TABLE_Y_MIN * (1 << IK_FRAC_BITS);
+    const int32_t gx_max = (IK_TABLE_COLS - 1) * IK_GRID_ONE;
+    const int32_t gy_max = (IK_TABLE_ROWS - 1) * IK_GRID_ONE;
+    int32_t off = 0;
+    if (gx < 0 || gx > gx_max) {
+        off += gx < 0 ? -gx : gx - gx_max;
+        gx = gx < 0 ? 0 : gx_max;
+    }
+    if (gy < 0 || gy > gy_max) {
+        off += gy < 0 ? -gy : gy - gy_max;
+        gy = gy < 0 ? 0 : gy_max;
+    }
+
+    // The last row and column are the far corner of the cell before them
+    int32_t col = gx >> IK_GRID_FRAC_BITS;
+    int32_t row = gy >> IK_GRID_FRAC_BITS;
+    col -= col == IK_TABLE_COLS - 1;
+    row -= row == IK_TABLE_ROWS - 1;
+    int32_t fx = gx - col * IK_GRID_ONE;
+    int32_t fy = gy - row * IK_GRID_ONE;
+
+    const int16_t *d = &workspace_table[row * IK_TABLE_COLS + col];
+    int32_t d00 = d[0], d01 = d[1], d10 = d[IK_TABLE_COLS], d11 = d[IK_TABLE_COLS + 1];
+    if (grad_x != NULL) {
+        *grad_x = ((d01 - d00) * (IK_GRID_ONE - fy) + (d11 - d10) * fy) >> IK_GRID_FRAC_BITS;
+        *grad_y = ((d10 - d00) * (IK_GRID_ONE - fx) + (d11 - d01) * fx) >> IK_GRID_FRAC_BITS;
+    }
+    const int32_t round = 1 << (2 * IK_GRID_FRAC_BITS - 1);
+    int32_t top = d00 * (IK_GRID_ONE - fx) + d01 * fx;
+    int32_t bot = d10 * (IK_GRID_ONE - fx) + d11 * fx;
+    return ((top * (IK_GRID_ONE - fy) + bot * fy + round) >> (2 * IK_GRID_FRAC_BITS)) - off;
+}
+
+// O(1) feasibility of a foot target, a table read and a bilinear blend
+static inline bool workspace_reachable(int32_t x_q4, int32_t y_q4)
+{
+    return workspace_distance_q4(x_q4, y_q4, NULL, NULL) >= WORKSPACE_MARGIN_Q4;
+}
+
+// Moves an unreachable target to the closest reachable point, stepping down
+// the distance field along its gradient. Returns 0 if the target was
+// reachable already, 1 if it was moved and -1 if no reachable point was
+// found (the target is then left as it was).
+static inline int workspace_project_q4(int32_t *x_q4, int32_t *y_q4)
+{
+    int32_t x = *x_q4, y = *y_q4;
+    // Far off targets first come back to the table, where the field has a gradient
+    x = x < IK_TABLE_X_MIN * (1 << IK_FRAC_BITS) ? IK_TABLE_X_MIN * (1 << IK_FRAC_BITS) : x;
+    x = x > WORKSPACE_X_MAX_Q4 ? WORKSPACE_X_MAX_Q4 : x;
+    y = y < IK_TABLE_Y_MIN * (1 << IK_FRAC_BITS) ? IK_TABLE_Y_MIN * (1 << IK_FRAC_BITS) : y;
+    y = y > WORKSPACE_Y_MAX_Q4 ? WORKSPACE_Y_MAX_Q4 : y;
+    if (x == *x_q4 && y == *y_q4 && workspace_reachable(x, y)) {
+        return 0;
+    }
+
+    for (int i = 0; i < WORKSPACE_PROJECT_STEPS; i++) {
+        int32_t grad_x, grad_y;
+        int32_t dist = workspace_distance_q4(x, y, &grad_x, &grad_y);
+        if (dist >= WORKSPACE_MARGIN_Q4) {
+            *x_q4 = x;
+            *y_q4 = y;
+            return 1;
+        }
+        float len = sqrtf((float)(grad_x * grad_x + grad_y * grad_y));
+        if (len == 0) {
+            break;
+        }
+        // A quarter mm past the margin so rounding can't leave it on the edge
+        float step = (float)(WORKSPACE_MARGIN_Q4 + (1 << IK_FRAC_BITS) / 4 - dist) / len;
+        x += (int32_t)lrintf(grad_x * step);
+        y += (int32_t)lrintf(grad_y * step);
+    }
+    if (workspace_reachable(x, y)) {
+        *x_q4 = x;
+        *y_q4 = y;
+        return 1;
+    }
+    return -1;
+}
+
+#endif // WORKSPACE_H
@@ -0,0 +1,437 @@
+// Generated by tools/gen_ik_table.py, do not edit by hand.
+#ifndef WORKSPACE_TABLE_H
+#define WORKSPACE_TABLE_H
+
+#include <stdint.h>
+#include "ik_table.h"
+
+static_assert(IK_TABLE_X_MIN == -36 && IK_TABLE_Y_MIN == 12 && IK_TABLE_STEP_SHIFT == 0 &&
+              IK_TABLE_COLS == 95 && IK_TABLE_ROWS == 53,
+              "workspace_table.h is stale, rerun tools/gen_ik_table.py");
+
+// Signed distance (Q4 mm, positive inside) of every ik_table grid point to
+// the edge of the targets ik_lookup_ticks() accepts
+static const int16_t workspace_table[IK_TABLE_ROWS * IK_TABLE_COLS] = {
+      -104,  -104,  -107,  -111,  -118,  -125,  -132,  -138,  -144,  -149,  -154,  -159,
+      -163,  -166,  -170,  -172,  -174,  -176,  -176,  -177,  -176,  -176,  -174,  -172,
+      -170,  -167,  -164,  -159,  -155,  -151,  -145,  -139,  -132,  -125,  -119,  -111,
+      -104,   -95,   -88,   -78,   -70,   -60,   -51,   -40,   -33,   -23,   -16,   -16,
+       -23,   -33,   -40,   -51,   -60,   -70,   -78,   -88,   -95,  -104,  -111,  -119,
+      -125,  -132,  -139,  -145,  -151,  -155,  -159,  -163,  -167,  -170,  -172,  -174,
+      -176,  -176,  -177,  -176,  -176,  -174,  -172,  -170,  -166,  -163,  -159,  -154,
+      -149,  -144,  -138,  -132,  -125,  -118,  -111,  -107,  -104,  -104,  -106,   -88,
+       -88,   -91,   -97,  -104,  -111,  -118,  -123,  -129,  -134,  -139,  -144,  -148,
+      -151,  -154,  -156,  -158,  -160,  -160,  -161,  -160,  -160,  -158,  -156,  -154,
+      -151,  -148,  -144,  -140,  -135,  -130,  -124,  -118,  -111,  -104,   -98,   -89,
+       -82,   -73,   -65,   -56,   -48,   -38,   -28,   -18,   -16,     4,     4,   -16,
+       -18,   -28,   -38,   -48,   -56,   -65,   -73,   -82,   -89,   -98,  -104,  -111,
+      -118,  -124,  -130,  -135,  -140,  -144,  -148,  -151,  -154,  -156,  -158,  -160,
+      -160,  -161,  -160,  -160,  -158,  -156,  -154,  -151,  -148,  -144,  -139,  -134,
+      -129,  -123,  -118,  -111,  -104,   -97,   -91,   -88,   -88,   -90,   -72,   -72,
+       -76,   -82,   -89,   -97,  -103,  -109,  -114,  -119,  -124,  -128,  -132,  -135,
+      -138,  -141,  -143,  -144,  -144,  -145,  -144,  -144,  -143,  -141,  -138,  -136,
+      -133,  -129,  -124,  -120,  -115,  -109,  -104,   -97,   -89,   -84,   -75,   -68,
+       -60,   -52,   -43,   -34,   -26,   -16,    -6,     4,     6,     6,     4,    -6,
+       -16,   -26,   -34,   -43,   -52,   -60,   -68,   -75,   -84,   -89,   -97,  -104,
+      -109,  -115,  -120,  -124,  -129,  -132,  -136,  -138,  -141,  -143,  -144,  -144,
+      -145,  -144,  -144,  -143,  -141,  -138,  -135,  -132,  -128,  -124,  -119,  -114,
+      -109,  -103,   -97,   -89,   -82,   -76,   -72,   -72,   -75,   -56,   -57,   -61,
+       -68,   -75,   -82,   -88,   -94,   -99,  -104,  -109,  -113,  -116,  -119,  -122,
+      -125,  -127,  -128,  -128,  -130,  -128,  -128,  -127,  -125,  -122,  -120,  -117,
+      -114,  -109,  -105,  -100,   -95,   -89,   -82,   -75,   -68,   -62,   -54,   -47,
+       -38,   -30,   -20,   -13,    -4,     6,    20,    20,    20,    20,     6,    -4,
+       -13,   -20,   -30,   -38,   -47,   -54,   -62,   -68,   -75,   -82,   -89,   -95,
+      -100,  -105,  -109,  -113,  -116,  -120,  -122,  -125,  -127,  -128,  -128,  -130,
+      -128,  -128,  -127,  -125,  -122,  -119,  -116,  -113,  -109,  -104,   -99,   -94,
+       -88,   -82,   -75,   -68,   -61,   -57,   -56,   -59,   -40,   -41,   -47,   -54,
+       -61,   -67,   -73,   -79,   -84,   -89,   -93,   -97,  -101,  -104,  -107,  -109,
+      -112,  -112,  -112,  -114,  -112,  -112,  -112,  -109,  -107,  -104,  -101,   -98,
+       -94,   -89,   -85,   -80,   -74,   -68,   -61,   -54,   -48,   -40,   -32,   -25,
+       -16,    -9,     4,    11,    20,    28,    36,    36,    28,    20,    11,     4,
+        -9,   -16,   -25,   -32,   -40,   -48,   -54,   -61,   -68,   -74,   -80,   -85,
+       -89,   -94,   -97,  -101,  -104,  -107,  -109,  -112,  -112,  -112,  -114,  -112,
+      -112,  -112,  -109,  -107,  -104,  -101,   -97,   -93,   -89,   -84,   -79,   -73,
+       -67,   -61,   -54,   -47,   -41,   -40,   -45,   -24,   -25,   -32,   -39,   -47,
+       -52,   -58,   -63,   -68,   -74,   -78,   -82,   -85,   -88,   -91,   -93,   -96,
+       -96,   -96,   -98,   -96,   -96,   -96,   -93,   -91,   -88,   -86,   -82,   -79,
+       -74,   -70,   -65,   -59,   -53,   -47,   -40,   -33,   -27,   -18,   -11,    -4,
+         8,    17,    25,    34,    41,    51,    51,    41,    34,    25,    17,     8,
+        -4,   -11,   -18,   -27,   -33,   -40,   -47,   -53,   -59,   -65,   -70,   -74,
+       -79,   -82,   -86,   -88,   -91,   -93,   -96,   -96,   -96,   -98,   -96,   -96,
+       -96,   -93,   -91,   -88,   -85,   -82,   -78,   -74,   -68,   -63,   -58,   -52,
+       -47,   -39,   -32,   -25,   -24,   -31,    -9,   -11,   -18,   -25,   -32,   -38,
+       -43,   -48,   -53,   -58,   -62,   -66,   -69,   -72,   -76,   -77,   -80,   -80,
+       -80,   -82,   -80,   -80,   -80,   -77,   -76,   -72,   -70,   -67,   -63,   -58,
+       -54,   -49,   -45,   -38,   -32,   -25,   -18,   -13,    -6,     6,    13,    22,
+        29,    39,    47,    56,    63,    63,    56,    47,    39,    29,    22,    13,
+         6,    -6,   -13,   -18,   -25,   -32,   -38,   -45,   -49,   -54,   -58,   -63,
+       -66,   -70,   -72,   -76,   -77,   -80,   -80,   -80,   -82,   -80,   -80,   -80,
+       -77,   -76,   -72,   -69,   -66,   -62,   -58,   -53,   -48,   -43,   -38,   -32,
+       -25,   -18,   -11,    -9,   -22,    -4,     6,    -4,   -11,   -16,   -23,   -28,
+       -33,   -38,   -43,   -47,   -51,   -53,   -57,   -60,   -61,   -64,   -64,   -64,
+       -67,   -64,   -64,   -64,   -61,   -60,   -57,   -54,   -52,   -48,   -43,   -39,
+       -34,   -29,   -23,   -18,   -11,    -6,     4,    11,    20,    27,    34,    43,
+        51,    61,    69,    77,    77,    69,    61,    51,    43,    34,    27,    20,
+        11,     4,    -6,   -11,   -18,   -23,   -29,   -34,   -39,   -43,   -48,   -51,
+       -54,   -57,   -60,   -61,   -64,   -64,   -64,   -67,   -64,   -64,   -64,   -61,
+       -60,   -57,   -53,   -51,   -47,   -43,   -38,   -33,   -28,   -23,   -16,   -11,
+        -4,     6,    -4,   -20,    -4,    16,    13,     6,    -4,    -8,   -13,   -18,
+       -23,   -28,   -32,   -36,   -38,   -41,   -44,   -46,   -48,   -48,   -48,   -52,
+       -48,   -48,   -48,   -46,   -44,   -41,   -39,   -36,   -32,   -28,   -24,   -20,
+       -14,    -9,    -4,     6,    12,    20,    25,    32,    41,    48,    57,    64,
+        74,    82,    91,    91,    82,    74,    64,    57,    48,    41,    32,    25,
+        20,    12,     6,    -4,    -9,   -14,   -20,   -24,   -28,   -32,   -36,   -39,
+       -41,   -44,   -46,   -48,   -48,   -48,   -52,   -48,   -48,   -48,   -46,   -44,
+       -41,   -38,   -36,   -32,   -28,   -23,   -18,   -13,    -8,    -4,     6,    13,
+        16,    -4,   -20,    -4,    13,    27,    20,    14,     9,     4,    -4,    -8,
+       -12,   -16,   -20,   -23,   -25,   -28,   -30,   -32,   -32,   -32,   -36,   -32,
+       -32,   -32,   -30,   -28,   -25,   -24,   -20,   -16,   -13,    -8,    -4,     4,
+         8,    14,    20,    27,    32,    39,    47,    54,    63,    70,    79,    87,
+        96,   104,   104,    96,    87,    79,    70,    63,    54,    47,    39,    32,
+        27,    20,    14,     8,     4,    -4,    -8,   -13,   -16,   -20,   -24,   -25,
+       -28,   -30,   -32,   -32,   -32,   -36,   -32,   -32,   -32,   -30,   -28,   -25,
+       -23,   -20,   -16,   -12,    -8,    -4,     4,     9,    14,    20,    27,    13,
+        -4,   -20,    -8,    12,    28,    36,    29,    24,    20,    14,     9,     6,
+         4,    -4,    -8,   -11,   -12,   -16,   -16,   -16,   -16,   -20,   -16,   -16,
+       -16,   -16,   -12,   -11,    -8,    -4,    -4,     4,     9,    13,    18,    23,
+        29,    34,    41,    47,    54,    61,    68,    77,    84,    92,   100,   109,
+       118,   118,   109,   100,    92,    84,    77,    68,    61,    54,    47,    41,
+        34,    29,    23,    18,    13,     9,     4,     4,    -4,    -8,   -11,   -12,
+       -16,   -16,   -16,   -16,   -20,   -16,   -16,   -16,   -16,   -12,   -11,    -8,
+        -4,     4,     6,     9,    14,    20,    24,    29,    36,    28,    12,    -8,
+       -24,    -8,     9,    24,    40,    45,    39,    34,    29,    24,    20,    16,
+        14,    12,     8,     8,     4,     4,     4,    -4,    -4,    -4,     4,     4,
+         4,     8,     8,    12,    13,    16,    20,    24,    28,    33,    38,    43,
+        49,    56,    62,    68,    75,    82,    90,    98,   106,   114,   122,   131,
+       131,   122,   114,   106,    98,    90,    82,    75,    68,    62,    56,    49,
+        43,    38,    33,    28,    24,    20,    16,    13,    12,     8,     8,     4,
+         4,     4,    -4,    -4,    -4,     4,     4,     4,     8,     8,    12,    14,
+        16,    20,    24,    29,    34,    39,    45,    40,    24,     9,    -8,   -24,
+       -12,     8,    22,    37,    53,    54,    49,    45,    40,    36,    32,    29,
+        27,    24,    22,    20,    20,    20,    16,    16,    16,    20,    20,    20,
+        22,    24,    27,    28,    32,    36,    39,    44,    48,    53,    58,    64,
+        70,    77,    82,    90,    97,   104,   112,   120,   128,   136,   144,   144,
+       136,   128,   120,   112,   104,    97,    90,    82,    77,    70,    64,    58,
+        53,    48,    44,    39,    36,    32,    28,    27,    24,    22,    20,    20,
+        20,    16,    16,    16,    20,    20,    20,    22,    24,    27,    29,    32,
+        36,    40,    45,    49,    54,    53,    37,    22,     8,   -12,   -28,   -16,
+         4,    20,    36,    51,    66,    65,    59,    56,    52,    48,    45,    42,
+        40,    37,    36,    36,    36,    32,    32,    32,    36,    36,    36,    37,
+        40,    42,    44,    48,    51,    54,    59,    63,    68,    74,    79,    85,
+        91,    97,   104,   111,   118,   126,   134,   141,   150,   158,   158,   150,
+       141,   134,   126,   118,   111,   104,    97,    91,    85,    79,    74,    68,
+        63,    59,    54,    52,    48,    44,    42,    40,    37,    36,    36,    36,
+        32,    32,    32,    36,    36,    36,    37,    40,    42,    45,    48,    52,
+        56,    59,    65,    66,    51,    36,    20,     4,   -16,   -30,   -16,    -4,
+        16,    30,    46,    61,    77,    75,    71,    67,    64,    61,    57,    56,
+        53,    52,    52,    51,    48,    48,    48,    51,    52,    52,    53,    56,
+        57,    60,    63,    66,    70,    75,    79,    84,    89,    94,   100,   106,
+       113,   118,   126,   132,   140,   148,   156,   163,   172,   172,   163,   156,
+       148,   140,   132,   126,   118,   113,   106,   100,    94,    89,    84,    79,
+        75,    70,    67,    63,    60,    57,    56,    53,    52,    52,    51,    48,
+        48,    48,    51,    52,    52,    53,    56,    57,    61,    64,    67,    71,
+        75,    77,    61,    46,    30,    16,    -4,   -16,   -32,   -22,    -8,    12,
+        27,    42,    57,    72,    87,    86,    82,    80,    76,    73,    72,    68,
+        68,    68,    66,    64,    64,    64,    66,    68,    68,    68,    72,    73,
+        76,    79,    82,    86,    90,    94,    99,   104,   109,   115,   120,   127,
+       133,   140,   147,   154,   161,   170,   177,   185,   185,   177,   170,   161,
+       154,   147,   140,   133,   127,   120,   115,   109,   104,    99,    94,    90,
+        86,    82,    79,    76,    73,    72,    68,    68,    68,    66,    64,    64,
+        64,    66,    68,    68,    68,    72,    73,    76,    80,    82,    86,    87,
+        72,    57,    42,    27,    12,    -8,   -22,   -37,   -25,   -11,     8,    22,
+        37,    53,    68,    84,    98,    98,    95,    92,    89,    87,    84,    84,
+        84,    82,    80,    80,    80,    82,    84,    84,    84,    87,    89,    92,
+        94,    97,   101,   105,   110,   114,   119,   124,   129,   135,   141,   148,
+       154,   161,   168,   175,   183,   191,   199,   199,   191,   183,   175,   168,
+       161,   154,   148,   141,   135,   129,   124,   119,   114,   110,   105,   101,
+        98,    94,    92,    89,    87,    84,    84,    84,    82,    80,    80,    80,
+        82,    84,    84,    84,    87,    89,    92,    95,    98,    98,    84,    68,
+        53,    37,    22,     8,   -11,   -25,   -41,   -30,   -16,     4,    18,    33,
+        48,    63,    77,    92,   108,   111,   108,   105,   103,   100,   100,   100,
+        97,    96,    96,    96,    97,   100,   100,   100,   103,   105,   108,   110,
+       113,   116,   120,   125,   129,   134,   139,   144,   150,   156,   163,   169,
+       175,   182,   190,   197,   205,   213,   213,   205,   197,   190,   182,   175,
+       169,   163,   156,   150,   144,   139,   134,   129,   125,   120,   117,   114,
+       110,   108,   105,   103,   100,   100,   100,    97,    96,    96,    96,    97,
+       100,   100,   100,   103,   105,   108,   111,   108,    92,    77,    63,    48,
+        33,    18,     4,   -16,   -30,   -46,   -34,   -20,    -4,    13,    27,    42,
+        57,    72,    87,   102,   116,   123,   121,   118,   116,   116,   116,   113,
+       112,   112,   112,   113,   116,   116,   116,   118,   121,   123,   126,   129,
+       132,   136,   140,   145,   149,   154,   159,   165,   171,   177,   184,   190,
+       197,   204,   211,   219,   227,   227,   219,   211,   204,   197,   190,   184,
+       177,   171,   165,   159,   154,   149,   145,   140,   136,   133,   129,   126,
+       123,   121,   118,   116,   116,   116,   113,   112,   112,   112,   113,   116,
+       116,   116,   118,   121,   123,   116,   102,    87,    72,    57,    42,    27,
+        13,    -4,   -20,   -34,   -49,   -39,   -25,   -11,     8,    22,    37,    52,
+        66,    80,    95,   108,   121,   134,   134,   132,   132,   132,   129,   128,
+       128,   128,   129,   132,   132,   132,   134,   137,   139,   141,   145,   148,
+       151,   156,   160,   164,   170,   175,   180,   186,   192,   199,   204,   211,
+       218,   225,   233,   241,   241,   233,   225,   218,   211,   204,   199,   192,
+       186,   180,   175,   170,   164,   160,   156,   151,   148,   145,   141,   139,
+       137,   134,   132,   132,   132,   129,   128,   128,   128,   129,   132,   132,
+       132,   134,   134,   121,   108,    95,    80,    66,    52,    37,    22,     8,
+       -11,   -25,   -39,   -54,   -46,   -30,   -16,     4,    16,    30,    45,    59,
+        74,    86,    99,   113,   127,   141,   148,   148,   148,   145,   144,   144,
+       144,   145,   148,   148,   148,   150,   152,   155,   157,   160,   163,   167,
+       171,   176,   180,   185,   190,   195,   201,   206,   213,   219,   225,   233,
+       240,   247,   255,   255,   247,   240,   233,   225,   219,   213,   206,   201,
+       195,   190,   185,   180,   176,   171,   167,   164,   160,   157,   155,   152,
+       150,   148,   148,   148,   145,   144,   144,   144,   145,   148,   148,   148,
+       141,   127,   113,    99,    86,    74,    59,    45,    30,    16,     4,   -16,
+       -30,   -46,   -61,   -51,   -36,   -22,    -8,     9,    23,    38,    51,    63,
+        77,    91,   106,   119,   131,   141,   153,   163,   161,   160,   160,   160,
+       161,   163,   164,   164,   166,   168,   170,   173,   176,   179,   182,   186,
+       191,   195,   200,   205,   210,   215,   221,   227,   234,   240,   247,   254,
+       261,   268,   268,   261,   254,   247,   240,   234,   227,   221,   215,   210,
+       205,   200,   195,   191,   186,   183,   180,   176,   173,   170,   168,   166,
+       164,   164,   163,   161,   160,   160,   160,   161,   163,   153,   141,   131,
+       119,   106,    91,    77,    63,    51,    38,    23,     9,    -8,   -22,   -36,
+       -51,   -66,   -57,   -43,   -29,   -14,     4,    18,    28,    41,    56,    71,
+        86,    96,   108,   119,   131,   143,   156,   170,   176,   176,   176,   177,
+       179,   180,   180,   182,   184,   186,   189,   191,   195,   198,   202,   206,
+       211,   215,   220,   225,   230,   236,   242,   249,   255,   261,   268,   276,
+       283,   283,   276,   268,   261,   255,   249,   242,   236,   230,   225,   220,
+       215,   211,   206,   202,   199,   195,   191,   189,   186,   184,   182,   180,
+       180,   179,   177,   176,   176,   176,   170,   156,   143,   131,   119,   108,
+        96,    86,    71,    56,    41,    28,    18,     4,   -14,   -29,   -43,   -57,
+       -72,   -64,   -49,   -34,   -20,    -6,     6,    20,    36,    51,    63,    74,
+        86,    96,   108,   121,   134,   148,   163,   176,   187,   192,   193,   195,
+       196,   196,   197,   200,   202,   205,   207,   210,   213,   217,   221,   226,
+       230,   235,   240,   245,   251,   257,   263,   270,   276,   283,   290,   297,
+       297,   290,   283,   276,   270,   263,   257,   251,   245,   240,   235,   230,
+       226,   221,   217,   214,   211,   207,   205,   202,   200,   197,   196,   196,
+       195,   193,   192,   187,   176,   163,   148,   134,   121,   108,    96,    86,
+        74,    63,    51,    36,    20,     6,    -6,   -20,   -34,   -49,   -64,   -79,
+       -70,   -56,   -41,   -28,   -16,     4,    16,    28,    41,    51,    63,    74,
+        86,    99,   113,   127,   141,   153,   164,   176,   187,   198,   209,   212,
+       212,   213,   216,   218,   220,   223,   226,   229,   233,   237,   242,   246,
+       251,   256,   261,   266,   272,   278,   284,   290,   297,   304,   311,   311,
+       304,   297,   290,   284,   278,   272,   266,   261,   256,   251,   246,   242,
+       237,   233,   230,   226,   223,   220,   218,   216,   213,   212,   212,   209,
+       198,   187,   176,   164,   153,   141,   127,   113,    99,    86,    74,    63,
+        51,    41,    28,    16,     4,   -16,   -28,   -41,   -56,   -70,   -85,   -77,
+       -63,   -51,   -36,   -22,    -8,     6,    20,    28,    41,    51,    63,    77,
+        91,   106,   119,   131,   141,   153,   164,   176,   187,   198,   209,   220,
+       228,   231,   234,   236,   239,   242,   245,   248,   252,   257,   261,   266,
+       271,   276,   281,   287,   293,   299,   305,   312,   318,   326,   326,   318,
+       312,   305,   299,   293,   287,   281,   276,   271,   266,   261,   257,   252,
+       249,   246,   242,   239,   236,   234,   231,   228,   220,   209,   198,   187,
+       176,   164,   153,   141,   131,   119,   106,    91,    77,    63,    51,    41,
+        28,    20,     6,    -8,   -22,   -36,   -51,   -63,   -77,   -91,   -86,   -72,
+       -57,   -43,   -29,   -16,     4,     6,    20,    28,    41,    56,    71,    86,
+        96,   108,   119,   131,   141,   153,   164,   176,   187,   198,   206,   214,
+       223,   233,   244,   255,   257,   260,   264,   268,   272,   276,   281,   286,
+       291,   296,   302,   308,   314,   320,   326,   333,   340,   340,   333,   326,
+       320,   314,   308,   302,   296,   291,   286,   281,   276,   272,   268,   264,
+       261,   257,   255,   244,   233,   223,   214,   206,   198,   187,   176,   164,
+       153,   141,   131,   119,   108,    96,    86,    71,    56,    41,    28,    20,
+         6,     4,   -16,   -29,   -43,   -57,   -72,   -86,   -99,   -93,   -79,   -64,
+       -51,   -36,   -23,   -16,     4,     6,    20,    36,    51,    63,    74,    86,
+        96,   108,   119,   131,   141,   153,   164,   176,   184,   192,   201,   211,
+       221,   232,   242,   250,   259,   268,   277,   285,   292,   296,   301,   306,
+       311,   316,   322,   328,   335,   341,   347,   354,   354,   347,   341,   335,
+       328,   322,   316,   311,   306,   301,   296,   292,   285,   277,   268,   259,
+       250,   242,   232,   221,   211,   201,   192,   184,   176,   164,   153,   141,
+       131,   119,   108,    96,    86,    74,    63,    51,    36,    20,     6,     4,
+       -16,   -23,   -36,   -51,   -64,   -79,   -93,  -107,  -100,   -86,   -72,   -58,
+       -45,   -36,   -23,   -16,     4,    20,    28,    41,    51,    63,    74,    86,
+        96,   108,   119,   131,   141,   153,   163,   170,   179,   188,   198,   209,
+       220,   228,   236,   246,   256,   263,   270,   277,   285,   294,   303,   309,
+       314,   320,   327,   335,   339,   344,   347,   347,   344,   339,   335,   327,
+       320,   314,   309,   303,   294,   285,   277,   270,   263,   256,   246,   236,
+       228,   220,   209,   198,   188,   179,   170,   163,   153,   141,   131,   119,
+       108,    96,    86,    74,    63,    51,    41,    28,    20,     4,   -16,   -23,
+       -36,   -45,   -58,   -72,   -86,  -100,  -115,  -107,   -93,   -80,   -68,   -58,
+       -45,   -32,   -16,    -4,     6,    20,    28,    41,    51,    63,    74,    86,
+        96,   108,   119,   131,   141,   148,   156,   166,   176,   187,   198,   206,
+       214,   223,   233,   242,   249,   256,   263,   272,   281,   288,   294,   299,
+       306,   313,   319,   324,   328,   331,   331,   328,   324,   319,   313,   306,
+       299,   294,   288,   281,   272,   263,   256,   249,   242,   233,   223,   214,
+       206,   198,   187,   176,   166,   156,   148,   141,   131,   119,   108,    96,
+        86,    74,    63,    51,    41,    28,    20,     6,    -4,   -16,   -32,   -45,
+       -58,   -68,   -80,   -93,  -107,  -122,  -115,  -102,   -91,   -80,   -67,   -52,
+       -38,   -26,   -16,     4,     6,    20,    28,    41,    51,    63,    74,    86,
+        96,   108,   119,   127,   134,   143,   153,   164,   176,   184,   192,   201,
+       211,   220,   228,   234,   242,   250,   259,   268,   273,   279,   285,   292,
+       299,   304,   309,   312,   315,   315,   312,   309,   304,   299,   292,   285,
+       279,   273,   268,   259,   250,   242,   234,   228,   220,   211,   201,   192,
+       184,   176,   164,   153,   143,   134,   127,   119,   108,    96,    86,    74,
+        63,    51,    41,    28,    20,     6,     4,   -16,   -26,   -38,   -52,   -67,
+       -80,   -91,  -102,  -115,  -129,  -125,  -113,  -102,   -88,   -73,   -60,   -48,
+       -36,   -23,   -16,     4,     6,    20,    28,    41,    51,    63,    74,    86,
+        96,   106,   113,   121,   131,   141,   153,   163,   170,   179,   188,   198,
+       206,   213,   220,   228,   236,   246,   253,   258,   264,   270,   277,   284,
+       288,   294,   297,   300,   300,   297,   294,   288,   284,   277,   270,   264,
+       258,   253,   246,   236,   228,   220,   213,   206,   198,   188,   179,   170,
+       163,   153,   141,   131,   121,   113,   106,    96,    86,    74,    63,    51,
+        41,    28,    20,     6,     4,   -16,   -23,   -36,   -48,   -60,   -73,   -88,
+      -102,  -113,  -125,  -138,  -136,  -123,  -109,   -95,   -82,   -71,   -58,   -45,
+       -36,   -23,   -16,     4,     6,    20,    28,    41,    51,    63,    74,    86,
+        91,    99,   108,   119,   131,   141,   148,   156,   166,   176,   184,   192,
+       199,   206,   214,   223,   233,   238,   243,   249,   256,   263,   269,   273,
+       278,   281,   284,   284,   281,   278,   273,   269,   263,   256,   249,   243,
+       238,   233,   223,   214,   206,   199,   192,   184,   176,   166,   156,   148,
+       141,   131,   119,   108,    99,    91,    86,    74,    63,    51,    41,    28,
+        20,     6,     4,   -16,   -23,   -36,   -45,   -58,   -71,   -82,   -95,  -109,
+      -123,  -136,  -148,  -145,  -131,  -118,  -105,   -93,   -80,   -68,   -58,   -45,
+       -36,   -23,   -16,     4,     6,    20,    28,    41,    51,    63,    71,    77,
+        86,    96,   108,   119,   127,   134,   143,   153,   163,   170,   178,   184,
+       192,   201,   211,   218,   223,   228,   234,   242,   249,   253,   258,   262,
+       265,   269,   269,   265,   262,   258,   253,   249,   242,   234,   228,   223,
+       218,   211,   201,   192,   184,   178,   170,   163,   153,   143,   134,   127,
+       119,   108,    96,    86,    77,    71,    63,    51,    41,    28,    20,     6,
+         4,   -16,   -23,   -36,   -45,   -58,   -68,   -80,   -93,  -105,  -118,  -131,
+      -145,  -158,  -153,  -140,  -128,  -115,  -102,   -91,   -80,   -68,   -58,   -45,
+       -36,   -23,   -16,     4,     6,    20,    28,    41,    51,    56,    63,    74,
+        86,    96,   106,   113,   121,   131,   141,   148,   156,   163,   170,   179,
+       188,   198,   203,   207,   213,   220,   228,   234,   238,   243,   247,   249,
+       253,   253,   249,   247,   243,   238,   234,   228,   220,   213,   207,   203,
+       198,   188,   179,   170,   163,   156,   148,   141,   131,   121,   113,   106,
+        96,    86,    74,    63,    56,    51,    41,    28,    20,     6,     4,   -16,
+       -23,   -36,   -45,   -58,   -68,   -80,   -91,  -102,  -115,  -128,  -140,  -153,
+      -167,  -162,  -150,  -138,  -125,  -113,  -102,   -91,   -80,   -68,   -58,   -45,
+       -36,   -23,   -16,     4,     6,    20,    28,    36,    41,    51,    63,    74,
+        86,    91,    99,   108,   119,   127,   134,   142,   148,   156,   166,   176,
+       184,   187,   192,   199,   206,   213,   218,   223,   228,   231,   234,   238,
+       238,   234,   231,   228,   223,   218,   213,   206,   199,   192,   187,   184,
+       176,   166,   156,   148,   142,   134,   127,   119,   108,    99,    91,    86,
+        74,    63,    51,    41,    36,    28,    20,     6,     4,   -16,   -23,   -36,
+       -45,   -58,   -68,   -80,   -91,  -102,  -113,  -125,  -138,  -150,  -162,  -175,
+      -173,  -160,  -148,  -136,  -125,  -113,  -102,   -91,   -80,   -68,   -58,   -45,
+       -36,   -23,   -16,     4,     6,    20,    20,    28,    41,    51,    63,    71,
+        77,    86,    96,   106,   113,   121,   127,   134,   143,   153,   163,   168,
+       172,   178,   184,   192,   199,   203,   207,   213,   215,   218,   223,   223,
+       218,   215,   213,   207,   203,   199,   192,   184,   178,   172,   168,   163,
+       153,   143,   134,   127,   121,   113,   106,    96,    86,    77,    71,    63,
+        51,    41,    28,    20,    20,     6,     4,   -16,   -23,   -36,   -45,   -58,
+       -68,   -80,   -91,  -102,  -113,  -125,  -136,  -148,  -160,  -173,  -185,  -182,
+      -170,  -158,  -148,  -136,  -125,  -113,  -102,   -91,   -80,   -68,   -58,   -45,
+       -36,   -23,   -16,     4,     4,     6,    20,    28,    41,    51,    56,    63,
+        74,    86,    91,    99,   106,   113,   121,   131,   141,   148,   152,   157,
+       163,   170,   178,   184,   187,   192,   197,   199,   203,   207,   207,   203,
+       199,   197,   192,   187,   184,   178,   170,   163,   157,   152,   148,   141,
+       131,   121,   113,   106,    99,    91,    86,    74,    63,    56,    51,    41,
+        28,    20,     6,     4,     4,   -16,   -23,   -36,   -45,   -58,   -68,   -80,
+       -91,  -102,  -113,  -125,  -136,  -148,  -158,  -170,  -182,  -195,  -193,  -181,
+      -170,  -158,  -148,  -136,  -125,  -113,  -102,   -91,   -80,   -68,   -58,   -45,
+       -36,   -23,   -16,   -16,     4,     6,    20,    28,    36,    41,    51,    63,
+        71,    77,    86,    91,    99,   108,   119,   127,   134,   137,   142,   148,
+       156,   163,   168,   172,   178,   181,   184,   187,   192,   192,   187,   184,
+       181,   178,   172,   168,   163,   156,   148,   142,   137,   134,   127,   119,
+       108,    99,    91,    86,    77,    71,    63,    51,    41,    36,    28,    20,
+         6,     4,   -16,   -16,   -23,   -36,   -45,   -58,   -68,   -80,   -91,  -102,
+      -113,  -125,  -136,  -148,  -158,  -170,  -181,  -193,  -205,  -204,  -193,  -181,
+      -170,  -158,  -148,  -136,  -125,  -113,  -102,   -91,   -80,   -68,   -58,   -45,
+       -36,   -32,   -23,   -16,     4,     6,    20,    20,    28,    41,    51,    56,
+        63,    71,    77,    86,    96,   106,   113,   118,   121,   127,   134,   142,
+       148,   152,   157,   163,   165,   168,   172,   178,   178,   172,   168,   165,
+       163,   157,   152,   148,   142,   134,   127,   121,   118,   113,   106,    96,
+        86,    77,    71,    63,    56,    51,    41,    28,    20,    20,     6,     4,
+       -16,   -23,   -32,   -36,   -45,   -58,   -68,   -80,   -91,  -102,  -113,  -125,
+      -136,  -148,  -158,  -170,  -181,  -193,  -204,  -215,  -215,  -204,  -193,  -181,
+      -170,  -158,  -148,  -136,  -125,  -113,  -102,   -91,   -80,   -68,   -58,   -51,
+       -45,   -36,   -23,   -16,     4,     4,     6,    20,    28,    36,    41,    51,
+        56,    63,    74,    86,    91,    99,   102,   106,   113,   121,   127,   134,
+       137,   142,   148,   149,   152,   157,   163,   163,   157,   152,   149,   148,
+       142,   137,   134,   127,   121,   113,   106,   102,    99,    91,    86,    74,
+        63,    56,    51,    41,    36,    28,    20,     6,     4,     4,   -16,   -23,
+       -36,   -45,   -51,   -58,   -68,   -80,   -91,  -102,  -113,  -125,  -136,  -148,
+      -158,  -170,  -181,  -193,  -204,  -215,  -226,  -226,  -215,  -204,  -193,  -181,
+      -170,  -158,  -148,  -136,  -125,  -113,  -102,   -91,   -80,   -72,   -66,   -58,
+       -45,   -36,   -23,   -16,   -16,     4,     6,    20,    20,    28,    36,    41,
+        51,    63,    71,    77,    84,    86,    91,    99,   106,   113,   118,   121,
+       127,   132,   134,   137,   142,   148,   148,   142,   137,   134,   132,   127,
+       121,   118,   113,   106,    99,    91,    86,    84,    77,    71,    63,    51,
+        41,    36,    28,    20,    20,     6,     4,   -16,   -16,   -23,   -36,   -45,
+       -58,   -66,   -72,   -80,   -91,  -102,  -113,  -125,  -136,  -148,  -158,  -170,
+      -181,  -193,  -204,  -215,  -226,  -238,  -238,  -226,  -215,  -204,  -193,  -181,
+      -170,  -158,  -148,  -136,  -125,  -113,  -102,   -93,   -86,   -80,   -68,   -58,
+       -45,   -36,   -32,   -23,   -16,     4,     4,     6,    20,    20,    28,    41,
+        51,    56,    63,    68,    71,    77,    86,    91,    99,   102,   106,   113,
+       116,   118,   121,   127,   132,   132,   127,   121,   118,   116,   113,   106,
+       102,    99,    91,    86,    77,    71,    68,    63,    56,    51,    41,    28,
+        20,    20,     6,     4,     4,   -16,   -23,   -32,   -36,   -45,   -58,   -68,
+       -80,   -86,   -93,  -102,  -113,  -125,  -136,  -148,  -158,  -170,  -181,  -193,
+      -204,  -215,  -226,  -238,  -249,  -249,  -238,  -226,  -215,  -204,  -193,  -181,
+      -170,  -158,  -148,  -136,  -125,  -115,  -107,  -101,   -91,   -80,   -68,   -58,
+       -51,   -45,   -36,   -23,   -16,   -16,     4,     4,     6,    20,    28,    36,
+        41,    51,    52,    56,    63,    71,    77,    84,    86,    91,    99,   100,
+       102,   106,   113,   116,   116,   113,   106,   102,   100,    99,    91,    86,
+        84,    77,    71,    63,    56,    52,    51,    41,    36,    28,    20,     6,
+         4,     4,   -16,   -16,   -23,   -36,   -45,   -51,   -58,   -68,   -80,   -91,
+      -101,  -107,  -115,  -125,  -136,  -148,  -158,  -170,  -181,  -193,  -204,  -215,
+      -226,  -238,  -249,  -260,  -260,  -249,  -238,  -226,  -215,  -204,  -193,  -181,
+      -170,  -158,  -148,  -138,  -129,  -122,  -113,  -102,   -91,   -80,   -72,   -66,
+       -58,   -45,   -36,   -32,   -23,   -16,   -16,     4,     6,    20,    20,    28,
+        36,    36,    41,    51,    56,    63,    68,    71,    77,    84,    84,    86,
+        91,    99,   100,   100,    99,    91,    86,    84,    84,    77,    71,    68,
+        63,    56,    51,    41,    36,    36,    28,    20,    20,     6,     4,   -16,
+       -16,   -23,   -32,   -36,   -45,   -58,   -66,   -72,   -80,   -91,  -102,  -113,
+      -122,  -129,  -138,  -148,  -158,  -170,  -181,  -193,  -204,  -215,  -226,  -238,
+      -249,  -260,  -272,  -272,  -260,  -249,  -238,  -226,  -215,  -204,  -193,  -181,
+      -170,  -160,  -151,  -143,  -136,  -125,  -113,  -102,   -93,   -86,   -80,   -68,
+       -58,   -51,   -45,   -36,   -32,   -23,   -16,     4,     4,     6,    20,    20,
+        20,    28,    36,    41,    51,    52,    56,    63,    68,    68,    71,    77,
+        84,    84,    84,    84,    77,    71,    68,    68,    63,    56,    52,    51,
+        41,    36,    28,    20,    20,    20,     6,     4,     4,   -16,   -23,   -32,
+       -36,   -45,   -51,   -58,   -68,   -80,   -86,   -93,  -102,  -113,  -125,  -136,
+      -143,  -151,  -160,  -170,  -181,  -193,  -204,  -215,  -226,  -238,  -249,  -260,
+      -272,  -283,  -283,  -272,  -260,  -249,  -238,  -226,  -215,  -204,  -193,  -182,
+      -173,  -165,  -158,  -148,  -136,  -125,  -115,  -107,  -101,   -91,   -80,   -72,
+       -66,   -58,   -51,   -45,   -36,   -23,   -16,   -16,     4,     4,     4,     6,
+        20,    20,    28,    36,    36,    41,    51,    52,    52,    56,    63,    68,
+        68,    68,    68,    63,    56,    52,    52,    51,    41,    36,    36,    28,
+        20,    20,     6,     4,     4,     4,   -16,   -16,   -23,   -36,   -45,   -51,
+       -58,   -66,   -72,   -80,   -91,  -101,  -107,  -115,  -125,  -136,  -148,  -158,
+      -165,  -173,  -182,  -193,  -204,  -215,  -226,  -238,  -249,  -260,  -272,  -283,
+      -294,  -294,  -283,  -272,  -260,  -249,  -238,  -226,  -215,  -205,  -195,  -187,
+      -179,  -170,  -158,  -148,  -138,  -129,  -122,  -113,  -102,   -93,   -86,   -80,
+       -72,   -66,   -58,   -45,   -36,   -32,   -23,   -16,   -16,   -16,     4,     4,
+         6,    20,    20,    20,    28,    36,    36,    36,    41,    51,    52,    52,
+        52,    52,    51,    41,    36,    36,    36,    28,    20,    20,    20,     6,
+         4,     4,   -16,   -16,   -16,   -23,   -32,   -36,   -45,   -58,   -66,   -72,
+       -80,   -86,   -93,  -102,  -113,  -122,  -129,  -138,  -148,  -158,  -170,  -179,
+      -187,  -195,  -205,  -215,  -226,  -238,  -249,  -260,  -272,  -283,  -294,  -306,
+      -306,  -294,  -283,  -272,  -260,  -249,  -238,  -227,  -218,  -209,  -200,  -193,
+      -181,  -170,  -160,  -151,  -143,  -136,  -125,  -115,  -107,  -101,   -93,   -86,
+       -80,   -68,   -58,   -51,   -45,   -36,   -32,   -32,   -23,   -16,   -16,     4,
+         4,     4,     6,    20,    20,    20,    20,    28,    36,    36,    36,    36,
+        36,    36,    28,    20,    20,    20,    20,     6,     4,     4,     4,   -16,
+       -16,   -23,   -32,   -32,   -36,   -45,   -51,   -58,   -68,   -80,   -86,   -93,
+      -101,  -107,  -115,  -125,  -136,  -143,  -151,  -160,  -170,  -181,  -193,  -200,
+      -209,  -218,  -227,  -238,  -249,  -260,  -272,  -283,  -294,  -306,  -317,  -317,
+      -306,  -294,  -283,  -272,  -260,  -250,  -240,  -231,  -222,  -215,  -204,  -193,
+      -182,  -173,  -165,  -158,  -148,  -138,  -129,  -122,  -115,  -107,  -101,   -91,
+       -80,   -72,   -66,   -58,   -51,   -48,   -45,   -36,   -32,   -23,   -16,   -16,
+       -16,     4,     4,     4,     4,     6,    20,    20,    20,    20,    20,    20,
+        20,    20,     6,     4,     4,     4,     4,   -16,   -16,   -16,   -23,   -32,
+       -36,   -45,   -48,   -51,   -58,   -66,   -72,   -80,   -91,  -101,  -107,  -115,
+      -122,  -129,  -138,  -148,  -158,  -165,  -173,  -182,  -193,  -204,  -215,  -222,
+      -231,  -240,  -250,  -260,  -272,  -283,  -294,  -306,  -317,  -328,  -328,  -317,
+      -306,  -294,  -283,  -272,  -262,  -253,  -244,  -236,  -226,  -215,  -205,  -195,
+      -187,  -179,  -170,  -160,  -151,  -143,  -137,  -129,  -122,  -113,  -102,   -93,
+       -86,   -80,   -72,   -66,   -64,   -58,   -51,   -45,   -36,   -32,   -32,   -23,
+       -16,   -16,   -16,   -16,     4,     4,     4,     4,     6,     6,     4,     4,
+         4,     4,   -16,   -16,   -16,   -16,   -23,   -32,   -32,   -36,   -45,   -51,
+       -58,   -64,   -66,   -72,   -80,   -86,   -93,  -102,  -113,  -122,  -129,  -137,
+      -143,  -151,  -160,  -170,  -179,  -187,  -195,  -205,  -215,  -226,  -236,  -244,
+      -253,  -262,  -272,  -283,  -294,  -306,  -317,  -328,  -339,  -339,  -328,  -317,
+      -306,  -295,  -285,  -275,  -266,  -258,  -249,  -238,  -227,  -218,  -209,  -200,
+      -193,  -182,  -173,  -165,  -158,  -151,  -143,  -136,  -125,  -115,  -107,  -101,
+       -93,   -86,   -82,   -80,   -72,   -66,   -58,   -51,   -48,   -45,   -36,   -32,
+       -32,   -32,   -23,   -16,   -16,   -16,   -16,     4,     4,   -16,   -16,   -16,
+       -16,   -23,   -32,   -32,   -32,   -36,   -45,   -48,   -51,   -58,   -66,   -72,
+       -80,   -82,   -86,   -93,  -101,  -107,  -115,  -125,  -136,  -143,  -151,  -158,
+      -165,  -173,  -182,  -193,  -200,  -209,  -218,  -227,  -238,  -249,  -258,  -266,
+      -275,  -285,  -295,  -306,  -317,  -328,  -339,  -351,  -351,  -339,  -328,  -318,
+      -307,  -298,  -288,  -280,  -272,  -260,  -250,  -240,  -231,  -222,  -215,  -205,
+      -195,  -187,  -179,  -172,  -165,  -158,  -148,  -138,  -129,  -122,  -115,  -107,
+      -101,   -97,   -93,   -86,   -80,   -72,   -66,   -64,   -58,   -51,   -48,   -48,
+       -45,   -36,   -32,   -32,   -32,   -23,   -16,   -16,   -23,   -32,   -32,   -32,
+       -36,   -45,   -48,   -48,   -51,   -58,   -64,   -66,   -72,   -80,   -86,   -93,
+       -97,  -101,  -107,  -115,  -122,  -129,  -138,  -148,  -158,  -165,  -172,  -179,
+      -187,  -195,  -205,  -215,  -222,  -231,  -240,  -250,  -260,  -272,  -280,  -288,
+      -298,  -307,  -318,  -328,  -339,  -351,  -362,
+};
+
+#endif // WORKSPACE_TABLE_H
@@ -0,0 +1,55 @@
+#ifndef SERVO_MODEL_H
+#define SERVO_MODEL_H
+
+#include <stdint.h>
+
+// Shortest gap left between the end of the longest pulse and the next frame
+#define SERVO_FRAME_GAP_US      500
+#define SERVO_RATE_MIN_HZ       50
+
+typedef enum {
+    SERVO_MODEL_ANALOG = 0,     // classic hobby servo, 50Hz frames
+    SERVO_MODEL_DIGITAL_200,    // digital servo, frames up to 200Hz
+    SERVO_MODEL_DIGITAL_333,    // digital servo, frames up to 333Hz
+    SERVO_MODEL_COUNT
+} servo_model_id_t;
+
+// Compare values (1us ticks) a servo accepts and how often it takes a new one.
+// Faster frames only help a servo that reads every pulse; an analog one
+// driven faster than it was made for runs hot or jitters.
+typedef struct {
+    const char *name;
+    uint16_t min_pulse_us;
+    uint16_t max_pulse_us;
+    uint16_t max_hz;
+} servo_model_t;
+
+static const servo_model_t servo_models[SERVO_MODEL_COUNT] = {
+    {"analog", 500, 2500, 50},
+    {"digital 200Hz", 500, 2500, 200},
+    {"digital 333Hz", 500, 2500, 333},
+};
+
+static inline const servo_model_t *servo_model(servo_model_id_t id) {
+    return &servo_models[id < SERVO_MODEL_COUNT ? id : SERVO_MODEL_ANALOG];
+}
+
+// Frame period for rate_hz, clamped to what both models take and long enough
+// for their longest pulse plus SERVO_FRAME_GAP_US
+static inline uint32_t servo_frame_us(uint32_t rate_hz, const servo_model_t *a, const servo_model_t *b) {
+    uint32_t hz = rate_hz;
+    if (hz > a->max_hz) {
+        hz = a->max_hz;
+    }
+    if (hz > b->max_hz) {
+        hz = b->max_hz;
+    }
+    if (hz < SERVO_RATE_MIN_HZ) {
+        hz = SERVO_RATE_MIN_HZ;
+    }
+    uint32_t frame = 1000000 / hz;
+    uint32_t pulse = (a->max_pulse_us > b->max_pulse_us ? a->max_pulse_us : b->max_pulse_us) + SERVO_FRAME_GAP_US;
+    return frame > pulse ? frame : pulse;
+}
+
+#endif // SERVO_MODEL_H
@@ -0,0 +1,64 @@
+#ifndef SERVO_PROFILE_H
+#define SERVO_PROFILE_H
+
+#include <stdint.h>
+
+#define PROFILE_AXES            4       // body_ticks_t order: left front, left rear, right front, right rear
+#define PROFILE_SNAP_TICKS      0.5f    // closer than this and slow enough counts as arrived
+
+// Compare ticks (1us) per second and per second squared. A speed of 0 turns
+// the profile off for that axis, targets are then written as they come.
+typedef struct {
+    float max_speed;
+    float max_accel;
+} profile_limits_t;
+
+typedef struct {
+    float pos;          // ticks
+    float vel;          // ticks/s
+    float target;
+    profile_limits_t limits;
+    uint16_t out;       // compare value last handed out
+} profile_axis_t;
+
+// Trapezoidal motion profile per servo, advanced once per servo frame. Each
+// step accelerates towards the target at most max_accel, cruises at most
+// max_speed, and brakes so the axis comes to rest on the target. The braking
+// speed is solved on the step grid rather than the continuous v^2 = 2ad, so
+// the axis lands on the target instead of overshooting by up to one step.
+// A new target mid move is simply followed from the current speed, so
+// retargeting never jumps either.
+//
+// No allocation, no locking: a handful of float operations and one sqrtf per
+// moving axis and step. Owned by the task that steps it.
+class ServoProfiler {
+private:
+    profile_axis_t axes[PROFILE_AXES];
+    float dt;                   // s per step
+    uint32_t moving;            // bit per axis not yet at rest on its target
+
+public:
+    ServoProfiler(uint32_t step_us);
+
+    void set_limits(int axis, const profile_limits_t &limits);
+
+    // Places the axis at ticks, at rest, e.g. the compare value written at init
+    void reset(int axis, uint16_t ticks);
+
+    void set_target(int axis, uint16_t ticks);
+
+    // One step of every axis. out gets all compare values, the return value
+    // has a bit set for each one that changed since the last step.
+    uint32_t step(uint16_t out[PROFILE_AXES]);
+
+    uint16_t target(int axis) const;
+
+    // Bit per axis still moving, 0 once everything arrived
+    uint32_t moving_mask() const;
+
+    // Time the axis needs to come to rest on its target from its current
+    // position and speed, along the same profile
+    uint32_t eta_us(int axis) const;
+};
+
+#endif // SERVO_PROFILE_H
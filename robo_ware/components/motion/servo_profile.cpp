@@ -0,0 +1,125 @@
+#include "servo_profile.h"
+
+#include <math.h>
+
+static inline float clampf(float v, float limit) {
+    return v > limit ? limit : (v < -limit ? -limit : v);
+}
+
+ServoProfiler::ServoProfiler(uint32_t step_us) {
+    dt = step_us * 1e-6f;
+    moving = 0;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        axes[i].limits.max_speed = 0;
+        axes[i].limits.max_accel = 0;
+        reset(i, 0);
+    }
+}
+
+void ServoProfiler::set_limits(int axis, const profile_limits_t &limits) {
+    axes[axis].limits = limits;
+}
+
+void ServoProfiler::reset(int axis, uint16_t ticks) {
+    profile_axis_t *a = &axes[axis];
+    a->pos = ticks;
+    a->vel = 0;
+    a->target = ticks;
+    a->out = ticks;
+    moving &= ~(1u << axis);
+}
+
+void ServoProfiler::set_target(int axis, uint16_t ticks) {
+    profile_axis_t *a = &axes[axis];
+    a->target = ticks;
+    if (a->pos != a->target || a->vel != 0) {
+        moving |= 1u << axis;
+    }
+}
+
+uint32_t ServoProfiler::step(uint16_t out[PROFILE_AXES]) {
+    uint32_t changed = 0;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        profile_axis_t *a = &axes[i];
+        if (moving & (1u << i)) {
+            float d = a->target - a->pos;
+            float dv_max = a->limits.max_accel * dt;
+            if (a->limits.max_speed <= 0 || a->limits.max_accel <= 0 ||
+                (fabsf(d) <= PROFILE_SNAP_TICKS && fabsf(a->vel) <= dv_max)) {
+                a->pos = a->target;
+                a->vel = 0;
+                moving &= ~(1u << i);
+            } else {
+                // Speed v = n*dv_max from which braking by dv_max per step covers
+                // exactly |d|: steps of n, n-1, .., frac(n) times dv_max*dt. With
+                // m = floor(n) that is (m+1)*n - m*(m+1)/2 units, and m is where
+                // the integer braking distances m*(m+1)/2 pass |d|.
+                float units = fabsf(d) / (dv_max * dt);
+                float m = floorf(sqrtf(0.25f + 2.0f * units) - 0.5f);
+                float n = (units + m * (m + 1) * 0.5f) / (m + 1);
+                float v_stop = n * dv_max;
+                float v_want = v_stop < a->limits.max_speed ? v_stop : a->limits.max_speed;
+                v_want = d > 0 ? v_want : -v_want;
+                a->vel += clampf(v_want - a->vel, dv_max);
+                a->pos += a->vel * dt;
+                // Float rounding can leave the last braking step a hair off the
+                // target. The axis keeps that step's speed and comes to rest on
+                // the next one, so a new target right now starts from the real
+                // speed. A target moved too close to stop for is overshot and
+                // approached again from the other side.
+                if (fabsf(a->target - a->pos) <= PROFILE_SNAP_TICKS && fabsf(a->vel) <= dv_max) {
+                    a->pos = a->target;
+                }
+            }
+        }
+        uint16_t ticks = (uint16_t)lrintf(a->pos);
+        if (ticks != a->out) {
+            a->out = ticks;
+            changed |= 1u << i;
+        }
+        out[i] = ticks;
+    }
+    return changed;
+}
+
+uint16_t ServoProfiler::target(int axis) const {
+    return (uint16_t)axes[axis].target;
+}
+
+uint32_t ServoProfiler::moving_mask() const {
+    return moving;
+}
+
+uint32_t ServoProfiler::eta_us(int axis) const {
+    const profile_axis_t *a = &axes[axis];
+    if (!(moving & (1u << axis))) {
+        return 0;
+    }
+    float vmax = a->limits.max_speed;
+    float acc = a->limits.max_accel;
+    if (vmax <= 0 || acc <= 0) {
+        return 0;
+    }
+    float d = a->target - a->pos;
+    float v = d >= 0 ? a->vel : -a->vel;        // speed towards the target
+    d = fabsf(d);
+    float t = 0;
+    if (v < 0) {
+        // Heading away: stop first, the way back grows by the braking distance
+        t = -v / acc;
+        d += v * v / (2 * acc);
+        v = 0;
+    }
+    if (v > vmax) {
+        v = vmax;
+    }
+    float peak2 = acc * d + v * v * 0.5f;
+    if (peak2 <= vmax * vmax) {
+        float peak = sqrtf(peak2);
+        t += (peak - v) / acc + peak / acc;
+    } else {
+        float ramps = (vmax * vmax - v * v) / (2 * acc) + vmax * vmax / (2 * acc);
+        t += (vmax - v) / acc + vmax / acc + (d - ramps) / vmax;
+    }
+    return (uint32_t)(t * 1e6f);
+}
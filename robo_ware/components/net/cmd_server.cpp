@@ -0,0 +1,470 @@
+#include "cmd_server.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "hal_socket.h"
+
+#define KEEPALIVE_IDLE               240
+#define KEEPALIVE_INTERVAL           10
+#define KEEPALIVE_COUNT              5
+
+static const char *NET_TAG = "NET";
+
+CmdServer::CmdServer(uint16_t port, proto_frame_cb_t on_frame, void *frame_ctx, cmd_tx_pull_t tx_pull, void *tx_ctx)
+    : port(port), on_frame(on_frame), frame_ctx(frame_ctx), tx_pull(tx_pull), tx_ctx(tx_ctx),
+      listen_sock(-1), serials(0), rounds(0), current(-1), last_accepted(0), wake_fd(-1), udp_sock(-1),
+      on_datagram(NULL), datagram_ctx(NULL), udp_peer_addr(0), udp_peer_port(0), udp_last_seq(0),
+      udp_synced(false), stream_acquire(NULL), stream_release(NULL), stream_ctx(NULL), stream_frame(NULL),
+      stream_len(0), stream_off(0), stream_slot(-1), stats() {
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        clients[i].sock = -1;
+        clients[i].serial = 0;
+        clients[i].active = 0;
+        clients[i].tx_len = 0;
+        proto_decoder_init(&clients[i].decoder);
+    }
+}
+
+CmdServer::~CmdServer() {
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        close_client(i);
+    }
+    if (listen_sock >= 0) {
+        close(listen_sock);
+    }
+    if (wake_fd >= 0) {
+        close(wake_fd);
+    }
+    if (udp_sock >= 0) {
+        close(udp_sock);
+    }
+}
+
+int CmdServer::open() {
+    if (wake_fd < 0) {
+        wake_fd = hal_eventfd();
+        if (wake_fd < 0) {
+            ESP_LOGE(NET_TAG, "Unable to create eventfd: errno %d", errno);
+            return -1;
+        }
+    }
+    if (listen_sock >= 0) {
+        close(listen_sock);
+    }
+
+    listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    if (listen_sock < 0) {
+        ESP_LOGE(NET_TAG, "Unable to create socket: errno %d", errno);
+        return -1;
+    }
+    int opt = 1;
+    setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listen_sock, CMD_SERVER_MAX_CLIENTS) != 0) {
+        ESP_LOGE(NET_TAG, "Unable to listen on port %u: errno %d", port, errno);
+        close(listen_sock);
+        listen_sock = -1;
+        return -1;
+    }
+    ESP_LOGI(NET_TAG, "Listening on port %u", bound_port());
+    return 0;
+}
+
+int CmdServer::open_udp(uint16_t udp_port, proto_frame_cb_t on_datagram, void *ctx) {
+    if (udp_sock >= 0) {
+        close(udp_sock);
+    }
+    this->on_datagram = on_datagram;
+    datagram_ctx = ctx;
+    udp_synced = false;
+
+    udp_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    if (udp_sock < 0) {
+        ESP_LOGE(NET_TAG, "Unable to create UDP socket: errno %d", errno);
+        return -1;
+    }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(udp_port);
+    if (bind(udp_sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        ESP_LOGE(NET_TAG, "Unable to bind UDP port %u: errno %d", udp_port, errno);
+        close(udp_sock);
+        udp_sock = -1;
+        return -1;
+    }
+    fcntl(udp_sock, F_SETFL, fcntl(udp_sock, F_GETFL, 0) | O_NONBLOCK);
+    ESP_LOGI(NET_TAG, "Teleop on UDP port %u", bound_udp_port());
+    return 0;
+}
+
+void CmdServer::accept_client() {
+    struct sockaddr_in source_addr;
+    socklen_t addr_len = sizeof(source_addr);
+    int sock = accept(listen_sock, (struct sockaddr *)&source_addr, &addr_len);
+    if (sock < 0) {
+        ESP_LOGE(NET_TAG, "Unable to accept connection: errno %d", errno);
+        return;
+    }
+    // A controller reconnecting after a Wi-Fi drop leaves the old socket half
+    // open until keepalive gives up. With no slot free the quietest one goes.
+    int slot = -1;
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        if (clients[i].sock < 0) {
+            slot = i;
+            break;
+        }
+        if (slot < 0 || (int32_t)(clients[i].active - clients[slot].active) < 0) {
+            slot = i;
+        }
+    }
+    if (clients[slot].sock >= 0) {
+        ESP_LOGW(NET_TAG, "New client replaces client %d", slot);
+        close_client(slot);
+        stats.replaced++;
+    }
+
+    int keepAlive = 1;
+    int keepIdle = KEEPALIVE_IDLE;
+    int keepInterval = KEEPALIVE_INTERVAL;
+    int keepCount = KEEPALIVE_COUNT;
+    int noDelay = 1;
+    setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, &keepAlive, sizeof(int));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPIDLE, &keepIdle, sizeof(int));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPINTVL, &keepInterval, sizeof(int));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPCNT, &keepCount, sizeof(int));
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(int));
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+
+    char addr_str[16];
+    inet_ntop(AF_INET, &source_addr.sin_addr, addr_str, sizeof(addr_str));
+    ESP_LOGI(NET_TAG, "Client %d connected from %s", slot, addr_str);
+
+    client_t *c = &clients[slot];
+    c->sock = sock;
+    c->serial = ++serials;
+    c->active = rounds;
+    proto_decoder_init(&c->decoder);
+    c->tx_len = 0;
+    last_accepted = slot;
+    stats.accepted++;
+}
+
+void CmdServer::close_client(int slot) {
+    client_t *c = &clients[slot];
+    if (c->sock < 0) {
+        return;
+    }
+    shutdown(c->sock, SHUT_RDWR);
+    close(c->sock);
+    c->sock = -1;
+    c->tx_len = 0;
+    if (stream_frame != NULL && stream_slot == slot) {
+        stream_release(stream_frame, stream_ctx);
+        stream_frame = NULL;
+    }
+}
+
+int CmdServer::newest_client() const {
+    int newest = -1;
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        if (clients[i].sock >= 0 && (newest < 0 || (int32_t)(clients[i].serial - clients[newest].serial) > 0)) {
+            newest = i;
+        }
+    }
+    return newest;
+}
+
+void CmdServer::read_client(int slot) {
+    client_t *c = &clients[slot];
+    uint8_t buf[CMD_SERVER_RX_CHUNK];
+    // Drain everything the stack has so one select() round handles a burst
+    while (c->sock >= 0) {
+        ssize_t received = recv(c->sock, buf, sizeof(buf), 0);
+        if (received > 0) {
+            stats.rx_bytes += received;
+            c->active = rounds;
+            current = slot;
+            proto_decoder_feed(&c->decoder, buf, received, on_frame, frame_ctx);
+            current = -1;
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (received < 0) {
+            ESP_LOGE(NET_TAG, "Error occurred during receiving on client %d: errno %d", slot, errno);
+        } else {
+            ESP_LOGI(NET_TAG, "Client %d disconnected", slot);
+        }
+        close_client(slot);
+        stats.disconnects++;
+    }
+}
+
+void CmdServer::write_client(int slot) {
+    client_t *c = &clients[slot];
+    // Queued frames and replies first, then the stream, until the socket is full.
+    // A stream frame partly sent is finished before anything else goes to its
+    // client, so frames never interleave on the wire. New stream frames go to
+    // the newest client, one already started is finished where it started.
+    while (c->sock >= 0) {
+        const uint8_t *data;
+        size_t len;
+        bool mid_stream = stream_frame != NULL && stream_slot == slot && stream_off > 0;
+        bool from_tx = c->tx_len > 0 && !mid_stream;
+        if (from_tx) {
+            data = c->tx_buf;
+            len = c->tx_len;
+        } else {
+            if (stream_frame == NULL && stream_acquire != NULL && slot == newest_client()) {
+                stream_frame = stream_acquire(&stream_len, stream_ctx);
+                stream_off = 0;
+                stream_slot = slot;
+            }
+            if (stream_frame == NULL || stream_slot != slot) {
+                return;
+            }
+            data = stream_frame + stream_off;
+            len = stream_len - stream_off;
+        }
+
+        ssize_t written = ::send(c->sock, data, len, 0);
+        if (written < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            ESP_LOGE(NET_TAG, "Error occurred during sending on client %d: errno %d", slot, errno);
+            close_client(slot);
+            stats.disconnects++;
+            return;
+        }
+        stats.tx_bytes += written;
+
+        if (from_tx) {
+            memmove(c->tx_buf, c->tx_buf + written, c->tx_len - written);
+            c->tx_len -= written;
+        } else {
+            stream_off += written;
+            if (stream_off == stream_len) {
+                stream_release(stream_frame, stream_ctx);
+                stream_frame = NULL;
+                stats.stream_frames++;
+            }
+        }
+    }
+}
+
+void CmdServer::pull_tx() {
+    if (tx_pull == NULL) {
+        return;
+    }
+    int slot = newest_client();
+    client_t *c = &clients[slot < 0 ? 0 : slot];
+    // Stop once the largest frame might not fit, the rest waits in the queue
+    while (sizeof(c->tx_buf) - c->tx_len >= PROTO_MAX_FRAME) {
+        size_t len = tx_pull(c->tx_buf + c->tx_len, sizeof(c->tx_buf) - c->tx_len, tx_ctx);
+        if (len == 0) {
+            break;
+        }
+        if (slot >= 0) {
+            c->tx_len += len;
+        } else {
+            stats.tx_dropped++;     // nobody to send to
+        }
+    }
+}
+
+void CmdServer::read_udp() {
+    uint8_t buf[PROTO_MAX_FRAME];
+    uint8_t newest[PROTO_MAX_FRAME];
+    size_t newest_len = 0;
+
+    // Drain the whole burst first, only its newest frame is worth applying
+    while (1) {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = recvfrom(udp_sock, buf, sizeof(buf), 0, (struct sockaddr *)&from, &from_len);
+        if (len < 0) {
+            break;
+        }
+        stats.udp_rx++;
+        proto_frame_t frame;
+        if (proto_decode_frame(buf, len, &frame) != 0) {
+            stats.udp_bad++;
+            continue;
+        }
+        if (from.sin_addr.s_addr != udp_peer_addr || from.sin_port != udp_peer_port) {
+            udp_peer_addr = from.sin_addr.s_addr;
+            udp_peer_port = from.sin_port;
+            udp_synced = false;
+        }
+        // Serial number arithmetic, the sequence wraps at 16 bits
+        if (udp_synced && (int16_t)(frame.seq - udp_last_seq) <= 0) {
+            stats.udp_stale++;
+            continue;
+        }
+        if (newest_len) {
+            stats.udp_stale++;      // overtaken by this one
+        }
+        udp_last_seq = frame.seq;
+        udp_synced = true;
+        memcpy(newest, buf, len);
+        newest_len = len;
+    }
+
+    proto_frame_t frame;
+    if (newest_len && proto_decode_frame(newest, newest_len, &frame) == 0 && on_datagram) {
+        on_datagram(&frame, datagram_ctx);
+    }
+}
+
+int CmdServer::poll(int timeout_ms) {
+    if (listen_sock < 0) {
+        return -1;
+    }
+    pull_tx();
+
+    fd_set readfds, writefds;
+    FD_ZERO(&readfds);
+    FD_ZERO(&writefds);
+    FD_SET(listen_sock, &readfds);
+    FD_SET(wake_fd, &readfds);
+    int max_fd = listen_sock > wake_fd ? listen_sock : wake_fd;
+    if (udp_sock >= 0) {
+        FD_SET(udp_sock, &readfds);
+        if (udp_sock > max_fd) {
+            max_fd = udp_sock;
+        }
+    }
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        const client_t *c = &clients[i];
+        if (c->sock < 0) {
+            continue;
+        }
+        FD_SET(c->sock, &readfds);
+        if (c->tx_len > 0 || (stream_frame != NULL && stream_slot == i)) {
+            FD_SET(c->sock, &writefds);
+        }
+        if (c->sock > max_fd) {
+            max_fd = c->sock;
+        }
+    }
+
+    struct timeval tv;
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+    int ready = select(max_fd + 1, &readfds, &writefds, NULL, timeout_ms < 0 ? NULL : &tv);
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        ESP_LOGE(NET_TAG, "select failed: errno %d", errno);
+        for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+            close_client(i);
+        }
+        close(listen_sock);
+        listen_sock = -1;
+        return -1;
+    }
+
+    // Teleop first, it is the most latency sensitive
+    if (udp_sock >= 0 && FD_ISSET(udp_sock, &readfds)) {
+        read_udp();
+    }
+    if (FD_ISSET(wake_fd, &readfds)) {
+        uint64_t count;
+        if (read(wake_fd, &count, sizeof(count)) == sizeof(count)) {
+            stats.wakeups++;
+        }
+        pull_tx();
+    }
+    rounds++;
+    // Sockets picked before an accept, a replaced slot holds the new client now
+    int ready_read[CMD_SERVER_MAX_CLIENTS];
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        ready_read[i] = clients[i].sock >= 0 && FD_ISSET(clients[i].sock, &readfds) ? clients[i].sock : -1;
+    }
+    if (FD_ISSET(listen_sock, &readfds)) {
+        accept_client();
+    }
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        if (clients[i].sock >= 0 && clients[i].sock == ready_read[i]) {
+            read_client(i);
+        }
+    }
+    // Replies queued by on_frame and new stream frames go out in the same round
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        if (clients[i].sock >= 0) {
+            write_client(i);
+        }
+    }
+    return 0;
+}
+
+void CmdServer::wake() {
+    uint64_t one = 1;
+    if (write(wake_fd, &one, sizeof(one)) < 0) {
+        // Counter saturated, poll() is already due to run
+    }
+}
+
+void CmdServer::set_stream(cmd_stream_acquire_t acquire, cmd_stream_release_t release, void *ctx) {
+    stream_acquire = acquire;
+    stream_release = release;
+    stream_ctx = ctx;
+}
+
+bool CmdServer::send(const uint8_t *frame, size_t len) {
+    int slot = current >= 0 ? current : newest_client();
+    client_t *c = &clients[slot < 0 ? 0 : slot];
+    if (slot < 0 || c->sock < 0 || len > sizeof(c->tx_buf) - c->tx_len) {
+        stats.tx_dropped++;
+        return false;
+    }
+    memcpy(c->tx_buf + c->tx_len, frame, len);
+    c->tx_len += len;
+    return true;
+}
+
+bool CmdServer::connected() const {
+    return newest_client() >= 0;
+}
+
+int CmdServer::current_client() const {
+    return current;
+}
+
+uint16_t CmdServer::bound_port() const {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    if (listen_sock < 0 || getsockname(listen_sock, (struct sockaddr *)&addr, &len) != 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+uint16_t CmdServer::bound_udp_port() const {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    if (udp_sock < 0 || getsockname(udp_sock, (struct sockaddr *)&addr, &len) != 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+const cmd_server_stats_t &CmdServer::get_stats() const {
+    return stats;
+}
+
+const proto_stats_t &CmdServer::get_proto_stats() const {
+    return clients[last_accepted].decoder.stats;
+}
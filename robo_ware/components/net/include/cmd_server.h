@@ -0,0 +1,161 @@
+#ifndef CMD_SERVER_H
+#define CMD_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "protocol.h"
+
+#define CMD_SERVER_MAX_CLIENTS  3       // TCP connections served at once
+#define CMD_SERVER_TX_BUF       1024    // encoded frames waiting for the socket, per client
+#define CMD_SERVER_RX_CHUNK     512     // bytes per recv()
+
+// Pulls one encoded frame from another task's queue into buf, returns its
+// length or 0 when there is nothing to send. Must not block.
+typedef size_t (*cmd_tx_pull_t)(uint8_t *buf, size_t size, void *ctx);
+
+// Zero copy stream source: acquire lends out the next frame (NULL if none),
+// release returns it once send() has taken all of it
+typedef const uint8_t *(*cmd_stream_acquire_t)(size_t *len, void *ctx);
+typedef void (*cmd_stream_release_t)(const uint8_t *frame, void *ctx);
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t replaced;          // clients dropped because a new one connected with every slot taken
+    uint32_t disconnects;
+    uint32_t rx_bytes;
+    uint32_t tx_bytes;
+    uint32_t tx_dropped;        // frames that did not fit in the tx buffer
+    uint32_t wakeups;
+    uint32_t stream_frames;     // frames sent straight from the stream source
+    uint32_t udp_rx;            // datagrams received
+    uint32_t udp_bad;           // not exactly one valid frame
+    uint32_t udp_stale;         // older than one already delivered, or overtaken in the same burst
+} cmd_server_stats_t;
+
+// Single threaded, select() driven command server. One task owns it and calls
+// poll() in a loop; it serves up to CMD_SERVER_MAX_CLIENTS connections, each
+// in its own slot with its own frame decoder, and only waits for writability
+// while frames are pending. With every slot taken a new connection replaces
+// the one that has been quiet the longest, most likely left half open by a
+// controller that reconnected after a Wi-Fi drop. on_frame can tell the
+// clients apart by current_client().
+//
+// Other tasks hand frames over through their own queue plus wake(), which
+// kicks select() through an eventfd so nothing ever sleeps on a timer.
+// High rate streams (telemetry) instead lend their frames out through
+// set_stream() and are sent from where they were packed; queued frames and
+// replies go first. Queued and streamed frames go to the newest connection,
+// replies to the client that asked.
+// Optionally it also listens for one-frame UDP datagrams (teleop). Those skip
+// the stream decoder and only the newest by sequence number is delivered, out
+// of order or overtaken datagrams are dropped. A new sender address resets
+// the sequence tracking so a restarted joystick app is accepted at once.
+//
+// Builds against lwIP on the ESP32 and BSD sockets on Linux, see hal_socket.h.
+class CmdServer {
+private:
+    uint16_t port;
+    proto_frame_cb_t on_frame;
+    void *frame_ctx;
+    cmd_tx_pull_t tx_pull;
+    void *tx_ctx;
+
+    // One TCP connection
+    typedef struct {
+        int sock;
+        uint32_t serial;            // accept order, the highest is the newest connection
+        uint32_t active;            // poll round that last received from it
+        proto_decoder_t decoder;
+        uint8_t tx_buf[CMD_SERVER_TX_BUF];
+        size_t tx_len;
+    } client_t;
+
+    int listen_sock;
+    client_t clients[CMD_SERVER_MAX_CLIENTS];
+    uint32_t serials;
+    uint32_t rounds;
+    int current;                    // slot on_frame is handling a frame of, -1 otherwise
+    int last_accepted;              // slot, its decoder stats outlive the connection
+    int wake_fd;
+
+    int udp_sock;
+    proto_frame_cb_t on_datagram;
+    void *datagram_ctx;
+    uint32_t udp_peer_addr;
+    uint16_t udp_peer_port;
+    uint16_t udp_last_seq;
+    bool udp_synced;
+
+    cmd_stream_acquire_t stream_acquire;
+    cmd_stream_release_t stream_release;
+    void *stream_ctx;
+    const uint8_t *stream_frame;    // borrowed, partly sent
+    size_t stream_len;
+    size_t stream_off;
+    int stream_slot;                // client it goes to
+
+    cmd_server_stats_t stats;
+
+    void accept_client();
+
+    void close_client(int slot);
+
+    void read_client(int slot);
+
+    void write_client(int slot);
+
+    // Live slot with the highest serial, -1 if none
+    int newest_client() const;
+
+    void pull_tx();
+
+    void read_udp();
+
+public:
+    CmdServer(uint16_t port, proto_frame_cb_t on_frame, void *frame_ctx, cmd_tx_pull_t tx_pull, void *tx_ctx);
+
+    ~CmdServer();
+
+    // Creates the listening socket and the wake eventfd. Returns 0 or -1 (errno set).
+    int open();
+
+    // Adds the UDP teleop socket, on_datagram gets the newest frame of each burst.
+    // Returns 0 or -1 (errno set).
+    int open_udp(uint16_t udp_port, proto_frame_cb_t on_datagram, void *ctx);
+
+    // Frames to send whenever the client can take them, see cmd_stream_acquire_t
+    void set_stream(cmd_stream_acquire_t acquire, cmd_stream_release_t release, void *ctx);
+
+    // Waits up to timeout_ms (-1 forever) and handles whatever is ready.
+    // Returns -1 if the listening socket failed and open() has to be redone.
+    int poll(int timeout_ms);
+
+    // Any task. Makes the owner's poll() return and pull the tx queue.
+    void wake();
+
+    // Owner task only, e.g. from on_frame. Goes to the client whose frame is
+    // being handled, otherwise to the newest one. Returns false if the frame
+    // was dropped.
+    bool send(const uint8_t *frame, size_t len);
+
+    // Any client connected
+    bool connected() const;
+
+    // Slot (0 to CMD_SERVER_MAX_CLIENTS - 1) of the TCP client whose frame
+    // on_frame is handling, -1 outside on_frame and for UDP datagrams. A slot
+    // is reused by a later connection once its client is gone.
+    int current_client() const;
+
+    // Port actually bound, useful after open() with port 0
+    uint16_t bound_port() const;
+
+    uint16_t bound_udp_port() const;
+
+    const cmd_server_stats_t &get_stats() const;
+
+    // Decoder of the newest connection, or the last one if it closed
+    const proto_stats_t &get_proto_stats() const;
+};
+
+#endif // CMD_SERVER_H
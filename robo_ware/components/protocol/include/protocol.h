@@ -0,0 +1,173 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Binary command frames, used on every link (TCP, UART, ...). All fields little endian.
+ *
+ *   0  2  magic        PROTO_MAGIC0 PROTO_MAGIC1
+ *   2  1  version      PROTO_VERSION
+ *   3  1  type         proto_msg_t
+ *   4  2  length       payload bytes, at most PROTO_MAX_PAYLOAD
+ *   6  2  seq          sender sequence number, wraps
+ *   8  n  payload
+ * 8+n  2  crc          CRC-16/CCITT-FALSE over version..payload
+ */
+#define PROTO_MAGIC0            0xA5
+#define PROTO_MAGIC1            0x5A
+#define PROTO_VERSION           1
+#define PROTO_HEADER_LEN        8
+#define PROTO_CRC_LEN           2
+#define PROTO_MAX_PAYLOAD       240
+#define PROTO_MAX_FRAME         (PROTO_HEADER_LEN + PROTO_MAX_PAYLOAD + PROTO_CRC_LEN)
+
+typedef enum {
+    PROTO_MSG_LEG_TARGETS   = 0x01,     // n x proto_leg_target_t
+    PROTO_MSG_SERVO_ANGLES  = 0x02,     // n x proto_servo_angle_t
+    PROTO_MSG_GAIT          = 0x03,     // one proto_gait_t
+    PROTO_MSG_CALIB         = 0x04,     // one proto_calib_t
+    PROTO_MSG_PING          = 0x10,     // any payload, answered with a PONG carrying it back
+    PROTO_MSG_PONG          = 0x11,
+    PROTO_MSG_SCHED_REQ     = 0x12,     // no payload, answered with a PROTO_MSG_SCHED
+    PROTO_MSG_TRACE_REQ     = 0x13,     // trace.h, answered with PROTO_MSG_TRACE_STATS and maybe PROTO_MSG_TRACE
+    PROTO_MSG_TELEMETRY     = 0x20,     // telemetry.h
+    PROTO_MSG_SCHED         = 0x21,     // proto_sched_t, then n x proto_sched_task_t
+    PROTO_MSG_TRACE_STATS   = 0x22,     // trace.h
+    PROTO_MSG_TRACE         = 0x23,     // trace.h
+} proto_msg_t;
+
+// Foot target, 5 bytes on the wire: leg, x, y
+#define PROTO_LEG_TARGET_LEN    5
+typedef struct {
+    uint8_t leg;        // leg_id_t
+    int16_t x_q4;       // mm, Q4
+    int16_t y_q4;
+} proto_leg_target_t;
+
+// Direct servo angle, 3 bytes on the wire: servo, angle
+#define PROTO_SERVO_ANGLE_LEN   3
+typedef struct {
+    uint8_t servo;      // 1-4, same numbering as LegSystem::set_servo_angle
+    int16_t angle;      // degrees
+} proto_servo_angle_t;
+
+// Walking gait, 13 bytes on the wire. Step length and height 0 stops it.
+#define PROTO_GAIT_LEN          13
+typedef struct {
+    uint16_t period_ms;         // one full cycle
+    int16_t step_length_q4;     // mm, Q4
+    int16_t step_height_q4;
+    int16_t center_x_q4;
+    int16_t stand_y_q4;
+    uint16_t phase_offset;      // right leg ahead of the left, 65536 is one cycle
+    uint8_t stance_pct;         // share of the cycle on the ground
+} proto_gait_t;
+
+// Calibration curve of one servo, 20 bytes on the wire: servo, flags, pulse widths
+#define PROTO_CALIB_LEN         20
+#define PROTO_CALIB_POINTS      9       // nominal -90 to 90 degrees every 22.5
+#define PROTO_CALIB_SAVE        0x01    // flags: also store it in flash
+typedef struct {
+    uint8_t servo;              // 0-3: left front, left rear, right front, right rear
+    uint8_t flags;
+    uint16_t pulse_us[PROTO_CALIB_POINTS];
+} proto_calib_t;
+
+// CPU report, 20 bytes on the wire: window, then load and worst task wakeup
+// latency of each core over that window
+#define PROTO_SCHED_LEN         20
+#define PROTO_SCHED_CORES       2
+typedef struct {
+    uint32_t window_us;                         // since the previous report
+    uint16_t load_permille[PROTO_SCHED_CORES];  // everything but the idle task
+    uint32_t latency_max_us[PROTO_SCHED_CORES];
+} proto_sched_t;
+
+// One task of a CPU report, 18 bytes on the wire
+#define PROTO_SCHED_TASK_LEN    18
+#define PROTO_SCHED_NAME_LEN    12
+#define PROTO_SCHED_ANY_CORE    0xFF
+typedef struct {
+    char name[PROTO_SCHED_NAME_LEN + 1];        // cut to 12 characters on the wire
+    uint8_t core;               // PROTO_SCHED_ANY_CORE for a task without affinity
+    uint8_t prio;
+    uint16_t share_permille;    // of one core over the window
+    uint16_t stack_free;        // bytes, high-water mark
+} proto_sched_task_t;
+
+#define PROTO_MAX_SCHED_TASKS   ((PROTO_MAX_PAYLOAD - PROTO_SCHED_LEN) / PROTO_SCHED_TASK_LEN)
+
+#define PROTO_MAX_LEG_TARGETS   (PROTO_MAX_PAYLOAD / PROTO_LEG_TARGET_LEN)
+#define PROTO_MAX_SERVO_ANGLES  (PROTO_MAX_PAYLOAD / PROTO_SERVO_ANGLE_LEN)
+
+// A decoded frame. payload points into the decoder buffer and is only valid
+// inside the callback.
+typedef struct {
+    uint8_t version;
+    uint8_t type;
+    uint16_t seq;
+    uint16_t len;
+    const uint8_t *payload;
+} proto_frame_t;
+
+typedef struct {
+    uint32_t frames;        // valid frames delivered
+    uint32_t crc_errors;
+    uint32_t bad_version;
+    uint32_t oversize;      // length field above PROTO_MAX_PAYLOAD
+    uint32_t skipped;       // bytes thrown away while hunting for the next magic
+    uint32_t seq_gaps;      // frames missing between two valid ones
+} proto_stats_t;
+
+typedef void (*proto_frame_cb_t)(const proto_frame_t *frame, void *ctx);
+
+// Streaming decoder, the byte stream may be split anywhere between feeds.
+// Corrupt frames are skipped and the decoder resyncs on the next magic.
+typedef struct {
+    uint8_t buf[PROTO_MAX_FRAME];
+    uint16_t fill;
+    uint16_t expect;        // full frame length once the header is in, 0 before
+    uint16_t next_seq;
+    bool synced_seq;
+    proto_stats_t stats;
+} proto_decoder_t;
+
+uint16_t proto_crc16(const uint8_t *data, size_t len, uint16_t crc);
+
+void proto_decoder_init(proto_decoder_t *dec);
+
+void proto_decoder_feed(proto_decoder_t *dec, const uint8_t *data, size_t len, proto_frame_cb_t on_frame, void *ctx);
+
+// Decodes a buffer holding exactly one frame, e.g. a UDP datagram. Returns 0 or -1.
+int proto_decode_frame(const uint8_t *data, size_t len, proto_frame_t *frame);
+
+// Builds a frame into out. Returns the frame length or 0 if it doesn't fit.
+size_t proto_encode(uint8_t type, uint16_t seq, const uint8_t *payload, uint16_t len, uint8_t *out, size_t out_size);
+
+size_t proto_encode_leg_targets(uint16_t seq, const proto_leg_target_t *targets, size_t count,
+                                uint8_t *out, size_t out_size);
+
+size_t proto_encode_servo_angles(uint16_t seq, const proto_servo_angle_t *angles, size_t count,
+                                 uint8_t *out, size_t out_size);
+
+size_t proto_encode_gait(uint16_t seq, const proto_gait_t *gait, uint8_t *out, size_t out_size);
+
+size_t proto_encode_calib(uint16_t seq, const proto_calib_t *calib, uint8_t *out, size_t out_size);
+
+size_t proto_encode_sched(uint16_t seq, const proto_sched_t *sched, const proto_sched_task_t *tasks, size_t count,
+                          uint8_t *out, size_t out_size);
+
+// Payload parsers. Return the number of records or -1 for a malformed payload.
+int proto_parse_leg_targets(const proto_frame_t *frame, proto_leg_target_t *out, size_t max);
+
+int proto_parse_servo_angles(const proto_frame_t *frame, proto_servo_angle_t *out, size_t max);
+
+int proto_parse_gait(const proto_frame_t *frame, proto_gait_t *out);
+
+int proto_parse_calib(const proto_frame_t *frame, proto_calib_t *out);
+
+// Returns the number of tasks or -1
+int proto_parse_sched(const proto_frame_t *frame, proto_sched_t *sched, proto_sched_task_t *tasks, size_t max);
+
+#endif // PROTOCOL_H
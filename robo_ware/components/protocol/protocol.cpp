@@ -0,0 +1,358 @@
+#include "protocol.h"
+
+#include <string.h>
+
+// CRC-16/CCITT-FALSE, poly 0x1021, one table lookup per byte. Built at compile
+// time so it lives in flash and needs no init.
+struct crc_table_t {
+    uint16_t v[256];
+    constexpr crc_table_t() : v() {
+        for (int i = 0; i < 256; i++) {
+            uint16_t crc = (uint16_t)(i << 8);
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+            }
+            v[i] = crc;
+        }
+    }
+};
+static constexpr crc_table_t crc_table;
+
+uint16_t proto_crc16(const uint8_t *data, size_t len, uint16_t crc) {
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 8) ^ crc_table.v[(crc >> 8) ^ data[i]]);
+    }
+    return crc;
+}
+
+static inline uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+void proto_decoder_init(proto_decoder_t *dec) {
+    memset(dec, 0, sizeof(*dec));
+}
+
+// Throws away the first n buffered bytes
+static void decoder_drop(proto_decoder_t *dec, uint16_t n) {
+    memmove(dec->buf, dec->buf + n, dec->fill - n);
+    dec->fill -= n;
+    dec->expect = 0;
+}
+
+// Makes buf start with a magic (or a lone first magic byte at the end), or empties it
+static void decoder_hunt(proto_decoder_t *dec) {
+    uint16_t i = 0;
+    while (i < dec->fill) {
+        const uint8_t *m = (const uint8_t *)memchr(dec->buf + i, PROTO_MAGIC0, dec->fill - i);
+        if (m == NULL) {
+            i = dec->fill;
+            break;
+        }
+        i = (uint16_t)(m - dec->buf);
+        if (i + 1 == dec->fill || dec->buf[i + 1] == PROTO_MAGIC1) {
+            break;
+        }
+        i++;
+    }
+    if (i) {
+        dec->stats.skipped += i;
+        decoder_drop(dec, i);
+    }
+}
+
+// Checks and delivers whatever is buffered. Returns false when more bytes are needed.
+static bool decoder_step(proto_decoder_t *dec, proto_frame_cb_t on_frame, void *ctx) {
+    decoder_hunt(dec);
+    if (dec->expect == 0) {
+        if (dec->fill < PROTO_HEADER_LEN) {
+            return false;
+        }
+        uint16_t len = get_u16(dec->buf + 4);
+        if (dec->buf[2] != PROTO_VERSION) {
+            dec->stats.bad_version++;
+            dec->stats.skipped++;
+            decoder_drop(dec, 1);
+            return true;
+        }
+        if (len > PROTO_MAX_PAYLOAD) {
+            dec->stats.oversize++;
+            dec->stats.skipped++;
+            decoder_drop(dec, 1);
+            return true;
+        }
+        dec->expect = (uint16_t)(PROTO_HEADER_LEN + len + PROTO_CRC_LEN);
+    }
+    if (dec->fill < dec->expect) {
+        return false;
+    }
+
+    uint16_t frame_len = dec->expect;
+    uint16_t payload_len = (uint16_t)(frame_len - PROTO_HEADER_LEN - PROTO_CRC_LEN);
+    uint16_t crc = proto_crc16(dec->buf + 2, frame_len - 2 - PROTO_CRC_LEN, 0xFFFF);
+    if (crc != get_u16(dec->buf + frame_len - PROTO_CRC_LEN)) {
+        // Likely a magic inside another frame's payload, rescan from the next byte
+        dec->stats.crc_errors++;
+        dec->stats.skipped++;
+        decoder_drop(dec, 1);
+        return true;
+    }
+
+    proto_frame_t frame;
+    frame.version = dec->buf[2];
+    frame.type = dec->buf[3];
+    frame.len = payload_len;
+    frame.seq = get_u16(dec->buf + 6);
+    frame.payload = dec->buf + PROTO_HEADER_LEN;
+
+    if (dec->synced_seq && frame.seq != dec->next_seq) {
+        dec->stats.seq_gaps += (uint16_t)(frame.seq - dec->next_seq);
+    }
+    dec->next_seq = (uint16_t)(frame.seq + 1);
+    dec->synced_seq = true;
+    dec->stats.frames++;
+
+    if (on_frame) {
+        on_frame(&frame, ctx);
+    }
+    decoder_drop(dec, frame_len);
+    return true;
+}
+
+void proto_decoder_feed(proto_decoder_t *dec, const uint8_t *data, size_t len, proto_frame_cb_t on_frame, void *ctx) {
+    while (len > 0) {
+        // Copy as much as fits, then drain complete frames out of the buffer
+        size_t room = sizeof(dec->buf) - dec->fill;
+        size_t n = len < room ? len : room;
+        memcpy(dec->buf + dec->fill, data, n);
+        dec->fill = (uint16_t)(dec->fill + n);
+        data += n;
+        len -= n;
+        while (decoder_step(dec, on_frame, ctx)) {
+        }
+    }
+}
+
+int proto_decode_frame(const uint8_t *data, size_t len, proto_frame_t *frame) {
+    if (len < PROTO_HEADER_LEN + PROTO_CRC_LEN || data[0] != PROTO_MAGIC0 || data[1] != PROTO_MAGIC1 ||
+        data[2] != PROTO_VERSION) {
+        return -1;
+    }
+    uint16_t payload_len = get_u16(data + 4);
+    if (payload_len > PROTO_MAX_PAYLOAD || len != (size_t)(PROTO_HEADER_LEN + payload_len + PROTO_CRC_LEN)) {
+        return -1;
+    }
+    if (proto_crc16(data + 2, len - 2 - PROTO_CRC_LEN, 0xFFFF) != get_u16(data + len - PROTO_CRC_LEN)) {
+        return -1;
+    }
+    frame->version = data[2];
+    frame->type = data[3];
+    frame->len = payload_len;
+    frame->seq = get_u16(data + 6);
+    frame->payload = data + PROTO_HEADER_LEN;
+    return 0;
+}
+
+size_t proto_encode(uint8_t type, uint16_t seq, const uint8_t *payload, uint16_t len, uint8_t *out, size_t out_size) {
+    size_t frame_len = PROTO_HEADER_LEN + len + PROTO_CRC_LEN;
+    if (len > PROTO_MAX_PAYLOAD || frame_len > out_size) {
+        return 0;
+    }
+    out[0] = PROTO_MAGIC0;
+    out[1] = PROTO_MAGIC1;
+    out[2] = PROTO_VERSION;
+    out[3] = type;
+    put_u16(out + 4, len);
+    put_u16(out + 6, seq);
+    if (len && payload != out + PROTO_HEADER_LEN) {
+        memmove(out + PROTO_HEADER_LEN, payload, len);
+    }
+    put_u16(out + PROTO_HEADER_LEN + len, proto_crc16(out + 2, PROTO_HEADER_LEN - 2 + len, 0xFFFF));
+    return frame_len;
+}
+
+// The encoders serialize straight into the frame buffer, proto_encode then
+// only fills in the header and CRC
+size_t proto_encode_leg_targets(uint16_t seq, const proto_leg_target_t *targets, size_t count,
+                                uint8_t *out, size_t out_size) {
+    if (count > PROTO_MAX_LEG_TARGETS || out_size < PROTO_HEADER_LEN + count * PROTO_LEG_TARGET_LEN + PROTO_CRC_LEN) {
+        return 0;
+    }
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    for (size_t i = 0; i < count; i++, p += PROTO_LEG_TARGET_LEN) {
+        p[0] = targets[i].leg;
+        put_u16(p + 1, (uint16_t)targets[i].x_q4);
+        put_u16(p + 3, (uint16_t)targets[i].y_q4);
+    }
+    return proto_encode(PROTO_MSG_LEG_TARGETS, seq, out + PROTO_HEADER_LEN, (uint16_t)(count * PROTO_LEG_TARGET_LEN),
+                        out, out_size);
+}
+
+size_t proto_encode_servo_angles(uint16_t seq, const proto_servo_angle_t *angles, size_t count,
+                                 uint8_t *out, size_t out_size) {
+    if (count > PROTO_MAX_SERVO_ANGLES || out_size < PROTO_HEADER_LEN + count * PROTO_SERVO_ANGLE_LEN + PROTO_CRC_LEN) {
+        return 0;
+    }
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    for (size_t i = 0; i < count; i++, p += PROTO_SERVO_ANGLE_LEN) {
+        p[0] = angles[i].servo;
+        put_u16(p + 1, (uint16_t)angles[i].angle);
+    }
+    return proto_encode(PROTO_MSG_SERVO_ANGLES, seq, out + PROTO_HEADER_LEN, (uint16_t)(count * PROTO_SERVO_ANGLE_LEN),
+                        out, out_size);
+}
+
+size_t proto_encode_gait(uint16_t seq, const proto_gait_t *gait, uint8_t *out, size_t out_size) {
+    if (out_size < PROTO_HEADER_LEN + PROTO_GAIT_LEN + PROTO_CRC_LEN) {
+        return 0;
+    }
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    put_u16(p, gait->period_ms);
+    put_u16(p + 2, (uint16_t)gait->step_length_q4);
+    put_u16(p + 4, (uint16_t)gait->step_height_q4);
+    put_u16(p + 6, (uint16_t)gait->center_x_q4);
+    put_u16(p + 8, (uint16_t)gait->stand_y_q4);
+    put_u16(p + 10, gait->phase_offset);
+    p[12] = gait->stance_pct;
+    return proto_encode(PROTO_MSG_GAIT, seq, out + PROTO_HEADER_LEN, PROTO_GAIT_LEN, out, out_size);
+}
+
+size_t proto_encode_calib(uint16_t seq, const proto_calib_t *calib, uint8_t *out, size_t out_size) {
+    if (out_size < PROTO_HEADER_LEN + PROTO_CALIB_LEN + PROTO_CRC_LEN) {
+        return 0;
+    }
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    p[0] = calib->servo;
+    p[1] = calib->flags;
+    for (int i = 0; i < PROTO_CALIB_POINTS; i++) {
+        put_u16(p + 2 + 2 * i, calib->pulse_us[i]);
+    }
+    return proto_encode(PROTO_MSG_CALIB, seq, out + PROTO_HEADER_LEN, PROTO_CALIB_LEN, out, out_size);
+}
+
+size_t proto_encode_sched(uint16_t seq, const proto_sched_t *sched, const proto_sched_task_t *tasks, size_t count,
+                          uint8_t *out, size_t out_size) {
+    size_t len = PROTO_SCHED_LEN + count * PROTO_SCHED_TASK_LEN;
+    if (count > PROTO_MAX_SCHED_TASKS || out_size < PROTO_HEADER_LEN + len + PROTO_CRC_LEN) {
+        return 0;
+    }
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    put_u32(p, sched->window_us);
+    for (int c = 0; c < PROTO_SCHED_CORES; c++) {
+        put_u16(p + 4 + 2 * c, sched->load_permille[c]);
+        put_u32(p + 8 + 4 * c, sched->latency_max_us[c]);
+    }
+    p += PROTO_SCHED_LEN;
+    for (size_t i = 0; i < count; i++, p += PROTO_SCHED_TASK_LEN) {
+        // Zero padded, a name of exactly 12 characters has no terminator
+        memset(p, 0, PROTO_SCHED_NAME_LEN);
+        memcpy(p, tasks[i].name, strnlen(tasks[i].name, PROTO_SCHED_NAME_LEN));
+        p[12] = tasks[i].core;
+        p[13] = tasks[i].prio;
+        put_u16(p + 14, tasks[i].share_permille);
+        put_u16(p + 16, tasks[i].stack_free);
+    }
+    return proto_encode(PROTO_MSG_SCHED, seq, out + PROTO_HEADER_LEN, (uint16_t)len, out, out_size);
+}
+
+int proto_parse_leg_targets(const proto_frame_t *frame, proto_leg_target_t *out, size_t max) {
+    if (frame->type != PROTO_MSG_LEG_TARGETS || frame->len % PROTO_LEG_TARGET_LEN) {
+        return -1;
+    }
+    size_t count = frame->len / PROTO_LEG_TARGET_LEN;
+    if (count > max) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    for (size_t i = 0; i < count; i++, p += PROTO_LEG_TARGET_LEN) {
+        out[i].leg = p[0];
+        out[i].x_q4 = (int16_t)get_u16(p + 1);
+        out[i].y_q4 = (int16_t)get_u16(p + 3);
+    }
+    return (int)count;
+}
+
+int proto_parse_servo_angles(const proto_frame_t *frame, proto_servo_angle_t *out, size_t max) {
+    if (frame->type != PROTO_MSG_SERVO_ANGLES || frame->len % PROTO_SERVO_ANGLE_LEN) {
+        return -1;
+    }
+    size_t count = frame->len / PROTO_SERVO_ANGLE_LEN;
+    if (count > max) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    for (size_t i = 0; i < count; i++, p += PROTO_SERVO_ANGLE_LEN) {
+        out[i].servo = p[0];
+        out[i].angle = (int16_t)get_u16(p + 1);
+    }
+    return (int)count;
+}
+
+int proto_parse_gait(const proto_frame_t *frame, proto_gait_t *out) {
+    if (frame->type != PROTO_MSG_GAIT || frame->len != PROTO_GAIT_LEN) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    out->period_ms = get_u16(p);
+    out->step_length_q4 = (int16_t)get_u16(p + 2);
+    out->step_height_q4 = (int16_t)get_u16(p + 4);
+    out->center_x_q4 = (int16_t)get_u16(p + 6);
+    out->stand_y_q4 = (int16_t)get_u16(p + 8);
+    out->phase_offset = get_u16(p + 10);
+    out->stance_pct = p[12];
+    return 1;
+}
+
+int proto_parse_calib(const proto_frame_t *frame, proto_calib_t *out) {
+    if (frame->type != PROTO_MSG_CALIB || frame->len != PROTO_CALIB_LEN) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    out->servo = p[0];
+    out->flags = p[1];
+    for (int i = 0; i < PROTO_CALIB_POINTS; i++) {
+        out->pulse_us[i] = get_u16(p + 2 + 2 * i);
+    }
+    return 1;
+}
+
+int proto_parse_sched(const proto_frame_t *frame, proto_sched_t *sched, proto_sched_task_t *tasks, size_t max) {
+    if (frame->type != PROTO_MSG_SCHED || frame->len < PROTO_SCHED_LEN ||
+        (frame->len - PROTO_SCHED_LEN) % PROTO_SCHED_TASK_LEN) {
+        return -1;
+    }
+    size_t count = (frame->len - PROTO_SCHED_LEN) / PROTO_SCHED_TASK_LEN;
+    if (count > max) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    sched->window_us = get_u32(p);
+    for (int c = 0; c < PROTO_SCHED_CORES; c++) {
+        sched->load_permille[c] = get_u16(p + 4 + 2 * c);
+        sched->latency_max_us[c] = get_u32(p + 8 + 4 * c);
+    }
+    p += PROTO_SCHED_LEN;
+    for (size_t i = 0; i < count; i++, p += PROTO_SCHED_TASK_LEN) {
+        memcpy(tasks[i].name, p, PROTO_SCHED_NAME_LEN);
+        tasks[i].name[PROTO_SCHED_NAME_LEN] = 0;
+        tasks[i].core = p[12];
+        tasks[i].prio = p[13];
+        tasks[i].share_permille = get_u16(p + 14);
+        tasks[i].stack_free = get_u16(p + 16);
+    }
+    return (int)count;
+}
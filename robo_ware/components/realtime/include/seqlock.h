@@ -0,0 +1,86 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+#define SEQLOCK_READ_RETRIES    4
+
+// Single writer, any number of readers, latest value only. version is odd
+// while the writer copies, the value lives in relaxed atomic words so a racing
+// read is well defined, and a reader that sees the version change under it
+// retries. T must be trivially copyable.
+template <typename T>
+class Seqlock {
+private:
+    static const uint32_t WORDS = (sizeof(T) + 3) / 4;
+
+    std::atomic<uint32_t> version;
+    std::atomic<uint32_t> slot[WORDS];
+
+public:
+    Seqlock() : version(0)
+    {
+        for (uint32_t i = 0; i < WORDS; i++) {
+            slot[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer, never blocks
+    void write(const T &value)
+    {
+        uint32_t words[WORDS] = {};
+        memcpy(words, &value, sizeof(value));
+        uint32_t v = version.load(std::memory_order_relaxed);
+        version.store(v + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (uint32_t i = 0; i < WORDS; i++) {
+            slot[i].store(words[i], std::memory_order_relaxed);
+        }
+        version.store(v + 2, std::memory_order_release);
+    }
+
+    // Reader. False if nothing was written yet or every retry was torn by a
+    // writer preempted mid copy; *value is left untouched then.
+    bool read(T *value) const
+    {
+        uint32_t writes;
+        return read(value, &writes);
+    }
+
+    // Reader. *writes is the writes() count of the value read, a reader that
+    // remembers it can't take one value for two.
+    bool read(T *value, uint32_t *writes) const
+    {
+        for (int attempt = 0; attempt < SEQLOCK_READ_RETRIES; attempt++) {
+            uint32_t v = version.load(std::memory_order_acquire);
+            if (v == 0) {
+                return false;
+            }
+            if (v & 1) {
+                continue;
+            }
+            uint32_t words[WORDS];
+            for (uint32_t i = 0; i < WORDS; i++) {
+                words[i] = slot[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) != v) {
+                continue;
+            }
+            memcpy(value, words, sizeof(*value));
+            *writes = v / 2;
+            return true;
+        }
+        return false;
+    }
+
+    // Bumped by every write, lets a reader tell a new value from a re-read
+    uint32_t writes() const
+    {
+        return version.load(std::memory_order_acquire) / 2;
+    }
+};
+
+#endif // SEQLOCK_H
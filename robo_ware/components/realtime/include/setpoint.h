@@ -0,0 +1,32 @@
+#ifndef SETPOINT_H
+#define SETPOINT_H
+
+#include <stdint.h>
+#include "spsc_ring.h"
+
+#define SETPOINT_RING_SIZE      64
+
+typedef enum {
+    LEG_LEFT = 0,
+    LEG_RIGHT = 1,
+} leg_id_t;
+
+typedef enum {
+    SETPOINT_FOOT = 0,      // foot target, leg/x_q4/y_q4
+    SETPOINT_SERVO = 1,     // direct servo angle, leg holds the servo number 1-4
+} setpoint_kind_t;
+
+// One command for the control task, stamped when it entered the firmware
+typedef struct {
+    uint32_t timestamp_us;
+    int16_t x_q4;           // mm, Q4
+    int16_t y_q4;
+    uint8_t leg;
+    uint8_t kind;           // setpoint_kind_t
+    int16_t angle;          // degrees, SETPOINT_SERVO only
+} setpoint_t;
+
+// Network task -> control task
+typedef SpscRing<setpoint_t, SETPOINT_RING_SIZE> SetpointRing;
+
+#endif // SETPOINT_H
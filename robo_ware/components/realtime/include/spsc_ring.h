@@ -0,0 +1,82 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Lock free single producer / single consumer ring. One task pushes, one task
+// pops, neither ever blocks or enters the kernel. head is only written by the
+// producer and tail only by the consumer; the release store of each index
+// publishes the slot contents to the other side, so records are never seen torn.
+//
+// N must be a power of two. The indices run freely and wrap at 2^32.
+template <typename T, uint32_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+private:
+    // Separate cache lines on the host, harmless padding on the ESP32
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+    alignas(64) std::atomic<uint32_t> dropped;     // written by the producer only
+    T slots[N];
+
+public:
+    SpscRing() : head(0), tail(0), dropped(0) {}
+
+    // Producer. Returns false (and counts a drop) when the ring is full.
+    bool push(const T &item)
+    {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer. Copies the oldest record without removing it.
+    bool peek(T *item) const
+    {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        *item = slots[t & (N - 1)];
+        return true;
+    }
+
+    // Consumer. Removes the oldest record.
+    bool pop(T *item)
+    {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        *item = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side, a snapshot that may be stale by the time it returns
+    uint32_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    // Either side
+    uint32_t drops() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    static constexpr uint32_t capacity()
+    {
+        return N;
+    }
+};
+
+#endif // SPSC_RING_H
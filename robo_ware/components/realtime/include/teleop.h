@@ -0,0 +1,70 @@
+#ifndef TELEOP_H
+#define TELEOP_H
+
+#include <stdint.h>
+
+#include "seqlock.h"
+
+// Newest foot targets from the teleop link
+typedef struct {
+    uint32_t timestamp_us;  // when the datagram arrived
+    uint16_t seq;
+    uint8_t legs;           // bit (1 << leg_id_t) for every leg present
+    uint8_t reserved;
+    int16_t x_q4[2];        // by leg_id_t
+    int16_t y_q4[2];
+} teleop_cmd_t;
+
+typedef enum {
+    TELEOP_IDLE = 0,        // nothing received since start or since the last timeout
+    TELEOP_NEW,             // a newer command than last time, apply it
+    TELEOP_HOLD,            // still the same command, within the watchdog time
+    TELEOP_TIMEOUT,         // reported once when commands stop, park the legs
+} teleop_event_t;
+
+// Single slot mailbox: the network task overwrites it, the control task reads
+// the latest command once per period and never sees a queue of stale ones.
+// The slot is a Seqlock; a read torn SEQLOCK_READ_RETRIES times (the writer
+// was preempted mid copy) counts as "no new command" for the period. On top
+// of it the reader keeps the watchdog.
+class TeleopMailbox {
+private:
+    Seqlock<teleop_cmd_t> slot;
+
+    // Reader side only
+    uint32_t seen;              // slot writes already returned
+    uint32_t last_us;
+    bool active;
+    uint32_t timeout_us;
+
+public:
+    explicit TeleopMailbox(uint32_t timeout_us) : seen(0), last_us(0), active(false), timeout_us(timeout_us) {}
+
+    // Writer
+    void publish(const teleop_cmd_t &cmd)
+    {
+        slot.write(cmd);
+    }
+
+    // Reader. now_us on the same clock as the command timestamps.
+    teleop_event_t poll(uint32_t now_us, teleop_cmd_t *cmd)
+    {
+        uint32_t writes;
+        if (slot.writes() != seen && slot.read(cmd, &writes) && writes != seen) {
+            seen = writes;
+            last_us = cmd->timestamp_us;
+            active = true;
+            return TELEOP_NEW;
+        }
+        if (!active) {
+            return TELEOP_IDLE;
+        }
+        if (now_us - last_us > timeout_us) {
+            active = false;
+            return TELEOP_TIMEOUT;
+        }
+        return TELEOP_HOLD;
+    }
+};
+
+#endif // TELEOP_H
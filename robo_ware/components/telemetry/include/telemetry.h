@@ -0,0 +1,107 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "imu_sample.h"
+#include "protocol.h"
+
+/* PROTO_MSG_TELEMETRY payload, fixed size, little endian:
+ *
+ *   0  4  timestamp_us     when the frame was packed
+ *   4  4  sample           frame counter, gaps mean overwritten frames
+ *   8  8  servo_ticks[4]   compare values: left front, left rear, right front, right rear
+ *  16  1  imu_count        valid entries in imu[]
+ *  17  1  flags            TELEMETRY_FLAG_*
+ *  18 18  imu[TELEMETRY_MAX_IMU]: timestamp_us, accel[3], gyro[3], temp
+ *  90  2  foot_x_q4[2]     estimated foot positions, Q4 mm, left then right
+ *  94  2  foot_y_q4[2]
+ *  98  2  height_q4        body height over the lower foot, Q4 mm
+ *
+ * The feet are only meaningful with their TELEMETRY_FLAG_FOOT_* bit set.
+ * Frames from before the feet block end at offset 90, telemetry_parse()
+ * still takes them.
+ */
+#define TELEMETRY_SERVOS            4
+#define TELEMETRY_MAX_IMU           4       // IMU samples per frame, covers 1kHz IMU at 250Hz telemetry
+#define TELEMETRY_IMU_LEN           18
+#define TELEMETRY_IMU_OFFSET        18
+#define TELEMETRY_FEET_OFFSET       (TELEMETRY_IMU_OFFSET + TELEMETRY_MAX_IMU * TELEMETRY_IMU_LEN)
+#define TELEMETRY_FEET_LEN          10
+#define TELEMETRY_PAYLOAD_LEN       (TELEMETRY_FEET_OFFSET + TELEMETRY_FEET_LEN)
+#define TELEMETRY_FRAME_LEN         (PROTO_HEADER_LEN + TELEMETRY_PAYLOAD_LEN + PROTO_CRC_LEN)
+
+static_assert(TELEMETRY_PAYLOAD_LEN <= PROTO_MAX_PAYLOAD, "telemetry frame too large");
+
+// flags, one bit per leg_id_t
+#define TELEMETRY_FLAG_FOOT_LEFT    (1 << 0)
+#define TELEMETRY_FLAG_FOOT_RIGHT   (1 << 1)
+
+// Writers for a frame handed out by TelemetryBuffer::begin(). Fields go
+// straight to their wire position, there is no intermediate struct.
+void telemetry_put_header(uint8_t *frame, uint32_t timestamp_us, uint32_t sample);
+
+void telemetry_put_servos(uint8_t *frame, const uint16_t ticks[TELEMETRY_SERVOS]);
+
+// Appends one IMU sample, returns false once TELEMETRY_MAX_IMU are in
+bool telemetry_put_imu(uint8_t *frame, const imu_sample_t *imu);
+
+// Foot estimate of the control loop, valid has a bit (1 << leg) per solved foot
+void telemetry_put_feet(uint8_t *frame, const int16_t x_q4[2], const int16_t y_q4[2], int16_t height_q4,
+                        uint8_t valid);
+
+// Reader for the host side
+typedef struct {
+    uint32_t timestamp_us;
+    uint32_t sample;
+    uint16_t servo_ticks[TELEMETRY_SERVOS];
+    uint8_t imu_count;
+    uint8_t flags;
+    imu_sample_t imu[TELEMETRY_MAX_IMU];
+    int16_t foot_x_q4[2];
+    int16_t foot_y_q4[2];
+    int16_t height_q4;
+} telemetry_frame_t;
+
+int telemetry_parse(const proto_frame_t *frame, telemetry_frame_t *out);
+
+// Double buffered frame region between one producer (the telemetry task) and
+// one consumer (the network task, which send()s straight out of the slot).
+//
+// Each slot is FREE, WRITING, READY or SENDING. At most one slot is SENDING,
+// so the producer always finds the other one to write; if that one still
+// holds an unsent frame it is overwritten (newest wins) and counted. The
+// consumer takes READY slots oldest first. Slot ownership moves with CAS, so
+// neither side ever blocks.
+class TelemetryBuffer {
+private:
+    enum : uint8_t { SLOT_FREE, SLOT_WRITING, SLOT_READY, SLOT_SENDING };
+
+    alignas(4) uint8_t slots[2][TELEMETRY_FRAME_LEN];
+    std::atomic<uint8_t> state[2];
+    std::atomic<uint32_t> order[2];     // commit order, written before the READY release
+    uint32_t commits;           // producer only
+    uint32_t overwritten;       // producer only
+    int writing;                // producer only, slot between begin() and commit()
+
+public:
+    TelemetryBuffer();
+
+    // Producer. Returns the frame to fill, never NULL.
+    uint8_t *begin();
+
+    // Producer. Fills in header and CRC and publishes the frame.
+    void commit(uint16_t seq);
+
+    // Consumer. Oldest published frame, TELEMETRY_FRAME_LEN bytes, or NULL.
+    const uint8_t *acquire();
+
+    // Consumer. Hands the slot back once the frame is sent.
+    void release(const uint8_t *frame);
+
+    uint32_t overwrites() const;
+};
+
+#endif // TELEMETRY_H
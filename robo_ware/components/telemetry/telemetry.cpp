@@ -0,0 +1,188 @@
+#include "telemetry.h"
+
+#include <string.h>
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void telemetry_put_header(uint8_t *frame, uint32_t timestamp_us, uint32_t sample) {
+    uint8_t *p = frame + PROTO_HEADER_LEN;
+    put_u32(p, timestamp_us);
+    put_u32(p + 4, sample);
+}
+
+void telemetry_put_servos(uint8_t *frame, const uint16_t ticks[TELEMETRY_SERVOS]) {
+    uint8_t *p = frame + PROTO_HEADER_LEN + 8;
+    for (int i = 0; i < TELEMETRY_SERVOS; i++) {
+        put_u16(p + 2 * i, ticks[i]);
+    }
+}
+
+bool telemetry_put_imu(uint8_t *frame, const imu_sample_t *imu) {
+    uint8_t *count = frame + PROTO_HEADER_LEN + 16;
+    if (*count >= TELEMETRY_MAX_IMU) {
+        return false;
+    }
+    uint8_t *p = frame + PROTO_HEADER_LEN + TELEMETRY_IMU_OFFSET + *count * TELEMETRY_IMU_LEN;
+    put_u32(p, imu->timestamp_us);
+    for (int i = 0; i < 3; i++) {
+        put_u16(p + 4 + 2 * i, (uint16_t)imu->accel[i]);
+        put_u16(p + 10 + 2 * i, (uint16_t)imu->gyro[i]);
+    }
+    put_u16(p + 16, (uint16_t)imu->temp);
+    (*count)++;
+    return true;
+}
+
+void telemetry_put_feet(uint8_t *frame, const int16_t x_q4[2], const int16_t y_q4[2], int16_t height_q4,
+                        uint8_t valid) {
+    uint8_t *p = frame + PROTO_HEADER_LEN + TELEMETRY_FEET_OFFSET;
+    for (int i = 0; i < 2; i++) {
+        put_u16(p + 2 * i, (uint16_t)x_q4[i]);
+        put_u16(p + 4 + 2 * i, (uint16_t)y_q4[i]);
+    }
+    put_u16(p + 8, (uint16_t)height_q4);
+    uint8_t *flags = frame + PROTO_HEADER_LEN + 17;
+    *flags = (uint8_t)((*flags & ~(TELEMETRY_FLAG_FOOT_LEFT | TELEMETRY_FLAG_FOOT_RIGHT)) |
+                       (valid & (TELEMETRY_FLAG_FOOT_LEFT | TELEMETRY_FLAG_FOOT_RIGHT)));
+}
+
+int telemetry_parse(const proto_frame_t *frame, telemetry_frame_t *out) {
+    // Older firmware sends no feet block
+    if (frame->type != PROTO_MSG_TELEMETRY ||
+        (frame->len != TELEMETRY_PAYLOAD_LEN && frame->len != TELEMETRY_FEET_OFFSET)) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    out->timestamp_us = get_u32(p);
+    out->sample = get_u32(p + 4);
+    for (int i = 0; i < TELEMETRY_SERVOS; i++) {
+        out->servo_ticks[i] = get_u16(p + 8 + 2 * i);
+    }
+    out->imu_count = p[16];
+    out->flags = p[17];
+    if (out->imu_count > TELEMETRY_MAX_IMU) {
+        return -1;
+    }
+    for (int n = 0; n < out->imu_count; n++) {
+        const uint8_t *q = p + TELEMETRY_IMU_OFFSET + n * TELEMETRY_IMU_LEN;
+        imu_sample_t *imu = &out->imu[n];
+        imu->timestamp_us = get_u32(q);
+        for (int i = 0; i < 3; i++) {
+            imu->accel[i] = (int16_t)get_u16(q + 4 + 2 * i);
+            imu->gyro[i] = (int16_t)get_u16(q + 10 + 2 * i);
+        }
+        imu->temp = (int16_t)get_u16(q + 16);
+    }
+    if (frame->len == TELEMETRY_PAYLOAD_LEN) {
+        const uint8_t *q = p + TELEMETRY_FEET_OFFSET;
+        for (int i = 0; i < 2; i++) {
+            out->foot_x_q4[i] = (int16_t)get_u16(q + 2 * i);
+            out->foot_y_q4[i] = (int16_t)get_u16(q + 4 + 2 * i);
+        }
+        out->height_q4 = (int16_t)get_u16(q + 8);
+    } else {
+        out->flags &= (uint8_t)~(TELEMETRY_FLAG_FOOT_LEFT | TELEMETRY_FLAG_FOOT_RIGHT);
+        memset(out->foot_x_q4, 0, sizeof(out->foot_x_q4));
+        memset(out->foot_y_q4, 0, sizeof(out->foot_y_q4));
+        out->height_q4 = 0;
+    }
+    return 0;
+}
+
+TelemetryBuffer::TelemetryBuffer() : commits(0), overwritten(0), writing(-1) {
+    memset(slots, 0, sizeof(slots));
+    for (int i = 0; i < 2; i++) {
+        state[i].store(SLOT_FREE, std::memory_order_relaxed);
+        order[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+uint8_t *TelemetryBuffer::begin() {
+    writing = -1;
+    while (1) {
+        for (int i = 0; i < 2; i++) {
+            uint8_t expect = SLOT_FREE;
+            if (state[i].compare_exchange_strong(expect, SLOT_WRITING, std::memory_order_acquire)) {
+                writing = i;
+                break;
+            }
+        }
+        if (writing < 0) {
+            // No free slot, the consumer is behind: overwrite the older unsent frame
+            int oldest = (int32_t)(order[0].load(std::memory_order_relaxed) -
+                                   order[1].load(std::memory_order_relaxed)) <= 0 ? 0 : 1;
+            for (int k = 0; k < 2 && writing < 0; k++) {
+                int i = k == 0 ? oldest : 1 - oldest;
+                uint8_t expect = SLOT_READY;
+                if (state[i].compare_exchange_strong(expect, SLOT_WRITING, std::memory_order_acquire)) {
+                    writing = i;
+                    overwritten++;
+                }
+            }
+        }
+        // Otherwise the consumer just took a slot, the other one is free now
+        if (writing >= 0) {
+            memset(slots[writing] + PROTO_HEADER_LEN, 0, TELEMETRY_PAYLOAD_LEN);
+            return slots[writing];
+        }
+    }
+}
+
+void TelemetryBuffer::commit(uint16_t seq) {
+    uint8_t *frame = slots[writing];
+    proto_encode(PROTO_MSG_TELEMETRY, seq, frame + PROTO_HEADER_LEN, TELEMETRY_PAYLOAD_LEN, frame, TELEMETRY_FRAME_LEN);
+    order[writing].store(++commits, std::memory_order_relaxed);
+    state[writing].store(SLOT_READY, std::memory_order_release);
+    writing = -1;
+}
+
+const uint8_t *TelemetryBuffer::acquire() {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int pick = -1;
+        for (int i = 0; i < 2; i++) {
+            if (state[i].load(std::memory_order_acquire) != SLOT_READY) {
+                continue;
+            }
+            if (pick < 0 || (int32_t)(order[i].load(std::memory_order_relaxed) -
+                                      order[pick].load(std::memory_order_relaxed)) < 0) {
+                pick = i;
+            }
+        }
+        if (pick < 0) {
+            return NULL;
+        }
+        // Loses only if the producer grabbed this slot to overwrite it
+        uint8_t expect = SLOT_READY;
+        if (state[pick].compare_exchange_strong(expect, SLOT_SENDING, std::memory_order_acquire)) {
+            return slots[pick];
+        }
+    }
+    return NULL;
+}
+
+void TelemetryBuffer::release(const uint8_t *frame) {
+    int i = frame == slots[0] ? 0 : 1;
+    state[i].store(SLOT_FREE, std::memory_order_release);
+}
+
+uint32_t TelemetryBuffer::overwrites() const {
+    return overwritten;
+}
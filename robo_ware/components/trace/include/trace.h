@@ -0,0 +1,250 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "protocol.h"
+#include "seqlock.h"
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_cpu.h"
+#else
+#include <time.h>
+#endif
+
+#define TRACE_CORES             2
+#define TRACE_RING_EVENTS       512     // per core, a power of two: about 2s of the control core at 50Hz
+#define TRACE_HIST_SUB_BITS     3       // 8 buckets per power of two, at most 12.5% wide
+#define TRACE_HIST_BUCKETS      ((32 - TRACE_HIST_SUB_BITS + 1) << TRACE_HIST_SUB_BITS)
+
+static_assert((TRACE_RING_EVENTS & (TRACE_RING_EVENTS - 1)) == 0, "TRACE_RING_EVENTS must be a power of two");
+
+// Cycle counter of the calling core. On the host a nanosecond clock stands in.
+#ifdef ESP_PLATFORM
+#define TRACE_CYCLES_PER_US     CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+
+static inline uint32_t trace_cycles() {
+    return (uint32_t)esp_cpu_get_cycle_count();
+}
+
+static inline int trace_core() {
+    return esp_cpu_get_core_id();
+}
+#else
+#define TRACE_CYCLES_PER_US     1000
+
+static inline uint32_t trace_cycles() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+static inline int trace_core() {
+    return 0;
+}
+#endif
+
+// Stages of the command to pulse pipeline
+typedef enum {
+    TRACE_RX = 0,       // one command frame, decoded and handed on (arg: message type)
+    TRACE_IK,           // one foot target to compare values (arg: leg)
+    TRACE_PROFILE,      // motion profile step of all servos
+    TRACE_COMMIT,       // calibration and MCPWM compare writes
+    TRACE_TELEMETRY,    // one telemetry frame packed
+    TRACE_CONTROL,      // whole control tick, wakeup to done
+    TRACE_STAGES
+} trace_stage_t;
+
+extern const char *const trace_stage_names[TRACE_STAGES];
+
+typedef struct {
+    uint32_t start;     // cycles of the recording core
+    uint32_t cycles;
+    uint8_t stage;
+    uint8_t arg;
+} trace_event_t;
+
+// Durations in nanoseconds. p99 is the middle of its histogram bucket.
+typedef struct {
+    uint32_t count;
+    uint32_t min_ns;
+    uint32_t avg_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+} trace_summary_t;
+
+typedef struct {
+    uint64_t sum;       // cycles
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+} trace_totals_t;
+
+// Log-linear histogram of durations in cycles: exact below 8, then 8 buckets
+// per power of two. One task records into it, any task reads. Count, sum,
+// min and max go out through a Seqlock from the writer's own copy, so the
+// average needs no 64 bit atomics; the buckets are single words. clear() only
+// asks, the writer empties everything on its next add().
+class TraceHistogram {
+private:
+    std::atomic<uint32_t> buckets[TRACE_HIST_BUCKETS];
+    trace_totals_t totals;      // writer only
+    Seqlock<trace_totals_t> published;
+    std::atomic<bool> clear_requested;
+
+    void reset();
+
+public:
+    TraceHistogram();
+
+    static inline uint32_t bucket_of(uint32_t cycles) {
+        if (cycles < (1u << TRACE_HIST_SUB_BITS)) {
+            return cycles;
+        }
+        uint32_t msb = 31 - __builtin_clz(cycles);
+        uint32_t shift = msb - TRACE_HIST_SUB_BITS;
+        return ((shift + 1) << TRACE_HIST_SUB_BITS) | ((cycles >> shift) & ((1u << TRACE_HIST_SUB_BITS) - 1));
+    }
+
+    // Smallest value of a bucket, and its width
+    static uint32_t bucket_low(uint32_t bucket, uint32_t *width);
+
+    inline void add(uint32_t cycles) {
+        if (clear_requested.load(std::memory_order_relaxed)) {
+            reset();
+        }
+        std::atomic<uint32_t> *b = &buckets[bucket_of(cycles)];
+        b->store(b->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        totals.sum += cycles;
+        totals.count++;
+        totals.min = cycles < totals.min ? cycles : totals.min;
+        totals.max = cycles > totals.max ? cycles : totals.max;
+        published.write(totals);
+    }
+
+    void summary(trace_summary_t *out, uint32_t cycles_per_us) const;
+
+    void clear();
+};
+
+// Per core rings of the latest stage events plus a histogram per stage.
+// record() costs two cycle counter reads, a few loads and stores and one
+// atomic increment; no locks, no kernel calls, so it can run in any task.
+// Tasks on the same core share a ring, slots are claimed with fetch_add.
+//
+// Histograms always record. The rings stop while a dump reads them, a stage
+// finishing right at pause() may still land in its slot.
+class Tracer {
+private:
+    struct ring_t {
+        std::atomic<uint32_t> head;
+        trace_event_t events[TRACE_RING_EVENTS];
+    };
+    ring_t rings[TRACE_CORES];
+    TraceHistogram hist[TRACE_STAGES];
+    std::atomic<bool> recording;
+
+public:
+    Tracer();
+
+    inline void record(trace_stage_t stage, uint32_t start, uint8_t arg = 0) {
+        uint32_t cycles = trace_cycles() - start;
+        hist[stage].add(cycles);
+        if (recording.load(std::memory_order_relaxed)) {
+            ring_t *r = &rings[trace_core() & (TRACE_CORES - 1)];
+            trace_event_t *e = &r->events[r->head.fetch_add(1, std::memory_order_relaxed) & (TRACE_RING_EVENTS - 1)];
+            e->start = start;
+            e->cycles = cycles;
+            e->stage = (uint8_t)stage;
+            e->arg = arg;
+        }
+    }
+
+    void pause();
+
+    void resume();
+
+    // While paused: how many events core has, and the i-th oldest of them
+    size_t event_count(int core) const;
+
+    const trace_event_t *event(int core, size_t i) const;
+
+    void summary(trace_stage_t stage, trace_summary_t *out) const;
+
+    void clear_histograms();
+};
+
+// Records into trace if there is one, for call sites with an optional tracer
+static inline void trace_record(Tracer *trace, trace_stage_t stage, uint32_t start, uint8_t arg = 0) {
+    if (trace != NULL) {
+        trace->record(stage, start, arg);
+    }
+}
+
+/* Wire format, little endian.
+ *
+ * PROTO_MSG_TRACE_REQ payload: empty or one flags byte
+ *   PROTO_TRACE_EVENTS     stream the rings too, as PROTO_MSG_TRACE frames
+ *   PROTO_TRACE_CLEAR      restart the histograms after this report
+ *
+ * PROTO_MSG_TRACE_STATS payload: one record per stage
+ *   0  1  stage
+ *   1  4  count
+ *   5 16  min_ns, avg_ns, p99_ns, max_ns
+ *
+ * PROTO_MSG_TRACE payload: events of one core
+ *   0  1  core
+ *   1  1  flags            PROTO_TRACE_LAST on the final frame of a dump
+ *   2  2  cycles_per_us
+ *   4 10  events[]: start, cycles, stage, arg
+ */
+#define TRACE_STAT_LEN          21
+#define TRACE_FRAME_HEADER_LEN  4
+#define TRACE_EVENT_LEN         10
+#define TRACE_FRAME_EVENTS      ((PROTO_MAX_PAYLOAD - TRACE_FRAME_HEADER_LEN) / TRACE_EVENT_LEN)
+#define PROTO_TRACE_LAST        0x01
+#define PROTO_TRACE_EVENTS      0x01
+#define PROTO_TRACE_CLEAR       0x02
+
+static_assert(TRACE_STAGES * TRACE_STAT_LEN <= PROTO_MAX_PAYLOAD, "trace stats frame too large");
+
+size_t trace_encode_stats(uint16_t seq, const Tracer *trace, uint8_t *out, size_t out_size);
+
+// Reader for the host side, returns the number of stages or -1
+int trace_parse_stats(const proto_frame_t *frame, trace_summary_t out[TRACE_STAGES]);
+
+typedef struct {
+    uint8_t core;
+    uint8_t flags;
+    uint16_t cycles_per_us;
+    uint16_t count;
+    trace_event_t events[TRACE_FRAME_EVENTS];
+} trace_frame_t;
+
+int trace_parse_frame(const proto_frame_t *frame, trace_frame_t *out);
+
+// Streams a paused Tracer's rings as PROTO_MSG_TRACE frames, one per next()
+// call, and resumes recording after the last. Owned by the sending task.
+class TraceDump {
+private:
+    Tracer *trace;
+    uint16_t seq;
+    int core;           // -1 when idle
+    size_t sent;        // events of this core already out
+
+public:
+    TraceDump();
+
+    // Pauses trace and starts over, a dump still running is cut short
+    void start(Tracer *trace, uint16_t seq);
+
+    bool active() const;
+
+    // Next frame into out, 0 once everything went out
+    size_t next(uint8_t *out, size_t out_size);
+};
+
+#endif // TRACE_H
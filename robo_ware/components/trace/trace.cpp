@@ -0,0 +1,249 @@
+#include "trace.h"
+
+#include <string.h>
+
+const char *const trace_stage_names[TRACE_STAGES] = {"rx", "ik", "profile", "commit", "telemetry", "control"};
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static inline uint32_t cycles_to_ns(uint64_t cycles, uint32_t cycles_per_us) {
+    uint64_t ns = cycles * 1000 / cycles_per_us;
+    return ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+TraceHistogram::TraceHistogram() {
+    clear_requested.store(false, std::memory_order_relaxed);
+    reset();
+}
+
+void TraceHistogram::reset() {
+    for (int i = 0; i < TRACE_HIST_BUCKETS; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    totals.sum = 0;
+    totals.count = 0;
+    totals.min = UINT32_MAX;
+    totals.max = 0;
+    published.write(totals);
+    clear_requested.store(false, std::memory_order_relaxed);
+}
+
+uint32_t TraceHistogram::bucket_low(uint32_t bucket, uint32_t *width) {
+    if (bucket < (1u << TRACE_HIST_SUB_BITS)) {
+        *width = 1;
+        return bucket;
+    }
+    uint32_t shift = (bucket >> TRACE_HIST_SUB_BITS) - 1;
+    uint32_t mantissa = (1u << TRACE_HIST_SUB_BITS) | (bucket & ((1u << TRACE_HIST_SUB_BITS) - 1));
+    *width = 1u << shift;
+    return mantissa << shift;
+}
+
+void TraceHistogram::summary(trace_summary_t *out, uint32_t cycles_per_us) const {
+    memset(out, 0, sizeof(*out));
+    trace_totals_t t;
+    if (clear_requested.load(std::memory_order_relaxed) || !published.read(&t) || t.count == 0) {
+        return;
+    }
+    out->count = t.count;
+    out->min_ns = cycles_to_ns(t.min, cycles_per_us);
+    out->max_ns = cycles_to_ns(t.max, cycles_per_us);
+    out->avg_ns = cycles_to_ns(t.sum / t.count, cycles_per_us);
+
+    // The buckets are read after the totals and may hold a few samples more
+    uint32_t counts[TRACE_HIST_BUCKETS];
+    uint64_t n = 0;
+    for (int i = 0; i < TRACE_HIST_BUCKETS; i++) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        n += counts[i];
+    }
+    uint64_t rank = (n * 99 + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < TRACE_HIST_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint32_t width;
+            uint64_t mid = bucket_low(i, &width) + width / 2;
+            mid = mid < t.min ? t.min : (mid > t.max ? t.max : mid);
+            out->p99_ns = cycles_to_ns(mid, cycles_per_us);
+            break;
+        }
+    }
+}
+
+void TraceHistogram::clear() {
+    clear_requested.store(true, std::memory_order_relaxed);
+}
+
+Tracer::Tracer() {
+    for (int c = 0; c < TRACE_CORES; c++) {
+        rings[c].head.store(0, std::memory_order_relaxed);
+        memset(rings[c].events, 0, sizeof(rings[c].events));
+    }
+    recording.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::pause() {
+    recording.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::resume() {
+    recording.store(true, std::memory_order_relaxed);
+}
+
+size_t Tracer::event_count(int core) const {
+    uint32_t head = rings[core].head.load(std::memory_order_acquire);
+    return head < TRACE_RING_EVENTS ? head : TRACE_RING_EVENTS;
+}
+
+const trace_event_t *Tracer::event(int core, size_t i) const {
+    uint32_t head = rings[core].head.load(std::memory_order_acquire);
+    uint32_t oldest = head - (uint32_t)event_count(core);
+    return &rings[core].events[(oldest + i) & (TRACE_RING_EVENTS - 1)];
+}
+
+void Tracer::summary(trace_stage_t stage, trace_summary_t *out) const {
+    hist[stage].summary(out, TRACE_CYCLES_PER_US);
+}
+
+void Tracer::clear_histograms() {
+    for (int i = 0; i < TRACE_STAGES; i++) {
+        hist[i].clear();
+    }
+}
+
+size_t trace_encode_stats(uint16_t seq, const Tracer *trace, uint8_t *out, size_t out_size) {
+    const size_t len = TRACE_STAGES * TRACE_STAT_LEN;
+    if (out_size < PROTO_HEADER_LEN + len + PROTO_CRC_LEN) {
+        return 0;
+    }
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    for (int i = 0; i < TRACE_STAGES; i++, p += TRACE_STAT_LEN) {
+        trace_summary_t s;
+        trace->summary((trace_stage_t)i, &s);
+        p[0] = (uint8_t)i;
+        put_u32(p + 1, s.count);
+        put_u32(p + 5, s.min_ns);
+        put_u32(p + 9, s.avg_ns);
+        put_u32(p + 13, s.p99_ns);
+        put_u32(p + 17, s.max_ns);
+    }
+    return proto_encode(PROTO_MSG_TRACE_STATS, seq, out + PROTO_HEADER_LEN, (uint16_t)len, out, out_size);
+}
+
+int trace_parse_stats(const proto_frame_t *frame, trace_summary_t out[TRACE_STAGES]) {
+    if (frame->type != PROTO_MSG_TRACE_STATS || frame->len % TRACE_STAT_LEN) {
+        return -1;
+    }
+    memset(out, 0, TRACE_STAGES * sizeof(trace_summary_t));
+    int count = 0;
+    // Stages this build doesn't know are skipped
+    for (const uint8_t *p = frame->payload; p < frame->payload + frame->len; p += TRACE_STAT_LEN) {
+        if (p[0] >= TRACE_STAGES) {
+            continue;
+        }
+        trace_summary_t *s = &out[p[0]];
+        s->count = get_u32(p + 1);
+        s->min_ns = get_u32(p + 5);
+        s->avg_ns = get_u32(p + 9);
+        s->p99_ns = get_u32(p + 13);
+        s->max_ns = get_u32(p + 17);
+        count++;
+    }
+    return count;
+}
+
+int trace_parse_frame(const proto_frame_t *frame, trace_frame_t *out) {
+    if (frame->type != PROTO_MSG_TRACE || frame->len < TRACE_FRAME_HEADER_LEN ||
+        (frame->len - TRACE_FRAME_HEADER_LEN) % TRACE_EVENT_LEN) {
+        return -1;
+    }
+    const uint8_t *p = frame->payload;
+    out->core = p[0];
+    out->flags = p[1];
+    out->cycles_per_us = get_u16(p + 2);
+    out->count = (uint16_t)((frame->len - TRACE_FRAME_HEADER_LEN) / TRACE_EVENT_LEN);
+    if (out->cycles_per_us == 0 || out->count > TRACE_FRAME_EVENTS) {
+        return -1;
+    }
+    p += TRACE_FRAME_HEADER_LEN;
+    for (int i = 0; i < out->count; i++, p += TRACE_EVENT_LEN) {
+        out->events[i].start = get_u32(p);
+        out->events[i].cycles = get_u32(p + 4);
+        out->events[i].stage = p[8];
+        out->events[i].arg = p[9];
+    }
+    return out->count;
+}
+
+TraceDump::TraceDump() {
+    trace = NULL;
+    seq = 0;
+    core = -1;
+    sent = 0;
+}
+
+void TraceDump::start(Tracer *trace, uint16_t seq) {
+    this->trace = trace;
+    this->seq = seq;
+    core = 0;
+    sent = 0;
+    trace->pause();
+}
+
+bool TraceDump::active() const {
+    return core >= 0;
+}
+
+size_t TraceDump::next(uint8_t *out, size_t out_size) {
+    if (core < 0) {
+        return 0;
+    }
+    size_t total = trace->event_count(core);
+    size_t count = total - sent < TRACE_FRAME_EVENTS ? total - sent : TRACE_FRAME_EVENTS;
+    size_t len = TRACE_FRAME_HEADER_LEN + count * TRACE_EVENT_LEN;
+    if (out_size < PROTO_HEADER_LEN + len + PROTO_CRC_LEN) {
+        return 0;
+    }
+    // Every core sends at least one frame, the host sees it had nothing
+    bool core_done = sent + count == total;
+    bool last = core_done && core == TRACE_CORES - 1;
+    uint8_t *p = out + PROTO_HEADER_LEN;
+    p[0] = (uint8_t)core;
+    p[1] = last ? PROTO_TRACE_LAST : 0;
+    put_u16(p + 2, TRACE_CYCLES_PER_US);
+    p += TRACE_FRAME_HEADER_LEN;
+    for (size_t i = 0; i < count; i++, p += TRACE_EVENT_LEN) {
+        const trace_event_t *e = trace->event(core, sent + i);
+        put_u32(p, e->start);
+        put_u32(p + 4, e->cycles);
+        p[8] = e->stage;
+        p[9] = e->arg;
+    }
+    sent += count;
+    if (core_done) {
+        sent = 0;
+        core++;
+    }
+    if (last) {
+        core = -1;
+        trace->resume();
+    }
+    return proto_encode(PROTO_MSG_TRACE, seq, out + PROTO_HEADER_LEN, (uint16_t)len, out, out_size);
+}
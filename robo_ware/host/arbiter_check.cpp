@@ -0,0 +1,629 @@
+// Checks the command arbiter the control loop takes its setpoints from:
+//  - a higher priority source preempts, and hands the leg back with the
+//    lower one's newest target when it goes away
+//  - leases run out, a lapsed source with park_on_expiry parks its legs
+//  - the owner keeps a leg against sources of the same priority
+//  - exclusive sources hold both legs, offsets ride on the owner's target
+//  - queued sources give one command per leg a tick in order, newest-only
+//    sources the latest one
+// then runs it against simulated concurrent clients: three TCP clients over
+// loopback through the command server, a UART-like producer thread and
+// teleop offered on the control thread, with the control thread ticking at
+// 1 kHz. No emitted target may come from a source that doesn't own the leg,
+// none may be lost or reordered while the owner keeps a leg, and ownership
+// has to follow priority. Ends with the cost of tick().
+//   ./arbiter_check
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "arbiter.h"
+#include "cmd_server.h"
+#include "protocol.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static uint32_t now_us()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+static setpoint_t foot(uint32_t t, int leg, int x, int y)
+{
+    setpoint_t sp = {};
+    sp.timestamp_us = t;
+    sp.kind = SETPOINT_FOOT;
+    sp.leg = (uint8_t)leg;
+    sp.x_q4 = (int16_t)x;
+    sp.y_q4 = (int16_t)y;
+    return sp;
+}
+
+static setpoint_t servo(uint32_t t, int servo, int angle)
+{
+    setpoint_t sp = {};
+    sp.timestamp_us = t;
+    sp.kind = SETPOINT_SERVO;
+    sp.leg = (uint8_t)servo;
+    sp.angle = (int16_t)angle;
+    return sp;
+}
+
+static bool has_foot(const arb_setpoint_t &out, int leg, int x, int y)
+{
+    return (out.feet & (1u << leg)) && out.x_q4[leg] == x && out.y_q4[leg] == y;
+}
+
+static void check_preemption()
+{
+    CommandArbiter arb;
+    int low = arb.add_source({"low", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    int high = arb.add_source({"high", 30, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    arb_setpoint_t out;
+
+    arb.push(low, foot(0, LEG_LEFT, 100, 700));
+    arb.tick(0, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 100, 700) && out.owner[LEG_LEFT] == low, "low source not applied");
+    EXPECT(out.owner[LEG_RIGHT] == ARB_NONE && !(out.feet & (1u << LEG_RIGHT)), "right leg touched");
+
+    arb.push(high, foot(1000, LEG_LEFT, 200, 720));
+    arb.push(low, foot(1000, LEG_LEFT, 110, 700));
+    arb.tick(1000, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 200, 720) && out.owner[LEG_LEFT] == high, "high source didn't preempt");
+
+    // Still held by high, the low source's commands are kept but not applied
+    arb.push(low, foot(2000, LEG_LEFT, 120, 700));
+    arb.tick(2000, &out);
+    EXPECT(out.feet == 0 && out.owner[LEG_LEFT] == high, "preempted command went out");
+
+    arb.expire(high);
+    arb.tick(3000, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 120, 700) && out.owner[LEG_LEFT] == low, "leg not handed back to low, at 120");
+    EXPECT(out.park == 0, "parked without park_on_expiry");
+
+    arb_source_stats_t s;
+    arb.get_stats(low, &s);
+    EXPECT(s.commands == 3 && s.preempted == 2 && s.takeovers == 2, "low stats %u %u %u", s.commands, s.preempted,
+           s.takeovers);
+    arb.get_stats(high, &s);
+    EXPECT(s.applied == 1 && s.expired == 1, "high stats %u %u", s.applied, s.expired);
+}
+
+static void check_lease()
+{
+    CommandArbiter arb;
+    int tcp = arb.add_source({"tcp", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 5000});
+    int teleop = arb.add_source({"teleop", 30, ARB_MERGE_OVERRIDE, ARB_INPUT_NEWEST, true, 0});
+    arb_setpoint_t out;
+
+    arb.push(tcp, foot(0, LEG_RIGHT, 50, 600));
+    arb.tick(0, &out);
+    arb.tick(5000, &out);
+    EXPECT(out.owner[LEG_RIGHT] == tcp, "lease ended early");
+    arb.tick(5001, &out);
+    EXPECT(out.owner[LEG_RIGHT] == ARB_NONE && out.park == 0, "lease didn't end, or parked");
+
+    // Teleop on both legs, then its link is lost with nobody left to take over
+    arb.offer(teleop, foot(6000, LEG_LEFT, 0, 640), 6000);
+    arb.offer(teleop, foot(6000, LEG_RIGHT, 0, 640), 6000);
+    arb.tick(6000, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 0, 640) && has_foot(out, LEG_RIGHT, 0, 640), "teleop not applied");
+    arb.expire(teleop);
+    arb.tick(7000, &out);
+    EXPECT(out.park == 3 && out.feet == 0, "legs not parked, park 0x%x", out.park);
+    arb.tick(8000, &out);
+    EXPECT(out.park == 0, "parked twice");
+
+    // A live source below takes over instead of parking
+    arb.offer(teleop, foot(9000, LEG_LEFT, 0, 640), 9000);
+    arb.tick(9000, &out);
+    arb.push(tcp, foot(9500, LEG_LEFT, 30, 650));
+    arb.tick(10000, &out);
+    arb.expire(teleop);
+    arb.tick(11000, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 30, 650) && out.park == 0, "tcp didn't take over from teleop");
+}
+
+static void check_ties()
+{
+    CommandArbiter arb;
+    int a = arb.add_source({"a", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 5000});
+    int b = arb.add_source({"b", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 5000});
+    arb_setpoint_t out;
+
+    arb.push(b, foot(0, LEG_LEFT, 1, 600));
+    arb.tick(0, &out);
+    arb.push(a, foot(1000, LEG_LEFT, 2, 600));
+    arb.push(b, foot(1000, LEG_LEFT, 3, 600));
+    arb.tick(1000, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 3, 600) && out.owner[LEG_LEFT] == b, "owner lost the leg on a tie");
+
+    // b goes quiet, its lease runs out and a gets the leg with its newest target
+    arb.push(a, foot(4000, LEG_LEFT, 4, 600));
+    arb.tick(4000, &out);
+    EXPECT(out.owner[LEG_LEFT] == b && out.feet == 0, "b's lease ended early");
+    arb.tick(6001, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 4, 600) && out.owner[LEG_LEFT] == a, "a didn't get the leg");
+
+    // Both new at once: the lowest id wins
+    CommandArbiter arb2;
+    a = arb2.add_source({"a", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    b = arb2.add_source({"b", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    arb2.push(b, foot(0, LEG_RIGHT, 5, 600));
+    arb2.push(a, foot(0, LEG_RIGHT, 6, 600));
+    arb2.tick(0, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 6, 600) && out.owner[LEG_RIGHT] == a, "lowest id didn't win");
+}
+
+static void check_exclusive_offset()
+{
+    CommandArbiter arb;
+    int tcp = arb.add_source({"tcp", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    int gait = arb.add_source({"gait", 20, ARB_MERGE_EXCLUSIVE, ARB_INPUT_QUEUE, false, 0});
+    int trim = arb.add_source({"trim", 5, ARB_MERGE_OFFSET, ARB_INPUT_NEWEST, false, 0});
+    arb_setpoint_t out;
+
+    arb.push(tcp, foot(0, LEG_RIGHT, 100, 600));
+    arb.tick(0, &out);
+
+    // A gait that sends nothing still holds both legs
+    arb.claim(gait, 1000);
+    arb.push(tcp, foot(1000, LEG_RIGHT, 110, 600));
+    arb.tick(1000, &out);
+    EXPECT(out.owner[LEG_LEFT] == gait && out.owner[LEG_RIGHT] == gait && out.feet == 0, "gait not exclusive");
+    arb.expire(gait);
+    arb.tick(2000, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 110, 600) && out.owner[LEG_RIGHT] == tcp, "tcp not back after the gait");
+    EXPECT(out.owner[LEG_LEFT] == ARB_NONE, "left leg has an owner");
+
+    // Offsets add to the owner's target, a change alone rewrites it
+    arb.push(trim, foot(3000, LEG_RIGHT, 16, -32));
+    arb.tick(3000, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 126, 568) && out.owner[LEG_RIGHT] == tcp, "offset not added, %d %d",
+           out.x_q4[LEG_RIGHT], out.y_q4[LEG_RIGHT]);
+    arb.push(tcp, foot(4000, LEG_RIGHT, 120, 600));
+    arb.tick(4000, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 136, 568), "offset not kept on a new target");
+    arb.tick(5000, &out);
+    EXPECT(out.feet == 0, "unchanged offset rewrote the target");
+    arb.expire(trim);
+    arb.tick(6000, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 120, 600), "offset not removed");
+
+    // Without a foot target to ride on, an offset does nothing
+    arb.push(trim, foot(7000, LEG_LEFT, 16, 16));
+    arb.tick(7000, &out);
+    EXPECT(out.feet == 0 && out.owner[LEG_LEFT] == ARB_NONE, "offset owned a leg");
+}
+
+static void check_inputs()
+{
+    CommandArbiter arb;
+    int q = arb.add_source({"queue", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    int n = arb.add_source({"newest", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_NEWEST, false, 0});
+    arb_setpoint_t out;
+
+    for (int i = 0; i < 3; i++) {
+        arb.push(q, foot(0, LEG_LEFT, i, 600));
+    }
+    arb.push(q, servo(0, 4, 30));
+    arb.push(q, servo(0, 1, 40));
+    for (int i = 0; i < 3; i++) {
+        arb.tick(1000 * i, &out);
+        EXPECT(has_foot(out, LEG_LEFT, i, 600), "queued target %d not in order", i);
+        EXPECT(out.servos == 0, "servo went out with a foot target of its leg");
+    }
+    // Servo 4 is the left leg, it waited for the foot targets; servo 1 is the right
+    arb.tick(3000, &out);
+    EXPECT(out.servos == 0x9 && out.angle[3] == 30 && out.angle[0] == 40 && out.feet == 0, "servos 0x%x",
+           out.servos);
+
+    // The queued source holds the right leg through servo 1 until it goes
+    arb.expire(q);
+    for (int i = 0; i < 3; i++) {
+        arb.push(n, foot(4000, LEG_RIGHT, 10 + i, 600));
+    }
+    arb.tick(4000, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 12, 600), "newest-only source didn't give its newest");
+    arb.tick(5000, &out);
+    EXPECT(out.feet == 0, "newest-only source repeated");
+
+    setpoint_t bad = foot(6000, 2, 0, 0);
+    arb.push(q, bad);
+    arb.push(q, servo(6000, 5, 0));
+    arb.tick(6000, &out);
+    arb_source_stats_t s;
+    arb.get_stats(q, &s);
+    EXPECT(s.invalid == 2 && out.feet == 0 && out.servos == 0, "invalid commands %u", s.invalid);
+}
+
+// oldest_us is the oldest command of the tick, not of the source's lifetime
+static void check_age()
+{
+    CommandArbiter arb;
+    int tcp = arb.add_source({"tcp", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    int uart = arb.add_source({"uart", 10, ARB_MERGE_OVERRIDE, ARB_INPUT_NEWEST, false, 0});
+    arb_setpoint_t out;
+
+    // One command a tick, each 3ms old when the tick takes it
+    for (uint32_t i = 1; i <= 5; i++) {
+        uint32_t t = 20000 * i;
+        arb.push(tcp, foot(t - 3000, LEG_LEFT, (int)i, 600));
+        arb.tick(t, &out);
+        EXPECT(out.feet == 1u << LEG_LEFT && out.fresh && out.oldest_us == t - 3000,
+               "tick %u: oldest_us %u, queued at %u", i, out.oldest_us, t - 3000);
+    }
+
+    // Two sources in one tick, the older of the two
+    arb.push(tcp, foot(119000, LEG_LEFT, 10, 600));
+    arb.push(uart, foot(117000, LEG_RIGHT, 10, 600));
+    arb.push(uart, foot(118000, LEG_RIGHT, 11, 600));
+    arb.tick(120000, &out);
+    EXPECT(out.feet == 3 && out.oldest_us == 118000, "oldest_us %u of two sources", out.oldest_us);
+
+    // A dropped command doesn't count, nor one held back that goes out on a takeover
+    int high = arb.add_source({"high", 30, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    arb.push(high, foot(139000, LEG_LEFT, 20, 600));
+    arb.push(tcp, foot(135000, LEG_LEFT, 21, 600));
+    arb.tick(140000, &out);
+    EXPECT(out.feet == 1u << LEG_LEFT && out.oldest_us == 139000, "oldest_us %u with a dropped command",
+           out.oldest_us);
+    arb.expire(high);
+    arb.push(uart, foot(159000, LEG_RIGHT, 12, 600));
+    arb.tick(160000, &out);
+    EXPECT(has_foot(out, LEG_LEFT, 21, 600) && out.oldest_us == 159000, "oldest_us %u on a takeover",
+           out.oldest_us);
+    arb.push(high, foot(179000, LEG_RIGHT, 30, 600));
+    arb.tick(180000, &out);
+    arb.expire(high);
+    arb.tick(200000, &out);
+    EXPECT(has_foot(out, LEG_RIGHT, 12, 600) && !out.fresh, "a takeover alone is fresh, oldest_us %u",
+           out.oldest_us);
+
+    arb_source_stats_t s;
+    arb.get_stats(tcp, &s);
+    EXPECT(s.age_max == 5000, "tcp age max %u", s.age_max);
+}
+
+// Simulated clients. Every target carries its sender in y and a per sender,
+// per leg sequence number in x, so the control thread can tell what it got.
+#define TAG_UART        5
+#define TAG_TELEOP      6
+#define RUN_MS          1600
+#define TCP_LEASE_US    30000
+
+static int16_t tag_y(int tag, int leg)
+{
+    return (int16_t)(tag * 8 + leg);
+}
+
+struct tick_log_t {
+    uint32_t t_ms;
+    uint8_t owner[2];
+    uint8_t feet;
+    uint8_t park;
+    int16_t x_q4[2];
+    int16_t y_q4[2];
+};
+
+struct harness_t {
+    CommandArbiter arb;
+    CmdServer *server;
+    int tcp_source[CMD_SERVER_MAX_CLIENTS];
+    std::atomic<int> source_of_client[CMD_SERVER_MAX_CLIENTS];
+    std::atomic<uint32_t> tcp_frames;
+};
+
+static void on_frame(const proto_frame_t *frame, void *ctx)
+{
+    harness_t *h = (harness_t *)ctx;
+    proto_leg_target_t targets[PROTO_MAX_LEG_TARGETS];
+    int count = proto_parse_leg_targets(frame, targets, PROTO_MAX_LEG_TARGETS);
+    int source = h->tcp_source[h->server->current_client()];
+    for (int i = 0; i < count; i++) {
+        h->source_of_client[targets[i].y_q4 >> 3].store(source);
+        h->arb.push(source, foot(now_us(), targets[i].leg, targets[i].x_q4, targets[i].y_q4));
+    }
+    h->tcp_frames++;
+}
+
+static int connect_to(uint16_t port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("connect");
+        exit(1);
+    }
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return sock;
+}
+
+static bool owned_by(const tick_log_t &l, int source)
+{
+    return l.owner[LEG_LEFT] == source && l.owner[LEG_RIGHT] == source;
+}
+
+static void check_concurrent()
+{
+    harness_t *h = new harness_t();
+    static const char *names[CMD_SERVER_MAX_CLIENTS] = {"tcp0", "tcp1", "tcp2"};
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        h->tcp_source[i] = h->arb.add_source({names[i], 10, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, TCP_LEASE_US});
+        h->source_of_client[i] = -1;
+    }
+    int uart = h->arb.add_source({"uart", 20, ARB_MERGE_OVERRIDE, ARB_INPUT_NEWEST, false, TCP_LEASE_US});
+    int teleop = h->arb.add_source({"teleop", 30, ARB_MERGE_OVERRIDE, ARB_INPUT_NEWEST, true, 0});
+    h->tcp_frames = 0;
+
+    CmdServer server(0, on_frame, h, NULL, NULL);
+    h->server = &server;
+    if (server.open() != 0) {
+        EXPECT(false, "server didn't open");
+        return;
+    }
+    std::atomic<bool> stop(false);
+    std::thread net([&] {
+        while (!stop.load()) {
+            server.poll(20);
+        }
+    });
+
+    // Client 0 commands the left leg, client 1 the right, client 2 both
+    int socks[CMD_SERVER_MAX_CLIENTS];
+    for (int k = 0; k < CMD_SERVER_MAX_CLIENTS; k++) {
+        socks[k] = connect_to(server.bound_port());
+    }
+    std::atomic<bool> go(false);
+    auto start = clock_type::now();
+    auto at = [&](int ms) { return start + std::chrono::milliseconds(ms); };
+    uint32_t sent[CMD_SERVER_MAX_CLIENTS] = {};
+    std::vector<std::thread> clients;
+    for (int k = 0; k < CMD_SERVER_MAX_CLIENTS; k++) {
+        clients.emplace_back([&, k] {
+            while (!go.load()) {
+            }
+            uint8_t frame[PROTO_MAX_FRAME];
+            auto next = start;
+            for (int seq = 0; clock_type::now() < at(1500); seq++) {
+                proto_leg_target_t t[2];
+                int n = 0;
+                for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+                    if (k == 2 || k == leg) {
+                        t[n].leg = (uint8_t)leg;
+                        t[n].x_q4 = (int16_t)seq;
+                        t[n].y_q4 = tag_y(k, leg);
+                        n++;
+                    }
+                }
+                size_t len = proto_encode_leg_targets((uint16_t)seq, t, n, frame, sizeof(frame));
+                if (send(socks[k], frame, len, 0) == (ssize_t)len) {
+                    sent[k] += n;
+                }
+                next += std::chrono::microseconds(2000);
+                std::this_thread::sleep_until(next);
+            }
+        });
+    }
+
+    // Producer on its own thread, straight into its ring
+    uint32_t uart_sent = 0;
+    std::thread uart_thread([&] {
+        while (!go.load()) {
+        }
+        std::this_thread::sleep_until(at(400));
+        for (int seq = 0; clock_type::now() < at(1100); seq++) {
+            for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+                if (h->arb.push(uart, foot(now_us(), leg, seq, tag_y(TAG_UART, leg)))) {
+                    uart_sent++;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    });
+
+    std::vector<tick_log_t> log;
+    std::vector<uint32_t> tick_ns;
+    log.reserve(RUN_MS + 100);
+    tick_ns.reserve(RUN_MS + 100);
+    std::thread control([&] {
+        while (!go.load()) {
+        }
+        auto next = start;
+        bool teleop_on = false;
+        for (int seq = 0; next < at(RUN_MS); seq++) {
+            next += std::chrono::milliseconds(1);
+            std::this_thread::sleep_until(next);
+            uint32_t now = now_us();
+            uint32_t t_ms = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(clock_type::now() - start)
+                                .count();
+            if (t_ms >= 700 && t_ms < 900) {
+                for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+                    h->arb.offer(teleop, foot(now, leg, seq, tag_y(TAG_TELEOP, leg)), now);
+                }
+                teleop_on = true;
+            } else if (teleop_on) {
+                h->arb.expire(teleop);
+                teleop_on = false;
+            }
+            arb_setpoint_t out;
+            auto t0 = clock_type::now();
+            h->arb.tick(now, &out);
+            tick_ns.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - t0)
+                                  .count());
+            log.push_back({t_ms, {out.owner[0], out.owner[1]}, out.feet, out.park, {out.x_q4[0], out.x_q4[1]},
+                           {out.y_q4[0], out.y_q4[1]}});
+        }
+    });
+
+    go = true;
+    for (std::thread &c : clients) {
+        c.join();
+    }
+    uart_thread.join();
+    control.join();
+    stop = true;
+    net.join();
+    for (int k = 0; k < CMD_SERVER_MAX_CLIENTS; k++) {
+        close(socks[k]);
+    }
+
+    // Source of each sender tag
+    int source_of_tag[8];
+    for (int i = 0; i < 8; i++) {
+        source_of_tag[i] = -1;
+    }
+    for (int k = 0; k < CMD_SERVER_MAX_CLIENTS; k++) {
+        source_of_tag[k] = h->source_of_client[k].load();
+        EXPECT(source_of_tag[k] >= 0, "client %d never arrived", k);
+    }
+    source_of_tag[TAG_UART] = uart;
+    source_of_tag[TAG_TELEOP] = teleop;
+
+    uint32_t wrong_owner = 0, lost = 0, reordered = 0, window = 0, emitted = 0, parked = 0;
+    int32_t last_seq[8][2];
+    for (int i = 0; i < 8; i++) {
+        last_seq[i][0] = last_seq[i][1] = -1;
+    }
+    uint8_t prev_owner[2] = {ARB_NONE, ARB_NONE};
+    for (const tick_log_t &l : log) {
+        for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+            if (l.park & (1u << leg)) {
+                parked++;
+            }
+            if (!(l.feet & (1u << leg))) {
+                continue;
+            }
+            emitted++;
+            int tag = l.y_q4[leg] >> 3;
+            int source = tag < 8 ? source_of_tag[tag] : -1;
+            if (source < 0 || source != l.owner[leg] || (l.y_q4[leg] & 7) != leg) {
+                wrong_owner++;
+                continue;
+            }
+            int32_t seq = l.x_q4[leg];
+            if (seq < last_seq[tag][leg]) {
+                reordered++;
+            } else if (tag < CMD_SERVER_MAX_CLIENTS && prev_owner[leg] == source && last_seq[tag][leg] >= 0 &&
+                       seq != last_seq[tag][leg] + 1) {
+                // Queued, same owner as last tick: every command goes out, one per tick
+                lost++;
+            }
+            last_seq[tag][leg] = seq;
+        }
+
+        // Ownership by priority, away from the switch points
+        bool ok = true;
+        if ((l.t_ms >= 50 && l.t_ms < 390) || (l.t_ms >= 1200 && l.t_ms < 1490)) {
+            for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+                ok = ok && (l.owner[leg] == source_of_tag[leg] || l.owner[leg] == source_of_tag[2]);
+            }
+        } else if ((l.t_ms >= 450 && l.t_ms < 690) || (l.t_ms >= 910 && l.t_ms < 1090)) {
+            ok = owned_by(l, uart);
+        } else if (l.t_ms >= 710 && l.t_ms < 890) {
+            ok = owned_by(l, teleop);
+        } else if (l.t_ms >= 1560) {
+            ok = l.owner[LEG_LEFT] == ARB_NONE && l.owner[LEG_RIGHT] == ARB_NONE;
+        }
+        if (!ok) {
+            window++;
+        }
+        prev_owner[LEG_LEFT] = l.owner[LEG_LEFT];
+        prev_owner[LEG_RIGHT] = l.owner[LEG_RIGHT];
+    }
+
+    uint32_t taken = 0, overflows = 0, total_sent = uart_sent;
+    for (int k = 0; k < CMD_SERVER_MAX_CLIENTS; k++) {
+        total_sent += sent[k];
+    }
+    for (int i = 0; i < h->arb.sources_count(); i++) {
+        arb_source_stats_t s;
+        h->arb.get_stats(i, &s);
+        if (i != teleop) {
+            taken += s.commands;
+        }
+        overflows += s.overflows;
+        printf("  %-6s commands %5u applied %5u preempted %5u takeovers %3u expired %2u overflows %u age max %u us\n",
+               h->arb.source_name(i), s.commands, s.applied, s.preempted, s.takeovers, s.expired, s.overflows,
+               s.age_max);
+    }
+    printf("concurrent: %zu ticks, %u targets out, %u sent, %u taken\n", log.size(), emitted, total_sent, taken);
+    EXPECT(wrong_owner == 0, "%u targets from a source not owning the leg", wrong_owner);
+    EXPECT(reordered == 0, "%u targets older than one before", reordered);
+    EXPECT(lost == 0, "%u queued targets skipped", lost);
+    EXPECT(window <= 10, "%u ticks with the wrong owner", window);
+    EXPECT(parked == 0, "%u legs parked, someone was always there to take over", parked);
+    EXPECT(taken + overflows == total_sent, "sent %u, taken %u + overflows %u", total_sent, taken, overflows);
+
+    std::sort(tick_ns.begin(), tick_ns.end());
+    printf("tick() under load: p50 %u ns, p99 %u ns, max %u ns\n", tick_ns[tick_ns.size() / 2],
+           tick_ns[tick_ns.size() * 99 / 100], tick_ns.back());
+    delete h;
+}
+
+// Every source full of commands, the worst a tick does
+static void bench()
+{
+    CommandArbiter *arb = new CommandArbiter();
+    for (int i = 0; i < ARB_MAX_SOURCES; i++) {
+        arb->add_source({"bench", (uint8_t)(i * 5), (uint8_t)(i == 0 ? ARB_MERGE_OFFSET : ARB_MERGE_OVERRIDE),
+                         (uint8_t)(i & 1), false, 100000});
+    }
+    const int ticks = 200000;
+    double ns = 0;
+    int32_t sink = 0;
+    arb_setpoint_t out;
+    for (int t = 0; t < ticks; t++) {
+        uint32_t now = (uint32_t)t * 1000;
+        for (int i = 0; i < ARB_MAX_SOURCES; i++) {
+            arb->push(i, foot(now, LEG_LEFT, t & 255, 600));
+            arb->push(i, foot(now, LEG_RIGHT, t & 255, 600));
+        }
+        auto t0 = clock_type::now();
+        arb->tick(now, &out);
+        ns += std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+        sink += out.x_q4[0] + out.owner[1];
+    }
+    printf("tick(), %d sources with two commands each: %.0f ns (checksum %d)\n", ARB_MAX_SOURCES, ns / ticks, sink);
+    delete arb;
+}
+
+int main()
+{
+    check_preemption();
+    check_lease();
+    check_ties();
+    check_exclusive_offset();
+    check_inputs();
+    check_age();
+    check_concurrent();
+    bench();
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,223 @@
+// ns/solve of the IK and FK variants in the kinematics component
+//   ./bench_kinematics --benchmark_counters_tabular=true
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "kinematics.h"
+#include "ik_lut.h"
+#include "fk_lut.h"
+#include "ik_batch.h"
+
+struct target_t {
+    int32_t x_q4;
+    int32_t y_q4;
+};
+
+// Reachable Q4 targets, shared by every benchmark so they walk the same points
+static const std::vector<target_t> &targets()
+{
+    static std::vector<target_t> t;
+    if (t.empty()) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int32_t> dx(IK_TABLE_X_MIN * 16, (IK_TABLE_X_MIN + IK_TABLE_COLS - 1) * 16);
+        std::uniform_int_distribution<int32_t> dy(IK_TABLE_Y_MIN * 16, (IK_TABLE_Y_MIN + IK_TABLE_ROWS - 1) * 16);
+        while (t.size() < 4096) {
+            target_t p = {dx(rng), dy(rng)};
+            uint16_t front = 0, rear = 0;
+            if (ik_solve_ticks(p.x_q4 / 16.0, p.y_q4 / 16.0, &front, &rear) == 0) {
+                t.push_back(p);
+            }
+        }
+    }
+    return t;
+}
+
+static void BM_IkDouble(benchmark::State &state)
+{
+    const std::vector<target_t> &t = targets();
+    size_t i = 0;
+    for (auto _ : state) {
+        uint16_t front = 0, rear = 0;
+        const target_t &p = t[i++ & (t.size() - 1)];
+        benchmark::DoNotOptimize(ik_solve_ticks(p.x_q4 / 16.0, p.y_q4 / 16.0, &front, &rear));
+        benchmark::DoNotOptimize(front);
+        benchmark::DoNotOptimize(rear);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IkDouble);
+
+static void BM_IkFloat(benchmark::State &state)
+{
+    const std::vector<target_t> &t = targets();
+    size_t i = 0;
+    for (auto _ : state) {
+        uint16_t front = 0, rear = 0;
+        const target_t &p = t[i++ & (t.size() - 1)];
+        benchmark::DoNotOptimize(ik_solve_ticksf(p.x_q4 / 16.0f, p.y_q4 / 16.0f, &front, &rear));
+        benchmark::DoNotOptimize(front);
+        benchmark::DoNotOptimize(rear);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IkFloat);
+
+static void BM_IkFixedTable(benchmark::State &state)
+{
+    const std::vector<target_t> &t = targets();
+    size_t i = 0;
+    for (auto _ : state) {
+        uint16_t front = 0, rear = 0;
+        const target_t &p = t[i++ & (t.size() - 1)];
+        benchmark::DoNotOptimize(ik_lookup_ticks(p.x_q4, p.y_q4, &front, &rear));
+        benchmark::DoNotOptimize(front);
+        benchmark::DoNotOptimize(rear);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IkFixedTable);
+
+struct pose_t {
+    uint16_t front;
+    uint16_t rear;
+};
+
+// The compare values of targets(), what the control loop solves back every tick
+static const std::vector<pose_t> &poses()
+{
+    static std::vector<pose_t> p;
+    if (p.empty()) {
+        for (const target_t &t : targets()) {
+            pose_t q;
+            if (ik_lookup_ticks(t.x_q4, t.y_q4, &q.front, &q.rear) == 0) {
+                p.push_back(q);
+            }
+        }
+    }
+    return p;
+}
+
+static void BM_FkDouble(benchmark::State &state)
+{
+    const std::vector<pose_t> &p = poses();
+    size_t i = 0;
+    for (auto _ : state) {
+        const pose_t &q = p[i++ % p.size()];
+        double front_deg, rear_deg, x = 0, y = 0;
+        ik_ticks_to_deg(q.front, q.rear, &front_deg, &rear_deg);
+        benchmark::DoNotOptimize(fk_solve_deg(front_deg, rear_deg, &x, &y));
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(y);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FkDouble);
+
+static void BM_FkFloat(benchmark::State &state)
+{
+    const std::vector<pose_t> &p = poses();
+    const float deg_per_tick = (float)(SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) /
+                               (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US);
+    size_t i = 0;
+    for (auto _ : state) {
+        const pose_t &q = p[i++ % p.size()];
+        float x = 0, y = 0;
+        float front_deg = (q.front - SERVO_CENTER_TICKS) * deg_per_tick + SERVO_HORN_OFFSET;
+        float rear_deg = SERVO_HORN_OFFSET - (q.rear - SERVO_CENTER_TICKS) * deg_per_tick;
+        benchmark::DoNotOptimize(fk_solve_degf(front_deg, rear_deg, &x, &y));
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(y);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FkFloat);
+
+static void BM_FkFixedTable(benchmark::State &state)
+{
+    const std::vector<pose_t> &p = poses();
+    size_t i = 0;
+    for (auto _ : state) {
+        const pose_t &q = p[i++ % p.size()];
+        int32_t x = 0, y = 0;
+        benchmark::DoNotOptimize(fk_lookup_q4(q.front, q.rear, &x, &y));
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(y);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FkFixedTable);
+
+// One gait cycle of n points, elliptic foot path with the legs half a cycle apart
+struct gait_t {
+    std::vector<int16_t> left_x, left_y, right_x, right_y;
+
+    explicit gait_t(size_t n)
+    {
+        for (size_t i = 0; i < n; i++) {
+            double phase = 2 * M_PI * i / n;
+            left_x.push_back((int16_t)lround((10 + 15 * cos(phase)) * 16));
+            left_y.push_back((int16_t)lround((45 - 8 * std::max(0.0, sin(phase))) * 16));
+            right_x.push_back((int16_t)lround((10 - 15 * cos(phase)) * 16));
+            right_y.push_back((int16_t)lround((45 - 8 * std::max(0.0, -sin(phase))) * 16));
+        }
+    }
+
+    gait_targets_t targets() const
+    {
+        return {left_x.data(), left_y.data(), right_x.data(), right_y.data(), left_x.size()};
+    }
+};
+
+static void BM_TrajectoryBatch(benchmark::State &state)
+{
+    gait_t gait(state.range(0));
+    gait_targets_t t = gait.targets();
+    std::vector<body_ticks_t> out(t.count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ik_solve_batch(&t, out.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * t.count);
+}
+BENCHMARK(BM_TrajectoryBatch)->Arg(200);
+
+static void BM_TrajectoryScalarTable(benchmark::State &state)
+{
+    gait_t gait(state.range(0));
+    std::vector<body_ticks_t> out(gait.left_x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < out.size(); i++) {
+            uint16_t f = 0, r = 0;
+            ik_lookup_ticks(gait.left_x[i], gait.left_y[i], &out[i].left_front, &out[i].left_rear);
+            ik_lookup_ticks(gait.right_x[i], gait.right_y[i], &f, &r);
+            out[i].right_front = SERVO_MIRROR_TICKS - f;
+            out[i].right_rear = SERVO_MIRROR_TICKS - r;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_TrajectoryScalarTable)->Arg(200);
+
+static void BM_TrajectoryScalarFloat(benchmark::State &state)
+{
+    gait_t gait(state.range(0));
+    std::vector<body_ticks_t> out(gait.left_x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < out.size(); i++) {
+            uint16_t f = 0, r = 0;
+            ik_solve_ticksf(gait.left_x[i] / 16.0f, gait.left_y[i] / 16.0f, &out[i].left_front, &out[i].left_rear);
+            ik_solve_ticksf(gait.right_x[i] / 16.0f, gait.right_y[i] / 16.0f, &f, &r);
+            out[i].right_front = SERVO_MIRROR_TICKS - f;
+            out[i].right_rear = SERVO_MIRROR_TICKS - r;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_TrajectoryScalarFloat)->Arg(200);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+// Decoder throughput of the binary command protocol, against the old text lines
+//   ./bench_protocol --benchmark_counters_tabular=true
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "protocol.h"
+
+// A stream of frames with both legs per frame, like the gait sender produces
+static std::vector<uint8_t> make_stream(size_t frames, double corrupt)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(-400, 900);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::vector<uint8_t> stream;
+    uint8_t frame[PROTO_MAX_FRAME];
+    for (size_t i = 0; i < frames; i++) {
+        proto_leg_target_t t[2] = {
+            {0, (int16_t)coord(rng), (int16_t)coord(rng)},
+            {1, (int16_t)coord(rng), (int16_t)coord(rng)},
+        };
+        size_t len = proto_encode_leg_targets((uint16_t)i, t, 2, frame, sizeof(frame));
+        stream.insert(stream.end(), frame, frame + len);
+    }
+    for (uint8_t &b : stream) {
+        if (chance(rng) < corrupt) {
+            b ^= (uint8_t)(1 << (rng() & 7));
+        }
+    }
+    return stream;
+}
+
+static void count_targets(const proto_frame_t *frame, void *ctx)
+{
+    proto_leg_target_t t[PROTO_MAX_LEG_TARGETS];
+    int n = proto_parse_leg_targets(frame, t, PROTO_MAX_LEG_TARGETS);
+    *(size_t *)ctx += n > 0 ? n : 0;
+}
+
+// Arg is the recv() chunk size
+static void run_decoder(benchmark::State &state, const std::vector<uint8_t> &stream)
+{
+    size_t chunk = state.range(0);
+    proto_decoder_t dec;
+    size_t targets = 0;
+    for (auto _ : state) {
+        proto_decoder_init(&dec);
+        for (size_t off = 0; off < stream.size(); off += chunk) {
+            size_t n = std::min(chunk, stream.size() - off);
+            proto_decoder_feed(&dec, stream.data() + off, n, count_targets, &targets);
+        }
+        benchmark::DoNotOptimize(targets);
+    }
+    state.SetBytesProcessed(state.iterations() * stream.size());
+    state.SetItemsProcessed(state.iterations() * dec.stats.frames);
+    state.counters["crc_err"] = dec.stats.crc_errors;
+}
+
+static void BM_DecodeClean(benchmark::State &state)
+{
+    static const std::vector<uint8_t> stream = make_stream(4096, 0.0);
+    run_decoder(state, stream);
+}
+BENCHMARK(BM_DecodeClean)->Arg(1)->Arg(64)->Arg(1460);
+
+// One flipped bit per ~1000 bytes, exercises the resync path
+static void BM_DecodeNoisy(benchmark::State &state)
+{
+    static const std::vector<uint8_t> stream = make_stream(4096, 0.001);
+    run_decoder(state, stream);
+}
+BENCHMARK(BM_DecodeNoisy)->Arg(1460);
+
+static void BM_EncodeLegTargets(benchmark::State &state)
+{
+    proto_leg_target_t t[2] = {{0, 100, 500}, {1, -40, 520}};
+    uint8_t frame[PROTO_MAX_FRAME];
+    uint16_t seq = 0;
+    for (auto _ : state) {
+        t[0].x_q4++;
+        benchmark::DoNotOptimize(proto_encode_leg_targets(seq++, t, 2, frame, sizeof(frame)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeLegTargets);
+
+// The text protocol this replaced: one "<leg> <x> <y>\n" line per leg in a
+// 256 byte buffer, split with strchr and strtol
+static void BM_TextLines(benchmark::State &state)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(-25, 56);
+    std::string text;
+    for (int i = 0; i < 4096; i++) {
+        for (int leg = 0; leg < 2; leg++) {
+            text += std::to_string(leg) + " " + std::to_string(coord(rng)) + " " + std::to_string(coord(rng)) + "\n";
+        }
+    }
+    std::vector<char> buf(text.begin(), text.end());
+    buf.push_back(0);
+    for (auto _ : state) {
+        std::vector<char> work(buf);
+        long sum = 0;
+        char *line = work.data();
+        char *nl;
+        while ((nl = strchr(line, '\n')) != NULL) {
+            *nl = 0;
+            char *end;
+            sum += strtol(line, &end, 10);
+            sum += strtol(end, &end, 10);
+            sum += strtol(end, &end, 10);
+            line = nl + 1;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_TextLines);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,188 @@
+// Telemetry path throughput: packing into the double buffer, the old
+// txQueue copy path for comparison, and end to end over loopback TCP.
+//   ./bench_telemetry --benchmark_counters_tabular=true
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "cmd_server.h"
+#include "telemetry.h"
+
+static void pack_payload(uint8_t *frame, uint32_t n)
+{
+    static const uint16_t ticks[TELEMETRY_SERVOS] = {1500, 1620, 1380, 1500};
+    telemetry_put_header(frame, n * 2000, n);
+    telemetry_put_servos(frame, ticks);
+    for (int i = 0; i < 2; i++) {
+        imu_sample_t s = {n * 2000 + i * 1000, {120, -40, 16384}, {3, -7, 1}, 1200};
+        telemetry_put_imu(frame, &s);
+    }
+}
+
+static void pack_frame(TelemetryBuffer *buf, uint32_t n)
+{
+    pack_payload(buf->begin(), n);
+    buf->commit((uint16_t)n);
+}
+
+// Producer and consumer on one thread: pack, commit, acquire, "send", release
+static void BM_TelemetryBuffer(benchmark::State &state)
+{
+    TelemetryBuffer *buf = new TelemetryBuffer();
+    uint8_t sink[TELEMETRY_FRAME_LEN];
+    uint32_t n = 0;
+    for (auto _ : state) {
+        pack_frame(buf, n++);
+        const uint8_t *frame = buf->acquire();
+        memcpy(sink, frame, TELEMETRY_FRAME_LEN);   // stands in for send()
+        buf->release(frame);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * TELEMETRY_FRAME_LEN);
+    delete buf;
+}
+BENCHMARK(BM_TelemetryBuffer);
+
+// The same frame through the old txQueue path: packed and encoded into a
+// local buffer, copied into the queue, copied out, then handed to send().
+// Same payload, CRC and byte count as above, only the two queue copies differ.
+static void BM_TxQueueCopy(benchmark::State &state)
+{
+    static uint8_t queue_slot[TELEMETRY_FRAME_LEN];
+    uint8_t msg[TELEMETRY_FRAME_LEN];
+    uint8_t out[TELEMETRY_FRAME_LEN];
+    uint8_t sink[TELEMETRY_FRAME_LEN];
+    uint32_t n = 0;
+    for (auto _ : state) {
+        memset(msg + PROTO_HEADER_LEN, 0, TELEMETRY_PAYLOAD_LEN);    // as begin() does
+        pack_payload(msg, n);
+        proto_encode(PROTO_MSG_TELEMETRY, (uint16_t)n, msg + PROTO_HEADER_LEN, TELEMETRY_PAYLOAD_LEN, msg, sizeof(msg));
+        n++;
+        memcpy(queue_slot, msg, sizeof(msg));       // xQueueSend
+        memcpy(out, queue_slot, sizeof(out));       // xQueueReceive
+        memcpy(sink, out, sizeof(out));             // send()
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * TELEMETRY_FRAME_LEN);
+}
+BENCHMARK(BM_TxQueueCopy);
+
+static const uint8_t *acquire(size_t *len, void *ctx)
+{
+    *len = TELEMETRY_FRAME_LEN;
+    return ((TelemetryBuffer *)ctx)->acquire();
+}
+
+static void release(const uint8_t *frame, void *ctx)
+{
+    ((TelemetryBuffer *)ctx)->release(frame);
+}
+
+struct rx_t {
+    uint32_t frames;
+    uint32_t last_sample;
+    uint32_t gaps;
+};
+
+static void on_telemetry(const proto_frame_t *frame, void *ctx)
+{
+    telemetry_frame_t t;
+    rx_t *rx = (rx_t *)ctx;
+    if (telemetry_parse(frame, &t) == 0) {
+        if (rx->frames && t.sample != rx->last_sample + 1) {
+            rx->gaps++;
+        }
+        rx->last_sample = t.sample;
+        rx->frames++;
+    }
+}
+
+// Producer thread packing as fast as it can, the server thread sending from
+// the buffer, this thread receiving and parsing. Frames the network could not
+// keep up with are overwritten, counted as gaps.
+static void BM_LoopbackStream(benchmark::State &state)
+{
+    TelemetryBuffer *buf = new TelemetryBuffer();
+    CmdServer server(0, NULL, NULL, NULL, NULL);
+    server.set_stream(acquire, release, buf);
+    if (server.open() != 0) {
+        state.SkipWithError("open failed");
+        delete buf;
+        return;
+    }
+    std::atomic<bool> stop(false);
+    std::thread net([&] {
+        while (!stop.load()) {
+            server.poll(10);
+        }
+    });
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(server.bound_port());
+    if (sock < 0 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        state.SkipWithError("connect failed");
+        stop = true;
+        net.join();
+        if (sock >= 0) {
+            close(sock);
+        }
+        delete buf;
+        return;
+    }
+    while (!server.connected()) {
+        std::this_thread::yield();
+    }
+
+    std::thread producer([&] {
+        uint32_t n = 0;
+        while (!stop.load()) {
+            pack_frame(buf, n++);
+            server.wake();
+            if ((n & 15) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    rx_t rx = {};
+    uint8_t chunk[4096];
+    for (auto _ : state) {
+        uint32_t target = rx.frames + 1000;
+        while (rx.frames < target) {
+            ssize_t n = recv(sock, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                state.SkipWithError("connection lost");
+                break;
+            }
+            proto_decoder_feed(&dec, chunk, n, on_telemetry, &rx);
+        }
+    }
+    state.SetItemsProcessed(rx.frames);
+    state.SetBytesProcessed((int64_t)rx.frames * TELEMETRY_FRAME_LEN);
+    state.counters["gaps"] = rx.gaps;
+    state.counters["crc_err"] = dec.stats.crc_errors;
+
+    stop = true;
+    producer.join();
+    net.join();
+    close(sock);
+    delete buf;
+}
+BENCHMARK(BM_LoopbackStream)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,165 @@
+// Checks the servo calibration curves the firmware applies on every commit:
+//  - the identity curve maps every nominal compare value onto itself
+//  - random measured curves: knots hit exactly, monotonic in between, within
+//    half a tick of the exact piecewise linear curve
+//  - calib_valid() refuses curves out of range or not increasing
+//  - a calibration frame survives encode and parse
+// and the cost of calibrating one body commit (four servos).
+//   ./calib_check
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "protocol.h"
+#include "servo_calib.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+// A servo that is off center, scaled and a little bent, like a real one
+static calib_curve_t random_curve(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> offset(-120, 120), scale(0.85, 1.1), bend(-40, 40);
+    double o = offset(rng), k = scale(rng), b = bend(rng);
+    calib_curve_t c;
+    for (int i = 0; i < CALIB_POINTS; i++) {
+        double u = (double)i / (CALIB_POINTS - 1) * 2 - 1;     // -1..1
+        double v = SERVO_CENTER_TICKS + o + k * u * (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / 2 * 0.9 +
+                   b * (1 - u * u);
+        c.pulse_us[i] = (uint16_t)lrint(v);
+    }
+    return c;
+}
+
+static double reference(const calib_curve_t *c, int ticks)
+{
+    double pos = (ticks - SERVO_MIN_PULSEWIDTH_US) / (double)CALIB_STEP_TICKS;
+    int i = std::min((int)pos, CALIB_POINTS - 2);
+    double f = pos - i;
+    return c->pulse_us[i] + (c->pulse_us[i + 1] - c->pulse_us[i]) * f;
+}
+
+static void check_identity()
+{
+    calib_curve_t c;
+    calib_identity(&c);
+    int worst = 0;
+    for (int t = SERVO_MIN_PULSEWIDTH_US; t <= SERVO_MAX_PULSEWIDTH_US; t++) {
+        worst = std::max(worst, abs(calib_apply(&c, (uint16_t)t) - t));
+    }
+    printf("identity curve: largest change %d ticks\n", worst);
+    EXPECT(worst == 0, "identity moves a value by %d", worst);
+    EXPECT(calib_valid(&c, SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US), "identity refused");
+}
+
+static void check_random()
+{
+    std::mt19937 rng(17);
+    double worst_err = 0;
+    int refused = 0, curves = 2000;
+    bool monotonic = true, knots = true;
+    for (int n = 0; n < curves; n++) {
+        calib_curve_t c = random_curve(rng);
+        if (!calib_valid(&c, SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US)) {
+            refused++;
+            continue;
+        }
+        int prev = 0;
+        for (int t = SERVO_MIN_PULSEWIDTH_US; t <= SERVO_MAX_PULSEWIDTH_US; t++) {
+            int v = calib_apply(&c, (uint16_t)t);
+            worst_err = std::max(worst_err, fabs(v - reference(&c, t)));
+            monotonic = monotonic && v >= prev;
+            prev = v;
+        }
+        for (int i = 0; i < CALIB_POINTS; i++) {
+            knots = knots && calib_apply(&c, (uint16_t)(SERVO_MIN_PULSEWIDTH_US + i * CALIB_STEP_TICKS)) == c.pulse_us[i];
+        }
+    }
+    printf("%d random curves (%d out of range, refused): largest error %.2f ticks, monotonic %s, knots exact %s\n",
+           curves, refused, worst_err, monotonic ? "yes" : "no", knots ? "yes" : "no");
+    EXPECT(worst_err <= 0.5, "error %.2f ticks", worst_err);
+    EXPECT(monotonic, "calibrated values not monotonic");
+    EXPECT(knots, "knot missed");
+}
+
+static void check_valid()
+{
+    calib_curve_t c;
+    calib_identity(&c);
+    c.pulse_us[4] = c.pulse_us[3];
+    EXPECT(!calib_valid(&c, SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US), "flat segment accepted");
+    calib_identity(&c);
+    c.pulse_us[0] = SERVO_MIN_PULSEWIDTH_US - 1;
+    EXPECT(!calib_valid(&c, SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US), "pulse below the limit accepted");
+    calib_identity(&c);
+    EXPECT(!calib_valid(&c, 600, 2400), "curve beyond a narrower model accepted");
+}
+
+static void check_frame()
+{
+    proto_calib_t in = {2, PROTO_CALIB_SAVE, {}};
+    for (int i = 0; i < PROTO_CALIB_POINTS; i++) {
+        in.pulse_us[i] = (uint16_t)(510 + 245 * i);
+    }
+    uint8_t buf[PROTO_MAX_FRAME];
+    size_t len = proto_encode_calib(7, &in, buf, sizeof(buf));
+    proto_frame_t frame;
+    proto_calib_t out = {};
+    bool ok = len == PROTO_HEADER_LEN + PROTO_CALIB_LEN + PROTO_CRC_LEN && proto_decode_frame(buf, len, &frame) == 0 &&
+              proto_parse_calib(&frame, &out) == 1 && out.servo == in.servo && out.flags == in.flags;
+    for (int i = 0; i < PROTO_CALIB_POINTS; i++) {
+        ok = ok && out.pulse_us[i] == in.pulse_us[i];
+    }
+    printf("calibration frame: %zu bytes, round trip %s\n", len, ok ? "ok" : "broken");
+    EXPECT(ok, "calibration frame round trip");
+}
+
+static void bench()
+{
+    std::mt19937 rng(5);
+    calib_table_t table;
+    for (int s = 0; s < CALIB_SERVOS; s++) {
+        table.servo[s] = random_curve(rng);
+    }
+    std::uniform_int_distribution<int> ticks(SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US);
+    const int n = 1 << 16;
+    static uint16_t in[n][CALIB_SERVOS];
+    for (int i = 0; i < n; i++) {
+        for (int s = 0; s < CALIB_SERVOS; s++) {
+            in[i][s] = (uint16_t)ticks(rng);
+        }
+    }
+    uint32_t sink = 0;
+    clock_type::time_point t0 = clock_type::now();
+    for (int i = 0; i < n; i++) {
+        for (int s = 0; s < CALIB_SERVOS; s++) {
+            sink += calib_apply(&table.servo[s], in[i][s]);
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count() / n;
+    printf("one body commit through the table: %.1f ns (host), table %zu bytes (checksum %u)\n", ns, sizeof(table),
+           sink & 0xFF);
+}
+
+int main()
+{
+    check_identity();
+    check_random();
+    check_valid();
+    check_frame();
+    bench();
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
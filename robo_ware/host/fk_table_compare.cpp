@@ -0,0 +1,143 @@
+// Accuracy and speed of the fixed point FK table against the double precision
+// forward solve. Build with the host CMake project and run without args, exits
+// non-zero when the table strays too far on the poses the IK table commands or
+// misses too many of them.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "kinematics.h"
+#include "ik_lut.h"
+#include "fk_lut.h"
+
+#define MAX_ERROR_MM    0.25    // allowed on poses ik_lookup_ticks() produces
+#define MAX_MISS_PCT    0.1     // of those poses, next to a fold, left to fk_solve_degf()
+
+struct ticks_t {
+    uint16_t front;
+    uint16_t rear;
+};
+
+static bool ref_foot(double front_ticks, double rear_ticks, double *x, double *y)
+{
+    double front_deg, rear_deg;
+    ik_ticks_to_deg(front_ticks, rear_ticks, &front_deg, &rear_deg);
+    return fk_solve_deg(front_deg, rear_deg, x, y) == 0;
+}
+
+static double report_error(const char *name, std::vector<double> &err, size_t total)
+{
+    std::sort(err.begin(), err.end());
+    double sum = 0;
+    for (double e : err) {
+        sum += e;
+    }
+    printf("%-28s %7zu pts  miss %5.2f%%  mean %6.3f  p99 %6.3f  max %7.3f mm\n", name, err.size(),
+           100.0 * (total - err.size()) / total, sum / err.size(), err[err.size() * 99 / 100], err.back());
+    return err.back();
+}
+
+int main()
+{
+    // Round trip of every Q4 mm target the IK table solves, what the control
+    // loop will feed back. Error is against the double FK of the same ticks.
+    std::vector<ticks_t> commanded;
+    std::vector<double> err_cmd, err_round;
+    for (int32_t y = IK_TABLE_Y_MIN * 16; y < (IK_TABLE_Y_MIN + IK_TABLE_ROWS - 1) * 16; y += 4) {
+        for (int32_t x = IK_TABLE_X_MIN * 16; x < (IK_TABLE_X_MIN + IK_TABLE_COLS - 1) * 16; x += 4) {
+            ticks_t t;
+            if (ik_lookup_ticks(x, y, &t.front, &t.rear) != 0) {
+                continue;
+            }
+            commanded.push_back(t);
+            double rx, ry;
+            int32_t fx, fy;
+            if (!ref_foot(t.front, t.rear, &rx, &ry) || fk_lookup_q4(t.front, t.rear, &fx, &fy) != 0) {
+                continue;
+            }
+            err_cmd.push_back(std::hypot(fx / 16.0 - rx, fy / 16.0 - ry));
+            err_round.push_back(std::hypot(fx - x, fy - y) / 16.0);
+        }
+    }
+
+    // Any tick pair in the servo range
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dt(SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US);
+    std::vector<ticks_t> random;
+    std::vector<double> err_any;
+    size_t closed = 0;
+    while (random.size() < 100000) {
+        ticks_t t = {(uint16_t)dt(rng), (uint16_t)dt(rng)};
+        random.push_back(t);
+        double rx, ry;
+        int32_t fx, fy;
+        if (!ref_foot(t.front, t.rear, &rx, &ry)) {
+            continue;
+        }
+        closed++;
+        if (fk_lookup_q4(t.front, t.rear, &fx, &fy) == 0) {
+            err_any.push_back(std::hypot(fx / 16.0 - rx, fy / 16.0 - ry));
+        }
+    }
+
+    printf("FK table %dx%d cells, %zu bytes\n", FK_TABLE_COLS, FK_TABLE_ROWS, sizeof(fk_table));
+    double err_max = report_error("table, IK table poses", err_cmd, commanded.size());
+    report_error("round trip to the target", err_round, commanded.size());
+    report_error("table, any ticks", err_any, closed);
+    double miss_pct = 100.0 * (commanded.size() - err_cmd.size()) / commanded.size();
+    bool ok = miss_pct <= MAX_MISS_PCT && err_max <= MAX_ERROR_MM;
+
+    const int rounds = 20;
+    double sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const ticks_t &t : commanded) {
+            double x, y;
+            if (ref_foot(t.front, t.rear, &x, &y)) {
+                sink += x + y;
+            }
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    const float deg_per_tick = (float)(SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) /
+                               (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US);
+    for (int r = 0; r < rounds; r++) {
+        for (const ticks_t &t : commanded) {
+            float x, y;
+            float front_deg = (t.front - SERVO_CENTER_TICKS) * deg_per_tick + SERVO_HORN_OFFSET;
+            float rear_deg = SERVO_HORN_OFFSET - (t.rear - SERVO_CENTER_TICKS) * deg_per_tick;
+            if (fk_solve_degf(front_deg, rear_deg, &x, &y) == 0) {
+                sink += x + y;
+            }
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const ticks_t &t : commanded) {
+            int32_t x, y;
+            if (fk_lookup_q4(t.front, t.rear, &x, &y) == 0) {
+                sink += x + y;
+            }
+        }
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    double solves = (double)rounds * commanded.size();
+    double ns_double = std::chrono::duration<double, std::nano>(t1 - t0).count() / solves;
+    double ns_float = std::chrono::duration<double, std::nano>(t2 - t1).count() / solves;
+    double ns_table = std::chrono::duration<double, std::nano>(t3 - t2).count() / solves;
+    printf("double math  %7.2f ns/solve\n", ns_double);
+    printf("float math   %7.2f ns/solve  (%.1fx)\n", ns_float, ns_double / ns_float);
+    printf("table lookup %7.2f ns/solve  (%.1fx)\n", ns_table, ns_double / ns_table);
+    printf("(checksum %.0f)\n", sink);
+    if (ok) {
+        printf("PASS\n");
+    } else {
+        printf("FAILED, %.2f%% missed (limit %.2f%%), max error %.3f mm (limit %.2f mm)\n", miss_pct, MAX_MISS_PCT,
+               err_max, MAX_ERROR_MM);
+    }
+    return ok ? 0 : 1;
+}
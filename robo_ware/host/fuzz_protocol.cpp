@@ -0,0 +1,181 @@
+// Fuzzes the frame decoder. Standalone it runs a deterministic mutation loop
+// over valid frame streams and exits non-zero on any failure; built with
+// -fsanitize=fuzzer the main() is left out and libFuzzer drives the entry point.
+//   ./fuzz_protocol [iterations]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "protocol.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+struct collected_t {
+    std::vector<std::vector<uint8_t>> frames;   // re-encoded
+};
+
+// Every delivered frame has to be well formed and survive a parse/encode round trip
+static void on_frame(const proto_frame_t *frame, void *ctx)
+{
+    CHECK(frame->version == PROTO_VERSION);
+    CHECK(frame->len <= PROTO_MAX_PAYLOAD);
+
+    proto_leg_target_t targets[PROTO_MAX_LEG_TARGETS];
+    proto_servo_angle_t angles[PROTO_MAX_SERVO_ANGLES];
+    int n = proto_parse_leg_targets(frame, targets, PROTO_MAX_LEG_TARGETS);
+    CHECK(n <= (int)PROTO_MAX_LEG_TARGETS);
+    n = proto_parse_servo_angles(frame, angles, PROTO_MAX_SERVO_ANGLES);
+    CHECK(n <= (int)PROTO_MAX_SERVO_ANGLES);
+    proto_gait_t gait;
+    n = proto_parse_gait(frame, &gait);
+    CHECK(n == -1 || (frame->type == PROTO_MSG_GAIT && frame->len == PROTO_GAIT_LEN));
+    proto_calib_t calib;
+    n = proto_parse_calib(frame, &calib);
+    CHECK(n == -1 || (frame->type == PROTO_MSG_CALIB && frame->len == PROTO_CALIB_LEN));
+    proto_sched_t sched;
+    proto_sched_task_t sched_tasks[PROTO_MAX_SCHED_TASKS];
+    n = proto_parse_sched(frame, &sched, sched_tasks, PROTO_MAX_SCHED_TASKS);
+    CHECK(n <= (int)PROTO_MAX_SCHED_TASKS);
+    CHECK(n == -1 || sched_tasks[0].name[PROTO_SCHED_NAME_LEN] == 0 || n == 0);
+
+    std::vector<uint8_t> out(PROTO_MAX_FRAME);
+    size_t len = proto_encode(frame->type, frame->seq, frame->payload, frame->len, out.data(), out.size());
+    CHECK(len == (size_t)(PROTO_HEADER_LEN + frame->len + PROTO_CRC_LEN));
+    out.resize(len);
+    if (ctx) {
+        ((collected_t *)ctx)->frames.push_back(out);
+    }
+}
+
+static void feed_chunked(proto_decoder_t *dec, const uint8_t *data, size_t size, std::mt19937 &rng, void *ctx)
+{
+    size_t off = 0;
+    while (off < size) {
+        size_t n = std::min<size_t>(1 + rng() % 300, size - off);
+        proto_decoder_feed(dec, data + off, n, on_frame, ctx);
+        CHECK(dec->fill <= PROTO_MAX_FRAME);
+        off += n;
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    std::mt19937 rng((uint32_t)size);
+    feed_chunked(&dec, data, size, rng, NULL);
+    // Same bytes as one UDP datagram
+    proto_frame_t frame;
+    if (proto_decode_frame(data, size, &frame) == 0) {
+        on_frame(&frame, NULL);
+    }
+    return 0;
+}
+
+#ifndef BIPED_LIBFUZZER
+static std::vector<uint8_t> random_frame(std::mt19937 &rng, uint16_t seq)
+{
+    uint8_t frame[PROTO_MAX_FRAME];
+    size_t len;
+    switch (rng() % 3) {
+    case 0: {
+        proto_leg_target_t t[PROTO_MAX_LEG_TARGETS];
+        size_t count = rng() % (PROTO_MAX_LEG_TARGETS + 1);
+        for (size_t i = 0; i < count; i++) {
+            t[i] = {(uint8_t)(rng() & 1), (int16_t)rng(), (int16_t)rng()};
+        }
+        len = proto_encode_leg_targets(seq, t, count, frame, sizeof(frame));
+        break;
+    }
+    case 1: {
+        proto_servo_angle_t a[PROTO_MAX_SERVO_ANGLES];
+        size_t count = rng() % (PROTO_MAX_SERVO_ANGLES + 1);
+        for (size_t i = 0; i < count; i++) {
+            a[i] = {(uint8_t)(1 + rng() % 4), (int16_t)rng()};
+        }
+        len = proto_encode_servo_angles(seq, a, count, frame, sizeof(frame));
+        break;
+    }
+    default: {
+        // Unknown type full of magic bytes, the worst case for resync
+        uint8_t payload[PROTO_MAX_PAYLOAD];
+        uint16_t n = (uint16_t)(rng() % (PROTO_MAX_PAYLOAD + 1));
+        for (uint16_t i = 0; i < n; i++) {
+            payload[i] = (rng() & 1) ? PROTO_MAGIC0 : PROTO_MAGIC1;
+        }
+        len = proto_encode((uint8_t)(0x40 + rng() % 16), seq, payload, n, frame, sizeof(frame));
+        break;
+    }
+    }
+    return std::vector<uint8_t>(frame, frame + len);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000;
+    std::mt19937 rng(1234);
+    uint64_t fuzz_bytes = 0;
+    uint32_t fuzz_frames = 0;
+
+    for (uint32_t it = 0; it < iterations; it++) {
+        // Clean stream: every frame comes out, identical, whatever the chunking
+        std::vector<std::vector<uint8_t>> sent;
+        std::vector<uint8_t> stream;
+        size_t frames = 1 + rng() % 16;
+        for (size_t i = 0; i < frames; i++) {
+            sent.push_back(random_frame(rng, (uint16_t)(it * 16 + i)));
+            stream.insert(stream.end(), sent.back().begin(), sent.back().end());
+        }
+        collected_t got;
+        proto_decoder_t dec;
+        proto_decoder_init(&dec);
+        feed_chunked(&dec, stream.data(), stream.size(), rng, &got);
+        CHECK(got.frames == sent);
+        CHECK(dec.stats.crc_errors == 0 && dec.stats.skipped == 0);
+
+        // Mutated stream: anything may happen except a crash or a malformed frame
+        std::vector<uint8_t> bad(stream);
+        int mutations = 1 + rng() % 8;
+        for (int m = 0; m < mutations && !bad.empty(); m++) {
+            size_t pos = rng() % bad.size();
+            switch (rng() % 5) {
+            case 0: bad[pos] ^= (uint8_t)(1 << (rng() & 7)); break;
+            case 1: bad[pos] = (uint8_t)rng(); break;
+            case 2: bad.erase(bad.begin() + pos); break;
+            case 3: bad.insert(bad.begin() + pos, (uint8_t)rng()); break;
+            default: bad.resize(pos); break;
+            }
+        }
+        proto_decoder_init(&dec);
+        feed_chunked(&dec, bad.data(), bad.size(), rng, NULL);
+        fuzz_frames += dec.stats.frames;
+
+        // Pure noise
+        std::vector<uint8_t> noise(rng() % 2048);
+        for (uint8_t &b : noise) {
+            b = (uint8_t)rng();
+        }
+        LLVMFuzzerTestOneInput(noise.data(), noise.size());
+        fuzz_bytes += bad.size() + noise.size();
+
+        if (failures > 20) {
+            break;
+        }
+    }
+
+    printf("%u iterations, %llu mutated/noise bytes, %u frames recovered from mutated streams, %d failures\n",
+           iterations, (unsigned long long)fuzz_bytes, fuzz_frames, failures);
+    printf("%s\n", failures ? "FAIL" : "OK");
+    return failures != 0;
+}
+#endif
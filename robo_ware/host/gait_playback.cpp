@@ -0,0 +1,215 @@
+// Plays the firmware gait engine at the 50Hz servo rate through a scripted
+// sequence of parameter changes and checks that the compare values never
+// jump: the largest change between two ticks while blending has to stay
+// close to the largest change while walking steadily. Also reports how far
+// the interpolated table is from solving every point directly, the cost of
+// a tick with and without a table block being built, and the link traffic
+// against streaming foot targets.
+//
+// Script: start walking from the park pose, a longer and faster stride at
+// 5 s, an unreachable request at 8 s (rejected, walking goes on), stand at 10 s.
+//   ./gait_playback
+//   ./gait_playback --csv out.csv        compare values per tick
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "gait.h"
+#include "protocol.h"
+
+#define TICK_US         20000
+#define SIM_SECONDS     15
+#define LEG_PARK_X      10
+#define LEG_PARK_Y      45
+
+typedef std::chrono::steady_clock clock_type;
+
+static gait_params_t make_params(uint32_t period_ms, float length, float height)
+{
+    gait_params_t p;
+    p.period_us = period_ms * 1000;
+    p.step_length_q4 = (int16_t)lrintf(length * 16);
+    p.step_height_q4 = (int16_t)lrintf(height * 16);
+    p.center_x_q4 = LEG_PARK_X * 16;
+    p.stand_y_q4 = LEG_PARK_Y * 16;
+    p.phase_offset = 32768;
+    p.stance_pct = 60;
+    return p;
+}
+
+static void to_array(const body_ticks_t &b, int out[4])
+{
+    out[0] = b.left_front;
+    out[1] = b.left_rear;
+    out[2] = b.right_front;
+    out[3] = b.right_rear;
+}
+
+// One point of the path solved directly, no table
+static body_ticks_t solve_point(const gait_params_t *p, uint32_t phase)
+{
+    int16_t lx, ly, rx, ry;
+    GaitEngine::foot_path(p, phase, &lx, &ly);
+    GaitEngine::foot_path(p, phase + ((uint32_t)p->phase_offset << 16), &rx, &ry);
+    gait_targets_t t = {&lx, &ly, &rx, &ry, 1};
+    body_ticks_t out;
+    ik_solve_batch(&t, &out);
+    return out;
+}
+
+static int max_step(const body_ticks_t &a, const body_ticks_t &b)
+{
+    int x[4], y[4];
+    to_array(a, x);
+    to_array(b, y);
+    int m = 0;
+    for (int i = 0; i < 4; i++) {
+        m = std::max(m, abs(x[i] - y[i]));
+    }
+    return m;
+}
+
+// Largest tick to tick change of a gait played without any blending
+static int steady_step(const gait_params_t *p)
+{
+    uint32_t rate = (uint32_t)(((uint64_t)TICK_US << 32) / p->period_us);
+    body_ticks_t prev = solve_point(p, 0);
+    int m = 0;
+    for (uint64_t ph = rate; ph < ((uint64_t)1 << 32); ph += rate) {
+        body_ticks_t cur = solve_point(p, (uint32_t)ph);
+        m = std::max(m, max_step(prev, cur));
+        prev = cur;
+    }
+    return m;
+}
+
+// Interpolated table against direct IK on a fine phase grid
+static int table_error(const gait_params_t *p)
+{
+    body_ticks_t table[GAIT_TABLE_LEN];
+    for (uint32_t i = 0; i < GAIT_TABLE_LEN; i++) {
+        table[i] = solve_point(p, i << (32 - GAIT_TABLE_BITS));
+    }
+    int m = 0;
+    for (uint32_t k = 0; k < 4096; k++) {
+        uint32_t ph = k << 20;
+        uint32_t i = ph >> (32 - GAIT_TABLE_BITS);
+        double f = (ph & ((1u << (32 - GAIT_TABLE_BITS)) - 1)) / (double)(1u << (32 - GAIT_TABLE_BITS));
+        int a[4], b[4], d[4];
+        to_array(table[i], a);
+        to_array(table[(i + 1) % GAIT_TABLE_LEN], b);
+        to_array(solve_point(p, ph), d);
+        for (int s = 0; s < 4; s++) {
+            m = std::max(m, (int)lrint(fabs(a[s] + (b[s] - a[s]) * f - d[s])));
+        }
+    }
+    return m;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *csv = NULL;
+    if (argc >= 3 && strcmp(argv[1], "--csv") == 0) {
+        csv = fopen(argv[2], "w");
+        if (csv == NULL) {
+            perror(argv[2]);
+            return 1;
+        }
+        fprintf(csv, "t,left_front,left_rear,right_front,right_rear,walking\n");
+    }
+
+    gait_params_t walk = make_params(1000, 20, 8);
+    gait_params_t stride = make_params(600, 26, 10);
+    gait_params_t too_high = make_params(600, 26, 40);
+    gait_params_t stand = make_params(600, 0, 0);
+
+    GaitMailbox mailbox;
+    GaitEngine gait(&mailbox, TICK_US);
+
+    // Servos start parked, like LegSystem leaves them
+    int16_t px = LEG_PARK_X * 16, py = LEG_PARK_Y * 16;
+    gait_targets_t park_t = {&px, &py, &px, &py, 1};
+    body_ticks_t servos;
+    ik_solve_batch(&park_t, &servos);
+
+    // What the blends avoid: a table swapped in at the same phase, or a gait started cold from park
+    int steady = std::max(steady_step(&walk), steady_step(&stride));
+    int hard_switch = 0;
+    for (uint32_t k = 0; k < 256; k++) {
+        hard_switch = std::max(hard_switch, max_step(solve_point(&walk, k << 24), solve_point(&stride, k << 24)));
+    }
+    int cold_start = max_step(servos, solve_point(&walk, 0));
+
+    int blend_step = 0, walk_step = 0;
+    double tick_ns_sum = 0, tick_ns_max = 0;
+    uint32_t ticks = 0, walking_ticks = 0;
+    bool was_walking = false;
+    for (uint32_t t_us = 0; t_us < SIM_SECONDS * 1000000u; t_us += TICK_US) {
+        if (t_us == 0) {
+            mailbox.write(walk);
+        } else if (t_us == 5000000) {
+            mailbox.write(stride);
+        } else if (t_us == 8000000) {
+            mailbox.write(too_high);
+        } else if (t_us == 10000000) {
+            mailbox.write(stand);
+        }
+
+        uint16_t current[4] = {servos.left_front, servos.left_rear, servos.right_front, servos.right_rear};
+        body_ticks_t out;
+        clock_type::time_point t0 = clock_type::now();
+        bool walking = gait.tick(current, &out);
+        double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+        tick_ns_sum += ns;
+        tick_ns_max = std::max(tick_ns_max, ns);
+        ticks++;
+
+        if (walking) {
+            int step = max_step(servos, out);
+            // Blends run for one cycle after each accepted change
+            bool blending = (t_us < 1100000) || (t_us >= 5000000 && t_us < 5700000) || t_us >= 10000000;
+            if (blending) {
+                blend_step = std::max(blend_step, step);
+            } else {
+                walk_step = std::max(walk_step, step);
+            }
+            if (out.left_front == IK_TICKS_INVALID || out.right_front == IK_TICKS_INVALID) {
+                printf("FAIL: invalid compare value at %.2f s\n", t_us * 1e-6);
+                return 1;
+            }
+            servos = out;
+            walking_ticks++;
+        }
+        was_walking = walking;
+        if (csv != NULL) {
+            fprintf(csv, "%.2f,%u,%u,%u,%u,%d\n", t_us * 1e-6, servos.left_front, servos.left_rear,
+                    servos.right_front, servos.right_rear, walking);
+        }
+    }
+    if (csv != NULL) {
+        fclose(csv);
+    }
+
+    gait_stats_t st;
+    gait.get_stats(&st);
+    printf("gait: %u requests, %u rejected, %u blends, %u cycles, walked %.2f s\n", (unsigned)st.requests,
+           (unsigned)st.rejected, (unsigned)st.blends, (unsigned)st.cycles, walking_ticks * TICK_US * 1e-6);
+    printf("largest tick to tick change: steady %d, while walking %d, while blending %d\n", steady, walk_step,
+           blend_step);
+    printf("without blending: table switch up to %d on top of the step, cold start %d\n", hard_switch, cold_start);
+    printf("table of %d points vs direct IK: max error %d ticks walk, %d ticks stride\n", GAIT_TABLE_LEN,
+           table_error(&walk), table_error(&stride));
+    printf("tick: mean %.0f ns, max %.0f ns (host, max includes a %d point table block)\n", tick_ns_sum / ticks,
+           tick_ns_max, IK_BATCH_BLOCK);
+    double stream = 50.0 * (PROTO_HEADER_LEN + 2 * PROTO_LEG_TARGET_LEN + PROTO_CRC_LEN);
+    printf("link: %.0f B/s streaming both feet at 50Hz vs %d B per gait change\n", stream,
+           PROTO_HEADER_LEN + PROTO_GAIT_LEN + PROTO_CRC_LEN);
+
+    // Blending may be a little steeper than steady walking (two paths at once), never a jump
+    bool ok = st.rejected == 1 && st.blends == 3 && !was_walking && blend_step <= steady * 3 / 2 + 2;
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+// Accuracy and speed of the fixed point IK table against the double precision
+// math it replaces. Build with the host CMake project and run without args.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "kinematics.h"
+#include "ik_lut.h"
+#include "ik_batch.h"
+
+struct target_t {
+    int32_t x_q4;
+    int32_t y_q4;
+};
+
+static bool ref_ticks(double x, double y, double *front, double *rear)
+{
+    double front_deg = 0, rear_deg = 0;
+    if (ik_solve_deg(x, y, &front_deg, &rear_deg) != 0) {
+        return false;
+    }
+    ik_deg_to_ticks(front_deg, rear_deg, front, rear);
+    return *front >= SERVO_MIN_PULSEWIDTH_US && *front <= SERVO_MAX_PULSEWIDTH_US &&
+           *rear >= SERVO_MIN_PULSEWIDTH_US && *rear <= SERVO_MAX_PULSEWIDTH_US;
+}
+
+static void report_error(const char *name, std::vector<double> &err, size_t reachable)
+{
+    std::sort(err.begin(), err.end());
+    double sum = 0;
+    for (double e : err) {
+        sum += e;
+    }
+    printf("%-28s %7zu pts  miss %5.2f%%  mean %6.3f  p99 %6.3f  max %7.3f ticks\n", name, err.size(),
+           100.0 * (reachable - err.size()) / reachable, sum / err.size(), err[err.size() * 99 / 100],
+           err.back());
+}
+
+int main()
+{
+    // Every reachable integer mm target, what LegSystem::set_leg_pos receives today
+    std::vector<double> err_int, err_trunc;
+    size_t reachable_int = 0;
+    for (int y = IK_TABLE_Y_MIN; y < IK_TABLE_Y_MIN + IK_TABLE_ROWS; y++) {
+        for (int x = IK_TABLE_X_MIN; x < IK_TABLE_X_MIN + IK_TABLE_COLS; x++) {
+            double front, rear;
+            if (!ref_ticks(x, y, &front, &rear)) {
+                continue;
+            }
+            reachable_int++;
+
+            // Old calc_angle truncated the IK angles to whole degrees
+            double front_deg = 0, rear_deg = 0, tf, tr;
+            ik_solve_deg(x, y, &front_deg, &rear_deg);
+            ik_deg_to_ticks((int)front_deg, (int)rear_deg, &tf, &tr);
+            err_trunc.push_back(std::max(fabs(tf - front), fabs(tr - rear)));
+
+            uint16_t lf, lr;
+            if (ik_lookup_ticks(x * 16, y * 16, &lf, &lr) == 0) {
+                err_int.push_back(std::max(fabs(lf - front), fabs(lr - rear)));
+            }
+        }
+    }
+
+    // Random sub-mm targets exercise the interpolation
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int32_t> dx(IK_TABLE_X_MIN * 16, (IK_TABLE_X_MIN + IK_TABLE_COLS - 1) * 16);
+    std::uniform_int_distribution<int32_t> dy(IK_TABLE_Y_MIN * 16, (IK_TABLE_Y_MIN + IK_TABLE_ROWS - 1) * 16);
+    std::vector<target_t> targets;
+    std::vector<double> err_q4;
+    size_t reachable_q4 = 0;
+    while (targets.size() < 100000) {
+        target_t t = {dx(rng), dy(rng)};
+        double front, rear;
+        if (!ref_ticks(t.x_q4 / 16.0, t.y_q4 / 16.0, &front, &rear)) {
+            continue;
+        }
+        reachable_q4++;
+        targets.push_back(t);
+        uint16_t lf, lr;
+        if (ik_lookup_ticks(t.x_q4, t.y_q4, &lf, &lr) == 0) {
+            err_q4.push_back(std::max(fabs(lf - front), fabs(lr - rear)));
+        }
+    }
+
+    printf("IK table %dx%d cells, %zu bytes\n", IK_TABLE_COLS, IK_TABLE_ROWS, sizeof(ik_table));
+    report_error("old calc_angle (int deg)", err_trunc, reachable_int);
+    report_error("table, integer mm", err_int, reachable_int);
+    report_error("table, Q4 mm", err_q4, reachable_q4);
+
+    // The batch solver has to agree with the scalar lookup bit for bit
+    std::vector<int16_t> bx, by;
+    for (const target_t &t : targets) {
+        bx.push_back((int16_t)t.x_q4);
+        by.push_back((int16_t)t.y_q4);
+    }
+    gait_targets_t batch = {bx.data(), by.data(), bx.data(), by.data(), bx.size()};
+    std::vector<body_ticks_t> solved(batch.count);
+    size_t invalid = ik_solve_batch(&batch, solved.data());
+    size_t mismatch = 0;
+    for (size_t i = 0; i < targets.size(); i++) {
+        uint16_t lf = IK_TICKS_INVALID, lr = IK_TICKS_INVALID;
+        bool ok = ik_lookup_ticks(targets[i].x_q4, targets[i].y_q4, &lf, &lr) == 0;
+        const body_ticks_t &b = solved[i];
+        if (b.left_front != lf || b.left_rear != lr ||
+            b.right_front != (ok ? SERVO_MIRROR_TICKS - lf : IK_TICKS_INVALID) ||
+            b.right_rear != (ok ? SERVO_MIRROR_TICKS - lr : IK_TICKS_INVALID)) {
+            mismatch++;
+        }
+    }
+    printf("batch solve: %zu points, %zu unreachable, %zu mismatches vs scalar\n", batch.count, invalid, mismatch);
+
+    const int rounds = 20;
+    uint32_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const target_t &t : targets) {
+            double front_deg = 0, rear_deg = 0, front, rear;
+            ik_solve_deg(t.x_q4 / 16.0, t.y_q4 / 16.0, &front_deg, &rear_deg);
+            ik_deg_to_ticks(front_deg, rear_deg, &front, &rear);
+            sink += (uint32_t)front + (uint32_t)rear;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const target_t &t : targets) {
+            uint16_t front, rear;
+            if (ik_lookup_ticks(t.x_q4, t.y_q4, &front, &rear) == 0) {
+                sink += front + rear;
+            }
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double solves = (double)rounds * targets.size();
+    double ns_double = std::chrono::duration<double, std::nano>(t1 - t0).count() / solves;
+    double ns_table = std::chrono::duration<double, std::nano>(t2 - t1).count() / solves;
+    printf("double math  %7.2f ns/solve\n", ns_double);
+    printf("table lookup %7.2f ns/solve  (%.1fx)\n", ns_table, ns_double / ns_table);
+    printf("(checksum %u)\n", sink);
+    return mismatch == 0 ? 0 : 1;
+}
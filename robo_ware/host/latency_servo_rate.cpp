@@ -0,0 +1,190 @@
+// Command to pulse latency of the servo pipeline at each frame rate the
+// servo models allow. A discrete event model of the firmware path:
+//   command lands in the setpoint ring at a random time
+//   -> the control task wakes on a TEZ (plus wakeup latency) and takes it
+//   -> LegSystem commits: early in the period straight to the shadow
+//      registers, latched on the next TEZ; too late (LEG_COMMIT_GUARD_US) it is
+//      written by the next TEZ interrupt and latched one period later
+//   -> the first pulse with the new width ends (falling edge)
+// A control tick still running at a TEZ runs again right away, further TEZs
+// in the meantime collapse into that one, like ulTaskNotifyTake(pdTRUE).
+// Wakeup and execution times are assumptions, roughly what the control log
+// reports (latency max, exec max) with Wi-Fi busy; adjust with the flags.
+//
+// Second table: a 10 degree step through the firmware ServoProfiler at the
+// default Kconfig limits, time from the latch to the first pulse that moved
+// and to the first pulse on the target.
+//   ./latency_servo_rate [commands] [--exec-us N] [--spike-us N]
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "kinematics.h"
+#include "servo_model.h"
+#include "servo_profile.h"
+
+#define COMMIT_GUARD_US     200     // LEG_COMMIT_GUARD_US
+#define WAKE_US             15      // TEZ to control task running, fixed part
+#define WAKE_TAIL_US        25      // plus exponential tail of this mean
+#define SPIKE_PROB          0.002   // ticks delayed by a Wi-Fi interrupt burst
+#define COMMAND_GAP_US      10000   // mean time between commands
+#define STEP_DEG            10
+#define SPEED_DPS           600     // CONFIG_BIPED_SERVO_SPEED_DPS default
+#define ACCEL_DPS2          10000   // CONFIG_BIPED_SERVO_ACCEL_DPS2 default
+#define TICKS_PER_DEG       ((SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / (float)(SERVO_MAX_DEGREE - SERVO_MIN_DEGREE))
+
+typedef struct {
+    uint32_t frame_us;
+    double p50, p99, max, mean;
+    double deferred_pct;
+    uint32_t collapsed;     // TEZs that found the task still busy
+} rate_result_t;
+
+static double percentile(std::vector<double> &v, double p)
+{
+    size_t i = (size_t)(p * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + i, v.end());
+    return v[i];
+}
+
+static rate_result_t run_rate(uint32_t frame_us, int commands, double exec_us, double spike_us, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> gap(1.0 / COMMAND_GAP_US);
+    std::exponential_distribution<double> wake_tail(1.0 / WAKE_TAIL_US);
+    std::exponential_distribution<double> exec_tail(1.0 / (exec_us * 0.5));
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::uniform_int_distribution<int> width(SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US);
+
+    // Command arrival times, consumed in order
+    std::vector<double> arrivals(commands);
+    double t = frame_us * 3.7;
+    for (int i = 0; i < commands; i++) {
+        t += gap(rng);
+        arrivals[i] = t;
+    }
+
+    std::vector<double> latency;
+    latency.reserve(commands);
+    uint32_t deferred = 0, ticks = 0, collapsed = 0;
+    double busy_until = 0;
+    int next = 0;
+    for (uint64_t k = 0; next < commands; ) {
+        double tez = (double)k * frame_us;
+        double wake = WAKE_US + wake_tail(rng);
+        if (unit(rng) < SPIKE_PROB) {
+            wake += spike_us * unit(rng);
+        }
+        double start = std::max(tez + wake, busy_until);
+        double commit = start + exec_us * 0.5 + exec_tail(rng);
+        busy_until = commit;
+        ticks++;
+
+        // Everything in the ring when the tick drains it goes out in this commit
+        int first = next;
+        while (next < commands && arrivals[next] <= start) {
+            next++;
+        }
+        if (next != first) {
+            uint64_t j = (uint64_t)(commit / frame_us);
+            double since = commit - (double)j * frame_us;
+            bool direct = since < frame_us - COMMIT_GUARD_US;
+            double latch = (double)(j + (direct ? 1 : 2)) * frame_us;
+            deferred += direct ? 0 : 1;
+            for (int i = first; i < next; i++) {
+                latency.push_back(latch + width(rng) - arrivals[i]);
+            }
+        }
+
+        uint64_t k_next = std::max<uint64_t>(k + 1, (uint64_t)(busy_until / frame_us));
+        collapsed += (uint32_t)(k_next - k - 1);
+        k = k_next;
+    }
+
+    rate_result_t r = {};
+    r.frame_us = frame_us;
+    double sum = 0;
+    for (double v : latency) {
+        sum += v;
+        r.max = std::max(r.max, v);
+    }
+    r.mean = sum / latency.size();
+    r.p50 = percentile(latency, 0.5);
+    r.p99 = percentile(latency, 0.99);
+    r.deferred_pct = 100.0 * deferred / ticks;
+    r.collapsed = collapsed;
+    return r;
+}
+
+// Frames from the latch of a 10 degree step to its first moved pulse and to the target
+static void profile_step(uint32_t frame_us, int *first_move, int *arrive)
+{
+    ServoProfiler p(frame_us);
+    profile_limits_t lim = {SPEED_DPS * TICKS_PER_DEG, ACCEL_DPS2 * TICKS_PER_DEG};
+    p.set_limits(0, lim);
+    p.reset(0, SERVO_CENTER_TICKS);
+    uint16_t target = (uint16_t)lrintf(SERVO_CENTER_TICKS + STEP_DEG * TICKS_PER_DEG);
+    p.set_target(0, target);
+    uint16_t out[PROFILE_AXES];
+    *first_move = 0;
+    *arrive = 0;
+    for (int k = 1; k < 100000 && p.moving_mask() != 0; k++) {
+        p.step(out);
+        if (*first_move == 0 && out[0] != SERVO_CENTER_TICKS) {
+            *first_move = k;
+        }
+        if (out[0] == target) {
+            *arrive = k;
+            break;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int commands = 200000;
+    double exec_us = 250, spike_us = 2500;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--exec-us") == 0 && i + 1 < argc) {
+            exec_us = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--spike-us") == 0 && i + 1 < argc) {
+            spike_us = atof(argv[++i]);
+        } else {
+            commands = atoi(argv[i]);
+        }
+    }
+
+    const uint32_t rates[] = {50, 100, 200, 333};
+    printf("%d commands, wakeup %d+%d us, exec %.0f us mean, %.1f%% ticks up to %.0f us late\n", commands, WAKE_US,
+           WAKE_TAIL_US, exec_us, SPIKE_PROB * 100, spike_us);
+    printf("%5s %6s | %9s %9s %9s %9s | %8s %9s | %s\n", "rate", "frame", "mean", "p50", "p99", "max", "deferred",
+           "collapsed", "10deg step: first move, on target");
+
+    bool ok = true;
+    double prev_p99 = 1e18;
+    for (uint32_t hz : rates) {
+        // The slowest model that takes this rate
+        const servo_model_t *model = servo_model(SERVO_MODEL_ANALOG);
+        for (int m = SERVO_MODEL_COUNT - 1; m >= 0; m--) {
+            if (servo_models[m].max_hz >= hz) {
+                model = &servo_models[m];
+            }
+        }
+        uint32_t frame = servo_frame_us(hz, model, model);
+        rate_result_t r = run_rate(frame, commands, exec_us, spike_us, hz);
+        int first_move, arrive;
+        profile_step(frame, &first_move, &arrive);
+        printf("%4uHz %5uus | %7.2fms %7.2fms %7.2fms %7.2fms | %7.2f%% %9u | %.1f ms, %.1f ms (%s)\n", hz, frame,
+               r.mean * 1e-3, r.p50 * 1e-3, r.p99 * 1e-3, r.max * 1e-3, r.deferred_pct, r.collapsed,
+               first_move * frame * 1e-3, arrive * frame * 1e-3, model->name);
+        // Worst case without a spike: just missed a tick, deferred, longest pulse
+        ok = ok && r.p99 < prev_p99 && r.p99 <= 3.0 * frame + SERVO_MAX_PULSEWIDTH_US && arrive != 0;
+        prev_p99 = r.p99;
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
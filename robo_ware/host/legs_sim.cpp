@@ -0,0 +1,310 @@
+// LegSystem on the Linux HAL backend: the firmware's leg code, unchanged,
+// driving simulated PWM timers.
+//
+// Self test (default): checks the pulse widths each TEZ latches against the
+// commits, direct, deferred to the TEZ interrupt and coalesced, that both
+// legs always switch on the same period, that a move settles with forward
+// kinematics putting the feet back on their targets, and the I2C replay the
+// IMU reader reads through. Exits non-zero on failure.
+//   ./legs_sim
+//
+// Benchmark: the control tick (two foot targets through IK, a profile step,
+// a commit) and both TEZ interrupts in a loop, for a profiler:
+//   ./legs_sim --bench [seconds] [rate_hz]
+//   perf record -g ./legs_sim --bench 10 && perf report
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "hal_clock.h"
+#include "hal_i2c.h"
+#include "hal_sim.h"
+#include "imu_sample.h"
+#include "legs.h"
+
+#define T0_US           1000000
+#define MPU_ADDR        0x68
+#define MPU_ACCEL_XOUT  0x3B
+#define MPU_SMPLRT_DIV  0x19
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static int periods_seen = 0;
+
+static bool on_period(int timer, void *ctx) {
+    (void)ctx;
+    if (timer == 0) {
+        periods_seen++;
+    }
+    return false;
+}
+
+// Compare values of left front, left rear, right front, right rear
+static void outputs(uint32_t out[4]) {
+    out[0] = hal_sim_pwm_output(0, 0);
+    out[1] = hal_sim_pwm_output(0, 1);
+    out[2] = hal_sim_pwm_output(1, 0);
+    out[3] = hal_sim_pwm_output(1, 1);
+}
+
+static bool outputs_are(const body_ticks_t *t) {
+    uint32_t out[4];
+    outputs(out);
+    return out[0] == t->left_front && out[1] == t->left_rear && out[2] == t->right_front && out[3] == t->right_rear;
+}
+
+// Both TEZ interrupts of one period, left first like the hardware
+static void tez() {
+    hal_sim_pwm_period(0);
+    hal_sim_pwm_period(1);
+}
+
+static void check_commits() {
+    hal_sim_reset();
+    hal_sim_clock_set(T0_US);
+    LegSystem *legs = new LegSystem(50, SERVO_MODEL_ANALOG, SERVO_MODEL_ANALOG, NULL);
+    const uint32_t period = legs->period_us();
+    EXPECT(period == 20000, "period %u us", period);
+
+    // Centered from the constructor on, before the timers run
+    body_ticks_t center = {1500, 1500, 1500, 1500};
+    EXPECT(outputs_are(&center), "not centered at start");
+    periods_seen = 0;
+    EXPECT(legs->start(on_period, NULL) == ESP_OK, "start failed");
+    tez();
+    EXPECT(periods_seen == 1, "on_period ran %d times for one period", periods_seen);
+
+    // Early in the period: written right away, latched by the next TEZ
+    hal_sim_clock_advance(100);
+    body_ticks_t a = {1400, 1600, 1450, 1550};
+    EXPECT(legs->commit_body(&a) == ESP_OK, "commit a failed");
+    EXPECT(outputs_are(&center), "a output before its TEZ");
+    EXPECT(hal_sim_pwm_shadow(0, 0) == 1400 && hal_sim_pwm_shadow(1, 1) == 1550, "a not in the shadow registers");
+    hal_sim_clock_advance(period - 100);
+    tez();
+    EXPECT(outputs_are(&a), "a not latched by the next TEZ");
+
+    // Inside the guard before the next TEZ: left to the TEZ interrupts
+    hal_sim_clock_advance(period - LEG_COMMIT_GUARD_US / 2);
+    body_ticks_t b = {1300, 1700, 1350, 1650};
+    EXPECT(legs->commit_body(&b) == ESP_OK, "commit b failed");
+    EXPECT(hal_sim_pwm_shadow(0, 0) == 1400, "late commit written directly");
+    hal_sim_clock_advance(LEG_COMMIT_GUARD_US / 2);
+    hal_sim_pwm_period(0);
+    EXPECT(hal_sim_pwm_shadow(0, 0) == 1300 && hal_sim_pwm_shadow(1, 0) == 1450,
+           "left TEZ should take b for its own leg only");
+    hal_sim_pwm_period(1);
+    EXPECT(hal_sim_pwm_shadow(1, 0) == 1350, "right TEZ did not write its share of b");
+    EXPECT(outputs_are(&a), "b latched a period early");
+    hal_sim_clock_advance(period);
+    tez();
+    EXPECT(outputs_are(&b), "b not latched on the same period by both legs");
+
+    // Two late commits before a TEZ: only the newer one goes out
+    hal_sim_clock_advance(period - LEG_COMMIT_GUARD_US / 2);
+    body_ticks_t c = {1200, 1800, 1250, 1750};
+    body_ticks_t d = {1210, 1790, 1260, 1740};
+    legs->commit_body(&c);
+    legs->commit_body(&d);
+    hal_sim_clock_advance(LEG_COMMIT_GUARD_US / 2);
+    tez();
+    hal_sim_clock_advance(period);
+    tez();
+    EXPECT(outputs_are(&d), "coalesced commit lost");
+
+    leg_commit_stats_t stats;
+    legs->get_commit_stats(&stats);
+    EXPECT(stats.commits == 4 && stats.direct == 1 && stats.deferred == 3 && stats.coalesced == 1,
+           "stats: %u commits, %u direct, %u deferred, %u coalesced", stats.commits, stats.direct, stats.deferred,
+           stats.coalesced);
+
+    body_ticks_t bad = {100, 1500, 1500, 1500};
+    EXPECT(legs->commit_body(&bad) == ESP_ERR_INVALID_ARG, "pulse outside the servo model taken");
+
+    // Every write is one of a pair for the same leg, never a torn leg
+    hal_pwm_write_t log[64];
+    size_t n = hal_sim_pwm_writes(log, 64);
+    EXPECT(n == hal_sim_pwm_write_count() && n % 2 == 0, "%zu writes logged", n);
+    for (size_t i = 0; i + 1 < n; i += 2) {
+        EXPECT(log[i].timer == log[i + 1].timer && log[i].channel == 0 && log[i + 1].channel == 1 &&
+               log[i].time_us == log[i + 1].time_us, "writes %zu and %zu not one leg", i, i + 1);
+    }
+    printf("commits: %zu compare writes over %u periods\n", n, hal_sim_pwm_periods(0));
+    delete legs;
+}
+
+static void check_motion() {
+    hal_sim_reset();
+    hal_sim_clock_set(T0_US);
+    LegSystem *legs = new LegSystem(50, SERVO_MODEL_ANALOG, SERVO_MODEL_ANALOG, NULL);
+    legs->start(NULL, NULL);
+    EXPECT(legs->settled(), "not settled at start");
+    // Well away from center first, so the profile takes a number of frames
+    EXPECT(legs->set_leg_pos(true, LEG_PARK_X + 20, LEG_PARK_Y + 10) == ESP_OK, "left target out of reach");
+    EXPECT(legs->set_leg_pos(false, LEG_PARK_X + 20, LEG_PARK_Y + 10) == ESP_OK, "right target out of reach");
+    EXPECT(!legs->settled(), "settled with a move pending");
+    EXPECT(legs->wait_settled(1) == ESP_ERR_TIMEOUT, "wait_settled returned before the move");
+
+    int frames = 0;
+    while (!legs->settled() && frames < 500) {
+        hal_sim_clock_advance(1000);
+        legs->step_motion();
+        hal_sim_clock_advance(legs->period_us() - 1000);
+        tez();
+        frames++;
+    }
+    tez();
+    EXPECT(legs->settled() && legs->wait_settled(0) == ESP_OK, "no settle in %d frames", frames);
+    uint16_t ticks[4];
+    legs->get_servo_ticks(ticks);
+    body_ticks_t pose = {ticks[0], ticks[1], ticks[2], ticks[3]};
+    EXPECT(outputs_are(&pose), "outputs differ from the committed pose");
+    EXPECT(ticks[0] + ticks[2] == SERVO_MIRROR_TICKS && ticks[1] + ticks[3] == SERVO_MIRROR_TICKS,
+           "right leg not mirrored");
+    // The feet solved back from the servo values land where they were sent
+    foot_state_t feet;
+    legs->estimate_feet(&feet);
+    const int32_t x_q4 = (LEG_PARK_X + 20) * 16, y_q4 = (LEG_PARK_Y + 10) * 16;
+    EXPECT(feet.valid == 3, "feet valid %#x", feet.valid);
+    for (int leg = 0; leg < 2; leg++) {
+        EXPECT(abs(feet.x_q4[leg] - x_q4) <= 8 && abs(feet.y_q4[leg] - y_q4) <= 8,
+               "foot %d estimated at (%.2f, %.2f)", leg, feet.x_q4[leg] / 16.0, feet.y_q4[leg] / 16.0);
+    }
+    EXPECT(feet.height_q4 == std::max(feet.y_q4[0], feet.y_q4[1]), "height %d", feet.height_q4);
+    EXPECT(legs->set_leg_pos(true, 200, 200) == ESP_ERR_INVALID_ARG, "unreachable foot position taken");
+    printf("motion: settled in %d frames\n", frames);
+    delete legs;
+}
+
+static void check_i2c() {
+    hal_sim_reset();
+    uint8_t raw[IMU_BURST_LEN];
+    EXPECT(hal_i2c_read_regs(0, MPU_ADDR, MPU_ACCEL_XOUT, raw, sizeof(raw), 20) != 0, "read before init");
+    EXPECT(hal_i2c_init(0, 21, 22, 400000) == 0, "init failed");
+
+    // Three recorded bursts, then the sensor stops answering
+    const int frames = 3;
+    uint8_t rec[frames * IMU_BURST_LEN];
+    for (int f = 0; f < frames; f++) {
+        int16_t v[7] = {(int16_t)(100 * f), -200, 8192, (int16_t)(-3000 + f), 5, -6, (int16_t)(32767 - f)};
+        for (int i = 0; i < 7; i++) {
+            rec[f * IMU_BURST_LEN + 2 * i] = (uint8_t)((uint16_t)v[i] >> 8);
+            rec[f * IMU_BURST_LEN + 2 * i + 1] = (uint8_t)v[i];
+        }
+    }
+    EXPECT(hal_sim_i2c_replay(0, MPU_ADDR, MPU_ACCEL_XOUT, rec, IMU_BURST_LEN, frames) == 0, "replay refused");
+    for (int f = 0; f < frames; f++) {
+        EXPECT(hal_i2c_read_regs(0, MPU_ADDR, MPU_ACCEL_XOUT, raw, sizeof(raw), 20) == 0, "burst %d failed", f);
+        imu_sample_t s;
+        imu_unpack_burst(raw, &s);
+        EXPECT(s.accel[0] == 100 * f && s.accel[1] == -200 && s.accel[2] == 8192 && s.temp == -3000 + f &&
+               s.gyro[0] == 5 && s.gyro[1] == -6 && s.gyro[2] == 32767 - f, "burst %d decoded wrong", f);
+    }
+    EXPECT(hal_sim_i2c_replay_left(0, MPU_ADDR, MPU_ACCEL_XOUT) == 0, "frames left over");
+    EXPECT(hal_i2c_read_regs(0, MPU_ADDR, MPU_ACCEL_XOUT, raw, sizeof(raw), 20) != 0, "read past the recording");
+
+    // Other registers are a plain register file
+    EXPECT(hal_i2c_write_reg(0, MPU_ADDR, MPU_SMPLRT_DIV, 4, 100) == 0, "write failed");
+    uint8_t div = 0;
+    EXPECT(hal_i2c_read_regs(0, MPU_ADDR, MPU_SMPLRT_DIV, &div, 1, 20) == 0 && div == 4, "register reads %u", div);
+    hal_i2c_write_t w;
+    EXPECT(hal_sim_i2c_writes(&w, 1) == 1 && w.reg == MPU_SMPLRT_DIV && w.value == 4, "write not logged");
+    EXPECT(hal_i2c_write_reg(0, MPU_ADDR + 1, 0, 0, 100) != 0, "absent device acknowledged");
+}
+
+static void check_free_run() {
+    hal_sim_reset();
+    hal_sim_pwm_free_run(true);
+    LegSystem *legs = new LegSystem(200, SERVO_MODEL_DIGITAL_200, SERVO_MODEL_DIGITAL_200, NULL);
+    periods_seen = 0;
+    legs->start(on_period, NULL);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    hal_sim_reset();
+    // 20 periods of 5ms, a loaded machine may wake late
+    EXPECT(periods_seen >= 10 && periods_seen <= 21, "%d periods in 100ms", periods_seen);
+    delete legs;
+}
+
+static void bench(double seconds, uint32_t rate_hz) {
+    hal_sim_reset();
+    static Tracer trace;
+    LegSystem *legs = new LegSystem(rate_hz, SERVO_MODEL_DIGITAL_333, SERVO_MODEL_DIGITAL_333, NULL);
+    legs->set_trace(&trace);
+    legs->start(NULL, NULL);
+    // Speed limits off: every tick commits
+    for (int servo = 1; servo <= 4; servo++) {
+        legs->set_servo_limits(servo, 0, 0);
+    }
+
+    // Both feet around a circle inside the workspace, one point per tick
+    const int points = 256;
+    int32_t xs[points], ys[points];
+    for (int i = 0; i < points; i++) {
+        double a = 2 * M_PI * i / points;
+        xs[i] = (int32_t)lround((LEG_PARK_X + 10 * cos(a)) * (1 << IK_FRAC_BITS));
+        ys[i] = (int32_t)lround((LEG_PARK_Y + 10 * sin(a)) * (1 << IK_FRAC_BITS));
+    }
+
+    uint64_t ticks = 0;
+    uint32_t refused = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1000; i++, ticks++) {
+            int p = (int)(ticks % points);
+            refused += legs->set_leg_pos_q4(true, xs[p], ys[p]) != ESP_OK;
+            refused += legs->set_leg_pos_q4(false, xs[(p + points / 2) % points], ys[(p + points / 2) % points]) !=
+                       ESP_OK;
+            legs->step_motion();
+            tez();
+        }
+    }
+    double took = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    leg_commit_stats_t stats;
+    legs->get_commit_stats(&stats);
+    printf("%llu ticks in %.2f s, %.0f ns per tick, %u targets refused\n", (unsigned long long)ticks, took,
+           took * 1e9 / ticks, refused);
+    printf("commits %u: direct %u, deferred %u, coalesced %u\n", stats.commits, stats.direct, stats.deferred,
+           stats.coalesced);
+    printf("%-10s %10s %8s %8s %8s %8s\n", "stage", "count", "min ns", "avg ns", "p99 ns", "max ns");
+    for (int i = 0; i < TRACE_STAGES; i++) {
+        trace_summary_t s;
+        trace.summary((trace_stage_t)i, &s);
+        if (s.count != 0) {
+            printf("%-10s %10u %8u %8u %8u %8u\n", trace_stage_names[i], s.count, s.min_ns, s.avg_ns, s.p99_ns,
+                   s.max_ns);
+        }
+    }
+    delete legs;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        double seconds = argc > 2 ? atof(argv[2]) : 5;
+        uint32_t rate_hz = argc > 3 ? (uint32_t)atoi(argv[3]) : 333;
+        bench(seconds, rate_hz);
+        return 0;
+    }
+
+    check_commits();
+    check_motion();
+    check_i2c();
+    check_free_run();
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,283 @@
+// Runs the command server over loopback and prints latency histograms for
+//   command: client send() to on_frame() in the server
+//   ping:    PING to PONG round trip
+//   tx:      frame queued by another thread + wake() to client recv()
+// then reconnects repeatedly to check no sockets leak.
+//   ./loopback_latency [samples] [--poll-ms N]
+// --poll-ms N replaces the select() wait with a N ms sleep between
+// non-blocking polls, the way the old rx/tx tasks ran.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "cmd_server.h"
+#include "protocol.h"
+#include "spsc_ring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static uint32_t now_us()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+// log2 buckets in us plus exact percentiles from the sorted samples
+static void print_histogram(const char *name, std::vector<uint32_t> samples)
+{
+    if (samples.empty()) {
+        printf("%s: no samples\n", name);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    printf("%s: %zu samples, min %u us, p50 %u us, p99 %u us, max %u us\n", name, n, samples[0], samples[n / 2],
+           samples[n * 99 / 100], samples[n - 1]);
+    uint32_t buckets[32] = {};
+    for (uint32_t s : samples) {
+        int b = 0;
+        while (b < 31 && (1u << (b + 1)) <= s) {
+            b++;
+        }
+        buckets[s == 0 ? 0 : b]++;
+    }
+    for (int b = 0; b < 32; b++) {
+        if (buckets[b]) {
+            printf("  %7u..%-7u us %7u %s\n", b ? 1u << b : 0, (2u << b) - 1, buckets[b],
+                   std::string(std::max<size_t>(1, (size_t)buckets[b] * 50 / n), '#').c_str());
+        }
+    }
+}
+
+struct tx_frame_t {
+    uint16_t len;
+    uint8_t data[PROTO_MAX_FRAME];
+};
+
+struct harness_t {
+    CmdServer *server;
+    std::vector<uint32_t> cmd_sent;         // by seq
+    std::vector<uint32_t> cmd_latency;
+    SpscRing<tx_frame_t, 16> tx_ring;
+};
+
+static void on_frame(const proto_frame_t *frame, void *ctx)
+{
+    harness_t *h = (harness_t *)ctx;
+    if (frame->type == PROTO_MSG_LEG_TARGETS) {
+        if (frame->seq < h->cmd_sent.size()) {
+            h->cmd_latency.push_back(now_us() - h->cmd_sent[frame->seq]);
+        }
+    } else if (frame->type == PROTO_MSG_PING) {
+        uint8_t reply[PROTO_MAX_FRAME];
+        size_t len = proto_encode(PROTO_MSG_PONG, frame->seq, frame->payload, frame->len, reply, sizeof(reply));
+        h->server->send(reply, len);
+    }
+}
+
+static size_t pull_tx(uint8_t *buf, size_t size, void *ctx)
+{
+    harness_t *h = (harness_t *)ctx;
+    tx_frame_t f;
+    if (!h->tx_ring.pop(&f) || f.len > size) {
+        return 0;
+    }
+    memcpy(buf, f.data, f.len);
+    return f.len;
+}
+
+static int connect_to(uint16_t port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("connect");
+        exit(1);
+    }
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return sock;
+}
+
+// Reads exactly one frame of the expected type
+static bool recv_frame(int sock, proto_decoder_t *dec, uint8_t type, uint16_t *seq)
+{
+    struct want_t {
+        uint8_t type;
+        bool got;
+        uint16_t seq;
+    } want = {type, false, 0};
+    uint8_t buf[256];
+    while (!want.got) {
+        ssize_t n = recv(sock, buf, 1, 0);  // one byte at a time so nothing past the frame is consumed
+        if (n <= 0) {
+            return false;
+        }
+        proto_decoder_feed(dec, buf, n, [](const proto_frame_t *f, void *ctx) {
+            want_t *w = (want_t *)ctx;
+            if (f->type == w->type) {
+                w->got = true;
+                w->seq = f->seq;
+            }
+        }, &want);
+    }
+    *seq = want.seq;
+    return true;
+}
+
+static int open_fds()
+{
+    int count = 0;
+    DIR *d = opendir("/proc/self/fd");
+    if (d == NULL) {
+        return -1;
+    }
+    while (readdir(d) != NULL) {
+        count++;
+    }
+    closedir(d);
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t samples = 2000;
+    int poll_ms = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--poll-ms") == 0 && i + 1 < argc) {
+            poll_ms = atoi(argv[++i]);
+        } else {
+            samples = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+    harness_t h;
+    h.cmd_sent.resize(samples);
+    h.cmd_latency.reserve(samples);
+    CmdServer server(0, on_frame, &h, pull_tx, &h);
+    h.server = &server;
+    if (server.open() != 0) {
+        return 1;
+    }
+    uint16_t port = server.bound_port();
+
+    std::atomic<bool> stop(false);
+    std::thread net([&] {
+        while (!stop.load()) {
+            if (poll_ms < 0) {
+                server.poll(100);   // the timeout only lets the thread notice stop
+            } else {
+                server.poll(0);
+                std::this_thread::sleep_for(std::chrono::milliseconds(poll_ms));
+            }
+        }
+    });
+
+    int sock = connect_to(port);
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    uint8_t frame[PROTO_MAX_FRAME];
+
+    // Commands, paced so each one is a separate segment
+    for (uint32_t i = 0; i < samples; i++) {
+        proto_leg_target_t t[2] = {{0, (int16_t)i, 500}, {1, (int16_t)-i, 500}};
+        size_t len = proto_encode_leg_targets((uint16_t)i, t, 2, frame, sizeof(frame));
+        h.cmd_sent[i] = now_us();
+        if (send(sock, frame, len, 0) != (ssize_t)len) {
+            perror("send");
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    // Round trips
+    std::vector<uint32_t> rtt;
+    for (uint32_t i = 0; i < samples; i++) {
+        uint32_t t0 = now_us();
+        size_t len = proto_encode(PROTO_MSG_PING, (uint16_t)i, (const uint8_t *)&t0, sizeof(t0), frame, sizeof(frame));
+        send(sock, frame, len, 0);
+        uint16_t seq;
+        if (!recv_frame(sock, &dec, PROTO_MSG_PONG, &seq)) {
+            fprintf(stderr, "connection lost waiting for PONG\n");
+            return 1;
+        }
+        rtt.push_back(now_us() - t0);
+    }
+
+    // Frames from another thread, like telemetry on the firmware
+    std::vector<uint32_t> tx_latency;
+    for (uint32_t i = 0; i < samples; i++) {
+        tx_frame_t f;
+        uint32_t t0 = now_us();
+        f.len = (uint16_t)proto_encode(PROTO_MSG_PONG, (uint16_t)i, NULL, 0, f.data, sizeof(f.data));
+        while (!h.tx_ring.push(f)) {
+            std::this_thread::yield();
+        }
+        server.wake();
+        uint16_t seq;
+        if (!recv_frame(sock, &dec, PROTO_MSG_PONG, &seq)) {
+            fprintf(stderr, "connection lost waiting for tx frame\n");
+            return 1;
+        }
+        tx_latency.push_back(now_us() - t0);
+    }
+
+    // Reconnect storm: the next connection opens before the old one closes, like
+    // a controller coming back after a Wi-Fi drop. Neither may stay open on the
+    // server. The first reconnect settles before fds are counted.
+    int reconnects = (int)std::min<uint32_t>(200, samples);
+    int fds_before = -1;
+    for (int i = 0; i < reconnects; i++) {
+        int next = connect_to(port);
+        close(sock);    // client side only, the server has already replaced it or will
+        sock = next;
+        size_t len = proto_encode(PROTO_MSG_PING, (uint16_t)i, NULL, 0, frame, sizeof(frame));
+        send(sock, frame, len, 0);
+        proto_decoder_init(&dec);
+        uint16_t seq;
+        if (!recv_frame(sock, &dec, PROTO_MSG_PONG, &seq)) {
+            fprintf(stderr, "reconnect %d got no PONG\n", i);
+            return 1;
+        }
+        if (i == 0) {
+            fds_before = open_fds();
+        }
+    }
+    int fds_after = open_fds();
+
+    close(sock);
+    stop = true;
+    net.join();
+
+    printf("mode: %s\n", poll_ms < 0 ? "select()" : "polling");
+    print_histogram("command", h.cmd_latency);
+    print_histogram("ping rtt", rtt);
+    print_histogram("tx wake", tx_latency);
+
+    const cmd_server_stats_t &s = server.get_stats();
+    const proto_stats_t &p = server.get_proto_stats();
+    printf("server: accepted %u replaced %u disconnects %u rx %u B tx %u B wakeups %u tx dropped %u\n", s.accepted,
+           s.replaced, s.disconnects, s.rx_bytes, s.tx_bytes, s.wakeups, s.tx_dropped);
+    printf("decoder (last client): frames %u crc errors %u skipped %u\n", p.frames, p.crc_errors, p.skipped);
+    printf("open fds after 1 and %d reconnects: %d, %d\n", reconnects, fds_before, fds_after);
+
+    bool ok = h.cmd_latency.size() == samples && fds_after == fds_before && s.accepted == (uint32_t)reconnects + 1;
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+// Checks the firmware servo profiler against reference trapezoids and its
+// own limits, at the 50Hz servo rate:
+//  - rest to rest moves of many lengths against the closed form trapezoid:
+//    arrival time, largest deviation along the way, overshoot, eta_us()
+//  - a reversal mid move: no jump, arrival, limits held
+//  - random retargeting: speed and acceleration of the compare values never
+//    beyond the limits (plus one tick of rounding), every target reached
+//  - a walking gait table played through it: how far the servos lag the table
+//  ./profile_check                      default limits (600 deg/s, 10000 deg/s^2)
+//  ./profile_check <dps> <dps2>         other limits
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "gait.h"
+#include "servo_profile.h"
+
+#define STEP_US         20000
+#define TICKS_PER_DEG   ((SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / (float)(SERVO_MAX_DEGREE - SERVO_MIN_DEGREE))
+
+typedef std::chrono::steady_clock clock_type;
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+// Continuous rest to rest trapezoid: position after t seconds of a move of d ticks
+static double reference_pos(double d, double vmax, double acc, double t, double *total)
+{
+    double t_acc = vmax / acc;
+    double d_acc = 0.5 * acc * t_acc * t_acc;
+    double t_cruise = 0;
+    if (2 * d_acc > d) {
+        t_acc = sqrt(d / acc);
+        vmax = acc * t_acc;
+        d_acc = d / 2;
+    } else {
+        t_cruise = (d - 2 * d_acc) / vmax;
+    }
+    *total = 2 * t_acc + t_cruise;
+    if (t <= 0) {
+        return 0;
+    }
+    if (t < t_acc) {
+        return 0.5 * acc * t * t;
+    }
+    if (t < t_acc + t_cruise) {
+        return d_acc + vmax * (t - t_acc);
+    }
+    if (t < *total) {
+        double r = *total - t;
+        return d - 0.5 * acc * r * r;
+    }
+    return d;
+}
+
+// Tracks the compare values handed out and checks speed and acceleration
+struct limit_check_t {
+    float vmax, acc;
+    int prev, prev2;
+    int steps;
+    float worst_speed, worst_accel;
+
+    void start(int ticks)
+    {
+        prev = prev2 = ticks;
+        steps = 0;
+    }
+
+    void next(int ticks)
+    {
+        float dt = STEP_US * 1e-6f;
+        float speed = fabsf((float)(ticks - prev)) / dt;
+        float accel = fabsf((float)(ticks - 2 * prev + prev2)) / (dt * dt);
+        // One tick of rounding on either side
+        worst_speed = std::max(worst_speed, speed - 1 / dt);
+        worst_accel = std::max(worst_accel, steps >= 1 ? accel - 2 / (dt * dt) : 0);
+        prev2 = prev;
+        prev = ticks;
+        steps++;
+    }
+};
+
+static void check_moves(const profile_limits_t &lim)
+{
+    const double dt = STEP_US * 1e-6;
+    double worst_dev = 0, worst_late = 0, worst_eta = 0;
+    int worst_overshoot = 0;
+    for (int d = 1; d <= 2000; d += (d < 50 ? 1 : 37)) {
+        ServoProfiler p(STEP_US);
+        p.set_limits(0, lim);
+        p.reset(0, SERVO_MIN_PULSEWIDTH_US);
+        p.set_target(0, (uint16_t)(SERVO_MIN_PULSEWIDTH_US + d));
+        double eta = p.eta_us(0) * 1e-6;
+
+        uint16_t out[PROFILE_AXES];
+        int k = 0;
+        double total = 0;
+        while (p.moving_mask() != 0 && k < 100000) {
+            p.step(out);
+            k++;
+            int pos = out[0] - SERVO_MIN_PULSEWIDTH_US;
+            // The step grid runs up to one step ahead of the continuous curve
+            double ref_lo = reference_pos(d, lim.max_speed, lim.max_accel, (k - 1) * dt, &total);
+            double ref_hi = reference_pos(d, lim.max_speed, lim.max_accel, (k + 1) * dt, &total);
+            double dev = pos < ref_lo ? ref_lo - pos : (pos > ref_hi ? pos - ref_hi : 0);
+            worst_dev = std::max(worst_dev, dev);
+            worst_overshoot = std::max(worst_overshoot, pos - d);
+        }
+        EXPECT(out[0] == SERVO_MIN_PULSEWIDTH_US + d, "move of %d ends at %d", d, out[0] - SERVO_MIN_PULSEWIDTH_US);
+        worst_late = std::max(worst_late, k * dt - total);
+        worst_eta = std::max(worst_eta, fabs(eta - total));
+    }
+    printf("rest to rest, 1..2000 ticks: arrival at most %.0f ms after the reference, deviation %.1f ticks, "
+           "overshoot %d, eta error %.1f ms\n", worst_late * 1e3, worst_dev, worst_overshoot, worst_eta * 1e3);
+    EXPECT(worst_overshoot == 0, "overshoot %d", worst_overshoot);
+    EXPECT(worst_late <= 2 * dt + 1e-9, "arrives %.1f ms late", worst_late * 1e3);
+    EXPECT(worst_dev <= 1.0, "deviates %.1f ticks from the reference", worst_dev);
+    EXPECT(worst_eta <= 2 * dt, "eta off by %.1f ms", worst_eta * 1e3);
+}
+
+static void check_reversal(const profile_limits_t &lim)
+{
+    ServoProfiler p(STEP_US);
+    p.set_limits(0, lim);
+    p.reset(0, 1000);
+    p.set_target(0, 2400);
+    limit_check_t lc = {lim.max_speed, lim.max_accel, 0, 0, 0, 0, 0};
+    lc.start(1000);
+    uint16_t out[PROFILE_AXES];
+    int k = 0, peak = 0;
+    for (; k < 10; k++) {
+        p.step(out);
+        lc.next(out[0]);
+    }
+    p.set_target(0, 800);
+    uint32_t eta = p.eta_us(0);
+    int after = 0;
+    while (p.moving_mask() != 0 && after < 10000) {
+        p.step(out);
+        lc.next(out[0]);
+        peak = std::max(peak, (int)out[0]);
+        after++;
+    }
+    printf("reversal after 10 steps: peaks at %d, at 800 after %d steps (eta said %.0f ms), "
+           "speed over limit %.0f, accel over limit %.0f ticks/s^2\n",
+           peak, after, eta * 1e-3, lc.worst_speed - lim.max_speed, lc.worst_accel - lim.max_accel);
+    EXPECT(out[0] == 800, "reversal ends at %d", out[0]);
+    EXPECT(fabs(after * STEP_US - (double)eta) <= 2 * STEP_US, "reversal eta %u us vs %d steps", eta, after);
+    EXPECT(lc.worst_speed <= lim.max_speed, "speed %.0f", lc.worst_speed);
+    EXPECT(lc.worst_accel <= lim.max_accel, "accel %.0f", lc.worst_accel);
+}
+
+static void check_random(const profile_limits_t &lim)
+{
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> ticks(SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US);
+    std::uniform_int_distribution<int> hold(1, 60);
+    ServoProfiler p(STEP_US);
+    limit_check_t lc[PROFILE_AXES];
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        p.set_limits(i, lim);
+        p.reset(i, SERVO_CENTER_TICKS);
+        lc[i] = {lim.max_speed, lim.max_accel, 0, 0, 0, 0, 0};
+        lc[i].start(SERVO_CENTER_TICKS);
+    }
+    int next_change[PROFILE_AXES] = {0, 0, 0, 0};
+    uint16_t out[PROFILE_AXES];
+    double ns_sum = 0, ns_max = 0;
+    const int steps = 200000;
+    for (int k = 0; k < steps; k++) {
+        for (int i = 0; i < PROFILE_AXES; i++) {
+            if (k == next_change[i]) {
+                p.set_target(i, (uint16_t)ticks(rng));
+                next_change[i] = k + hold(rng);
+            }
+        }
+        clock_type::time_point t0 = clock_type::now();
+        p.step(out);
+        double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+        ns_sum += ns;
+        ns_max = std::max(ns_max, ns);
+        for (int i = 0; i < PROFILE_AXES; i++) {
+            lc[i].next(out[i]);
+        }
+    }
+    // Let everything arrive
+    int settle = 0;
+    while (p.moving_mask() != 0 && settle < 1000) {
+        p.step(out);
+        settle++;
+    }
+    float speed = 0, accel = 0;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        speed = std::max(speed, lc[i].worst_speed);
+        accel = std::max(accel, lc[i].worst_accel);
+        EXPECT(out[i] == p.target(i), "axis %d ends at %d, target %d", i, out[i], p.target(i));
+    }
+    printf("random retargeting, %d steps x %d servos: speed %.0f of %.0f, accel %.0f of %.0f ticks/s^2, "
+           "step %.0f ns mean %.0f ns max (host)\n", steps, PROFILE_AXES, speed, lim.max_speed, accel,
+           lim.max_accel, ns_sum / steps, ns_max);
+    EXPECT(speed <= lim.max_speed, "speed %.0f", speed);
+    EXPECT(accel <= lim.max_accel, "accel %.0f", accel);
+}
+
+// A 1s walking cycle, the servos should follow the table closely with sane limits
+static void check_gait(const profile_limits_t &lim)
+{
+    gait_params_t g = {1000000, 20 * 16, 8 * 16, 10 * 16, 45 * 16, 32768, 60};
+    GaitMailbox mailbox;
+    GaitEngine gait(&mailbox, STEP_US);
+    mailbox.write(g);
+    ServoProfiler p(STEP_US);
+    int16_t px = 10 * 16, py = 45 * 16;
+    gait_targets_t park = {&px, &py, &px, &py, 1};
+    body_ticks_t servos;
+    ik_solve_batch(&park, &servos);
+    uint16_t *s = &servos.left_front;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        p.set_limits(i, lim);
+        p.reset(i, s[i]);
+    }
+    int lag = 0;
+    for (int k = 0; k < 500; k++) {
+        body_ticks_t want;
+        uint16_t current[4] = {s[0], s[1], s[2], s[3]};
+        if (gait.tick(current, &want)) {
+            const uint16_t *w = &want.left_front;
+            for (int i = 0; i < PROFILE_AXES; i++) {
+                p.set_target(i, w[i]);
+            }
+        }
+        p.step(s);
+        // After the fade in, compare with the table value of the previous tick
+        if (k >= 100) {
+            for (int i = 0; i < PROFILE_AXES; i++) {
+                lag = std::max(lag, abs((int)s[i] - (int)p.target(i)));
+            }
+        }
+    }
+    printf("1s gait, 20mm stride through the profiler: largest lag behind the table %d ticks (%.1f deg)\n", lag,
+           lag / TICKS_PER_DEG);
+}
+
+int main(int argc, char **argv)
+{
+    float dps = 600, dps2 = 10000;
+    if (argc >= 3) {
+        dps = (float)atof(argv[1]);
+        dps2 = (float)atof(argv[2]);
+    }
+    profile_limits_t lim = {dps * TICKS_PER_DEG, dps2 * TICKS_PER_DEG};
+    printf("limits %.0f deg/s, %.0f deg/s^2 = %.0f ticks/s, %.0f ticks/s^2, step %d us\n", dps, dps2,
+           lim.max_speed, lim.max_accel, STEP_US);
+
+    check_moves(lim);
+    check_reversal(lim);
+    check_random(lim);
+    check_gait(lim);
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
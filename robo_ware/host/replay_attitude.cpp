@@ -0,0 +1,394 @@
+// Attitude estimators replayed over an IMU log: cost per update and error or
+// drift of the Mahony filter (float and Q30) against the complementary filter
+// of the mpu6050 component.
+//
+// Without a log a synthetic one is generated: rest, then roll/pitch/yaw swings
+// with accel vibration, gyro bias and timestamp jitter, then rest again. It
+// carries ground truth, so errors are absolute.
+//   ./replay_attitude [--write synth.csv]
+//
+// Replay a recorded log (raw LSB, optional truth columns in degrees):
+//   timestamp_us,ax,ay,az,gx,gy,gz,temp[,roll,pitch,yaw]
+//   ./replay_attitude log.csv [accel_lsb_per_g gyro_lsb_per_dps]
+//
+// Record one from the robot's telemetry stream:
+//   ./replay_attitude --record <ip> [port] [seconds] <out.csv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "attitude.h"
+#include "protocol.h"
+#include "telemetry.h"
+
+#define ACCEL_LSB       8192.0f     // +-4g, what the firmware configures
+#define GYRO_LSB        65.5f       // +-500dps
+#define SYNTH_HZ        1000
+#define SYNTH_SECONDS   60
+#define REST_SECONDS    5
+#define COST_REPEAT     20
+
+typedef std::chrono::steady_clock clock_type;
+
+static float accel_lsb = ACCEL_LSB;
+static float gyro_lsb = GYRO_LSB;
+
+struct record_t {
+    imu_sample_t s;
+    bool has_truth;
+    euler_t truth;
+};
+
+// mpu6050_complimentory_filter() with the component's constants. The two
+// gettimeofday() calls stay in for the cost, but dt comes from the log so
+// the replay runs faster than real time. Inputs are in g and dps, as
+// mpu6050_get_acce/gyro return them.
+struct Complementary {
+    float roll, pitch;
+    uint32_t counter;
+    uint32_t last_us;
+    struct timeval timer;
+
+    Complementary() : roll(0), pitch(0), counter(0), last_us(0) {}
+
+    void update(const imu_sample_t *s)
+    {
+        float ax = s->accel[0] / accel_lsb, ay = s->accel[1] / accel_lsb, az = s->accel[2] / accel_lsb;
+        float gx = s->gyro[0] / gyro_lsb, gy = s->gyro[1] / gyro_lsb;
+        counter++;
+        if (counter == 1) {
+            roll = atan2(ay, az) * 57.27272727f;
+            pitch = atan2(ax, az) * 57.27272727f;
+            gettimeofday(&timer, NULL);
+            last_us = s->timestamp_us;
+            return;
+        }
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        gettimeofday(&timer, NULL);
+        float dt = (s->timestamp_us - last_us) * 1e-6f;
+        last_us = s->timestamp_us;
+
+        float acce_roll = atan2(ay, az) * 57.27272727f;
+        float acce_pitch = atan2(ax, az) * 57.27272727f;
+        roll = 0.99f * (roll + gx * dt) + 0.01f * acce_roll;
+        pitch = 0.99f * (pitch + gy * dt) + 0.01f * acce_pitch;
+    }
+
+    euler_t euler() const
+    {
+        euler_t e = {roll, pitch, 0};
+        return e;
+    }
+};
+
+static int16_t clamp16(double v)
+{
+    return (int16_t)std::max(-32768.0, std::min(32767.0, std::round(v)));
+}
+
+static std::vector<record_t> synthesize()
+{
+    std::mt19937 rng(11);
+    std::normal_distribution<double> accel_noise(0, 0.02);      // g, plus walking vibration below
+    std::normal_distribution<double> gyro_noise(0, 0.05);       // dps
+    std::uniform_int_distribution<int> jitter(-40, 40);         // us
+    const double bias[3] = {1.5, -1.0, 0.5};                    // dps
+    const double d2r = M_PI / 180;
+
+    std::vector<record_t> log;
+    uint32_t ts = 1000000;
+    for (int n = 0; n < SYNTH_HZ * SYNTH_SECONDS; n++) {
+        ts += 1000000 / SYNTH_HZ + jitter(rng);
+        double t = n / (double)SYNTH_HZ;
+        bool moving = t > REST_SECONDS && t < SYNTH_SECONDS - REST_SECONDS;
+        double m = moving ? 1 : 0;
+        double tm = t - REST_SECONDS;
+        // Euler angles and their rates, radians
+        double phi = m * 20 * d2r * sin(2 * M_PI * 0.5 * tm);
+        double dphi = m * 20 * d2r * 2 * M_PI * 0.5 * cos(2 * M_PI * 0.5 * tm);
+        double theta = m * 15 * d2r * sin(2 * M_PI * 0.3 * tm);
+        double dtheta = m * 15 * d2r * 2 * M_PI * 0.3 * cos(2 * M_PI * 0.3 * tm);
+        double psi = m * 30 * d2r * sin(2 * M_PI * 0.1 * tm);
+        double dpsi = m * 30 * d2r * 2 * M_PI * 0.1 * cos(2 * M_PI * 0.1 * tm);
+
+        // Body rates from Z-Y-X Euler rates
+        double p = dphi - dpsi * sin(theta);
+        double q = dtheta * cos(phi) + dpsi * cos(theta) * sin(phi);
+        double r = -dtheta * sin(phi) + dpsi * cos(theta) * cos(phi);
+        // Gravity reaction in the body frame, plus a 2Hz step impact while moving
+        double bounce = m * 0.3 * std::max(0.0, sin(2 * M_PI * 2 * tm));
+        double ax = -sin(theta) + accel_noise(rng);
+        double ay = sin(phi) * cos(theta) + accel_noise(rng);
+        double az = cos(phi) * cos(theta) + bounce + accel_noise(rng);
+
+        record_t r_ = {};
+        r_.s.timestamp_us = ts;
+        r_.s.accel[0] = clamp16(ax * ACCEL_LSB);
+        r_.s.accel[1] = clamp16(ay * ACCEL_LSB);
+        r_.s.accel[2] = clamp16(az * ACCEL_LSB);
+        r_.s.gyro[0] = clamp16((p / d2r + bias[0] + gyro_noise(rng)) * GYRO_LSB);
+        r_.s.gyro[1] = clamp16((q / d2r + bias[1] + gyro_noise(rng)) * GYRO_LSB);
+        r_.s.gyro[2] = clamp16((r / d2r + bias[2] + gyro_noise(rng)) * GYRO_LSB);
+        r_.s.temp = 1200;
+        r_.has_truth = true;
+        r_.truth.roll = (float)(phi / d2r);
+        r_.truth.pitch = (float)(theta / d2r);
+        r_.truth.yaw = (float)(psi / d2r);
+        log.push_back(r_);
+    }
+    return log;
+}
+
+static bool read_csv(const char *path, std::vector<record_t> *log)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned ts;
+        int a[3], g[3], temp;
+        float tr[3];
+        int n = sscanf(line, "%u,%d,%d,%d,%d,%d,%d,%d,%f,%f,%f", &ts, &a[0], &a[1], &a[2], &g[0], &g[1], &g[2],
+                       &temp, &tr[0], &tr[1], &tr[2]);
+        if (n < 8) {
+            continue;   // header or junk
+        }
+        record_t r = {};
+        r.s.timestamp_us = ts;
+        for (int i = 0; i < 3; i++) {
+            r.s.accel[i] = (int16_t)a[i];
+            r.s.gyro[i] = (int16_t)g[i];
+        }
+        r.s.temp = (int16_t)temp;
+        r.has_truth = n == 11;
+        if (r.has_truth) {
+            r.truth.roll = tr[0];
+            r.truth.pitch = tr[1];
+            r.truth.yaw = tr[2];
+        }
+        log->push_back(r);
+    }
+    fclose(f);
+    return true;
+}
+
+static void write_csv_row(FILE *f, const record_t &r)
+{
+    fprintf(f, "%u,%d,%d,%d,%d,%d,%d,%d", (unsigned)r.s.timestamp_us, r.s.accel[0], r.s.accel[1], r.s.accel[2],
+            r.s.gyro[0], r.s.gyro[1], r.s.gyro[2], r.s.temp);
+    if (r.has_truth) {
+        fprintf(f, ",%.4f,%.4f,%.4f", r.truth.roll, r.truth.pitch, r.truth.yaw);
+    }
+    fprintf(f, "\n");
+}
+
+static void on_telemetry(const proto_frame_t *frame, void *ctx)
+{
+    telemetry_frame_t t;
+    if (telemetry_parse(frame, &t) != 0) {
+        return;
+    }
+    for (int i = 0; i < t.imu_count; i++) {
+        record_t r = {};
+        r.s = t.imu[i];
+        write_csv_row((FILE *)ctx, r);
+    }
+}
+
+static int record(const char *ip, uint16_t port, int seconds, const char *path)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, ip, &addr.sin_addr) != 1 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "cannot connect to %s:%u\n", ip, (unsigned)port);
+        return 1;
+    }
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    fprintf(f, "timestamp_us,ax,ay,az,gx,gy,gz,temp\n");
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    uint8_t chunk[4096];
+    clock_type::time_point end = clock_type::now() + std::chrono::seconds(seconds);
+    while (clock_type::now() < end) {
+        ssize_t n = recv(sock, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            break;
+        }
+        proto_decoder_feed(&dec, chunk, n, on_telemetry, f);
+    }
+    fclose(f);
+    close(sock);
+    printf("%u frames, %u CRC errors -> %s\n", (unsigned)dec.stats.frames, (unsigned)dec.stats.crc_errors, path);
+    return 0;
+}
+
+static float wrap180(float a)
+{
+    while (a > 180) {
+        a -= 360;
+    }
+    while (a < -180) {
+        a += 360;
+    }
+    return a;
+}
+
+struct errors_t {
+    double sq[3];
+    float max[3];
+    float end[3];       // mean error over the final rest period
+    euler_t first;      // mean estimate over the first and last second,
+    euler_t last;       // for logs without truth
+    uint32_t n;
+};
+
+template <typename F>
+static double cost_ns(F &filter, const std::vector<record_t> &log)
+{
+    volatile float sink = 0;
+    clock_type::time_point t0 = clock_type::now();
+    for (int rep = 0; rep < COST_REPEAT; rep++) {
+        filter = F();
+        for (const record_t &r : log) {
+            filter.update(&r.s);
+            sink = sink + filter.euler().roll;  // firmware publishes Euler every sample
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+    return ns / ((double)COST_REPEAT * log.size());
+}
+
+template <typename F>
+static errors_t replay(F &filter, const std::vector<record_t> &log, uint32_t rate_hz)
+{
+    errors_t e;
+    memset(&e, 0, sizeof(e));
+    size_t tail = std::min(log.size(), (size_t)rate_hz * 2);
+    size_t second = std::min(log.size(), (size_t)rate_hz);
+    for (size_t i = 0; i < log.size(); i++) {
+        filter.update(&log[i].s);
+        euler_t est = filter.euler();
+        const float *v = &est.roll;
+        if (i < second) {
+            e.first.roll += est.roll / second;
+            e.first.pitch += est.pitch / second;
+            e.first.yaw += est.yaw / second;
+        }
+        if (i >= log.size() - second) {
+            e.last.roll += est.roll / second;
+            e.last.pitch += est.pitch / second;
+            e.last.yaw += est.yaw / second;
+        }
+        if (!log[i].has_truth) {
+            continue;
+        }
+        const float *t = &log[i].truth.roll;
+        for (int k = 0; k < 3; k++) {
+            float d = fabsf(wrap180(v[k] - t[k]));
+            e.sq[k] += d * d;
+            e.max[k] = std::max(e.max[k], d);
+            if (i >= log.size() - tail) {
+                e.end[k] += d / tail;
+            }
+        }
+        e.n++;
+    }
+    return e;
+}
+
+template <typename F>
+static void report(const char *name, F filter, const std::vector<record_t> &log, uint32_t rate_hz, bool has_yaw)
+{
+    double ns = cost_ns(filter, log);
+    filter = F();
+    errors_t e = replay(filter, log, rate_hz);
+    printf("%-14s %7.1f ns/update", name, ns);
+    if (e.n > 0) {
+        for (int k = 0; k < (has_yaw ? 3 : 2); k++) {
+            printf(" | %s rms %5.2f max %6.2f end %5.2f", k == 0 ? "roll" : (k == 1 ? "pitch" : "yaw"),
+                   sqrt(e.sq[k] / e.n), e.max[k], e.end[k]);
+        }
+    } else {
+        printf(" | roll %+6.2f -> %+6.2f pitch %+6.2f -> %+6.2f", e.first.roll, e.last.roll, e.first.pitch,
+               e.last.pitch);
+        if (has_yaw) {
+            printf(" yaw %+7.2f -> %+7.2f", e.first.yaw, e.last.yaw);
+        }
+    }
+    printf("\n");
+}
+
+// Default constructible wrappers with the scale applied, so cost_ns() can reset them
+struct Mahony : MahonyFilter {
+    Mahony() { set_scale(::accel_lsb, ::gyro_lsb); }
+};
+
+struct MahonyQ : MahonyFilterQ {
+    MahonyQ() { set_scale(::accel_lsb, ::gyro_lsb); }
+};
+
+int main(int argc, char **argv)
+{
+    std::vector<record_t> log;
+    if (argc >= 3 && strcmp(argv[1], "--record") == 0) {
+        const char *ip = argv[2];
+        uint16_t port = argc > 4 ? (uint16_t)atoi(argv[3]) : 3333;
+        int seconds = argc > 5 ? atoi(argv[4]) : 30;
+        return record(ip, port, seconds, argv[argc - 1]);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--write") != 0) {
+        if (argc > 3) {
+            accel_lsb = (float)atof(argv[2]);
+            gyro_lsb = (float)atof(argv[3]);
+        }
+        if (!read_csv(argv[1], &log) || log.size() < 2) {
+            fprintf(stderr, "no samples in %s\n", argv[1]);
+            return 1;
+        }
+    } else {
+        log = synthesize();
+        if (argc >= 3) {
+            FILE *f = fopen(argv[2], "w");
+            if (f == NULL) {
+                perror(argv[2]);
+                return 1;
+            }
+            fprintf(f, "timestamp_us,ax,ay,az,gx,gy,gz,temp,roll,pitch,yaw\n");
+            for (const record_t &r : log) {
+                write_csv_row(f, r);
+            }
+            fclose(f);
+        }
+    }
+
+    uint32_t span = log.back().s.timestamp_us - log.front().s.timestamp_us;
+    uint32_t rate_hz = (uint32_t)((log.size() - 1) * 1000000.0 / span + 0.5);
+    printf("%zu samples, %.1f s, %u Hz%s\n", log.size(), span * 1e-6, (unsigned)rate_hz,
+           log[0].has_truth ? ", errors in degrees against truth" : ", no truth: mean of first -> last second");
+
+    report("complementary", Complementary(), log, rate_hz, false);
+    report("mahony", Mahony(), log, rate_hz, true);
+    report("mahony Q30", MahonyQ(), log, rate_hz, true);
+    return 0;
+}
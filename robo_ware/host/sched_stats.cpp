@@ -0,0 +1,192 @@
+// CPU load per core, wakeup latency and per task CPU time, asked from a robot
+// over the command connection (PROTO_MSG_SCHED_REQ). Each reply covers the
+// time since the previous report, the firmware's own 30s log included.
+//   ./sched_stats <ip> [port] [interval_s] [count]
+//
+// Without an address: encodes a full report, parses it back and checks that
+// every field survives, names of all lengths included. Exits non-zero on
+// failure.
+//   ./sched_stats
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "protocol.h"
+
+#define DEFAULT_PORT    3333
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static void print_report(const proto_sched_t *s, const proto_sched_task_t *tasks, int count)
+{
+    printf("window %.1f s | core 0 %5.1f%% latency max %u us | core 1 %5.1f%% latency max %u us\n",
+           s->window_us * 1e-6, s->load_permille[0] / 10.0, s->latency_max_us[0], s->load_permille[1] / 10.0,
+           s->latency_max_us[1]);
+    printf("  %-12s %4s %4s %6s %10s\n", "task", "core", "prio", "cpu", "stack free");
+    for (int i = 0; i < count; i++) {
+        const proto_sched_task_t *t = &tasks[i];
+        char core[8];
+        if (t->core == PROTO_SCHED_ANY_CORE) {
+            snprintf(core, sizeof(core), "any");
+        } else {
+            snprintf(core, sizeof(core), "%u", t->core);
+        }
+        printf("  %-12s %4s %4u %5.1f%% %10u\n", t->name, core, t->prio, t->share_permille / 10.0, t->stack_free);
+    }
+}
+
+static void self_test()
+{
+    proto_sched_t s = {12345678, {987, 12}, {41, 4000000000u}};
+    proto_sched_task_t tasks[PROTO_MAX_SCHED_TASKS];
+    for (int i = 0; i < (int)PROTO_MAX_SCHED_TASKS; i++) {
+        proto_sched_task_t *t = &tasks[i];
+        memset(t->name, 0, sizeof(t->name));
+        // Empty up to exactly PROTO_SCHED_NAME_LEN characters
+        for (int c = 0; c < i + 1 && c < PROTO_SCHED_NAME_LEN; c++) {
+            t->name[c] = (char)('a' + c);
+        }
+        if (i == 0) {
+            t->name[0] = 0;
+        }
+        t->core = i % 3 == 2 ? PROTO_SCHED_ANY_CORE : (uint8_t)(i % 2);
+        t->prio = (uint8_t)(24 - i);
+        t->share_permille = (uint16_t)(1000 - 80 * i);
+        t->stack_free = (uint16_t)(65535 - i);
+    }
+
+    for (size_t count = 0; count <= PROTO_MAX_SCHED_TASKS; count++) {
+        uint8_t frame[PROTO_MAX_FRAME];
+        size_t len = proto_encode_sched(7, &s, tasks, count, frame, sizeof(frame));
+        EXPECT(len == PROTO_HEADER_LEN + PROTO_SCHED_LEN + count * PROTO_SCHED_TASK_LEN + PROTO_CRC_LEN,
+               "%zu tasks encode to %zu bytes", count, len);
+        proto_frame_t f;
+        EXPECT(proto_decode_frame(frame, len, &f) == 0, "%zu tasks: frame does not decode", count);
+        proto_sched_t back;
+        proto_sched_task_t back_tasks[PROTO_MAX_SCHED_TASKS];
+        int n = proto_parse_sched(&f, &back, back_tasks, PROTO_MAX_SCHED_TASKS);
+        EXPECT(n == (int)count, "%zu tasks parse to %d", count, n);
+        EXPECT(back.window_us == s.window_us && back.load_permille[0] == 987 && back.load_permille[1] == 12 &&
+               back.latency_max_us[0] == 41 && back.latency_max_us[1] == 4000000000u, "header fields differ");
+        for (int i = 0; i < n; i++) {
+            EXPECT(strcmp(back_tasks[i].name, tasks[i].name) == 0, "name %d: '%s' vs '%s'", i, back_tasks[i].name,
+                   tasks[i].name);
+            EXPECT(back_tasks[i].core == tasks[i].core && back_tasks[i].prio == tasks[i].prio &&
+                   back_tasks[i].share_permille == tasks[i].share_permille &&
+                   back_tasks[i].stack_free == tasks[i].stack_free, "task %d fields differ", i);
+        }
+        if (count > 0) {
+            // Room for fewer tasks than the frame carries is an error, not a truncation
+            EXPECT(proto_parse_sched(&f, &back, back_tasks, count - 1) == -1, "%zu tasks fit in %zu", count,
+                   count - 1);
+        }
+    }
+    uint8_t frame[PROTO_MAX_FRAME];
+    EXPECT(proto_encode_sched(1, &s, tasks, PROTO_MAX_SCHED_TASKS + 1, frame, sizeof(frame)) == 0,
+           "encodes more than PROTO_MAX_SCHED_TASKS");
+
+    uint8_t last[PROTO_MAX_FRAME];
+    size_t len = proto_encode_sched(1, &s, tasks, PROTO_MAX_SCHED_TASKS, last, sizeof(last));
+    proto_frame_t f;
+    proto_decode_frame(last, len, &f);
+    proto_sched_t back;
+    proto_sched_task_t back_tasks[PROTO_MAX_SCHED_TASKS];
+    int n = proto_parse_sched(&f, &back, back_tasks, PROTO_MAX_SCHED_TASKS);
+    print_report(&back, back_tasks, n);
+}
+
+// Reads until a PROTO_MSG_SCHED frame parses, false on a closed connection
+static bool recv_report(int sock, proto_decoder_t *dec, proto_sched_t *s, proto_sched_task_t *tasks, int *count)
+{
+    struct want_t {
+        proto_sched_t *s;
+        proto_sched_task_t *tasks;
+        int count;
+    } want = {s, tasks, -1};
+    uint8_t buf[256];
+    while (want.count < 0) {
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            return false;
+        }
+        // Telemetry frames share the connection, everything else is skipped
+        proto_decoder_feed(dec, buf, n, [](const proto_frame_t *f, void *ctx) {
+            want_t *w = (want_t *)ctx;
+            if (f->type == PROTO_MSG_SCHED) {
+                w->count = proto_parse_sched(f, w->s, w->tasks, PROTO_MAX_SCHED_TASKS);
+            }
+        }, &want);
+    }
+    *count = want.count;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        self_test();
+        printf("%s\n", failures ? "FAIL" : "PASS");
+        return failures ? 1 : 0;
+    }
+
+    uint16_t port = argc > 2 ? (uint16_t)atoi(argv[2]) : DEFAULT_PORT;
+    int interval = argc > 3 ? atoi(argv[3]) : 5;
+    int reports = argc > 4 ? atoi(argv[4]) : 0;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, argv[1], &addr.sin_addr) != 1) {
+        fprintf(stderr, "bad address %s\n", argv[1]);
+        return 1;
+    }
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("connect");
+        return 1;
+    }
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    for (int k = 0; reports == 0 || k < reports; k++) {
+        uint8_t req[PROTO_MAX_FRAME];
+        size_t len = proto_encode(PROTO_MSG_SCHED_REQ, (uint16_t)k, NULL, 0, req, sizeof(req));
+        if (send(sock, req, len, 0) != (ssize_t)len) {
+            perror("send");
+            return 1;
+        }
+        proto_sched_t s;
+        proto_sched_task_t tasks[PROTO_MAX_SCHED_TASKS];
+        int count;
+        if (!recv_report(sock, &dec, &s, tasks, &count)) {
+            fprintf(stderr, "connection lost\n");
+            return 1;
+        }
+        if (count < 0) {
+            fprintf(stderr, "malformed report\n");
+            continue;
+        }
+        print_report(&s, tasks, count);
+        sleep(interval);
+    }
+    close(sock);
+    return 0;
+}
@@ -0,0 +1,215 @@
+// Command server output over a socket that only takes a few bytes per send().
+// send() is wrapped for the server's sockets: every call takes 1 to 17 bytes
+// and every fourth fails with EAGAIN, so every stream frame, reply and queued
+// frame goes out in pieces. Meanwhile the client pings, which queues PONG
+// replies while stream frames are half sent. The client's decoder has to see
+// every frame whole and in order: no CRC errors, no skipped bytes, each kind
+// of frame with consecutive sequence numbers. Exits non-zero on failure.
+//   ./short_write
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "cmd_server.h"
+#include "protocol.h"
+
+#define STREAM_FRAMES   2000
+#define STREAM_PAYLOAD  100     // about a telemetry frame
+#define PINGS_IN_FLIGHT 8
+#define QUEUED_EVERY    5       // tx_pull hands out a frame per this many stream frames
+
+static std::atomic<int> client_fd(-1);
+static std::atomic<uint32_t> short_calls(0);
+
+// Wins over libc's for the whole binary, CmdServer included. The client's
+// socket goes straight through.
+extern "C" ssize_t send(int fd, const void *buf, size_t len, int flags)
+{
+    if (fd != client_fd.load()) {
+        uint32_t n = short_calls++;
+        if (n % 4 == 3) {
+            errno = EAGAIN;
+            return -1;
+        }
+        size_t cap = 1 + n % 17;
+        if (len > cap) {
+            len = cap;
+        }
+    }
+    return syscall(SYS_sendto, fd, buf, len, flags, NULL, 0);
+}
+
+struct server_side_t {
+    CmdServer *server;
+    uint8_t stream_buf[PROTO_MAX_FRAME];
+    uint16_t stream_seq;
+    bool lent;
+    uint16_t queued_seq;
+};
+
+static const uint8_t *acquire_stream(size_t *len, void *ctx)
+{
+    server_side_t *s = (server_side_t *)ctx;
+    if (s->lent || s->stream_seq >= STREAM_FRAMES) {
+        return NULL;
+    }
+    uint8_t payload[STREAM_PAYLOAD];
+    for (int i = 0; i < STREAM_PAYLOAD; i++) {
+        payload[i] = (uint8_t)(s->stream_seq + i);
+    }
+    *len = proto_encode(PROTO_MSG_TELEMETRY, s->stream_seq, payload, sizeof(payload), s->stream_buf,
+                        sizeof(s->stream_buf));
+    s->stream_seq++;
+    s->lent = true;
+    return s->stream_buf;
+}
+
+static void release_stream(const uint8_t *frame, void *ctx)
+{
+    (void)frame;
+    ((server_side_t *)ctx)->lent = false;
+}
+
+static size_t pull_queued(uint8_t *buf, size_t size, void *ctx)
+{
+    server_side_t *s = (server_side_t *)ctx;
+    // Few enough that the tx buffer keeps room for the replies
+    if (s->queued_seq * QUEUED_EVERY >= s->stream_seq) {
+        return 0;
+    }
+    uint8_t payload[24] = {};
+    return proto_encode(PROTO_MSG_SCHED, s->queued_seq++, payload, sizeof(payload), buf, size);
+}
+
+static void on_frame(const proto_frame_t *frame, void *ctx)
+{
+    server_side_t *s = (server_side_t *)ctx;
+    if (frame->type == PROTO_MSG_PING) {
+        uint8_t reply[PROTO_MAX_FRAME];
+        size_t len = proto_encode(PROTO_MSG_PONG, frame->seq, frame->payload, frame->len, reply, sizeof(reply));
+        s->server->send(reply, len);
+    }
+}
+
+struct client_log_t {
+    uint32_t count[3];          // telemetry, queued, pong
+    uint32_t out_of_order;
+    int32_t last[3];
+    uint32_t bad_payload;
+};
+
+static void on_client_frame(const proto_frame_t *frame, void *ctx)
+{
+    client_log_t *log = (client_log_t *)ctx;
+    int kind = frame->type == PROTO_MSG_TELEMETRY ? 0 : frame->type == PROTO_MSG_SCHED ? 1 :
+               frame->type == PROTO_MSG_PONG ? 2 : -1;
+    if (kind < 0) {
+        log->out_of_order++;
+        return;
+    }
+    if (frame->seq != (uint16_t)(log->last[kind] + 1)) {
+        log->out_of_order++;
+    }
+    log->last[kind] = frame->seq;
+    log->count[kind]++;
+    if (kind == 0) {
+        for (int i = 0; i < frame->len; i++) {
+            if (frame->payload[i] != (uint8_t)(frame->seq + i)) {
+                log->bad_payload++;
+                break;
+            }
+        }
+    }
+}
+
+int main()
+{
+    server_side_t side = {};
+    CmdServer server(0, on_frame, &side, pull_queued, &side);
+    side.server = &server;
+    server.set_stream(acquire_stream, release_stream, &side);
+    if (server.open() != 0) {
+        return 1;
+    }
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    client_fd = sock;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(server.bound_port());
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("connect");
+        return 1;
+    }
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    std::atomic<bool> stop(false);
+    std::thread net([&] {
+        while (!stop.load()) {
+            server.poll(2);
+        }
+    });
+
+    client_log_t log = {};
+    log.last[0] = log.last[1] = log.last[2] = -1;
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    struct timeval tv = {0, 1000};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    uint32_t pings = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (std::chrono::steady_clock::now() < deadline) {
+        // About one ping per telemetry frame, the replies land in the middle of
+        // the stream. A few in flight at most, or they overflow the tx buffer.
+        if (log.count[0] < STREAM_FRAMES) {
+            if (pings <= log.count[0] && pings - log.count[2] < PINGS_IN_FLIGHT) {
+                uint8_t frame[PROTO_MAX_FRAME];
+                uint8_t payload[8] = {};
+                size_t len = proto_encode(PROTO_MSG_PING, (uint16_t)pings, payload, sizeof(payload), frame,
+                                          sizeof(frame));
+                if (send(sock, frame, len, 0) == (ssize_t)len) {
+                    pings++;
+                }
+            }
+        } else if (log.count[2] == pings) {
+            break;
+        }
+        uint8_t buf[512];
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n > 0) {
+            proto_decoder_feed(&dec, buf, n, on_client_frame, &log);
+        } else if (n == 0) {
+            break;
+        }
+    }
+    stop = true;
+    net.join();
+    close(sock);
+
+    const proto_stats_t &p = dec.stats;
+    printf("%u send() calls: telemetry %u/%d, queued %u, pongs %u/%u\n", short_calls.load(), log.count[0],
+           STREAM_FRAMES, log.count[1], log.count[2], pings);
+    const cmd_server_stats_t &st = server.get_stats();
+    printf("server: tx %u B, %u stream frames, %u dropped\n", st.tx_bytes, st.stream_frames, st.tx_dropped);
+    printf("decoder: frames %u crc errors %u bad version %u oversize %u skipped %u | out of order %u bad payload %u\n",
+           p.frames, p.crc_errors, p.bad_version, p.oversize, p.skipped, log.out_of_order, log.bad_payload);
+    bool ok = log.count[0] == STREAM_FRAMES && log.count[1] > 0 && pings > 0 && log.count[2] == pings &&
+              p.crc_errors == 0 && p.bad_version == 0 && p.oversize == 0 && p.skipped == 0 &&
+              log.out_of_order == 0 && log.bad_payload == 0;
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
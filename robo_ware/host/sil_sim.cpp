@@ -0,0 +1,757 @@
+// Software in the loop: the firmware's control code on the Linux HAL, closed
+// around a simulated robot. Every servo period the firmware's ControlLoop
+// runs one tick, with its CommandArbiter, GaitEngine and BalanceController,
+// on the attitude of the firmware's MahonyFilter. LegSystem writes the
+// simulated PWM timers and the servos of the model read them back. A host
+// source stands in for the client that parked the feet, the gait takes over
+// while it walks. Time is simulated, a run takes milliseconds.
+//
+// Model, sagittal plane only (both legs act in one plane, no roll):
+// - servos: first order lag on the latched pulse width with a speed limit
+// - legs: five-bar forward kinematics from kinematics.h
+// - body: rigid, mass and inertia about a centre of mass above the hips
+// - feet: a short flat sole each, heel and toe are penalty contacts with
+//   Coulomb friction (a sticking spring that slides once past mu * normal)
+// - IMU: 1kHz, gravity plus body acceleration, gyro bias and noise, at the
+//   firmware's full scales. Everything random comes from the seed.
+//
+// Scenario: held still for 0.5 s while the estimator settles and the feet
+// go to park, set down, pushed at 1 s, walk 6 s from 1.5 s, stand request,
+// 1.5 s more. Sweepable parameters and their defaults: ./sil_sim --help
+//
+//   ./sil_sim                                  self test, non-zero on failure
+//   ./sil_sim --run [name=value ...] [--trace out.csv]
+//   ./sil_sim --sweep out.csv|out.bin [name=value | name=from:to:step ...] [--jobs N]
+//
+// A sweep runs the cartesian grid of the given ranges on every core (or N
+// threads) and writes one row per run in grid order, so the file does not
+// depend on the thread count. .bin files are "SIL1", uint32 column count,
+// uint32 row count, the NUL terminated column names, then the rows as
+// little endian doubles.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arbiter.h"
+#include "attitude.h"
+#include "balance.h"
+#include "control.h"
+#include "esp_log.h"
+#include "gait.h"
+#include "hal_sim.h"
+#include "kinematics.h"
+#include "legs.h"
+
+#define G               9.81
+#define MASS            0.6         // kg
+#define INERTIA         1.2e-3      // kg m^2 about the centre of mass
+#define COM_ABOVE_HIP   0.025       // m
+#define IMU_ABOVE_HIP   0.010       // m
+#define FOOT_HALF       0.015       // m, heel and toe either side of the foot joint
+#define GROUND_K        2e4         // N/m per contact point
+#define GROUND_C        50.0        // N s/m
+#define FRICTION_K      2e4
+#define FRICTION_C      50.0
+#define MU              0.8
+#define SERVO_TAU       0.02        // s, servo lag
+#define FALL_DEG        45.0
+
+#define PHYS_US         100
+#define IMU_US          1000
+#define TICK_DELAY_US   300         // TEZ to the control task running
+#define HOLD_US         500000      // body held up while the estimator settles
+#define PUSH_US         1000000
+#define WALK_US         1500000
+#define STOP_US         7500000
+#define END_US          9000000
+#define ACCEL_LSB       8192.0
+#define GYRO_LSB        65.5
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+enum {
+    P_PERIOD_MS, P_STEP_MM, P_HEIGHT_MM, P_STANCE_PCT, P_KP, P_KI, P_KD, P_SERVO_DPS, P_RATE_HZ, P_PUSH_DPS, P_SEED,
+    P_COUNT
+};
+
+static const struct {
+    const char *name;
+    double value;
+    const char *help;
+} param_info[P_COUNT] = {
+    {"period_ms", 800, "gait cycle"},
+    {"step_mm", 8, "step length"},
+    {"height_mm", 6, "step height"},
+    {"stance_pct", 60, "share of the cycle on the ground"},
+    {"kp", BALANCE_PITCH_KP, "balance pitch mm/deg"},
+    {"ki", BALANCE_PITCH_KI, "balance pitch mm/(deg s)"},
+    {"kd", BALANCE_PITCH_KD, "balance pitch mm/(deg/s)"},
+    {"servo_dps", 400, "servo speed limit"},
+    {"rate_hz", 50, "servo frame rate, above 50 uses the 333Hz digital model"},
+    {"push_dps", 20, "pitch rate kick while standing"},
+    {"seed", 1, "IMU noise and bias"},
+};
+
+typedef struct {
+    double v[P_COUNT];
+} params_t;
+
+typedef struct {
+    double fell;                // 0 or 1
+    double fall_s;              // -1 if it didn't
+    double distance_mm;         // centre of mass, walk start to the end
+    double speed_mm_s;          // over the walk
+    double pitch_rms_deg;       // walk start to the end
+    double pitch_max_deg;
+    double push_max_deg;        // standing, after the push
+    double slip_mm;             // sliding of all contacts
+    double gait_rejected;
+    double balance_clipped;
+    double deferred;            // commits left to the TEZ interrupt
+} result_t;
+
+static const char *const result_names[] = {
+    "fell", "fall_s", "distance_mm", "speed_mm_s", "pitch_rms_deg", "pitch_max_deg", "push_max_deg", "slip_mm",
+    "gait_rejected", "balance_clipped", "deferred",
+};
+#define RESULT_COUNT    (sizeof(result_names) / sizeof(result_names[0]))
+
+static params_t default_params() {
+    params_t p;
+    for (int i = 0; i < P_COUNT; i++) {
+        p.v[i] = param_info[i].value;
+    }
+    return p;
+}
+
+static int param_index(const char *name, size_t len) {
+    for (int i = 0; i < P_COUNT; i++) {
+        if (strlen(param_info[i].name) == len && strncmp(param_info[i].name, name, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int16_t lsb(double v, double scale) {
+    return (int16_t)std::max(-32768.0, std::min(32767.0, std::round(v * scale)));
+}
+
+struct servo_t {
+    double ticks;       // position as a left leg pulse width
+
+    void step(double target, double max_rate, double dt) {
+        double v = (target - ticks) / SERVO_TAU;
+        v = std::max(-max_rate, std::min(max_rate, v));
+        ticks += v * dt;
+    }
+};
+
+struct contact_t {
+    bool touching;
+    double anchor;      // world x the friction spring holds on to
+};
+
+// Planar body. World x forward, z up. pitch positive tips the top forward
+// (nose down, as the firmware's attitude), body to world is
+// [cos sin; -sin cos] on (x, z).
+struct body_t {
+    double x, z, vx, vz, ax, az;
+    double pitch, rate, accel;
+};
+
+class SilSim {
+private:
+    params_t p;
+    LegSystem *legs;
+    CommandArbiter arbiter;
+    ControlLoop *control;
+    GaitMailbox gait_requests;
+    GaitEngine *gait;
+    BalanceController balance;
+    MahonyFilter filter;
+    AttitudeMailbox attitude;
+    attitude_t att;
+    FootStateMailbox foot_state;
+
+    servo_t servos[4];              // body_ticks_t order
+    double foot[2][2];              // body frame (x forward, z up) of each foot joint, m
+    double foot_prev[2][2];
+    contact_t contacts[2][2];       // by leg, heel and toe
+    body_t b;
+    double slip;
+
+    std::mt19937 rng;
+    std::normal_distribution<double> accel_noise, gyro_noise;
+    double gyro_bias;
+
+    void set_down();
+    void update_feet(double dt);
+    void step_body(double dt);
+    void sample_imu(uint32_t now);
+
+public:
+    SilSim(const params_t &params);
+    ~SilSim();
+
+    result_t run(FILE *trace);
+};
+
+static balance_gains_t pitch_gains(const params_t &p) {
+    return {(float)p.v[P_KP], (float)p.v[P_KI], (float)p.v[P_KD], BALANCE_PITCH_LIMIT};
+}
+
+// The model has no roll, a roll correction would only make the legs uneven
+static const balance_gains_t roll_gains = {0, 0, 0, BALANCE_ROLL_LIMIT};
+
+SilSim::SilSim(const params_t &params)
+    : p(params), balance(pitch_gains(params), roll_gains), rng((uint32_t)params.v[P_SEED]), accel_noise(0, 0.01),
+      gyro_noise(0, 0.05) {
+    // Each thread has its own simulated timers
+    hal_sim_reset();
+    hal_sim_clock_set(0);
+    servo_model_id_t model = p.v[P_RATE_HZ] > 50 ? SERVO_MODEL_DIGITAL_333 : SERVO_MODEL_ANALOG;
+    legs = new LegSystem((uint32_t)p.v[P_RATE_HZ], model, model, NULL);
+    legs->start(NULL, NULL);
+    gait = new GaitEngine(&gait_requests, legs->period_us());
+    filter.set_scale((float)ACCEL_LSB, (float)GYRO_LSB);
+    att = {};
+    slip = 0;
+    gyro_bias = std::uniform_real_distribution<double>(-1.5, 1.5)(rng);
+
+    // Sources as the firmware's, the host one never lapses
+    control = new ControlLoop(legs, &arbiter);
+    int host = arbiter.add_source({"host", ARB_PRIO_TCP, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, 0});
+    int gait_source = arbiter.add_source({"gait", ARB_PRIO_GAIT, ARB_MERGE_EXCLUSIVE, ARB_INPUT_QUEUE, false, 0});
+    control->set_gait(gait, gait_source);
+    control->set_balance(&balance, &attitude);
+    control->set_foot_state(&foot_state);
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        setpoint_t sp = {};
+        sp.kind = SETPOINT_FOOT;
+        sp.leg = leg;
+        sp.x_q4 = LEG_PARK_X * (1 << IK_FRAC_BITS);
+        sp.y_q4 = LEG_PARK_Y * (1 << IK_FRAC_BITS);
+        arbiter.push(host, sp);
+    }
+
+    // Servos where LegSystem centred them, the body resting on the soles
+    uint16_t ticks[4];
+    legs->get_servo_ticks(ticks);
+    for (int i = 0; i < 4; i++) {
+        servos[i].ticks = i >= 2 ? SERVO_MIRROR_TICKS - ticks[i] : ticks[i];
+    }
+    update_feet(0);
+    b = {};
+    set_down();
+    memset(contacts, 0, sizeof(contacts));
+}
+
+// Upright, the lower sole just loaded
+void SilSim::set_down() {
+    b.z = COM_ABOVE_HIP - std::min(foot[0][1], foot[1][1]) - MASS * G / (4 * GROUND_K);
+}
+
+SilSim::~SilSim() {
+    delete control;
+    delete gait;
+    delete legs;
+}
+
+// Servo angles to foot joint positions in the body frame
+void SilSim::update_feet(double dt) {
+    memcpy(foot_prev, foot, sizeof(foot));
+    for (int leg = 0; leg < 2; leg++) {
+        double front_deg, rear_deg, x, y;
+        ik_ticks_to_deg(servos[leg * 2].ticks, servos[leg * 2 + 1].ticks, &front_deg, &rear_deg);
+        if (fk_solve_deg(front_deg, rear_deg, &x, &y) == 0) {
+            foot[leg][0] = x * 1e-3;
+            foot[leg][1] = -y * 1e-3;
+        }
+    }
+    if (dt == 0) {
+        memcpy(foot_prev, foot, sizeof(foot));
+    }
+}
+
+void SilSim::step_body(double dt) {
+    double c = cos(b.pitch), s = sin(b.pitch);
+    double fx = 0, fz = -MASS * G, torque = 0;
+    for (int leg = 0; leg < 2; leg++) {
+        // Foot joint velocity in the body frame, from the servos
+        double ux = (foot[leg][0] - foot_prev[leg][0]) / dt;
+        double uz = (foot[leg][1] - foot_prev[leg][1]) / dt;
+        for (int k = 0; k < 2; k++) {
+            // Sole point relative to the centre of mass, body then world frame
+            double bx = foot[leg][0] + (k == 0 ? -FOOT_HALF : FOOT_HALF);
+            double bz = foot[leg][1] - COM_ABOVE_HIP;
+            double rx = c * bx + s * bz, rz = -s * bx + c * bz;
+            double px = b.x + rx, pz = b.z + rz;
+            double vx = b.vx + b.rate * rz + c * ux + s * uz;
+            double vz = b.vz - b.rate * rx - s * ux + c * uz;
+
+            contact_t *ct = &contacts[leg][k];
+            if (pz >= 0) {
+                ct->touching = false;
+                continue;
+            }
+            if (!ct->touching) {
+                ct->touching = true;
+                ct->anchor = px;
+            }
+            double n = std::max(0.0, -GROUND_K * pz - GROUND_C * vz);
+            double t = -FRICTION_K * (px - ct->anchor) - FRICTION_C * vx;
+            if (fabs(t) > MU * n) {
+                t = t > 0 ? MU * n : -MU * n;
+                double anchor = px + t / FRICTION_K;
+                slip += fabs(anchor - ct->anchor);
+                ct->anchor = anchor;
+            }
+            fx += t;
+            fz += n;
+            torque += t * rz - n * rx;
+        }
+    }
+    b.ax = fx / MASS;
+    b.az = fz / MASS;
+    b.accel = torque / INERTIA;
+    b.vx += b.ax * dt;
+    b.vz += b.az * dt;
+    b.rate += b.accel * dt;
+    b.x += b.vx * dt;
+    b.z += b.vz * dt;
+    b.pitch += b.rate * dt;
+}
+
+// Specific force at the IMU, rotated into the body frame, in g
+void SilSim::sample_imu(uint32_t now) {
+    const double d2r = M_PI / 180;
+    double c = cos(b.pitch), s = sin(b.pitch);
+    double h = IMU_ABOVE_HIP - COM_ABOVE_HIP;
+    double rx = s * h, rz = c * h;
+    // Centre of mass acceleration plus the tangential and centripetal terms
+    double wx = b.ax + b.accel * rz - b.rate * b.rate * rx;
+    double wz = b.az + G - b.accel * rx - b.rate * b.rate * rz;
+    imu_sample_t smp = {};
+    smp.timestamp_us = now;
+    smp.accel[0] = lsb((c * wx - s * wz) / G + accel_noise(rng), ACCEL_LSB);
+    smp.accel[1] = lsb(accel_noise(rng), ACCEL_LSB);
+    smp.accel[2] = lsb((s * wx + c * wz) / G + accel_noise(rng), ACCEL_LSB);
+    smp.gyro[0] = lsb(gyro_noise(rng), GYRO_LSB);
+    smp.gyro[1] = lsb(b.rate / d2r + gyro_bias + gyro_noise(rng), GYRO_LSB);
+    smp.gyro[2] = lsb(gyro_noise(rng), GYRO_LSB);
+    filter.update(&smp);
+    att.timestamp_us = smp.timestamp_us;
+    att.euler = filter.euler();
+    filter.rates(att.rate);
+    attitude.write(att);
+}
+
+result_t SilSim::run(FILE *trace) {
+    const double d2r = M_PI / 180;
+    const double dt = PHYS_US * 1e-6;
+    const uint32_t period = legs->period_us();
+    const double servo_rate = p.v[P_SERVO_DPS] * (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) /
+                              (SERVO_MAX_DEGREE - SERVO_MIN_DEGREE);
+
+    result_t r = {};
+    r.fall_s = -1;
+    double walk_x = 0, pitch_sq = 0;
+    uint32_t walk_n = 0;
+    uint32_t tick_due = UINT32_MAX;
+    uint32_t next_tez = 0;
+
+    if (trace != NULL) {
+        fprintf(trace, "t,x_mm,z_mm,pitch_deg,pitch_est_deg,left_x_mm,left_y_mm,right_x_mm,right_y_mm,cmd_x_mm\n");
+    }
+    for (uint32_t t = 0; t < END_US; t += PHYS_US) {
+        hal_sim_clock_set(t);
+        // On the first physics step of each frame, periods need not be a multiple of it
+        if (t >= next_tez) {
+            hal_sim_pwm_period(0);
+            hal_sim_pwm_period(1);
+            tick_due = t + TICK_DELAY_US;
+            next_tez += period;
+        }
+        if (t == WALK_US || t == STOP_US) {
+            // A step length and height of 0 is the stand request
+            gait_params_t g = {};
+            g.period_us = (uint32_t)(p.v[P_PERIOD_MS] * 1000);
+            if (t == WALK_US) {
+                g.step_length_q4 = (int16_t)lrint(p.v[P_STEP_MM] * 16);
+                g.step_height_q4 = (int16_t)lrint(p.v[P_HEIGHT_MM] * 16);
+            }
+            g.center_x_q4 = LEG_PARK_X * 16;
+            g.stand_y_q4 = LEG_PARK_Y * 16;
+            g.phase_offset = 32768;
+            g.stance_pct = (uint8_t)p.v[P_STANCE_PCT];
+            gait_requests.write(g);
+        }
+        if (t == tick_due) {
+            control->tick(t, TICK_DELAY_US);
+        }
+
+        for (int i = 0; i < 4; i++) {
+            double target = hal_sim_pwm_output(i / 2, i % 2);
+            servos[i].step(i >= 2 ? SERVO_MIRROR_TICKS - target : target, servo_rate, dt);
+        }
+        update_feet(dt);
+        if (t < HOLD_US) {
+            set_down();
+        } else {
+            if (t == PUSH_US) {
+                b.rate += p.v[P_PUSH_DPS] * d2r;
+            }
+            step_body(dt);
+        }
+        if (t % IMU_US == 0) {
+            sample_imu(t);
+        }
+
+        double pitch_deg = b.pitch / d2r;
+        if (fabs(pitch_deg) > FALL_DEG || b.z < COM_ABOVE_HIP) {
+            r.fell = 1;
+            r.fall_s = t * 1e-6;
+            break;
+        }
+        if (t >= PUSH_US && t < WALK_US) {
+            r.push_max_deg = std::max(r.push_max_deg, fabs(pitch_deg));
+        }
+        if (t == WALK_US) {
+            walk_x = b.x;
+        }
+        if (t >= WALK_US) {
+            pitch_sq += pitch_deg * pitch_deg;
+            walk_n++;
+            r.pitch_max_deg = std::max(r.pitch_max_deg, fabs(pitch_deg));
+        }
+        if (trace != NULL && t % IMU_US == 0) {
+            // Left foot x of the last commit, standing the park target plus the balance offset
+            foot_state_t fs;
+            foot_state.read(&fs);
+            fprintf(trace, "%.3f,%.2f,%.2f,%.3f,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f\n", t * 1e-6, b.x * 1e3, b.z * 1e3,
+                    pitch_deg, att.euler.pitch, foot[0][0] * 1e3, -foot[0][1] * 1e3, foot[1][0] * 1e3,
+                    -foot[1][1] * 1e3, fs.x_q4[LEG_LEFT] / 16.0);
+        }
+    }
+
+    if (!r.fell) {
+        r.distance_mm = (b.x - walk_x) * 1e3;
+        r.speed_mm_s = r.distance_mm / ((STOP_US - WALK_US) * 1e-6);
+    }
+    r.pitch_rms_deg = walk_n ? sqrt(pitch_sq / walk_n) : 0;
+    r.slip_mm = slip * 1e3;
+    gait_stats_t gs;
+    gait->get_stats(&gs);
+    r.gait_rejected = gs.rejected;
+    control_stats_t st;
+    control->get_stats(&st);
+    r.balance_clipped = st.balance_clipped;
+    leg_commit_stats_t cs;
+    legs->get_commit_stats(&cs);
+    r.deferred = cs.deferred;
+    return r;
+}
+
+static result_t simulate(const params_t &p, FILE *trace) {
+    SilSim sim(p);
+    return sim.run(trace);
+}
+
+static void print_result(const params_t &p, const result_t &r) {
+    for (int i = 0; i < P_COUNT; i++) {
+        printf("%s %g ", param_info[i].name, p.v[i]);
+    }
+    printf("\n  ");
+    const double *v = (const double *)&r;
+    for (size_t i = 0; i < RESULT_COUNT; i++) {
+        printf("%s %.3f ", result_names[i], v[i]);
+    }
+    printf("\n");
+}
+
+// Runs every parameter set on jobs threads, results in the same order
+static std::vector<result_t> run_all(const std::vector<params_t> &sets, unsigned jobs) {
+    std::vector<result_t> results(sets.size());
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threads;
+    for (unsigned j = 0; j < jobs; j++) {
+        threads.emplace_back([&]() {
+            for (size_t i = next++; i < sets.size(); i = next++) {
+                results[i] = simulate(sets[i], NULL);
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    return results;
+}
+
+static bool same(const result_t &a, const result_t &b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static int self_test() {
+    // Forward kinematics undoes the IK over the reachable stance area
+    double worst = 0;
+    for (int y = 35; y <= 55; y++) {
+        for (int x = -5; x <= 25; x++) {
+            uint16_t front, rear;
+            double front_deg, rear_deg, fx, fy;
+            if (ik_solve_ticks(x, y, &front, &rear) != 0) {
+                continue;
+            }
+            ik_ticks_to_deg(front, rear, &front_deg, &rear_deg);
+            if (fk_solve_deg(front_deg, rear_deg, &fx, &fy) == 0) {
+                worst = std::max(worst, std::hypot(fx - x, fy - y));
+            }
+        }
+    }
+    EXPECT(worst < 0.5, "FK of the IK ticks is %.3f mm off", worst);
+
+    // The firmware's balance gains as they ship, standing through the push and walking
+    params_t p = default_params();
+    p.v[P_STEP_MM] = 0;
+    p.v[P_HEIGHT_MM] = 0;
+    result_t stand = simulate(p, NULL);
+    print_result(p, stand);
+    EXPECT(!stand.fell, "fell over standing at %.2f s", stand.fall_s);
+    EXPECT(fabs(stand.distance_mm) < 2, "moved %.1f mm standing", stand.distance_mm);
+    EXPECT(stand.push_max_deg > 0.1, "the push did nothing");
+
+    p = default_params();
+    result_t walk = simulate(p, NULL);
+    print_result(p, walk);
+    EXPECT(!walk.fell, "fell over walking at %.2f s", walk.fall_s);
+    EXPECT(walk.distance_mm > 30, "walked only %.1f mm", walk.distance_mm);
+    EXPECT(walk.gait_rejected == 0, "gait rejected");
+
+    // Every seed of the IMU noise and bias, and a harder push
+    for (int seed = 2; seed <= 4; seed++) {
+        params_t q = default_params();
+        q.v[P_SEED] = seed;
+        q.v[P_PUSH_DPS] = 40;
+        result_t r = simulate(q, NULL);
+        EXPECT(!r.fell, "seed %d fell over at %.2f s", seed, r.fall_s);
+    }
+
+    // Digital servos at 333Hz, a frame is not a whole number of physics steps
+    p.v[P_RATE_HZ] = 333;
+    result_t fast = simulate(p, NULL);
+    EXPECT(!fast.fell && fast.distance_mm > 30, "333Hz walked %.1f mm, fell %g", fast.distance_mm, fast.fell);
+
+    p = default_params();
+    result_t again = simulate(p, NULL);
+    EXPECT(same(walk, again), "two runs of the same parameters differ");
+
+    // Side by side on threads, each its own simulated hardware
+    std::vector<params_t> sets;
+    for (int i = 0; i < 8; i++) {
+        params_t q = default_params();
+        q.v[P_STEP_MM] = 8 + 2 * i;
+        q.v[P_SEED] = i;
+        sets.push_back(q);
+    }
+    std::vector<result_t> threaded = run_all(sets, 4);
+    for (size_t i = 0; i < sets.size(); i++) {
+        EXPECT(same(threaded[i], simulate(sets[i], NULL)), "threaded run %zu differs from the serial one", i);
+    }
+
+    printf(failures == 0 ? "PASS\n" : "%d FAILED\n", failures);
+    return failures == 0 ? 0 : 1;
+}
+
+// name=value or name=from:to:step, appended to the grid axes
+static bool parse_axis(const char *arg, std::vector<std::vector<double>> &axes) {
+    const char *eq = strchr(arg, '=');
+    int i = eq != NULL ? param_index(arg, eq - arg) : -1;
+    if (i < 0) {
+        fprintf(stderr, "unknown parameter %s\n", arg);
+        return false;
+    }
+    double from, to, step;
+    if (sscanf(eq + 1, "%lf:%lf:%lf", &from, &to, &step) == 3 && step > 0 && to >= from) {
+        axes[i].clear();
+        for (double v = from; v <= to + step * 1e-6; v += step) {
+            axes[i].push_back(v);
+        }
+    } else if (sscanf(eq + 1, "%lf", &from) == 1) {
+        axes[i].assign(1, from);
+    } else {
+        fprintf(stderr, "bad value %s\n", arg);
+        return false;
+    }
+    return true;
+}
+
+static void write_csv(FILE *f, const std::vector<params_t> &sets, const std::vector<result_t> &results) {
+    for (int i = 0; i < P_COUNT; i++) {
+        fprintf(f, "%s,", param_info[i].name);
+    }
+    for (size_t i = 0; i < RESULT_COUNT; i++) {
+        fprintf(f, "%s%s", result_names[i], i + 1 < RESULT_COUNT ? "," : "\n");
+    }
+    for (size_t row = 0; row < sets.size(); row++) {
+        for (int i = 0; i < P_COUNT; i++) {
+            fprintf(f, "%g,", sets[row].v[i]);
+        }
+        const double *v = (const double *)&results[row];
+        for (size_t i = 0; i < RESULT_COUNT; i++) {
+            fprintf(f, "%.4f%s", v[i], i + 1 < RESULT_COUNT ? "," : "\n");
+        }
+    }
+}
+
+static void write_bin(FILE *f, const std::vector<params_t> &sets, const std::vector<result_t> &results) {
+    uint32_t header[2] = {(uint32_t)(P_COUNT + RESULT_COUNT), (uint32_t)sets.size()};
+    fwrite("SIL1", 1, 4, f);
+    fwrite(header, sizeof(header), 1, f);
+    for (int i = 0; i < P_COUNT; i++) {
+        fwrite(param_info[i].name, 1, strlen(param_info[i].name) + 1, f);
+    }
+    for (size_t i = 0; i < RESULT_COUNT; i++) {
+        fwrite(result_names[i], 1, strlen(result_names[i]) + 1, f);
+    }
+    for (size_t row = 0; row < sets.size(); row++) {
+        fwrite(sets[row].v, sizeof(double), P_COUNT, f);
+        fwrite(&results[row], sizeof(double), RESULT_COUNT, f);
+    }
+}
+
+static int sweep(const char *path, int argc, char **argv) {
+    std::vector<std::vector<double>> axes(P_COUNT);
+    params_t d = default_params();
+    for (int i = 0; i < P_COUNT; i++) {
+        axes[i].assign(1, d.v[i]);
+    }
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    bool ranges = false;
+    for (int a = 0; a < argc; a++) {
+        if (strcmp(argv[a], "--jobs") == 0 && a + 1 < argc) {
+            jobs = std::max(1, atoi(argv[++a]));
+        } else if (!parse_axis(argv[a], axes)) {
+            return 1;
+        } else {
+            ranges = true;
+        }
+    }
+    if (!ranges) {
+        // Gait timing and stride against the balance gains, the grid balance.h's defaults come from
+        parse_axis("period_ms=600:1000:200", axes);
+        parse_axis("step_mm=4:16:4", axes);
+        parse_axis("kp=0:1:0.25", axes);
+        parse_axis("ki=0:1:0.25", axes);
+        parse_axis("kd=0:0.02:0.01", axes);
+    }
+
+    // Cartesian product, the last parameter varying fastest
+    std::vector<params_t> sets(1, d);
+    for (int i = 0; i < P_COUNT; i++) {
+        std::vector<params_t> grown;
+        for (const params_t &s : sets) {
+            for (double v : axes[i]) {
+                params_t n = s;
+                n.v[i] = v;
+                grown.push_back(n);
+            }
+        }
+        sets.swap(grown);
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    std::vector<result_t> results = run_all(sets, jobs);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    size_t len = strlen(path);
+    if (len > 4 && strcmp(path + len - 4, ".bin") == 0) {
+        write_bin(f, sets, results);
+    } else {
+        write_csv(f, sets, results);
+    }
+    fclose(f);
+
+    size_t standing = 0;
+    for (const result_t &r : results) {
+        standing += r.fell == 0;
+    }
+    double sim_s = sets.size() * (END_US * 1e-6);
+    printf("%zu runs on %u threads in %.2f s, %.0fx real time | %zu stayed up | %s\n", sets.size(), jobs, wall,
+           sim_s / wall, standing, path);
+    return 0;
+}
+
+static void usage() {
+    printf("./sil_sim                                   self test\n"
+           "./sil_sim --run [name=value ...] [--trace out.csv]\n"
+           "./sil_sim --sweep out.csv|out.bin [name=value | name=from:to:step ...] [--jobs N]\n\n");
+    for (int i = 0; i < P_COUNT; i++) {
+        printf("  %-11s %8g  %s\n", param_info[i].name, param_info[i].value, param_info[i].help);
+    }
+}
+
+int main(int argc, char **argv) {
+    // LegSystem logs its setup, once per run
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    if (argc < 2) {
+        return self_test();
+    }
+    if (strcmp(argv[1], "--run") == 0) {
+        std::vector<std::vector<double>> axes(P_COUNT);
+        params_t p = default_params();
+        FILE *trace = NULL;
+        for (int a = 2; a < argc; a++) {
+            if (strcmp(argv[a], "--trace") == 0 && a + 1 < argc) {
+                trace = fopen(argv[++a], "w");
+                if (trace == NULL) {
+                    perror(argv[a]);
+                    return 1;
+                }
+            } else if (!parse_axis(argv[a], axes)) {
+                return 1;
+            }
+        }
+        for (int i = 0; i < P_COUNT; i++) {
+            if (!axes[i].empty()) {
+                p.v[i] = axes[i][0];
+            }
+        }
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        result_t r = simulate(p, trace);
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        print_result(p, r);
+        printf("%.1f ms, %.0fx real time\n", wall * 1e3, END_US * 1e-6 / wall);
+        if (trace != NULL) {
+            fclose(trace);
+        }
+        return 0;
+    }
+    if (strcmp(argv[1], "--sweep") == 0 && argc >= 3) {
+        return sweep(argv[2], argc - 3, argv + 3);
+    }
+    usage();
+    return strcmp(argv[1], "--help") == 0 ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+// Balance controller in closed loop with a simulated body, for tuning gains
+// offline. Everything between the IMU samples and the foot offsets is the
+// firmware code: MahonyFilter at 1kHz, BalanceController at the 50Hz servo
+// rate, offsets rounded to Q4 mm.
+//
+// Pitch: the feet are a line contact under the hips, so the body is an
+// inverted pendulum about it. Shifting the feet by dx moves the contact
+// relative to the centre of mass at height h:
+//   phi'' = g/h * (sin(phi) - (dx - com_offset) / h * cos(phi)) - damping * phi'
+// Roll: both feet on the ground, the body rolls by the ground slope minus the
+// leg length difference over the track width.
+// Servos follow the offsets as a second order lag with a speed limit. The
+// IMU sees gravity, the tangential and centripetal acceleration of the
+// pendulum, gyro bias and noise, quantized to the firmware's full scales.
+//
+// Scenario: held at a 2 deg lean for 1 s, released with the centre of mass
+// 4 mm ahead of the hips, a 30 deg/s push at 2 s, a 5 deg cross slope from 4 s.
+//   ./sim_balance                       line contact pitch gains below, roll from balance.h
+//   ./sim_balance <kp> <ki> <kd>        pitch gains to try
+//   ./sim_balance --sweep               grid over pitch kp, kd
+//   ./sim_balance --csv out.csv         trace of the default run
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "attitude.h"
+#include "balance.h"
+
+#define G               9.81
+#define COM_HEIGHT      0.07        // m, contact line to centre of mass
+#define IMU_HEIGHT      0.05        // m, contact line to IMU
+#define COM_OFFSET      0.004       // m, centre of mass ahead of the hips
+#define DAMPING         0.5         // 1/s
+#define TRACK           0.08        // m, between the feet
+#define SERVO_HZ        8.0         // second order servo bandwidth
+#define SERVO_SPEED     0.25        // m/s limit on a foot offset
+#define PHYS_US         100
+#define IMU_US          1000
+#define CONTROL_US      20000
+#define SIM_SECONDS     8
+#define HOLD_SECONDS    1.0
+#define ACCEL_LSB       8192.0
+#define GYRO_LSB        65.5
+
+// Best by ISE of --sweep on this model. The firmware's pitch defaults are
+// tuned on the flat soles of sil_sim, this pendulum has none to stand on.
+#define PENDULUM_PITCH_KP   2.5f
+#define PENDULUM_PITCH_KI   1.0f
+#define PENDULUM_PITCH_KD   0.3f
+
+typedef std::chrono::steady_clock clock_type;
+
+struct servo_t {
+    double pos, vel;
+
+    void step(double target, double dt)
+    {
+        double w = 2 * M_PI * SERVO_HZ;
+        vel += (w * w * (target - pos) - 2 * w * vel) * dt;
+        vel = std::max(-SERVO_SPEED, std::min(SERVO_SPEED, vel));
+        pos += vel * dt;
+    }
+};
+
+struct result_t {
+    double pitch_max;           // deg, after the push
+    double settle_s;            // push to |pitch| < 1 deg for good
+    double pitch_end;           // deg, mean over the last second
+    double roll_end;
+    double dx_max;              // mm
+    double ise;                 // integral of pitch^2 + roll^2, deg^2 s
+    double update_ns_mean;
+    double update_ns_max;
+    bool fell;
+};
+
+static int16_t lsb(double v, double scale)
+{
+    return (int16_t)std::max(-32768.0, std::min(32767.0, std::round(v * scale)));
+}
+
+static result_t simulate(const balance_gains_t &pitch_gains, const balance_gains_t &roll_gains, FILE *csv)
+{
+    std::mt19937 rng(5);
+    std::normal_distribution<double> accel_noise(0, 0.01);     // g
+    std::normal_distribution<double> gyro_noise(0, 0.05);      // dps
+    const double d2r = M_PI / 180;
+    const double gyro_bias[3] = {0.8, -1.2, 0.4};             // dps
+
+    MahonyFilter filter;
+    filter.set_scale((float)ACCEL_LSB, (float)GYRO_LSB);
+    BalanceController balance(pitch_gains, roll_gains);
+    attitude_t att;
+    bool have_att = false;
+    balance_offset_t off = {};
+
+    double phi = 2 * d2r, dphi = 0, ddphi = 0;
+    double slope = 0;
+    servo_t foot = {0, 0}, leg[2] = {{0, 0}, {0, 0}};
+
+    result_t r;
+    memset(&r, 0, sizeof(r));
+    r.settle_s = -1;
+    double last_outside = 2.0;
+    double update_ns_sum = 0;
+    uint32_t updates = 0;
+    double pitch_tail = 0, roll_tail = 0;
+    uint32_t tail_n = 0;
+
+    for (uint32_t t_us = 0; t_us < SIM_SECONDS * 1000000u; t_us += PHYS_US) {
+        double t = t_us * 1e-6;
+        double dt = PHYS_US * 1e-6;
+        if (t_us == 2000000) {
+            dphi += 30 * d2r;
+        }
+        slope = t >= 4.0 ? 5 * d2r : 0;
+
+        // Body, held for the first second while the estimator settles
+        if (t >= HOLD_SECONDS) {
+            ddphi = G / COM_HEIGHT * (sin(phi) - (foot.pos - COM_OFFSET) / COM_HEIGHT * cos(phi)) - DAMPING * dphi;
+            dphi += ddphi * dt;
+            phi += dphi * dt;
+        }
+        double roll = slope - (leg[LEG_RIGHT].pos - leg[LEG_LEFT].pos) / TRACK;
+        if (fabs(phi) > 45 * d2r) {
+            r.fell = true;
+            break;
+        }
+
+        // Servos chase the last offsets written
+        foot.step(off.dx_q4 / 16.0 * 1e-3, dt);
+        for (int i = 0; i < 2; i++) {
+            leg[i].step(off.dy_q4[i] / 16.0 * 1e-3, dt);
+        }
+
+        if (t_us % IMU_US == 0) {
+            imu_sample_t s = {};
+            s.timestamp_us = t_us;
+            double ax = -sin(phi) + IMU_HEIGHT * ddphi / G;
+            double az = cos(roll) * cos(phi) - IMU_HEIGHT * dphi * dphi / G;
+            s.accel[0] = lsb(ax + accel_noise(rng), ACCEL_LSB);
+            s.accel[1] = lsb(sin(roll) * cos(phi) + accel_noise(rng), ACCEL_LSB);
+            s.accel[2] = lsb(az + accel_noise(rng), ACCEL_LSB);
+            s.gyro[0] = lsb(gyro_bias[0] + gyro_noise(rng), GYRO_LSB);
+            s.gyro[1] = lsb(dphi / d2r + gyro_bias[1] + gyro_noise(rng), GYRO_LSB);
+            s.gyro[2] = lsb(gyro_bias[2] + gyro_noise(rng), GYRO_LSB);
+            filter.update(&s);
+            att.timestamp_us = s.timestamp_us;
+            att.euler = filter.euler();
+            filter.rates(att.rate);
+            have_att = true;
+        }
+
+        if (t_us % CONTROL_US == 0) {
+            clock_type::time_point t0 = clock_type::now();
+            balance.update(have_att ? &att : NULL, t_us, &off);
+            double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+            update_ns_sum += ns;
+            r.update_ns_max = std::max(r.update_ns_max, ns);
+            updates++;
+        }
+
+        double pitch_deg = phi / d2r, roll_deg = roll / d2r;
+        r.ise += (pitch_deg * pitch_deg + roll_deg * roll_deg) * dt;
+        if (t >= 2.0) {
+            r.pitch_max = std::max(r.pitch_max, fabs(pitch_deg));
+            if (fabs(pitch_deg) > 1.0) {
+                last_outside = t;
+            }
+        }
+        r.dx_max = std::max(r.dx_max, fabs(foot.pos * 1e3));
+        if (t >= SIM_SECONDS - 1) {
+            pitch_tail += pitch_deg;
+            roll_tail += roll_deg;
+            tail_n++;
+        }
+        if (csv != NULL && t_us % IMU_US == 0) {
+            fprintf(csv, "%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f\n", t, pitch_deg, roll_deg, att.euler.pitch,
+                    att.euler.roll, foot.pos * 1e3, leg[LEG_LEFT].pos * 1e3, leg[LEG_RIGHT].pos * 1e3);
+        }
+    }
+    if (!r.fell) {
+        r.settle_s = last_outside - 2.0;
+        r.pitch_end = pitch_tail / tail_n;
+        r.roll_end = roll_tail / tail_n;
+    }
+    r.update_ns_mean = updates ? update_ns_sum / updates : 0;
+    return r;
+}
+
+static void print_result(const balance_gains_t &g, const result_t &r)
+{
+    printf("kp %5.2f ki %5.2f kd %5.3f | ", g.kp, g.ki, g.kd);
+    if (r.fell) {
+        printf("fell\n");
+        return;
+    }
+    printf("push peak %5.2f deg settle %5.2f s | end pitch %+5.2f roll %+5.2f deg | dx max %5.1f mm | "
+           "ISE %7.1f\n",
+           r.pitch_max, r.settle_s, r.pitch_end, r.roll_end, r.dx_max, r.ise);
+}
+
+int main(int argc, char **argv)
+{
+    balance_gains_t pitch = {PENDULUM_PITCH_KP, PENDULUM_PITCH_KI, PENDULUM_PITCH_KD, BALANCE_PITCH_LIMIT};
+    balance_gains_t roll = {BALANCE_ROLL_KP, BALANCE_ROLL_KI, BALANCE_ROLL_KD, BALANCE_ROLL_LIMIT};
+
+    if (argc >= 2 && strcmp(argv[1], "--sweep") == 0) {
+        struct entry_t {
+            balance_gains_t g;
+            result_t r;
+        };
+        std::vector<entry_t> runs;
+        for (float kp = 1.0f; kp <= 5.01f; kp += 0.5f) {
+            for (float kd = 0.0f; kd <= 0.601f; kd += 0.05f) {
+                balance_gains_t g = pitch;
+                g.kp = kp;
+                g.kd = kd;
+                runs.push_back({g, simulate(g, roll, NULL)});
+            }
+        }
+        std::sort(runs.begin(), runs.end(), [](const entry_t &a, const entry_t &b) {
+            return a.r.fell != b.r.fell ? !a.r.fell : a.r.ise < b.r.ise;
+        });
+        size_t stable = std::count_if(runs.begin(), runs.end(), [](const entry_t &e) { return !e.r.fell; });
+        printf("%zu of %zu gain pairs stay up, best by ISE:\n", stable, runs.size());
+        for (size_t i = 0; i < std::min<size_t>(10, stable); i++) {
+            print_result(runs[i].g, runs[i].r);
+        }
+        return 0;
+    }
+
+    FILE *csv = NULL;
+    if (argc >= 3 && strcmp(argv[1], "--csv") == 0) {
+        csv = fopen(argv[2], "w");
+        if (csv == NULL) {
+            perror(argv[2]);
+            return 1;
+        }
+        fprintf(csv, "t,pitch,roll,pitch_est,roll_est,dx_mm,dy_left_mm,dy_right_mm\n");
+    } else if (argc >= 4) {
+        pitch.kp = (float)atof(argv[1]);
+        pitch.ki = (float)atof(argv[2]);
+        pitch.kd = (float)atof(argv[3]);
+    }
+
+    result_t r = simulate(pitch, roll, csv);
+    if (csv != NULL) {
+        fclose(csv);
+    }
+    print_result(pitch, r);
+    printf("update: mean %.0f ns, max %.0f ns (host), control period %u us\n", r.update_ns_mean, r.update_ns_max,
+           (unsigned)CONTROL_US);
+    return r.fell ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+// Hammers the setpoint ring from two threads and checks every record that was
+// pushed comes out once, in order and intact. Exits non-zero on any failure.
+//   ./stress_spsc [records]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "setpoint.h"
+
+// Every field is derived from the sequence number so a torn copy shows up
+static setpoint_t make_record(uint32_t seq)
+{
+    setpoint_t sp;
+    sp.timestamp_us = seq;
+    sp.x_q4 = (int16_t)(seq * 7);
+    sp.y_q4 = (int16_t)~(seq * 13);
+    sp.leg = (uint8_t)(seq & 1);
+    sp.kind = SETPOINT_FOOT;
+    sp.angle = 0;
+    return sp;
+}
+
+static bool intact(const setpoint_t &sp)
+{
+    setpoint_t ref = make_record(sp.timestamp_us);
+    return sp.x_q4 == ref.x_q4 && sp.y_q4 == ref.y_q4 && sp.leg == ref.leg;
+}
+
+struct result_t {
+    uint32_t received;
+    uint32_t lost;
+    uint32_t torn;
+    uint32_t reordered;
+    double seconds;
+};
+
+// drop_when_full mimics the network task, otherwise the producer spins until
+// there is room so every record has to make it through
+static result_t run(uint32_t records, bool drop_when_full)
+{
+    SetpointRing *ring = new SetpointRing();
+
+    uint32_t pushed = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        for (uint32_t seq = 0; seq < records; seq++) {
+            setpoint_t sp = make_record(seq);
+            if (drop_when_full) {
+                pushed += ring->push(sp);
+                if ((seq & 31) == 0) {
+                    std::this_thread::yield();  // let the consumer in on a single core box
+                }
+            } else {
+                while (!ring->push(sp)) {
+                    std::this_thread::yield();
+                }
+                pushed++;
+            }
+        }
+        // End marker, always delivered
+        while (!ring->push(make_record(UINT32_MAX))) {
+            std::this_thread::yield();
+        }
+    });
+
+    result_t r = {};
+    uint32_t expect = 0;
+    setpoint_t sp;
+    while (true) {
+        if (!ring->pop(&sp)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (!intact(sp)) {
+            r.torn++;
+            continue;
+        }
+        if (sp.timestamp_us == UINT32_MAX) {
+            break;
+        }
+        if (sp.timestamp_us < expect) {
+            r.reordered++;
+        }
+        expect = sp.timestamp_us + 1;
+        r.received++;
+    }
+    producer.join();
+    delete ring;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // Anything accepted by push() but never popped is lost
+    r.lost = pushed - r.received;
+    return r;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t records = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000000;
+    int failed = 0;
+
+    for (int drop = 0; drop <= 1; drop++) {
+        result_t r = run(records, drop);
+        printf("%-14s %u records in %.2fs (%.1f M/s), received %u, dropped at push %u, lost %u, torn %u, "
+               "reordered %u\n",
+               drop ? "drop-on-full" : "spin-on-full", records, r.seconds, r.received / r.seconds / 1e6, r.received,
+               records - r.received - r.lost, r.lost, r.torn, r.reordered);
+        if (r.lost || r.torn || r.reordered || (!drop && r.received != records)) {
+            failed = 1;
+        }
+    }
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed;
+}
@@ -0,0 +1,369 @@
+// Stage timings of the control pipeline, Linux side.
+//
+// Robot: asks for the stage histograms (min/avg/p99/max per stage) and the
+// latest events of both cores, prints the table and writes the events as a
+// Chrome trace (chrome://tracing, ui.perfetto.dev). Each core row is on its
+// own cycle counter; the two counters are not aligned.
+//   ./trace_dump <ip> [port] [out.json] [--clear]
+//
+// Self test (default): records known durations from several threads and
+// checks the histogram against the exact statistics, streams the rings
+// through TraceDump and the frame parser, writes the Chrome trace of that
+// and reports what record() costs. Exits non-zero on failure.
+//   ./trace_dump [out.json]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "protocol.h"
+#include "trace.h"
+
+#define DEFAULT_PORT    3333
+#define SAMPLES         200000
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+typedef struct {
+    int core;
+    uint16_t cycles_per_us;
+    trace_event_t event;
+} dumped_event_t;
+
+static void print_stats(const trace_summary_t stats[TRACE_STAGES])
+{
+    printf("%-10s %9s %10s %10s %10s %10s\n", "stage", "count", "min us", "avg us", "p99 us", "max us");
+    for (int i = 0; i < TRACE_STAGES; i++) {
+        const trace_summary_t *s = &stats[i];
+        printf("%-10s %9u %10.2f %10.2f %10.2f %10.2f\n", trace_stage_names[i], s->count, s->min_ns * 1e-3,
+               s->avg_ns * 1e-3, s->p99_ns * 1e-3, s->max_ns * 1e-3);
+    }
+}
+
+// Complete ("X") events in microseconds. Starts are unwrapped per core
+// against the previous event, events are written in end order so a start
+// may go back a little; the earliest start of a core becomes its 0.
+static bool write_chrome(const char *path, const std::vector<dumped_event_t> &events)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (int core = 0; core < TRACE_CORES; core++) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"core %d\"}}",
+                first ? "" : ",\n", core, core);
+        first = false;
+
+        std::vector<int64_t> start;
+        std::vector<const dumped_event_t *> mine;
+        int64_t t = 0, lowest = 0;
+        uint32_t prev = 0;
+        for (const dumped_event_t &e : events) {
+            if (e.core != core) {
+                continue;
+            }
+            t += mine.empty() ? 0 : (int32_t)(e.event.start - prev);
+            prev = e.event.start;
+            lowest = mine.empty() ? t : std::min(lowest, t);
+            start.push_back(t);
+            mine.push_back(&e);
+        }
+        for (size_t i = 0; i < mine.size(); i++) {
+            const dumped_event_t *e = mine[i];
+            double cpu = e->cycles_per_us;
+            const char *name = e->event.stage < TRACE_STAGES ? trace_stage_names[e->event.stage] : "?";
+            fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"biped\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                    "\"dur\":%.3f,\"args\":{\"arg\":%u}}", name, core, (start[i] - lowest) / cpu,
+                    e->event.cycles / cpu, e->event.arg);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return true;
+}
+
+// Sends every frame of a dump through the decoder and parser, like the robot's socket would
+static void collect_dump(TraceDump *dump, std::vector<dumped_event_t> *out, int *frames, bool *last)
+{
+    uint8_t buf[PROTO_MAX_FRAME];
+    size_t len;
+    *frames = 0;
+    *last = false;
+    while ((len = dump->next(buf, sizeof(buf))) != 0) {
+        proto_frame_t f;
+        trace_frame_t tf;
+        EXPECT(proto_decode_frame(buf, len, &f) == 0, "dump frame %d does not decode", *frames);
+        EXPECT(trace_parse_frame(&f, &tf) >= 0, "dump frame %d does not parse", *frames);
+        for (int i = 0; i < tf.count; i++) {
+            out->push_back({tf.core, tf.cycles_per_us, tf.events[i]});
+        }
+        *last = (tf.flags & PROTO_TRACE_LAST) != 0;
+        (*frames)++;
+    }
+}
+
+static void check_histogram()
+{
+    // Log-normal durations around 2us, plus a slow tail, as cycles (ns on the host)
+    std::mt19937 rng(5);
+    std::lognormal_distribution<double> dist(log(2000.0), 0.6);
+    std::vector<uint32_t> values(SAMPLES);
+    static TraceHistogram h;
+    uint64_t sum = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        values[i] = i % 1000 == 0 ? 1000000 + i : (uint32_t)dist(rng);
+        sum += values[i];
+        h.add(values[i]);
+    }
+    trace_summary_t s;
+    h.summary(&s, TRACE_CYCLES_PER_US);
+    std::sort(values.begin(), values.end());
+    uint32_t p99 = values[(size_t)ceil(0.99 * SAMPLES) - 1];
+    double p99_err = fabs((double)s.p99_ns - p99) / p99;
+    printf("histogram, %d samples: min %u/%u avg %u/%u max %u/%u p99 %u/%u ns (error %.1f%%)\n", SAMPLES,
+           s.min_ns, values.front(), s.avg_ns, (uint32_t)(sum / SAMPLES), s.max_ns, values.back(), s.p99_ns, p99,
+           p99_err * 100);
+    EXPECT(s.count == SAMPLES, "count %u", s.count);
+    EXPECT(s.min_ns == values.front() && s.max_ns == values.back(), "min/max");
+    EXPECT(s.avg_ns == (uint32_t)(sum / SAMPLES), "avg %u", s.avg_ns);
+    EXPECT(p99_err <= 1.0 / (1 << (TRACE_HIST_SUB_BITS + 1)), "p99 off by %.1f%%", p99_err * 100);
+
+    // Every value lands in a bucket that holds it
+    for (uint32_t v : {0u, 1u, 7u, 8u, 15u, 16u, 17u, 1000u, 65535u, 0x80000000u, 0xFFFFFFFFu}) {
+        uint32_t width;
+        uint32_t b = TraceHistogram::bucket_of(v);
+        uint64_t low = TraceHistogram::bucket_low(b, &width);
+        EXPECT(b < TRACE_HIST_BUCKETS && v >= low && v < low + width, "%u in bucket %u [%llu, +%u)", v, b,
+               (unsigned long long)low, width);
+    }
+
+    h.clear();
+    h.summary(&s, TRACE_CYCLES_PER_US);
+    EXPECT(s.count == 0, "cleared histogram reports %u", s.count);
+    h.add(42);
+    h.summary(&s, TRACE_CYCLES_PER_US);
+    EXPECT(s.count == 1 && s.min_ns == 42 && s.max_ns == 42 && s.p99_ns == 42, "after clear: %u %u", s.count,
+           s.p99_ns);
+}
+
+// One writer per stage on its own thread while another thread keeps reading
+// summaries, then a dump of the shared ring
+static void check_tracer(const char *json_path)
+{
+    static Tracer trace;
+    trace.clear_histograms();
+    const trace_stage_t stages[] = {TRACE_RX, TRACE_IK, TRACE_PROFILE, TRACE_COMMIT};
+    const int per_thread = 50000;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::thread reader([&]() {
+        while (!done.load()) {
+            for (int i = 0; i < TRACE_STAGES; i++) {
+                trace_summary_t s;
+                trace.summary((trace_stage_t)i, &s);
+                if (s.count != 0 && (s.avg_ns < s.min_ns || s.avg_ns > s.max_ns)) {
+                    torn++;
+                }
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (trace_stage_t stage : stages) {
+        writers.emplace_back([stage]() {
+            for (int k = 0; k < per_thread; k++) {
+                uint32_t t0 = trace_cycles();
+                // Something to time, a few hundred ns
+                volatile uint32_t x = 0;
+                for (int j = 0; j < 50 + (int)stage * 20; j++) {
+                    x = x + j;
+                }
+                trace.record(stage, t0, (uint8_t)(k & 0xFF));
+            }
+        });
+    }
+    for (std::thread &t : writers) {
+        t.join();
+    }
+    done = true;
+    reader.join();
+
+    trace_summary_t stats[TRACE_STAGES];
+    for (int i = 0; i < TRACE_STAGES; i++) {
+        trace.summary((trace_stage_t)i, &stats[i]);
+    }
+    print_stats(stats);
+    for (trace_stage_t stage : stages) {
+        EXPECT(stats[stage].count == (uint32_t)per_thread, "%s counted %u", trace_stage_names[stage],
+               stats[stage].count);
+    }
+    EXPECT(torn == 0, "%d summaries with the average outside min..max", torn.load());
+
+    // Stats frame round trip
+    uint8_t buf[PROTO_MAX_FRAME];
+    size_t len = trace_encode_stats(9, &trace, buf, sizeof(buf));
+    proto_frame_t f;
+    trace_summary_t back[TRACE_STAGES];
+    EXPECT(len != 0 && proto_decode_frame(buf, len, &f) == 0, "stats frame");
+    EXPECT(trace_parse_stats(&f, back) == TRACE_STAGES && memcmp(back, stats, sizeof(stats)) == 0,
+           "stats frame round trip");
+
+    TraceDump dump;
+    dump.start(&trace, 9);
+    // Paused: this one must not show up in the dump
+    trace.record(TRACE_CONTROL, trace_cycles());
+    std::vector<dumped_event_t> events;
+    int frames;
+    bool last;
+    collect_dump(&dump, &events, &frames, &last);
+    size_t expect = TRACE_RING_EVENTS;
+    int expect_frames = (TRACE_RING_EVENTS + TRACE_FRAME_EVENTS - 1) / TRACE_FRAME_EVENTS + (TRACE_CORES - 1);
+    printf("dump: %zu events in %d frames, %u per frame\n", events.size(), frames, (unsigned)TRACE_FRAME_EVENTS);
+    EXPECT(events.size() == expect, "dumped %zu events", events.size());
+    EXPECT(frames == expect_frames, "%d frames, expected %d", frames, expect_frames);
+    EXPECT(last && !dump.active(), "dump not finished");
+    bool control = false;
+    for (const dumped_event_t &e : events) {
+        control = control || e.event.stage == TRACE_CONTROL;
+        EXPECT(e.event.stage < TRACE_STAGES && e.cycles_per_us == TRACE_CYCLES_PER_US, "bad event");
+    }
+    EXPECT(!control, "event recorded while paused");
+
+    // Recording again after the dump
+    trace.record(TRACE_CONTROL, trace_cycles());
+    dump.start(&trace, 10);
+    events.clear();
+    collect_dump(&dump, &events, &frames, &last);
+    EXPECT(!events.empty() && events.back().event.stage == TRACE_CONTROL, "not recording after the dump");
+
+    if (json_path != NULL) {
+        EXPECT(write_chrome(json_path, events), "writing %s", json_path);
+        printf("wrote %s\n", json_path);
+    }
+
+    // Cost of one record() on this machine, single thread
+    const int n = 1000000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < n; k++) {
+        trace.record(TRACE_IK, trace_cycles());
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+    printf("record(): %.1f ns including the clock reads (host)\n", ns);
+}
+
+// Reads frames until the stats and, if asked, the whole dump arrived
+static bool recv_trace(int sock, bool want_events, trace_summary_t stats[TRACE_STAGES],
+                       std::vector<dumped_event_t> *events)
+{
+    struct want_t {
+        trace_summary_t *stats;
+        std::vector<dumped_event_t> *events;
+        bool got_stats;
+        bool got_last;
+    } want = {stats, events, false, !want_events};
+    proto_decoder_t dec;
+    proto_decoder_init(&dec);
+    uint8_t buf[512];
+    while (!want.got_stats || !want.got_last) {
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            return false;
+        }
+        // Telemetry shares the connection, everything else is skipped
+        proto_decoder_feed(&dec, buf, n, [](const proto_frame_t *f, void *ctx) {
+            want_t *w = (want_t *)ctx;
+            trace_frame_t tf;
+            if (f->type == PROTO_MSG_TRACE_STATS && trace_parse_stats(f, w->stats) >= 0) {
+                w->got_stats = true;
+            } else if (f->type == PROTO_MSG_TRACE && trace_parse_frame(f, &tf) >= 0) {
+                for (int i = 0; i < tf.count; i++) {
+                    w->events->push_back({tf.core, tf.cycles_per_us, tf.events[i]});
+                }
+                w->got_last = w->got_last || (tf.flags & PROTO_TRACE_LAST);
+            }
+        }, &want);
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || strstr(argv[1], ".json") != NULL) {
+        check_histogram();
+        check_tracer(argc > 1 ? argv[1] : NULL);
+        printf("%s\n", failures ? "FAIL" : "PASS");
+        return failures ? 1 : 0;
+    }
+
+    uint16_t port = DEFAULT_PORT;
+    const char *out = "trace.json";
+    uint8_t flags = PROTO_TRACE_EVENTS;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--clear") == 0) {
+            flags |= PROTO_TRACE_CLEAR;
+        } else if (strstr(argv[i], ".json") != NULL) {
+            out = argv[i];
+        } else {
+            port = (uint16_t)atoi(argv[i]);
+        }
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, argv[1], &addr.sin_addr) != 1) {
+        fprintf(stderr, "bad address %s\n", argv[1]);
+        return 1;
+    }
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("connect");
+        return 1;
+    }
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    uint8_t req[PROTO_MAX_FRAME];
+    size_t len = proto_encode(PROTO_MSG_TRACE_REQ, 1, &flags, 1, req, sizeof(req));
+    if (send(sock, req, len, 0) != (ssize_t)len) {
+        perror("send");
+        return 1;
+    }
+    trace_summary_t stats[TRACE_STAGES];
+    std::vector<dumped_event_t> events;
+    if (!recv_trace(sock, true, stats, &events)) {
+        fprintf(stderr, "connection lost\n");
+        return 1;
+    }
+    close(sock);
+    print_stats(stats);
+    if (!write_chrome(out, events)) {
+        return 1;
+    }
+    printf("%zu events written to %s\n", events.size(), out);
+    return 0;
+}
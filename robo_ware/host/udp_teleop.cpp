@@ -0,0 +1,228 @@
+// UDP teleop channel, Linux side.
+//
+// Self test (default): runs the command server and a 50 Hz "control loop" on
+// the teleop mailbox, sends an impaired datagram stream over loopback
+// (reordered, duplicated, corrupted) and checks that only ever newer commands
+// are applied, that the watchdog fires when the sender stops and that a
+// restarted sender is accepted at once. Exits non-zero on failure.
+//   ./udp_teleop
+//
+// Sender: streams a stepping foot trajectory to a robot.
+//   ./udp_teleop --send <ip> [port] [rate_hz] [seconds]
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "cmd_server.h"
+#include "protocol.h"
+#include "teleop.h"
+
+#define CONTROL_PERIOD_US   20000
+#define WATCHDOG_MS         250
+
+typedef std::chrono::steady_clock clock_type;
+
+static uint32_t now_us()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+static int udp_socket_to(const char *ip, uint16_t port, struct sockaddr_in *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
+    if (inet_pton(AF_INET, ip, &addr->sin_addr) != 1) {
+        fprintf(stderr, "bad address %s\n", ip);
+        exit(1);
+    }
+    return socket(AF_INET, SOCK_DGRAM, 0);
+}
+
+// Same stepping ellipse as the kinematics benchmark, both legs per datagram
+static size_t encode_step(uint16_t seq, double phase, uint8_t *frame)
+{
+    proto_leg_target_t t[2];
+    t[0].leg = 0;
+    t[0].x_q4 = (int16_t)lround((10 + 15 * cos(phase)) * 16);
+    t[0].y_q4 = (int16_t)lround((45 - 8 * std::max(0.0, sin(phase))) * 16);
+    t[1].leg = 1;
+    t[1].x_q4 = (int16_t)lround((10 - 15 * cos(phase)) * 16);
+    t[1].y_q4 = (int16_t)lround((45 - 8 * std::max(0.0, -sin(phase))) * 16);
+    return proto_encode_leg_targets(seq, t, 2, frame, PROTO_MAX_FRAME);
+}
+
+static int run_sender(const char *ip, uint16_t port, int rate_hz, int seconds)
+{
+    struct sockaddr_in addr;
+    int sock = udp_socket_to(ip, port, &addr);
+    uint8_t frame[PROTO_MAX_FRAME];
+    int count = rate_hz * seconds;
+    auto next = clock_type::now();
+    for (int i = 0; i < count; i++) {
+        size_t len = encode_step((uint16_t)i, 2 * M_PI * i / rate_hz, frame);   // one step per second
+        sendto(sock, frame, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+        next += std::chrono::microseconds(1000000 / rate_hz);
+        std::this_thread::sleep_until(next);
+    }
+    printf("sent %d datagrams to %s:%u\n", count, ip, port);
+    close(sock);
+    return 0;
+}
+
+struct control_log_t {
+    uint32_t applied;
+    uint32_t regressions;       // applied seq not newer than the previous one
+    uint32_t timeouts;
+    uint32_t timeout_at_us;
+    uint32_t last_seq;
+    bool have_seq;
+};
+
+static void on_datagram(const proto_frame_t *frame, void *ctx)
+{
+    proto_leg_target_t targets[PROTO_MAX_LEG_TARGETS];
+    int count = proto_parse_leg_targets(frame, targets, PROTO_MAX_LEG_TARGETS);
+    if (count <= 0) {
+        return;
+    }
+    teleop_cmd_t cmd = {};
+    cmd.timestamp_us = now_us();
+    cmd.seq = frame->seq;
+    for (int i = 0; i < count; i++) {
+        if (targets[i].leg <= 1) {
+            cmd.legs |= 1 << targets[i].leg;
+            cmd.x_q4[targets[i].leg] = targets[i].x_q4;
+            cmd.y_q4[targets[i].leg] = targets[i].y_q4;
+        }
+    }
+    ((TeleopMailbox *)ctx)->publish(cmd);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2 && strcmp(argv[1], "--send") == 0) {
+        return run_sender(argv[2], argc > 3 ? (uint16_t)atoi(argv[3]) : 3334, argc > 4 ? atoi(argv[4]) : 100,
+                          argc > 5 ? atoi(argv[5]) : 10);
+    }
+
+    TeleopMailbox mailbox(WATCHDOG_MS * 1000);
+    CmdServer server(0, NULL, NULL, NULL, NULL);
+    if (server.open() != 0 || server.open_udp(0, on_datagram, &mailbox) != 0) {
+        return 1;
+    }
+    uint16_t port = server.bound_udp_port();
+
+    std::atomic<bool> stop(false);
+    std::thread net([&] {
+        while (!stop.load()) {
+            server.poll(50);
+        }
+    });
+
+    control_log_t log = {};
+    std::atomic<bool> session_reset(false);
+    std::thread control([&] {
+        auto next = clock_type::now();
+        while (!stop.load()) {
+            next += std::chrono::microseconds(CONTROL_PERIOD_US);
+            std::this_thread::sleep_until(next);
+            teleop_cmd_t cmd;
+            teleop_event_t ev = mailbox.poll(now_us(), &cmd);
+            if (ev == TELEOP_NEW) {
+                if (session_reset.exchange(false)) {
+                    log.have_seq = false;
+                }
+                if (log.have_seq && (int16_t)(cmd.seq - log.last_seq) <= 0) {
+                    log.regressions++;
+                }
+                log.last_seq = cmd.seq;
+                log.have_seq = true;
+                log.applied++;
+            } else if (ev == TELEOP_TIMEOUT) {
+                log.timeouts++;
+                log.timeout_at_us = now_us();
+            }
+        }
+    });
+
+    // Impaired stream at 500 Hz: every 7th datagram is held back and sent
+    // after the next two, every 11th is duplicated, every 13th corrupted
+    struct sockaddr_in addr;
+    int sock = udp_socket_to("127.0.0.1", port, &addr);
+    const int count = 2000;
+    uint8_t frame[PROTO_MAX_FRAME];
+    uint8_t held[PROTO_MAX_FRAME];
+    size_t held_len = 0;
+    int held_age = 0;
+    auto next = clock_type::now();
+    for (int i = 0; i < count; i++) {
+        size_t len = encode_step((uint16_t)(60000 + i), 2 * M_PI * i / 500, frame);  // crosses the 16 bit wrap
+        if (i % 7 == 3 && held_len == 0) {
+            memcpy(held, frame, len);
+            held_len = len;
+            held_age = 0;
+        } else {
+            if (i % 13 == 5) {
+                frame[PROTO_HEADER_LEN + 1] ^= 0x40;
+            }
+            sendto(sock, frame, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+            if (i % 11 == 0) {
+                sendto(sock, frame, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+            }
+        }
+        if (held_len && ++held_age > 2) {
+            sendto(sock, held, held_len, 0, (struct sockaddr *)&addr, sizeof(addr));
+            held_len = 0;
+        }
+        next += std::chrono::microseconds(2000);
+        std::this_thread::sleep_until(next);
+    }
+    uint32_t stopped_at = now_us();
+    close(sock);
+
+    // Sender gone, the watchdog has to fire within its time plus one period
+    std::this_thread::sleep_for(std::chrono::milliseconds(WATCHDOG_MS + 100));
+    uint32_t timeouts = log.timeouts;
+    uint32_t trip_us = log.timeout_at_us - stopped_at;
+
+    // Restarted sender: new socket, sequence back at 0
+    session_reset = true;
+    uint32_t applied_before = log.applied;
+    sock = udp_socket_to("127.0.0.1", port, &addr);
+    for (int i = 0; i < 50; i++) {
+        size_t len = encode_step((uint16_t)i, 0, frame);
+        sendto(sock, frame, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * CONTROL_PERIOD_US / 1000));
+    uint32_t restart_applied = log.applied - applied_before;
+    close(sock);
+
+    stop = true;
+    net.join();
+    control.join();
+
+    const cmd_server_stats_t &s = server.get_stats();
+    printf("server: datagrams %u bad %u stale/overtaken %u\n", s.udp_rx, s.udp_bad, s.udp_stale);
+    printf("control: applied %u (of %d sent at 500 Hz into a 50 Hz loop), regressions %u\n", applied_before, count,
+           log.regressions);
+    printf("watchdog: %u timeout(s), tripped %.1f ms after the last datagram (limit %d ms)\n", timeouts,
+           trip_us / 1000.0, WATCHDOG_MS);
+    printf("restarted sender: %u commands applied\n", restart_applied);
+
+    bool ok = log.regressions == 0 && s.udp_bad > 0 && s.udp_stale > 0 && timeouts == 1 &&
+              trip_us <= (WATCHDOG_MS * 1000 + 2 * CONTROL_PERIOD_US) && restart_applied > 0;
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// Checks the workspace distance table against the IK lookup it guards, and
+// times it. Build with the host CMake project and run without args, exits
+// non-zero on failure.
+//
+// - every Q4 target workspace_reachable() passes, ik_lookup_ticks() accepts
+// - how much of what the lookup accepts the margin gives away
+// - projection lands on a reachable target, close to the nearest one found
+//   by brute force for targets on the table; reachable at all for targets
+//   up to 20mm off it
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "ik_lut.h"
+#include "workspace.h"
+
+#define X_MIN_Q4        (IK_TABLE_X_MIN * (1 << IK_FRAC_BITS))
+#define Y_MIN_Q4        (IK_TABLE_Y_MIN * (1 << IK_FRAC_BITS))
+#define OUTSIDE_Q4      (20 * (1 << IK_FRAC_BITS))      // projection targets reach this far off the table
+#define PROJECT_SAMPLES 2000
+#define PROJECT_SLACK   16                              // Q4 mm past the nearest reachable point, plus
+                                                        // 1/16 of the way there
+
+typedef std::chrono::steady_clock clock_type;
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+struct point_t {
+    int32_t x_q4;
+    int32_t y_q4;
+};
+
+static bool lookup_ok(int32_t x_q4, int32_t y_q4)
+{
+    uint16_t front, rear;
+    return ik_lookup_ticks(x_q4, y_q4, &front, &rear) == 0;
+}
+
+int main()
+{
+    // Every Q4 target of the table
+    size_t accepted = 0, passed = 0, wrong = 0;
+    std::vector<point_t> reachable;
+    for (int32_t y = Y_MIN_Q4; y <= WORKSPACE_Y_MAX_Q4; y++) {
+        for (int32_t x = X_MIN_Q4; x <= WORKSPACE_X_MAX_Q4; x++) {
+            bool ok = lookup_ok(x, y);
+            bool pass = workspace_reachable(x, y);
+            accepted += ok;
+            passed += pass;
+            if (pass && !ok) {
+                if (wrong++ < 5) {
+                    printf("(%.4f, %.4f) passes but the lookup refuses it\n", x / 16.0, y / 16.0);
+                }
+            }
+            if (pass && (x & 3) == 0 && (y & 3) == 0) {
+                reachable.push_back({x, y});
+            }
+        }
+    }
+    printf("%zu targets the lookup accepts, %zu pass the workspace check (%.1f%%)\n", accepted, passed,
+           100.0 * passed / accepted);
+    EXPECT(wrong == 0, "%zu targets pass that the lookup refuses", wrong);
+    EXPECT(passed > accepted * 9 / 10, "the margin gives away %.1f%% of the workspace",
+           100.0 - 100.0 * passed / accepted);
+
+    // Projection of unreachable targets, on and off the table
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> rx(X_MIN_Q4 - OUTSIDE_Q4, WORKSPACE_X_MAX_Q4 + OUTSIDE_Q4);
+    std::uniform_int_distribution<int32_t> ry(Y_MIN_Q4 - OUTSIDE_Q4, WORKSPACE_Y_MAX_Q4 + OUTSIDE_Q4);
+    std::vector<point_t> targets;
+    while (targets.size() < PROJECT_SAMPLES) {
+        point_t p = {rx(rng), ry(rng)};
+        if (!workspace_reachable(p.x_q4, p.y_q4)) {
+            targets.push_back(p);
+        }
+    }
+    size_t failed = 0, far = 0;
+    double excess_max = 0, excess_sum = 0;
+    for (const point_t &t : targets) {
+        point_t p = t;
+        int ret = workspace_project_q4(&p.x_q4, &p.y_q4);
+        if (ret != 1 || !workspace_reachable(p.x_q4, p.y_q4) || !lookup_ok(p.x_q4, p.y_q4)) {
+            if (failed++ < 5) {
+                printf("(%.2f, %.2f) projected to (%.2f, %.2f), returned %d\n", t.x_q4 / 16.0, t.y_q4 / 16.0,
+                       p.x_q4 / 16.0, p.y_q4 / 16.0, ret);
+            }
+            continue;
+        }
+        double best = 1e30;
+        for (const point_t &r : reachable) {
+            best = std::min(best, std::hypot((double)(r.x_q4 - t.x_q4), (double)(r.y_q4 - t.y_q4)));
+        }
+        double excess = std::hypot((double)(p.x_q4 - t.x_q4), (double)(p.y_q4 - t.y_q4)) - best;
+        excess_max = std::max(excess_max, excess);
+        excess_sum += std::max(0.0, excess);
+        // Off the table targets come back to it first, not straight towards the nearest point
+        bool on_table = t.x_q4 >= X_MIN_Q4 && t.x_q4 <= WORKSPACE_X_MAX_Q4 && t.y_q4 >= Y_MIN_Q4 &&
+                        t.y_q4 <= WORKSPACE_Y_MAX_Q4;
+        far += on_table && excess > PROJECT_SLACK + best / 16;
+    }
+    printf("projection: %zu of %zu failed, past the nearest reachable point by %.3f mm mean, %.3f mm max, "
+           "%zu on the table more than %.1f mm + 1/16 of the distance\n", failed, targets.size(),
+           excess_sum / targets.size() / 16, excess_max / 16, far, PROJECT_SLACK / 16.0);
+    EXPECT(failed == 0, "%zu projections failed", failed);
+    EXPECT(far == 0, "%zu projections land far from the nearest point", far);
+    // The park stance of legs.h
+    int32_t px = 10 * (1 << IK_FRAC_BITS), py = 45 * (1 << IK_FRAC_BITS);
+    EXPECT(workspace_project_q4(&px, &py) == 0 && px == 10 * (1 << IK_FRAC_BITS) && py == 45 * (1 << IK_FRAC_BITS),
+           "a reachable target was moved");
+
+    // Speed, over targets spread across the table
+    std::vector<point_t> spread(4096);
+    for (point_t &p : spread) {
+        p = {rx(rng), ry(rng)};
+    }
+    const int rounds = 500;
+    volatile int32_t sink = 0;
+    clock_type::time_point t0 = clock_type::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const point_t &p : spread) {
+            sink = sink + workspace_reachable(p.x_q4, p.y_q4);
+        }
+    }
+    double check_ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count() /
+                      (rounds * spread.size());
+    t0 = clock_type::now();
+    for (int r = 0; r < rounds / 10; r++) {
+        for (const point_t &t : targets) {
+            point_t p = t;
+            sink = sink + workspace_project_q4(&p.x_q4, &p.y_q4);
+        }
+    }
+    double project_ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count() /
+                        (rounds / 10 * targets.size());
+    printf("workspace_reachable %.1f ns, workspace_project_q4 %.1f ns (unreachable targets)\n", check_ns,
+           project_ns);
+
+    printf(failures == 0 ? "PASS\n" : "%d FAILED\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "nvs.h"
+
+#include "calib_store.h"
+
+static const char *TAG = "Calibration";
+
+// What goes into flash, the version guards against a layout change
+typedef struct {
+    uint16_t version;
+    uint16_t points;
+    calib_table_t table;
+} calib_blob_t;
+
+esp_err_t calib_store_load(calib_table_t *out) {
+    int64_t t0 = esp_timer_get_time();
+    calib_identity_table(out);
+
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(CALIB_NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (ret != ESP_OK) {
+        // The namespace only exists once something was saved
+        ESP_LOGI(TAG, "No calibration stored, using nominal pulse widths");
+        return ESP_ERR_NOT_FOUND;
+    }
+    calib_blob_t blob;
+    size_t len = sizeof(blob);
+    ret = nvs_get_blob(nvs, CALIB_NVS_KEY, &blob, &len);
+    nvs_close(nvs);
+    if (ret != ESP_OK || len != sizeof(blob) || blob.version != CALIB_NVS_VERSION || blob.points != CALIB_POINTS) {
+        ESP_LOGW(TAG, "Stored calibration unreadable or from another layout, using nominal pulse widths");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    for (int s = 0; s < CALIB_SERVOS; s++) {
+        if (calib_valid(&blob.table.servo[s], SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US)) {
+            out->servo[s] = blob.table.servo[s];
+        } else {
+            ESP_LOGW(TAG, "Stored curve of servo %d invalid, nominal for that one", s);
+        }
+    }
+    ESP_LOGI(TAG, "Calibration loaded in %lld us", (long long)(esp_timer_get_time() - t0));
+    return ESP_OK;
+}
+
+esp_err_t calib_store_save(const calib_table_t *table) {
+    calib_blob_t blob;
+    blob.version = CALIB_NVS_VERSION;
+    blob.points = CALIB_POINTS;
+    blob.table = *table;
+
+    nvs_handle_t nvs;
+    ESP_RETURN_ON_ERROR(nvs_open(CALIB_NVS_NAMESPACE, NVS_READWRITE, &nvs), TAG, "open");
+    esp_err_t ret = nvs_set_blob(nvs, CALIB_NVS_KEY, &blob, sizeof(blob));
+    if (ret == ESP_OK) {
+        ret = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+    return ret;
+}
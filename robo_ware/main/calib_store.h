@@ -0,0 +1,21 @@
+#ifndef CALIB_STORE_H
+#define CALIB_STORE_H
+
+#include "esp_err.h"
+#include "servo_calib.h"
+
+#define CALIB_NVS_NAMESPACE     "calib"
+#define CALIB_NVS_KEY           "table"
+#define CALIB_NVS_VERSION       1       // bump when calib_table_t changes
+
+// Reads every servo's curve with one blob read. Needs nvs_flash_init(), done
+// in wifi_init_sta(). Without a stored table, or one from another layout,
+// out is the identity table and ESP_ERR_NOT_FOUND is returned; a curve out
+// of range or not increasing is replaced by the identity on its own.
+esp_err_t calib_store_load(calib_table_t *out);
+
+// Writes the whole table, a few ms of flash work: command task only, never
+// the control task
+esp_err_t calib_store_save(const calib_table_t *table);
+
+#endif // CALIB_STORE_H
@@ -0,0 +1,272 @@
+#include <string.h>
+
+#include "control.h"
+#include "hal_clock.h"
+#include "workspace.h"
+
+ControlLoop::ControlLoop(LegSystem *legs, CommandArbiter *arbiter) {
+    this->legs = legs;
+    this->arbiter = arbiter;
+    teleop = NULL;
+    teleop_source = -1;
+    balance = NULL;
+    attitude = NULL;
+    gait = NULL;
+    gait_source = -1;
+    feet = NULL;
+    trace = NULL;
+#ifdef ESP_PLATFORM
+    sched = NULL;
+    task = NULL;
+#endif
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        foot_x_q4[leg] = 0;
+        foot_y_q4[leg] = 0;
+        foot_valid[leg] = false;
+        applied_dx[leg] = 0;
+        applied_dy[leg] = 0;
+    }
+    memset(&offset, 0, sizeof(offset));
+    feet_written = 0;
+    tez_time = 0;
+    tez_count = 0;
+    period_min = UINT32_MAX;
+    period_max = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+// Teleop goes through the arbiter like any other source, stamped with the datagram's arrival
+void ControlLoop::poll_teleop(uint32_t now) {
+    teleop_cmd_t cmd;
+    switch (teleop->poll(now, &cmd)) {
+    case TELEOP_NEW:
+        for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+            if (!(cmd.legs & (1 << leg))) {
+                continue;
+            }
+            setpoint_t sp = {};
+            sp.timestamp_us = cmd.timestamp_us;
+            sp.kind = SETPOINT_FOOT;
+            sp.leg = leg;
+            sp.x_q4 = cmd.x_q4[leg];
+            sp.y_q4 = cmd.y_q4[leg];
+            arbiter->offer(teleop_source, sp, now);
+        }
+        break;
+    case TELEOP_TIMEOUT:
+        // Link lost mid motion: legs nobody else takes are parked, not left where the last packet put them
+        arbiter->expire(teleop_source);
+        break;
+    default:
+        break;
+    }
+}
+
+// The arbiter never mixes foot targets and servo angles on one leg in a tick
+void ControlLoop::apply_command(const arb_setpoint_t *cmd, uint32_t now) {
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        esp_err_t err;
+        if (cmd->feet & (1u << leg)) {
+            err = set_foot(leg, cmd->x_q4[leg], cmd->y_q4[leg]);
+        } else if (cmd->park & (1u << leg)) {
+            err = set_foot(leg, LEG_PARK_X * (1 << IK_FRAC_BITS), LEG_PARK_Y * (1 << IK_FRAC_BITS));
+            stats.parked++;
+        } else {
+            continue;
+        }
+        if (err == ESP_OK) {
+            stats.applied++;
+        } else {
+            stats.rejected++;
+        }
+    }
+    for (int servo = 1; servo <= 4; servo++) {
+        if (!(cmd->servos & (1u << (servo - 1)))) {
+            continue;
+        }
+        if (legs->set_servo_angle(servo, cmd->angle[servo - 1]) == ESP_OK) {
+            // Servos 1 and 2 are the right leg, 3 and 4 the left
+            foot_valid[servo <= 2 ? LEG_RIGHT : LEG_LEFT] = false;
+            stats.applied++;
+        } else {
+            stats.rejected++;
+        }
+    }
+    if (cmd->fresh) {
+        uint32_t age = now - cmd->oldest_us;
+        if (age > stats.age_max) {
+            stats.age_max = age;
+        }
+    }
+}
+
+esp_err_t ControlLoop::write_foot(int leg, int32_t x_q4, int32_t y_q4) {
+    int32_t x = x_q4 + offset.dx_q4;
+    int32_t y = y_q4 + offset.dy_q4[leg];
+    if ((x != x_q4 || y != y_q4) && workspace_project_q4(&x, &y) != 0) {
+        // The correction pushed the foot out of reach, it goes as far as the workspace allows
+        stats.balance_clipped++;
+    }
+    int32_t dx = x - x_q4;
+    int32_t dy = y - y_q4;
+    esp_err_t err = legs->set_leg_pos_q4(leg == LEG_LEFT, x, y);
+    if (err != ESP_OK && (dx != 0 || dy != 0)) {
+        // No reachable point along the correction, the plain target is still worth writing
+        dx = 0;
+        dy = 0;
+        err = legs->set_leg_pos_q4(leg == LEG_LEFT, x_q4, y_q4);
+    }
+    if (err == ESP_OK) {
+        applied_dx[leg] = dx;
+        applied_dy[leg] = dy;
+    }
+    return err;
+}
+
+// Unreachable targets leave the leg, and the target it is balanced around, as they were
+esp_err_t ControlLoop::set_foot(int leg, int32_t x_q4, int32_t y_q4) {
+    esp_err_t err = write_foot(leg, x_q4, y_q4);
+    if (err == ESP_OK) {
+        foot_x_q4[leg] = x_q4;
+        foot_y_q4[leg] = y_q4;
+        foot_valid[leg] = true;
+        feet_written |= 1u << leg;
+    }
+    return err;
+}
+
+// First thing in a tick, so new targets are written with this tick's offset
+void ControlLoop::update_balance(uint32_t now) {
+    attitude_t att;
+    const attitude_t *latest = attitude->read(&att) ? &att : NULL;
+    // Without a fresh attitude the offset is zero, the feet go back to their plain targets
+    if (!balance->update(latest, now, &offset)) {
+        stats.balance_stale++;
+    }
+}
+
+// Last thing in a tick: legs no command touched still get the new offset
+void ControlLoop::hold_balance() {
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        if (!foot_valid[leg] || (feet_written & (1u << leg))) {
+            continue;
+        }
+        if (applied_dx[leg] != offset.dx_q4 || applied_dy[leg] != offset.dy_q4[leg]) {
+            write_foot(leg, foot_x_q4[leg], foot_y_q4[leg]);
+        }
+    }
+}
+
+// Next point of the gait table, if one is running. The gait's lease lasts as long as it plays.
+bool ControlLoop::step_gait(uint32_t now, body_ticks_t *ticks) {
+    uint16_t current[4];
+    legs->get_servo_ticks(current);
+    if (!gait->tick(current, ticks)) {
+        arbiter->expire(gait_source);
+        return false;
+    }
+    arbiter->claim(gait_source, now);
+    return true;
+}
+
+void ControlLoop::tick(uint32_t woke, uint32_t latency) {
+    const uint32_t period = legs->period_us();
+    uint32_t tick_start = trace_cycles();
+    if (latency > stats.latency_max) {
+        stats.latency_max = latency;
+    }
+
+    uint32_t balance_us = 0;
+    feet_written = 0;
+    if (balance != NULL) {
+        update_balance(woke);
+        balance_us = (uint32_t)hal_clock_us() - woke;
+    }
+
+    bool walking = false;
+    body_ticks_t ticks;
+    if (gait != NULL) {
+        uint32_t t0 = (uint32_t)hal_clock_us();
+        walking = step_gait(woke, &ticks);
+        uint32_t gait_us = (uint32_t)hal_clock_us() - t0;
+        if (gait_us > stats.gait_max) {
+            stats.gait_max = gait_us;
+        }
+    }
+    if (teleop != NULL) {
+        poll_teleop(woke);
+    }
+
+    arb_setpoint_t cmd;
+    arbiter->tick(woke, &cmd);
+    apply_command(&cmd, woke);
+    if (walking) {
+        if (cmd.owner[LEG_LEFT] == gait_source && cmd.owner[LEG_RIGHT] == gait_source) {
+            legs->set_body_ticks(&ticks);
+            // The table holds compare values, there is no foot target left to balance around
+            foot_valid[LEG_LEFT] = false;
+            foot_valid[LEG_RIGHT] = false;
+        } else {
+            // Lost a leg: stop where the last point left the servos, the next tick ends the lease
+            gait->halt();
+            stats.gait_halted++;
+        }
+    }
+
+    if (balance != NULL) {
+        uint32_t t0 = (uint32_t)hal_clock_us();
+        hold_balance();
+        balance_us += (uint32_t)hal_clock_us() - t0;
+        if (balance_us > stats.balance_max) {
+            stats.balance_max = balance_us;
+        }
+    }
+
+    // Targets of this tick go out along the speed and acceleration limits
+    legs->step_motion();
+    if (feet != NULL) {
+        foot_state_t state;
+        legs->estimate_feet(&state);
+        state.timestamp_us = woke;
+        feet->write(state);
+    }
+
+    uint32_t exec = (uint32_t)hal_clock_us() - woke;
+    if (exec > stats.exec_max) {
+        stats.exec_max = exec;
+    }
+    if (latency + exec >= period) {
+        stats.overruns++;
+    }
+    stats.periods++;
+    trace_record(trace, TRACE_CONTROL, tick_start);
+}
+
+void ControlLoop::set_balance(BalanceController *balance, const AttitudeMailbox *attitude) {
+    this->balance = balance;
+    this->attitude = attitude;
+}
+
+void ControlLoop::set_teleop(TeleopMailbox *teleop, int source) {
+    this->teleop = teleop;
+    teleop_source = source;
+}
+
+void ControlLoop::set_gait(GaitEngine *gait, int source) {
+    this->gait = gait;
+    gait_source = source;
+}
+
+void ControlLoop::set_foot_state(FootStateMailbox *feet) {
+    this->feet = feet;
+}
+
+void ControlLoop::set_trace(Tracer *trace) {
+    this->trace = trace;
+}
+
+void ControlLoop::get_stats(control_stats_t *out) {
+    *out = stats;
+    out->period_min = period_min.load(std::memory_order_relaxed);
+    out->period_max = period_max.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,151 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <atomic>
+
+#include "arbiter.h"
+#include "attitude.h"
+#include "balance.h"
+#include "gait.h"
+#include "legs.h"
+#include "trace.h"
+#include "teleop.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sched_monitor.h"
+#include "task_config.h"
+#endif
+
+#define CONTROL_STATS_LOG_US        10000000    // stats line every 10s, at any servo rate
+
+// All times in microseconds
+typedef struct {
+    uint32_t periods;           // control ticks run
+    uint32_t missed;            // TEZ events that found the loop still busy
+    uint32_t overruns;          // ticks that ran longer than one period
+    uint32_t period_min;        // TEZ to TEZ, measured in the ISR
+    uint32_t period_max;
+    uint32_t latency_max;       // TEZ to control task wakeup
+    uint32_t exec_max;          // wakeup to setpoints applied
+    uint32_t applied;           // arbiter setpoints written to the servos
+    uint32_t rejected;          // setpoints IK could not reach
+    uint32_t age_max;           // setpoint timestamp to applied
+    uint32_t parked;            // legs parked after the source holding them lapsed
+    uint32_t balance_max;       // balance update and the foot rewrites it caused
+    uint32_t balance_clipped;   // corrected targets out of reach, moved onto the workspace edge
+    uint32_t balance_stale;     // ticks without a fresh attitude, correction off
+    uint32_t gait_max;          // gait table step, including a block of a table build
+    uint32_t gait_halted;       // walking stopped, a higher priority source took a leg
+} control_stats_t;
+
+// Fixed rate servo loop. The MCPWM TEZ interrupt of the left leg timer wakes a
+// task pinned to CONTROL_TASK_CORE once per servo frame, which takes one
+// setpoint per leg from the command arbiter (no kernel call). The servo values
+// of a tick go out in one LegSystem commit, so all four latch on the same TEZ.
+//
+// The tick itself only uses the HAL, the task around it is the ESP32's
+// (control_task.cpp). Host targets build control.cpp and call tick() on
+// their own clock.
+class ControlLoop {
+private:
+    LegSystem *legs;
+    CommandArbiter *arbiter;
+    TeleopMailbox *teleop;
+    int teleop_source;
+    BalanceController *balance;
+    const AttitudeMailbox *attitude;
+    GaitEngine *gait;
+    int gait_source;
+    FootStateMailbox *feet;
+    Tracer *trace;
+#ifdef ESP_PLATFORM
+    SchedMonitor *sched;
+    TaskHandle_t task;
+    StaticTask_t task_buffer;
+    StackType_t stack[CONTROL_TASK_STACK];
+#endif
+
+    // Foot targets as commanded, before the balance offset. A leg that took a
+    // raw servo command is left alone until its next foot target.
+    int32_t foot_x_q4[2], foot_y_q4[2];
+    bool foot_valid[2];
+    balance_offset_t offset;                // this tick's correction
+    int32_t applied_dx[2], applied_dy[2];   // correction each leg was last written with
+    uint32_t feet_written;                  // legs written this tick, bit per leg_id_t
+
+    // Written by the TEZ ISR only, read by any task. Plain loads and stores,
+    // no read-modify-write on these, so they stay lock-free on the Xtensa.
+    std::atomic<uint32_t> tez_time;     // hal_clock_us() of the last TEZ, low 32 bits
+    std::atomic<uint32_t> tez_count;
+    std::atomic<uint32_t> period_min;
+    std::atomic<uint32_t> period_max;
+    control_stats_t stats;              // period_min and period_max filled in from the above
+
+#ifdef ESP_PLATFORM
+    static bool on_timer_empty(int timer, void *user_ctx);
+
+    static void task_entry(void *arg);
+
+    void run();
+#endif
+
+    void poll_teleop(uint32_t now);
+
+    void apply_command(const arb_setpoint_t *cmd, uint32_t now);
+
+    esp_err_t write_foot(int leg, int32_t x_q4, int32_t y_q4);
+
+    esp_err_t set_foot(int leg, int32_t x_q4, int32_t y_q4);
+
+    void update_balance(uint32_t now);
+
+    void hold_balance();
+
+    bool step_gait(uint32_t now, body_ticks_t *ticks);
+
+public:
+    // The control task is the single consumer of the arbiter's setpoints
+    ControlLoop(LegSystem *legs, CommandArbiter *arbiter);
+
+    // Before start(). The newest teleop command is offered to the arbiter as
+    // source each tick, a watchdog timeout ends the source's lease.
+    void set_teleop(TeleopMailbox *teleop, int source);
+
+    // Before start(). Every tick the controller reads the newest attitude and
+    // its offset is added to the foot targets before IK.
+    void set_balance(BalanceController *balance, const AttitudeMailbox *attitude);
+
+    // Before start(). A playing gait holds source, an exclusive one, and its
+    // ticks go out while the arbiter gives it both legs. Once a higher
+    // priority source takes a leg the gait halts. No balance offset while walking.
+    void set_gait(GaitEngine *gait, int source);
+
+    // Before start(). After every commit the feet are solved from the servo
+    // values and published, stamped with the tick's wakeup time.
+    void set_foot_state(FootStateMailbox *feet);
+
+    // Before start(). Every tick is timed into trace, wakeup to done.
+    void set_trace(Tracer *trace);
+
+    // One servo period: balance, gait, teleop, the arbiter's setpoints, the
+    // motion step and the foot state. woke is when the tick started on
+    // hal_clock_us(), latency how long after its TEZ. The control task runs it
+    // on every TEZ, a host target calls it on its own clock instead of start().
+    void tick(uint32_t woke, uint32_t latency);
+
+#ifdef ESP_PLATFORM
+    // Before start(). Each tick's TEZ to wakeup latency goes into the core's report.
+    void set_sched(SchedMonitor *sched);
+
+    // Creates the control task in the object's own stack and starts the servo timers
+    esp_err_t start();
+
+    TaskHandle_t task_handle() const;
+#endif
+
+    void get_stats(control_stats_t *out);
+};
+
+#endif // CONTROL_H
@@ -0,0 +1,102 @@
+// The ESP32 side of ControlLoop: the TEZ interrupt and the task that runs a
+// tick for each of its notifications
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+
+#include "control.h"
+#include "hal_clock.h"
+
+static const char *CONTROL_TAG = "Control";
+
+bool IRAM_ATTR ControlLoop::on_timer_empty(int timer, void *user_ctx) {
+    ControlLoop *loop = (ControlLoop *)user_ctx;
+    uint32_t now = (uint32_t)hal_clock_us();
+
+    uint32_t count = loop->tez_count.load(std::memory_order_relaxed);
+    loop->tez_count.store(count + 1, std::memory_order_relaxed);
+    if (count > 0) {
+        uint32_t period = now - loop->tez_time.load(std::memory_order_relaxed);
+        if (period < loop->period_min.load(std::memory_order_relaxed)) {
+            loop->period_min.store(period, std::memory_order_relaxed);
+        }
+        if (period > loop->period_max.load(std::memory_order_relaxed)) {
+            loop->period_max.store(period, std::memory_order_relaxed);
+        }
+    }
+    // Release: the task reads it after the notification below
+    loop->tez_time.store(now, std::memory_order_release);
+
+    BaseType_t task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(loop->task, &task_woken);
+    return task_woken == pdTRUE;
+}
+
+void ControlLoop::task_entry(void *arg) {
+    ((ControlLoop *)arg)->run();
+}
+
+void ControlLoop::run() {
+    const uint32_t period = legs->period_us();
+    const uint32_t log_every = CONTROL_STATS_LOG_US / period;
+
+    while (1) {
+        // Every TEZ gives one notification, more than one pending means we missed periods
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        if (pending == 0) {
+            ESP_LOGW(CONTROL_TAG, "No servo period for 100ms");
+            continue;
+        }
+        uint32_t woke = (uint32_t)hal_clock_us();
+        uint32_t latency = woke - tez_time.load(std::memory_order_acquire);
+        stats.missed += pending - 1;
+        if (sched != NULL) {
+            sched->note_latency(CONTROL_TASK_CORE, latency);
+        }
+        tick(woke, latency);
+
+        if (stats.periods % log_every == 0) {
+            leg_commit_stats_t commits;
+            legs->get_commit_stats(&commits);
+            uint32_t dropped = 0, preempted = 0;
+            for (int i = 0; i < arbiter->sources_count(); i++) {
+                arb_source_stats_t source;
+                arbiter->get_stats(i, &source);
+                dropped += source.overflows;
+                preempted += source.preempted;
+            }
+            ESP_LOGI(CONTROL_TAG, "periods %" PRIu32 " missed %" PRIu32 " overruns %" PRIu32
+                     " | period %" PRIu32 "..%" PRIu32 " us, latency max %" PRIu32 " us, exec max %" PRIu32
+                     " us | applied %" PRIu32 " rejected %" PRIu32 " dropped %" PRIu32 " age max %" PRIu32
+                     " us | preempted %" PRIu32 " parked %" PRIu32 " | balance max %" PRIu32 " us clipped %" PRIu32
+                     " stale %" PRIu32 " | gait max %" PRIu32 " us halted %" PRIu32
+                     " | commits %" PRIu32 " deferred %" PRIu32 " coalesced %" PRIu32,
+                     stats.periods, stats.missed, stats.overruns, period_min.load(std::memory_order_relaxed),
+                     period_max.load(std::memory_order_relaxed),
+                     stats.latency_max, stats.exec_max, stats.applied, stats.rejected, dropped,
+                     stats.age_max, preempted, stats.parked, stats.balance_max,
+                     stats.balance_clipped, stats.balance_stale, stats.gait_max, stats.gait_halted,
+                     commits.commits, commits.deferred, commits.coalesced);
+        }
+    }
+}
+
+
+void ControlLoop::set_sched(SchedMonitor *sched) {
+    this->sched = sched;
+}
+
+esp_err_t ControlLoop::start() {
+    task = xTaskCreateStaticPinnedToCore(task_entry, "control", CONTROL_TASK_STACK, this, CONTROL_TASK_PRIO, stack,
+                                         &task_buffer, CONTROL_TASK_CORE);
+    if (task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return legs->start(on_timer_empty, this);
+}
+
+TaskHandle_t ControlLoop::task_handle() const {
+    return task;
+}
@@ -0,0 +1,186 @@
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+
+#include "imu_reader.h"
+
+static const char *IMU_TAG = "IMU";
+
+// Registers the managed component has no setter for
+#define MPU6050_SMPLRT_DIV      0x19u
+#define MPU6050_CONFIG          0x1Au
+#define MPU6050_ACCEL_XOUT_H    0x3Bu
+
+#define MPU6050_DLPF_44HZ       3       // gyro output rate 1kHz with any DLPF setting 1..6
+#define MPU6050_GYRO_RATE_HZ    1000
+
+ImuReader::ImuReader(ImuRing *ring, AttitudeMailbox *attitude) {
+    this->ring = ring;
+    this->attitude = attitude;
+    sensor = NULL;
+    task = NULL;
+    drdy_time = 0;
+    acce_sensitivity = 0;
+    gyro_sensitivity = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void IRAM_ATTR ImuReader::on_data_ready(void *arg) {
+    ImuReader *reader = (ImuReader *)arg;
+    // Edges before start() created the task have nobody to wake
+    if (reader->task == NULL) {
+        return;
+    }
+    reader->drdy_time = (uint32_t)esp_timer_get_time();
+
+    BaseType_t task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(reader->task, &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
+
+void ImuReader::task_entry(void *arg) {
+    ((ImuReader *)arg)->run();
+}
+
+esp_err_t ImuReader::write_reg(uint8_t reg, uint8_t value) {
+    return hal_i2c_write_reg(IMU_I2C_PORT, MPU6050_I2C_ADDRESS, reg, value, 100);
+}
+
+void ImuReader::run() {
+    uint8_t raw[IMU_BURST_LEN];
+
+    while (1) {
+        // One notification per data ready edge, more than one pending means samples were overwritten
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        if (pending == 0) {
+            ESP_LOGW(IMU_TAG, "No data ready for 100ms");
+            continue;
+        }
+        stats.missed += pending - 1;
+
+        imu_sample_t s;
+        s.timestamp_us = drdy_time;
+        // Accel, temperature and gyro are contiguous, one transaction for all three
+        if (hal_i2c_read_regs(IMU_I2C_PORT, MPU6050_I2C_ADDRESS, MPU6050_ACCEL_XOUT_H, raw, sizeof(raw), 20) !=
+            ESP_OK) {
+            stats.i2c_errors++;
+            continue;
+        }
+        imu_unpack_burst(raw, &s);
+
+        // Before the ring, a full ring must not leave gaps in the integration
+        if (attitude != NULL) {
+            uint32_t t0 = (uint32_t)esp_timer_get_time();
+            filter.update(&s);
+            attitude_t a;
+            a.timestamp_us = s.timestamp_us;
+            a.euler = filter.euler();
+            filter.rates(a.rate);
+            attitude->write(a);
+            uint32_t took = (uint32_t)esp_timer_get_time() - t0;
+            if (took > stats.attitude_max) {
+                stats.attitude_max = took;
+            }
+        }
+
+        if (!ring->push(s)) {
+            stats.dropped++;
+            continue;
+        }
+        uint32_t read = (uint32_t)esp_timer_get_time() - s.timestamp_us;
+        if (read > stats.read_max) {
+            stats.read_max = read;
+        }
+        stats.samples++;
+
+        if (stats.samples % IMU_STATS_LOG_SAMPLES == 0) {
+            ESP_LOGI(IMU_TAG, "samples %" PRIu32 " dropped %" PRIu32 " missed %" PRIu32 " i2c errors %" PRIu32
+                     " | read max %" PRIu32 " us, attitude max %" PRIu32 " us",
+                     stats.samples, stats.dropped, stats.missed, stats.i2c_errors, stats.read_max,
+                     stats.attitude_max);
+        }
+    }
+}
+
+esp_err_t ImuReader::start(uint32_t rate_hz) {
+    if (rate_hz == 0 || rate_hz > MPU6050_GYRO_RATE_HZ) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The mpu6050 component below talks through the same driver
+    esp_err_t ret = hal_i2c_init(IMU_I2C_PORT, CONFIG_BIPED_IMU_SDA_GPIO, CONFIG_BIPED_IMU_SCL_GPIO, IMU_I2C_HZ);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    sensor = mpu6050_create(IMU_I2C_PORT, MPU6050_I2C_ADDRESS);
+    if (sensor == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_RETURN_ON_ERROR(mpu6050_wake_up(sensor), IMU_TAG, "wake up");
+    ESP_RETURN_ON_ERROR(mpu6050_config(sensor, ACCE_FS_4G, GYRO_FS_500DPS), IMU_TAG, "full scale");
+    ESP_RETURN_ON_ERROR(write_reg(MPU6050_CONFIG, MPU6050_DLPF_44HZ), IMU_TAG, "DLPF");
+    ESP_RETURN_ON_ERROR(write_reg(MPU6050_SMPLRT_DIV, (uint8_t)(MPU6050_GYRO_RATE_HZ / rate_hz - 1)), IMU_TAG,
+                        "sample rate");
+    // Read back once here instead of on every sample like mpu6050_get_acce/gyro do
+    ESP_RETURN_ON_ERROR(mpu6050_get_acce_sensitivity(sensor, &acce_sensitivity), IMU_TAG, "accel sensitivity");
+    ESP_RETURN_ON_ERROR(mpu6050_get_gyro_sensitivity(sensor, &gyro_sensitivity), IMU_TAG, "gyro sensitivity");
+    filter.set_scale(acce_sensitivity, gyro_sensitivity);
+
+    // 50us pulse, the burst read clears the status so no INT_STATUS read is needed
+    mpu6050_int_config_t irq = {};
+    irq.interrupt_pin = (gpio_num_t)CONFIG_BIPED_IMU_INT_GPIO;
+    irq.active_level = INTERRUPT_PIN_ACTIVE_HIGH;
+    irq.pin_mode = INTERRUPT_PIN_PUSH_PULL;
+    irq.interrupt_latch = INTERRUPT_LATCH_50US;
+    irq.interrupt_clear_behavior = INTERRUPT_CLEAR_ON_ANY_READ;
+    ESP_RETURN_ON_ERROR(mpu6050_config_interrupts(sensor, &irq), IMU_TAG, "interrupt pin");
+
+    // mpu6050_register_isr() passes the sensor handle as the ISR argument, we need the reader
+    ret = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        return ret;
+    }
+    ESP_RETURN_ON_ERROR(gpio_isr_handler_add(irq.interrupt_pin, on_data_ready, this), IMU_TAG, "isr");
+    ret = mpu6050_enable_interrupts(sensor, MPU6050_DATA_RDY_INT_BIT);
+    if (ret != ESP_OK) {
+        gpio_isr_handler_remove(irq.interrupt_pin);
+        ESP_LOGE(IMU_TAG, "data ready: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // Last, so a failed start leaves no reader task waiting for samples that never come
+    task = xTaskCreateStaticPinnedToCore(task_entry, "imu", IMU_TASK_STACK, this, IMU_TASK_PRIO, stack, &task_buffer,
+                                         IMU_TASK_CORE);
+    if (task == NULL) {
+        mpu6050_disable_interrupts(sensor, MPU6050_DATA_RDY_INT_BIT);
+        gpio_isr_handler_remove(irq.interrupt_pin);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ESP_LOGI(IMU_TAG, "%u Hz, %.0f LSB/g, %.1f LSB/dps",
+             (unsigned)(MPU6050_GYRO_RATE_HZ / (MPU6050_GYRO_RATE_HZ / rate_hz)), acce_sensitivity, gyro_sensitivity);
+    return ESP_OK;
+}
+
+float ImuReader::accel_lsb_per_g() const {
+    return acce_sensitivity;
+}
+
+float ImuReader::gyro_lsb_per_dps() const {
+    return gyro_sensitivity;
+}
+
+void ImuReader::get_stats(imu_stats_t *out) {
+    *out = stats;
+}
+
+TaskHandle_t ImuReader::task_handle() const {
+    return task;
+}
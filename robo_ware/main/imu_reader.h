@@ -0,0 +1,80 @@
+#ifndef IMU_READER_H
+#define IMU_READER_H
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/i2c.h"
+#include "mpu6050.h"
+#include "hal_i2c.h"
+
+#include "attitude.h"
+#include "control.h"
+#include "imu_sample.h"
+#include "task_config.h"
+
+#define IMU_I2C_PORT            I2C_NUM_0
+#define IMU_I2C_HZ              400000
+#define IMU_STATS_LOG_SAMPLES   10000   // 10s at 1kHz
+
+typedef struct {
+    uint32_t samples;           // pushed into the ring
+    uint32_t dropped;           // ring full, consumer behind
+    uint32_t missed;            // data ready edges that found the task still busy
+    uint32_t i2c_errors;
+    uint32_t read_max;          // data ready to sample in the ring, us
+    uint32_t attitude_max;      // estimator update and publish, us
+} imu_stats_t;
+
+#ifdef CONFIG_BIPED_ATTITUDE_FIXED_POINT
+typedef MahonyFilterQ AttitudeFilter;
+#else
+typedef MahonyFilter AttitudeFilter;
+#endif
+
+// MPU6050 sampled on its data ready interrupt. The ISR only timestamps the
+// edge and notifies the reader task, which fetches accel, temperature and gyro
+// in a single 14 byte read from ACCEL_XOUT_H and pushes the raw sample into
+// the ring. Full scale ranges are set once at start and their sensitivities
+// cached, nothing is read back per sample. Every sample also goes through
+// the attitude estimator, whose roll/pitch/yaw is published at the IMU rate.
+class ImuReader {
+private:
+    ImuRing *ring;
+    AttitudeMailbox *attitude;
+    AttitudeFilter filter;
+    mpu6050_handle_t sensor;
+    TaskHandle_t volatile task;     // NULL until start() succeeded, the ISR checks it
+    StaticTask_t task_buffer;
+    StackType_t stack[IMU_TASK_STACK];
+    volatile uint32_t drdy_time;    // esp_timer time of the last data ready edge, low 32 bits
+    float acce_sensitivity;         // LSB per g
+    float gyro_sensitivity;         // LSB per deg/s
+    imu_stats_t stats;
+
+    static void on_data_ready(void *arg);
+
+    static void task_entry(void *arg);
+
+    void run();
+
+    esp_err_t write_reg(uint8_t reg, uint8_t value);
+
+public:
+    // The reader task becomes the ring's producer and the mailbox's writer.
+    // attitude may be NULL, the estimator is skipped then.
+    ImuReader(ImuRing *ring, AttitudeMailbox *attitude);
+
+    // Installs the I2C driver, configures the sensor for rate_hz and starts sampling
+    esp_err_t start(uint32_t rate_hz);
+
+    TaskHandle_t task_handle() const;
+
+    float accel_lsb_per_g() const;
+
+    float gyro_lsb_per_dps() const;
+
+    void get_stats(imu_stats_t *out);
+};
+
+#endif // IMU_READER_H
@@ -1,32 +1,33 @@
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include <inttypes.h>
+#include <string.h>
+#include "sdkconfig.h"
 #include "esp_log.h"
-#include "driver/mcpwm_prelude.h"
-#include "math.h"
+#include "esp_check.h"
+#include "esp_attr.h"
 
+#include "hal_clock.h"
+#include "kinematics.h"
+#include "ik_lut.h"
+#include "fk_lut.h"
 #include "legs.h"
+#include "setpoint.h"
 
 #define FRONT_LEFT_SERVO             32
 #define BACK_LEFT_SERVO              33 
 #define BACK_RIGHT_SERVO             26
 #define FRONT_RIGHT_SERVO            27
 
-// Please consult the datasheet of your servo before changing the following parameters
-#define SERVO_MIN_PULSEWIDTH_US 500  // Minimum pulse width in microsecond
-#define SERVO_MAX_PULSEWIDTH_US 2500  // Maximum pulse width in microsecond
-#define SERVO_MIN_DEGREE        -90   // Minimum angle
-#define SERVO_MAX_DEGREE        90    // Maximum angle
-
-#define UPPER_LEG_LEN           40
-#define LOWER_LEG_LEN           24
-#define REAR_OFFSET             21
-#define PI                      3.14159
+// One PWM timer per leg, front and rear servo on its first two channels
+#define LEFT_LEG_TIMER               0
+#define RIGHT_LEG_TIMER              1
+#define FRONT_CHANNEL                0
+#define REAR_CHANNEL                 1
 
 static const char *SERVO_TAG = "Servo System";
 static const char *LEG_TAG   = "Leg System";
 
-#define SERVO_TIMEBASE_RESOLUTION_HZ 1000000  // 1MHz, 1us per tick
-#define SERVO_TIMEBASE_PERIOD        20000    // 20000 ticks, 20ms
+#define SERVO_TICKS_PER_DEG ((float)(SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / \
+                             (SERVO_MAX_DEGREE - SERVO_MIN_DEGREE))
 
 
 inline uint32_t LegSystem::angle_to_compare(int angle)
@@ -34,122 +35,163 @@ inline uint32_t LegSystem::angle_to_compare(int angle)
     return (angle - SERVO_MIN_DEGREE) * (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) / (SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) + SERVO_MIN_PULSEWIDTH_US;
 }
 
-int LegSystem::calc_angle(int x, int y, int *front_angle, int *rear_angle) {
-    double a1, a2, b1, b2;     // angles
-    double hypo1, hypo2;
-
-    // Calc hypotenuse assuming 0, 0 is on the front servo axis
-    hypo1 = sqrt(pow(x, 2) + pow(y, 2));
-    hypo2 = sqrt(pow(x - REAR_OFFSET, 2) + pow(y, 2));
-
-    a1 = acos(x / hypo1);
-    a2 = acos((REAR_OFFSET - x)/hypo2);
-    b1 = acos((pow(UPPER_LEG_LEN, 2) - pow(LOWER_LEG_LEN, 2) - pow(hypo1, 2))/(-2*LOWER_LEG_LEN*hypo1));
-    b2 = acos((pow(UPPER_LEG_LEN, 2) - pow(LOWER_LEG_LEN, 2) - pow(hypo2, 2))/(-2*LOWER_LEG_LEN*hypo2));
-
-    *front_angle = (180*(a1 + b1) / PI);      // -135 to account for servo horn setting
-    *rear_angle = (180*(a2 + b2) / PI);
-
-    if(*front_angle >= 270 || *front_angle <= -270) {
-        return -1;
-    }
-    if(*rear_angle >= 270 || *rear_angle <= -270) {
-        return -1;
-    }
-    return 0;
-} 
-
-esp_err_t LegSystem::init_servo(servo_config_t *servo, mcpwm_timer_handle_t *timer, int gpio_num, int clock_group) {
-    servo->oper = NULL;
-    servo->oper_config.group_id = clock_group; // operator must be in the same group to the timer
-
-    ESP_LOGI(SERVO_TAG, "Connect timer and operator");
-    ESP_ERROR_CHECK(mcpwm_new_operator(&servo->oper_config, &servo->oper));
-    ESP_ERROR_CHECK(mcpwm_operator_connect_timer(servo->oper, *timer));
-
-    ESP_LOGI(SERVO_TAG, "Create comparator and generator from the operator");
-    servo->comparator_config.flags.update_cmp_on_tez = true;
-
-    ESP_ERROR_CHECK(mcpwm_new_comparator(servo->oper, &servo->comparator_config, 
-                                         &servo->comparator));
-    servo->generator_config.gen_gpio_num = gpio_num;
+inline int LegSystem::compare_to_angle(uint32_t ticks)
+{
+    return ((int)ticks - SERVO_MIN_PULSEWIDTH_US) * (SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) / (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US) + SERVO_MIN_DEGREE;
+}
 
-    ESP_ERROR_CHECK(mcpwm_new_generator(servo->oper, &servo->generator_config, 
-                                        &servo->generator));
+esp_err_t LegSystem::init_servo(servo_config_t *servo, int timer, int channel, int gpio_num, int axis,
+                                const servo_model_t *model) {
+    servo->timer = timer;
+    servo->channel = channel;
+    servo->axis = axis;
+    servo->min_ticks = model->min_pulse_us;
+    servo->max_ticks = model->max_pulse_us;
+    servos[axis] = servo;
 
     // set the initial compare value, so that the servo will spin to the center position
-    ESP_ERROR_CHECK(mcpwm_comparator_set_compare_value(servo->comparator, angle_to_compare(0)));
-
-    ESP_LOGI(SERVO_TAG, "Set generator action on timer and compare event");
-    // go high on counter empty
-    ESP_ERROR_CHECK(mcpwm_generator_set_action_on_timer_event(servo->generator,
-                                                              MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_EVENT_EMPTY, MCPWM_GEN_ACTION_HIGH)));
-    // go low on compare threshold
-    ESP_ERROR_CHECK(mcpwm_generator_set_action_on_compare_event(servo->generator,
-                                                                MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, servo->comparator, MCPWM_GEN_ACTION_LOW)));
-    return ESP_OK;
+    servo->current_angle = 0;
+    servo->current_ticks = angle_to_compare(0);
+    profiler.reset(axis, (uint16_t)servo->current_ticks);
+    ESP_LOGI(SERVO_TAG, "GPIO %d on timer %d channel %d", gpio_num, timer, channel);
+    return hal_pwm_channel_init(timer, channel, gpio_num, calib_apply(&calib[axis], (uint16_t)servo->current_ticks));
 }
 
-LegSystem::LegSystem() {
-    // Set internal leg identifies (for angle calculation)
+LegSystem::LegSystem(uint32_t rate_hz, servo_model_id_t left_id, servo_model_id_t right_id,
+                     const CalibMailbox *calib)
+    : left_model(servo_model(left_id)), right_model(servo_model(right_id)),
+      frame_us(servo_frame_us(rate_hz, left_model, right_model)), calib_requests(calib), profiler(frame_us) {
+    if (frame_us != 1000000 / rate_hz) {
+        ESP_LOGW(LEG_TAG, "%" PRIu32 "Hz not supported by %s / %s servos, running %" PRIu32 "us frames", rate_hz,
+                 left_model->name, right_model->name, frame_us);
+    }
+    trace = NULL;
+    hal_flag_init(&settled_flag, true);
+    motion_settled = true;
+    hal_lock_init(&commit_lock);
+    pending = false;
+    due[0] = due[1] = false;
+    tez_count[0] = tez_count[1] = 0;
+    tez_time = 0;
+    running = false;
+    commit_stats = {};
+    on_period = NULL;
+    period_ctx = NULL;
+    // Before any servo is initialized, so even the first center pulse is calibrated
+    calib_seen = 0;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        calib_identity(&this->calib[i]);
+    }
+    poll_calibration();
     // Setup Timers
-    left_leg.timer = NULL;
-    right_leg.timer = NULL;
-    mcpwm_timer_config_t timer_left_config = {
-        .group_id = 0,
-        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
-        .resolution_hz = SERVO_TIMEBASE_RESOLUTION_HZ,
-        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
-        .period_ticks = SERVO_TIMEBASE_PERIOD,
-    };
-    mcpwm_timer_config_t timer_right_config = {
-        .group_id = 1,
-        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
-        .resolution_hz = SERVO_TIMEBASE_RESOLUTION_HZ,
-        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
-        .period_ticks = SERVO_TIMEBASE_PERIOD,
-    };
-    ESP_ERROR_CHECK(mcpwm_new_timer(&timer_left_config, &left_leg.timer));
-    ESP_ERROR_CHECK(mcpwm_new_timer(&timer_right_config, &right_leg.timer));
-    ESP_LOGI(LEG_TAG, "Timers made!");
+    left_leg.timer = LEFT_LEG_TIMER;
+    right_leg.timer = RIGHT_LEG_TIMER;
+    ESP_ERROR_CHECK(hal_pwm_timer_init(left_leg.timer, frame_us));
+    ESP_ERROR_CHECK(hal_pwm_timer_init(right_leg.timer, frame_us));
+    ESP_LOGI(LEG_TAG, "Timers made, %" PRIu32 "us frames", frame_us);
 
     // Left Leg Setup
-    esp_err_t ret = init_servo(&left_leg.front_servo, &left_leg.timer, FRONT_LEFT_SERVO, 0);
+    esp_err_t ret = init_servo(&left_leg.front_servo, left_leg.timer, FRONT_CHANNEL, FRONT_LEFT_SERVO, 0, left_model);
     if (ret != ESP_OK) {
         ESP_LOGE(LEG_TAG, "Failed to init front left servo: %s", esp_err_to_name(ret));
     }
-    left_leg.front_servo.angle_offset = 135;
     
-    ret = init_servo(&left_leg.rear_servo, &left_leg.timer, BACK_LEFT_SERVO, 0);
+    ret = init_servo(&left_leg.rear_servo, left_leg.timer, REAR_CHANNEL, BACK_LEFT_SERVO, 1, left_model);
     if (ret != ESP_OK) {
         ESP_LOGE(LEG_TAG, "Failed to init rear left servo: %s", esp_err_to_name(ret));
     }
-    left_leg.rear_servo.angle_offset = 135;
     ESP_LOGI(LEG_TAG, "Left leg setup!");
 
 
     // Right Leg Setup
-    ret = init_servo(&right_leg.front_servo, &right_leg.timer, FRONT_RIGHT_SERVO, 1);
+    ret = init_servo(&right_leg.front_servo, right_leg.timer, FRONT_CHANNEL, FRONT_RIGHT_SERVO, 2, right_model);
     if (ret != ESP_OK) {
         ESP_LOGE(LEG_TAG, "Failed to init front right servo: %s", esp_err_to_name(ret));
     }
-    right_leg.front_servo.angle_offset = 135;
 
-    ret = init_servo(&right_leg.rear_servo, &right_leg.timer, BACK_RIGHT_SERVO, 1);
+    ret = init_servo(&right_leg.rear_servo, right_leg.timer, REAR_CHANNEL, BACK_RIGHT_SERVO, 3, right_model);
     if (ret != ESP_OK) {
         ESP_LOGE(LEG_TAG, "Failed to init rear right servo: %s", esp_err_to_name(ret));
     }
-    right_leg.rear_servo.angle_offset = 135;
 
     ESP_LOGI(LEG_TAG, "Right leg setup!");
 
+    staged.left_front = (uint16_t)left_leg.front_servo.current_ticks;
+    staged.left_rear = (uint16_t)left_leg.rear_servo.current_ticks;
+    staged.right_front = (uint16_t)right_leg.front_servo.current_ticks;
+    staged.right_rear = (uint16_t)right_leg.rear_servo.current_ticks;
+    claimed = staged;
+    committed = staged;
+
+    for (int servo = 1; servo <= 4; servo++) {
+        set_servo_limits(servo, CONFIG_BIPED_SERVO_SPEED_DPS, CONFIG_BIPED_SERVO_ACCEL_DPS2);
+    }
+}
+
+// Runs for each timer's TEZ. The first interrupt of a period takes a staged
+// commit and writes its leg, the other leg's interrupt writes the same
+// values, so both legs latch them on the following TEZ.
+void IRAM_ATTR LegSystem::on_empty(int leg) {
+    uint32_t now = (uint32_t)hal_clock_us();
+    hal_lock_isr(&commit_lock);
+    uint32_t count = tez_count[leg] + 1;
+    tez_count[leg] = count;
+    if (leg == 0) {
+        tez_time = now;
+    }
+    if (due[leg]) {
+        write_leg(leg, &claimed);
+        due[leg] = false;
+    } else if (pending && count != tez_count[leg ^ 1]) {
+        claimed = staged;
+        pending = false;
+        write_leg(leg, &claimed);
+        due[leg ^ 1] = true;
+    }
+    hal_unlock_isr(&commit_lock);
+}
+
+bool IRAM_ATTR LegSystem::on_left_empty(int timer, void *user_ctx) {
+    LegSystem *legs = (LegSystem *)user_ctx;
+    legs->on_empty(0);
+    return legs->on_period != NULL ? legs->on_period(timer, legs->period_ctx) : false;
+}
+
+bool IRAM_ATTR LegSystem::on_right_empty(int, void *user_ctx) {
+    ((LegSystem *)user_ctx)->on_empty(1);
+    return false;
+}
+
+esp_err_t LegSystem::start(hal_pwm_period_cb_t on_period, void *user_ctx) {
+    // Event callbacks can only be registered before the timer is enabled. Both
+    // timers share the clock and start back to back, so the right leg runs at
+    // the same rate with a small fixed phase offset. Each timer's TEZ writes
+    // its own leg's share of a late commit, on_period runs after the left one.
+    this->on_period = on_period;
+    period_ctx = user_ctx;
+    ESP_RETURN_ON_ERROR(hal_pwm_set_period_callback(left_leg.timer, on_left_empty, this),
+                        LEG_TAG, "register left period callback");
+    ESP_RETURN_ON_ERROR(hal_pwm_set_period_callback(right_leg.timer, on_right_empty, this),
+                        LEG_TAG, "register right period callback");
+
     ESP_LOGI(LEG_TAG, "Enable and start timer");
-    ESP_ERROR_CHECK(mcpwm_timer_enable(left_leg.timer));
-    ESP_ERROR_CHECK(mcpwm_timer_enable(right_leg.timer));
-    ESP_ERROR_CHECK(mcpwm_timer_start_stop(left_leg.timer, MCPWM_TIMER_START_NO_STOP));
-    ESP_ERROR_CHECK(mcpwm_timer_start_stop(right_leg.timer, MCPWM_TIMER_START_NO_STOP));
+    hal_lock(&commit_lock);
+    tez_time = (uint32_t)hal_clock_us();
+    running = true;
+    hal_unlock(&commit_lock);
+    ESP_ERROR_CHECK(hal_pwm_start(left_leg.timer));
+    ESP_ERROR_CHECK(hal_pwm_start(right_leg.timer));
 
     ESP_LOGI("LEG INIT", "Both leg set up and ready to roll!");
+    return ESP_OK;
+}
+
+void LegSystem::set_trace(Tracer *trace) {
+    this->trace = trace;
+}
+
+uint32_t LegSystem::period_us() {
+    return frame_us;
 }
 
 // Function to set servo angle
@@ -160,34 +202,288 @@ esp_err_t LegSystem::set_servo_angle(int leg, int angle) { // servo_config_t *se
         case(2): servo = &right_leg.rear_servo; break;
         case(3): servo = &left_leg.front_servo; break;
         case(4): servo = &left_leg.rear_servo; break;
-        default: servo = NULL; break; // TODO: Invalid leg input
-  }
+        default: return ESP_ERR_INVALID_ARG;
+    }
     if (angle < SERVO_MIN_DEGREE || angle > SERVO_MAX_DEGREE) {
         return ESP_ERR_INVALID_ARG;
     }
-    servo->current_angle = angle;
-    return mcpwm_comparator_set_compare_value(servo->comparator, angle_to_compare(angle));
+    return set_servo_ticks(servo, angle_to_compare(angle));
+}
+
+esp_err_t LegSystem::set_servo_ticks(servo_config_t *servo, uint32_t ticks) {
+    if (!ticks_valid(servo, ticks)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    profiler.set_target(servo->axis, (uint16_t)ticks);
+    // Cleared here rather than in the next step_motion() so a waiter never sees a stale arrival
+    if (motion_settled && profiler.moving_mask() != 0) {
+        motion_settled = false;
+        hal_flag_clear(&settled_flag);
+    }
     return ESP_OK;
 }
 
+void IRAM_ATTR LegSystem::write_leg(int leg, const body_ticks_t *ticks) {
+    if (leg == 0) {
+        hal_pwm_set_compare(left_leg.timer, left_leg.front_servo.channel, ticks->left_front);
+        hal_pwm_set_compare(left_leg.timer, left_leg.rear_servo.channel, ticks->left_rear);
+    } else {
+        hal_pwm_set_compare(right_leg.timer, right_leg.front_servo.channel, ticks->right_front);
+        hal_pwm_set_compare(right_leg.timer, right_leg.rear_servo.channel, ticks->right_rear);
+    }
+}
+
+// Early in the period, with both timers past their TEZ, the shadow registers
+// are written right here; otherwise the next TEZ interrupts pick staged up.
+esp_err_t LegSystem::commit(const body_ticks_t *ticks) {
+    uint32_t t0 = trace_cycles();
+    const uint32_t window = period_us() - LEG_COMMIT_GUARD_US;
+    committed = *ticks;
+    body_ticks_t out;
+    out.left_front = calib_apply(&calib[0], ticks->left_front);
+    out.left_rear = calib_apply(&calib[1], ticks->left_rear);
+    out.right_front = calib_apply(&calib[2], ticks->right_front);
+    out.right_rear = calib_apply(&calib[3], ticks->right_rear);
+    hal_lock(&commit_lock);
+    staged = out;
+    uint32_t since = (uint32_t)hal_clock_us() - tez_time;
+    commit_stats.commits++;
+    if (pending) {
+        commit_stats.coalesced++;
+        pending = false;
+    }
+    if (!running || (tez_count[0] == tez_count[1] && since < window)) {
+        write_leg(0, &staged);
+        write_leg(1, &staged);
+        commit_stats.direct++;
+    } else {
+        pending = true;
+        commit_stats.deferred++;
+    }
+    hal_unlock(&commit_lock);
+
+    // What the servos get from the next TEZ or the one after, nominal, for telemetry
+    const uint16_t nominal[PROFILE_AXES] = {ticks->left_front, ticks->left_rear, ticks->right_front, ticks->right_rear};
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        servos[i]->current_ticks = nominal[i];
+        servos[i]->current_angle = compare_to_angle(nominal[i]);
+    }
+    trace_record(trace, TRACE_COMMIT, t0);
+    return ESP_OK;
+}
+
+bool LegSystem::ticks_valid(const servo_config_t *servo, uint32_t ticks) {
+    return ticks >= servo->min_ticks && ticks <= servo->max_ticks;
+}
+
+const servo_model_t *LegSystem::model_of(int axis) {
+    return axis < 2 ? left_model : right_model;
+}
+
+bool LegSystem::poll_calibration() {
+    if (calib_requests == NULL) {
+        return false;
+    }
+    uint32_t writes = calib_requests->writes();
+    calib_table_t table;
+    if (writes == calib_seen || !calib_requests->read(&table)) {
+        return false;
+    }
+    calib_seen = writes;
+    bool changed = false;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        const servo_model_t *model = model_of(i);
+        if (!calib_valid(&table.servo[i], model->min_pulse_us, model->max_pulse_us)) {
+            ESP_LOGW(LEG_TAG, "Calibration of axis %d outside %u-%uus or not increasing, kept the old one", i,
+                     model->min_pulse_us, model->max_pulse_us);
+            continue;
+        }
+        if (memcmp(&calib[i], &table.servo[i], sizeof(calib_curve_t)) != 0) {
+            calib[i] = table.servo[i];
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+esp_err_t LegSystem::commit_leg(bool is_left_leg, uint16_t front_ticks, uint16_t rear_ticks) {
+    leg_t *leg = is_left_leg ? &left_leg : &right_leg;
+    if (!ticks_valid(&leg->front_servo, front_ticks) || !ticks_valid(&leg->rear_servo, rear_ticks)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // The other leg keeps the values it was last committed with
+    body_ticks_t ticks = committed;
+    if (is_left_leg) {
+        ticks.left_front = front_ticks;
+        ticks.left_rear = rear_ticks;
+    } else {
+        ticks.right_front = front_ticks;
+        ticks.right_rear = rear_ticks;
+    }
+    return commit(&ticks);
+}
+
+esp_err_t LegSystem::commit_body(const body_ticks_t *ticks) {
+    if (!ticks_valid(&left_leg.front_servo, ticks->left_front) ||
+        !ticks_valid(&left_leg.rear_servo, ticks->left_rear) ||
+        !ticks_valid(&right_leg.front_servo, ticks->right_front) ||
+        !ticks_valid(&right_leg.rear_servo, ticks->right_rear)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return commit(ticks);
+}
+
+void LegSystem::get_commit_stats(leg_commit_stats_t *out) {
+    hal_lock(&commit_lock);
+    *out = commit_stats;
+    hal_unlock(&commit_lock);
+}
+
 esp_err_t LegSystem::set_leg_pos(bool is_left_leg, int x, int y) {
-    int front_angle, rear_angle;
-    calc_angle(x, y, &front_angle, &rear_angle);
+    esp_err_t ret = set_leg_pos_q4(is_left_leg, x * (1 << IK_FRAC_BITS), y * (1 << IK_FRAC_BITS));
+    if (ret != ESP_OK) {
+        ESP_LOGE(LEG_TAG, "Leg position (%i, %i) out of reach", x, y);
+    }
+    return ret;
+}
+
+esp_err_t LegSystem::set_leg_pos_q4(bool is_left_leg, int32_t x_q4, int32_t y_q4) {
+    uint16_t front_ticks = 0, rear_ticks = 0;
 
-    if(is_left_leg) {
-        front_angle = front_angle - left_leg.front_servo.angle_offset;
-        rear_angle = left_leg.rear_servo.angle_offset - rear_angle;
-        set_servo_angle(1, front_angle);
-        set_servo_angle(2, rear_angle);
+    // Table lookup gives left leg ticks, the right leg servos are mirrored
+    uint32_t t0 = trace_cycles();
+    int unreachable = ik_lookup_ticks(x_q4, y_q4, &front_ticks, &rear_ticks);
+    trace_record(trace, TRACE_IK, t0, is_left_leg ? 0 : 1);
+    if (unreachable != 0) {
+        return ESP_ERR_INVALID_ARG;
     }
-    else {
-        front_angle = right_leg.front_servo.angle_offset - front_angle;
-        rear_angle = rear_angle - right_leg.rear_servo.angle_offset;
-        set_servo_angle(3, front_angle);
-        set_servo_angle(4, rear_angle);
+
+    leg_t *leg = is_left_leg ? &left_leg : &right_leg;
+    if (!is_left_leg) {
+        front_ticks = SERVO_MIRROR_TICKS - front_ticks;
+        rear_ticks = SERVO_MIRROR_TICKS - rear_ticks;
+    }
+    esp_err_t ret = set_servo_ticks(&leg->front_servo, front_ticks);
+    if (ret == ESP_OK) {
+        ret = set_servo_ticks(&leg->rear_servo, rear_ticks);
     }
+    return ret;
+}
 
-    ESP_LOGI(LEG_TAG, "Set leg angles to %i, %i", front_angle, rear_angle);
-    
+void LegSystem::get_servo_ticks(uint16_t ticks[4]) {
+    ticks[0] = (uint16_t)left_leg.front_servo.current_ticks;
+    ticks[1] = (uint16_t)left_leg.rear_servo.current_ticks;
+    ticks[2] = (uint16_t)right_leg.front_servo.current_ticks;
+    ticks[3] = (uint16_t)right_leg.rear_servo.current_ticks;
+}
+
+esp_err_t LegSystem::park() {
+    esp_err_t ret = set_leg_pos_q4(true, LEG_PARK_X * (1 << IK_FRAC_BITS), LEG_PARK_Y * (1 << IK_FRAC_BITS));
+    esp_err_t ret_right = set_leg_pos_q4(false, LEG_PARK_X * (1 << IK_FRAC_BITS), LEG_PARK_Y * (1 << IK_FRAC_BITS));
+    return ret != ESP_OK ? ret : ret_right;
+}
+
+esp_err_t LegSystem::set_body_ticks(const body_ticks_t *ticks) {
+    // Unreachable points are IK_TICKS_INVALID, set_servo_ticks refuses those
+    esp_err_t ret = set_servo_ticks(&left_leg.front_servo, ticks->left_front);
+    if (ret == ESP_OK) {
+        ret = set_servo_ticks(&left_leg.rear_servo, ticks->left_rear);
+    }
+    if (ret == ESP_OK) {
+        ret = set_servo_ticks(&right_leg.front_servo, ticks->right_front);
+    }
+    if (ret == ESP_OK) {
+        ret = set_servo_ticks(&right_leg.rear_servo, ticks->right_rear);
+    }
+    return ret;
+}
+
+esp_err_t LegSystem::step_motion() {
+    uint16_t out[PROFILE_AXES];
+    esp_err_t ret = ESP_OK;
+    bool recalibrated = poll_calibration();
+    // One commit per frame for all four servos, only when the profile moved
+    // one or the same pose needs other pulse widths now
+    uint32_t t0 = trace_cycles();
+    uint32_t changed = profiler.step(out);
+    trace_record(trace, TRACE_PROFILE, t0);
+    if (changed != 0) {
+        body_ticks_t ticks = {out[0], out[1], out[2], out[3]};
+        ret = commit_body(&ticks);
+    } else if (recalibrated) {
+        body_ticks_t ticks = committed;
+        ret = commit(&ticks);
+    }
+    if (!motion_settled && profiler.moving_mask() == 0) {
+        motion_settled = true;
+        hal_flag_set(&settled_flag);
+    }
+    return ret;
+}
+
+esp_err_t LegSystem::set_servo_limits(int servo, float speed_dps, float accel_dps2) {
+    if (servo < 1 || servo > 4 || speed_dps < 0 || accel_dps2 < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Same numbering as set_servo_angle: 1, 2 right front and rear, 3, 4 left
+    static const int axis_of_servo[4] = {2, 3, 0, 1};
+    profile_limits_t limits = {speed_dps * SERVO_TICKS_PER_DEG, accel_dps2 * SERVO_TICKS_PER_DEG};
+    profiler.set_limits(axis_of_servo[servo - 1], limits);
     return ESP_OK;
 }
+
+bool LegSystem::settled() {
+    return hal_flag_is_set(&settled_flag);
+}
+
+esp_err_t LegSystem::wait_settled(uint32_t timeout_ms) {
+    return hal_flag_wait(&settled_flag, timeout_ms) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+uint32_t LegSystem::settle_eta_us() {
+    uint32_t eta = 0;
+    for (int i = 0; i < PROFILE_AXES; i++) {
+        uint32_t t = profiler.eta_us(i);
+        if (t > eta) {
+            eta = t;
+        }
+    }
+    return eta;
+}
+
+// Left leg compare values to the foot, false if the upper links can't meet
+static bool solve_foot(uint16_t front_ticks, uint16_t rear_ticks, int32_t *x_q4, int32_t *y_q4) {
+    if (fk_lookup_q4(front_ticks, rear_ticks, x_q4, y_q4) == 0) {
+        return true;
+    }
+    const float deg_per_tick = (float)(SERVO_MAX_DEGREE - SERVO_MIN_DEGREE) /
+                               (SERVO_MAX_PULSEWIDTH_US - SERVO_MIN_PULSEWIDTH_US);
+    float front_deg = ((int32_t)front_ticks - SERVO_CENTER_TICKS) * deg_per_tick + SERVO_HORN_OFFSET;
+    float rear_deg = SERVO_HORN_OFFSET - ((int32_t)rear_ticks - SERVO_CENTER_TICKS) * deg_per_tick;
+    float x, y;
+    if (fk_solve_degf(front_deg, rear_deg, &x, &y) != 0) {
+        return false;
+    }
+    *x_q4 = (int32_t)lrintf(x * (1 << IK_FRAC_BITS));
+    *y_q4 = (int32_t)lrintf(y * (1 << IK_FRAC_BITS));
+    return true;
+}
+
+void LegSystem::estimate_feet(foot_state_t *out) {
+    // Mirror the right leg back, both then solve as the left one
+    const uint16_t front[2] = {committed.left_front, (uint16_t)(SERVO_MIRROR_TICKS - committed.right_front)};
+    const uint16_t rear[2] = {committed.left_rear, (uint16_t)(SERVO_MIRROR_TICKS - committed.right_rear)};
+    out->valid = 0;
+    out->height_q4 = 0;
+    for (int leg = LEG_LEFT; leg <= LEG_RIGHT; leg++) {
+        int32_t x = 0, y = 0;
+        if (solve_foot(front[leg], rear[leg], &x, &y)) {
+            out->valid |= 1u << leg;
+            if (y > out->height_q4) {
+                out->height_q4 = (int16_t)y;
+            }
+        }
+        out->x_q4[leg] = (int16_t)x;
+        out->y_q4[leg] = (int16_t)y;
+    }
+}
@@ -1,47 +1,196 @@
 #ifndef LEGS_H
 #define LEGS_H
 
-#include "driver/mcpwm_prelude.h"
+#include "esp_err.h"
+#include "hal_pwm.h"
+#include "hal_sync.h"
+#include "ik_batch.h"
+#include "seqlock.h"
+#include "servo_calib.h"
+#include "servo_model.h"
+#include "servo_profile.h"
+#include "trace.h"
+
+// Safe stance for both feet, all servos close to center
+#define LEG_PARK_X      10
+#define LEG_PARK_Y      45
+
+// A commit this close to the next TEZ is left to the TEZ interrupt instead
+#define LEG_COMMIT_GUARD_US     200
 
 typedef struct {
-    mcpwm_oper_handle_t oper;
-    mcpwm_operator_config_t oper_config;
+    uint32_t commits;
+    uint32_t direct;        // written by the commit itself, latched on the next TEZ
+    uint32_t deferred;      // too late in the period, written from the TEZ interrupt a period later
+    uint32_t coalesced;     // deferred and replaced by a newer commit before any TEZ took it
+} leg_commit_stats_t;
 
-    mcpwm_cmpr_handle_t comparator;
-    mcpwm_comparator_config_t comparator_config;
+// Where the committed servo values put the feet, forward kinematics of the
+// nominal (calibrated) compare values. Q4 mm in the leg frame of
+// kinematics.h, y grows towards the ground.
+typedef struct {
+    uint32_t timestamp_us;      // control tick that committed them
+    int16_t x_q4[2];            // by leg_id_t
+    int16_t y_q4[2];
+    int16_t height_q4;          // servo axes above the ground, the foot further down carries the body
+    uint8_t valid;              // bit (1 << leg_id_t) for every foot solved, height_q4 needs one
+} foot_state_t;
 
-    mcpwm_gen_handle_t generator;
-    mcpwm_generator_config_t generator_config;
+// Written by the control task every tick, read by telemetry and anything closing a loop on it
+typedef Seqlock<foot_state_t> FootStateMailbox;
+
+typedef struct {
+    int timer;                  // HAL PWM timer of the leg
+    int channel;
 
     int current_angle;
-    int angle_offset;
+    uint32_t current_ticks;     // nominal compare value last committed, read by telemetry
+    int axis;                   // ServoProfiler axis, body_ticks_t order
+    uint16_t min_ticks;         // pulse limits of the servo model
+    uint16_t max_ticks;
 } servo_config_t;
 
 typedef struct {
     servo_config_t front_servo;
     servo_config_t rear_servo;
-    mcpwm_timer_handle_t timer;
+    int timer;
 } leg_t;
 
 class LegSystem {
 private:
     leg_t left_leg, right_leg;
+    servo_config_t *servos[PROFILE_AXES];   // by profiler axis
+    const servo_model_t *left_model, *right_model;
+    uint32_t frame_us;              // servo frame period, both timers
+
+    // Nominal to real pulse width per servo, by profiler axis. Copied out of
+    // the mailbox by the control task whenever a new table was written.
+    const CalibMailbox *calib_requests;
+    uint32_t calib_seen;
+    calib_curve_t calib[PROFILE_AXES];
+
+    ServoProfiler profiler;
+    Tracer *trace;
+    hal_flag_t settled_flag;        // every servo at rest on its target
+    bool motion_settled;
+
+    // Commit state, shared with the TEZ interrupts of both timers under commit_lock
+    hal_lock_t commit_lock;
+    body_ticks_t committed;         // last commit, control task only
+    body_ticks_t staged;            // newest commit
+    body_ticks_t claimed;           // what the first TEZ interrupt of a period took
+    bool pending;                   // staged, not written yet
+    bool due[2];                    // claimed still to be written, 0 left 1 right
+    uint32_t tez_count[2];
+    uint32_t tez_time;              // of the left timer, hal_clock_us() low 32 bits
+    bool running;
+    leg_commit_stats_t commit_stats;
+    hal_pwm_period_cb_t on_period;
+    void *period_ctx;
+
+    static bool on_left_empty(int timer, void *user_ctx);
 
-    esp_err_t init_servo(servo_config_t *servo, mcpwm_timer_handle_t *timer, int gpio_num,
-               int clock_group);
+    static bool on_right_empty(int timer, void *user_ctx);
+
+    void on_empty(int leg);
+
+    void write_leg(int leg, const body_ticks_t *ticks);
+
+    esp_err_t commit(const body_ticks_t *ticks);
+
+    esp_err_t init_servo(servo_config_t *servo, int timer, int channel, int gpio_num, int axis,
+                         const servo_model_t *model);
+
+    bool ticks_valid(const servo_config_t *servo, uint32_t ticks);
+
+    const servo_model_t *model_of(int axis);
+
+    // Takes a new calibration table if one was written, true if it changed
+    bool poll_calibration();
 
     inline uint32_t angle_to_compare(int angle);
 
-    int calc_angle(int x, int y, int *front_angle, int *rear_angle);
+    inline int compare_to_angle(uint32_t ticks);
+
+    // Hands the target to the profiler, step_motion() moves the servo there
+    esp_err_t set_servo_ticks(servo_config_t *servo, uint32_t ticks);
+
 
     
 public:
     
-    LegSystem();
-    
+    // Both timers run one frame rate so a body commit latches on the same TEZ
+    // of both legs: rate_hz is clamped to the slower of the two models, and
+    // every compare value is checked against the pulse limits of its leg's
+    // model. The motion profile and anything sized by period_us() follow.
+    // Compare values everywhere above the hardware are nominal (the ideal
+    // 500-2500us servo); each is mapped through its servo's curve from
+    // calib, if given, only when it goes out to the comparator.
+    LegSystem(uint32_t rate_hz, servo_model_id_t left_model, servo_model_id_t right_model,
+              const CalibMailbox *calib);
+
+    // Enables and starts both servo timers. on_period, if given, runs in ISR
+    // context on every TEZ (timer equals zero) event of the left leg timer.
+    esp_err_t start(hal_pwm_period_cb_t on_period, void *user_ctx);
+
+    // Before start(). IK, profile steps and commits are timed into trace.
+    void set_trace(Tracer *trace);
+
+    // Servo frame period in microseconds
+    uint32_t period_us();
+
     esp_err_t set_leg_pos(bool left_leg, int x, int y);
 
+    // Same as set_leg_pos() with Q4 mm targets and no logging, for the control loop
+    esp_err_t set_leg_pos_q4(bool left_leg, int32_t x_q4, int32_t y_q4);
+
     esp_err_t set_servo_angle(int leg, int angle);
+
+    // Compare values of left front, left rear, right front, right rear
+    void get_servo_ticks(uint16_t ticks[4]);
+
+    // Both feet to LEG_PARK_X, LEG_PARK_Y
+    esp_err_t park();
+
+    // Applies one point of a trajectory solved with ik_solve_batch()
+    esp_err_t set_body_ticks(const body_ticks_t *ticks);
+
+    // Raw compare values straight to the servos, past the motion profile;
+    // step_motion() commits through these. Both servos of a leg, or all four,
+    // always change on the same TEZ: a commit early enough in the period
+    // writes the shadow registers itself (they latch on the next TEZ), a late
+    // one is staged and written by the first TEZ interrupt, so it lands one
+    // period later but never half applied. Control task only.
+    esp_err_t commit_leg(bool left_leg, uint16_t front_ticks, uint16_t rear_ticks);
+
+    esp_err_t commit_body(const body_ticks_t *ticks);
+
+    void get_commit_stats(leg_commit_stats_t *out);
+
+    // All setters above only set targets. Once per servo frame, from the task
+    // that calls them (the control loop), this advances every servo along its
+    // speed and acceleration limited profile and writes the compare values
+    // that changed. A new calibration table is picked up here too, and the
+    // current pose written again through it.
+    esp_err_t step_motion();
+
+    // Servo numbered like set_servo_angle(). A speed of 0 writes targets as
+    // they come, without a profile.
+    esp_err_t set_servo_limits(int servo, float speed_dps, float accel_dps2);
+
+    // Every servo at rest on its target
+    bool settled();
+
+    // Any task. Blocks until every servo arrived or timeout, ESP_ERR_TIMEOUT then.
+    esp_err_t wait_settled(uint32_t timeout_ms);
+
+    // Time until the slowest servo arrives along its profile, control task only
+    uint32_t settle_eta_us();
+
+    // Foot positions of the last commit, control task only. The FK table
+    // solves them, poses next to where the legs fold fall back to the float
+    // solve. Leaves timestamp_us to the caller.
+    void estimate_feet(foot_state_t *out);
 };
 
 #endif
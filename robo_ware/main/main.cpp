@@ -1,7 +1,7 @@
+#include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
-#include "driver/mcpwm_prelude.h"
 #include "driver/uart.h"
 #include "math.h"
 
@@ -17,29 +17,149 @@
 #include "lwip/err.h"
 #include "lwip/sys.h"
 
+#include "arbiter.h"
+#include "calib_store.h"
 #include "legs.h"
+#include "mem_monitor.h"
+#include "sched_monitor.h"
+#include "control.h"
+#include "teleop.h"
+#include "telemetry_task.h"
+#include "imu_reader.h"
 #include "wifi.h"
 
-// #define SERVO_TIMEBASE_RESOLUTION_HZ 1000000  // 1MHz, 1us per tick
-// #define SERVO_TIMEBASE_PERIOD        20000    // 20000 ticks, 20ms
-
 // int left_x, left_y, right_x, right_y;
 // leg_t left_leg, right_leg;
 
 extern "C" void app_main();
 
+#if defined(CONFIG_BIPED_LEFT_SERVO_DIGITAL_333)
+#define LEFT_SERVO_MODEL    SERVO_MODEL_DIGITAL_333
+#elif defined(CONFIG_BIPED_LEFT_SERVO_DIGITAL_200)
+#define LEFT_SERVO_MODEL    SERVO_MODEL_DIGITAL_200
+#else
+#define LEFT_SERVO_MODEL    SERVO_MODEL_ANALOG
+#endif
+#if defined(CONFIG_BIPED_RIGHT_SERVO_DIGITAL_333)
+#define RIGHT_SERVO_MODEL   SERVO_MODEL_DIGITAL_333
+#elif defined(CONFIG_BIPED_RIGHT_SERVO_DIGITAL_200)
+#define RIGHT_SERVO_MODEL   SERVO_MODEL_DIGITAL_200
+#else
+#define RIGHT_SERVO_MODEL   SERVO_MODEL_ANALOG
+#endif
 
-QueueHandle_t txQueue;
-QueueHandle_t rxQueue;
 
+// app_main never returns: after boot it reports memory use and CPU load. Everything below
+// is static, in .bss rather than on the heap or app_main's stack.
 void app_main()
 {
-    rxQueue = xQueueCreate(1, sizeof(char[256]));
-    txQueue = xQueueCreate(1, sizeof(char[256]));
+    static StaticQueue_t tx_queue_buffer;
+    static uint8_t tx_queue_storage[sizeof(tx_frame_t)];
+    static CommandArbiter arbiter;
+    static CalibMailbox calib_mailbox;
+    static FootStateMailbox foot_mailbox;
+#ifdef CONFIG_BIPED_IMU
+    static ImuRing imu_ring;
+    static AttitudeMailbox attitude_mailbox;
+#endif
+#ifdef CONFIG_BIPED_TELEMETRY
+    static TelemetryBuffer telemetry_buffer;
+#endif
+#ifdef CONFIG_BIPED_GAIT
+    static GaitMailbox gait_mailbox;
+#endif
+#ifdef CONFIG_BIPED_UDP_TELEOP
+    static TeleopMailbox teleop_mailbox(CONFIG_BIPED_TELEOP_WATCHDOG_MS * 1000);
+#endif
+    static MemMonitor mem;
+    static SchedMonitor sched;
+    static Tracer trace;
+    static net_context_t net = {};
+
+    net.tx_queue = xQueueCreateStatic(1, sizeof(tx_frame_t), tx_queue_storage, &tx_queue_buffer);
+    net.arbiter = &arbiter;
+    net.calib = &calib_mailbox;
+    net.sched = &sched;
+    net.trace = &trace;
 
     wifi_init_sta();
     ESP_LOGI("SYSTEM", "Wifi init complete");
-    LegSystem legs;
+    // NVS is up now. The legs take the table before the first pulse goes out.
+    calib_table_t calib;
+    calib_store_load(&calib);
+    calib_mailbox.write(calib);
+    static LegSystem legs(CONFIG_BIPED_SERVO_HZ, LEFT_SERVO_MODEL, RIGHT_SERVO_MODEL, &calib_mailbox);
+    legs.set_trace(&trace);
     ESP_LOGI("SYSTEM", "Init legs complete");
-    // xTaskCreate(tcp_server_task, "tcp_server", 4096, 5, NULL);
+    // TCP clients hold the legs they command for a lease and lose them to a
+    // playing gait. Teleop outranks both, it is someone steering live. Its
+    // lease is the mailbox watchdog, legs it leaves behind are parked.
+    static const char *tcp_names[] = {"tcp0", "tcp1", "tcp2"};
+    static_assert(sizeof(tcp_names) / sizeof(tcp_names[0]) == CMD_SERVER_MAX_CLIENTS, "one name per client slot");
+    for (int i = 0; i < CMD_SERVER_MAX_CLIENTS; i++) {
+        net.tcp_source[i] = arbiter.add_source(
+            {tcp_names[i], ARB_PRIO_TCP, ARB_MERGE_OVERRIDE, ARB_INPUT_QUEUE, false, ARB_LEASE_TCP_US});
+    }
+    static ControlLoop control(&legs, &arbiter);
+#ifdef CONFIG_BIPED_UDP_TELEOP
+    control.set_teleop(&teleop_mailbox, arbiter.add_source(
+        {"teleop", ARB_PRIO_TELEOP, ARB_MERGE_OVERRIDE, ARB_INPUT_NEWEST, true, 0}));
+    net.teleop = &teleop_mailbox;
+#endif
+#ifdef CONFIG_BIPED_BALANCE
+    static BalanceController balance(
+        {BALANCE_PITCH_KP, BALANCE_PITCH_KI, BALANCE_PITCH_KD, BALANCE_PITCH_LIMIT},
+        {BALANCE_ROLL_KP, BALANCE_ROLL_KI, BALANCE_ROLL_KD, BALANCE_ROLL_LIMIT});
+    control.set_balance(&balance, &attitude_mailbox);
+#endif
+#ifdef CONFIG_BIPED_GAIT
+    static GaitEngine gait(&gait_mailbox, legs.period_us());
+    control.set_gait(&gait, arbiter.add_source({"gait", ARB_PRIO_GAIT, ARB_MERGE_EXCLUSIVE, ARB_INPUT_QUEUE, false, 0}));
+    net.gait = &gait_mailbox;
+#endif
+    control.set_foot_state(&foot_mailbox);
+    control.set_sched(&sched);
+    control.set_trace(&trace);
+    ESP_ERROR_CHECK(control.start());
+    mem.add_task(control.task_handle(), CONTROL_TASK_STACK);
+    ESP_LOGI("SYSTEM", "Control loop running");
+#ifdef CONFIG_BIPED_IMU
+    static ImuReader imu(&imu_ring, &attitude_mailbox);
+    // Walking doesn't need the IMU, run without it rather than reboot
+    if (imu.start(CONFIG_BIPED_IMU_HZ) == ESP_OK) {
+        mem.add_task(imu.task_handle(), IMU_TASK_STACK);
+        ESP_LOGI("SYSTEM", "IMU running");
+    } else {
+        ESP_LOGE("SYSTEM", "IMU init failed, telemetry carries no IMU samples");
+    }
+#endif
+#ifdef CONFIG_BIPED_TELEMETRY
+#ifdef CONFIG_BIPED_IMU
+    static TelemetryTask telemetry(&legs, &imu_ring, &telemetry_buffer);
+#else
+    static TelemetryTask telemetry(&legs, NULL, &telemetry_buffer);
+#endif
+    telemetry.set_feet(&foot_mailbox);
+    telemetry.set_sched(&sched);
+    telemetry.set_trace(&trace);
+    ESP_ERROR_CHECK(telemetry.start(CONFIG_BIPED_TELEMETRY_HZ));
+    mem.add_task(telemetry.task_handle(), TELEMETRY_TASK_STACK);
+    net.telemetry = &telemetry_buffer;
+#endif
+    TaskHandle_t net_handle = net_start(&net);
+    if (net_handle == NULL) {
+        ESP_LOGE("SYSTEM", "Network task not started");
+    } else {
+        mem.add_task(net_handle, NET_TASK_STACK);
+    }
+    mem.add_task(xTaskGetCurrentTaskHandle(), CONFIG_ESP_MAIN_TASK_STACK_SIZE);
+    mem.boot_done();
+    mem.log();
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(MEM_MONITOR_PERIOD_MS));
+        mem.log();
+        sched.log();
+        net_log(&net);
+    }
 }
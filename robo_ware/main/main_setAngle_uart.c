@@ -44,7 +44,13 @@ static const char *TAG = "Robot";
 int state = 0;
 int left_x, left_y, right_x, right_y;
 leg_t left_leg, right_leg;
-static const int RX_BUF_SIZE = 1024;
+#define RX_BUF_SIZE 1024
+#define RX_TASK_STACK 2048
+#define RX_TASK_CORE 0      // PRO_CPU, with Wi-Fi, away from the servo timers
+
+static uint8_t rx_buf[RX_BUF_SIZE + 1];
+static StaticTask_t rx_task_buffer;
+static StackType_t rx_task_stack[RX_TASK_STACK];
 
 static void update_legs(void) {
     set_leg_pos(&left_leg, left_x, left_y);
@@ -71,7 +77,7 @@ static void rx_task(void *arg)
 {
     static const char *RX_TASK_TAG = "RX_TASK";
     esp_log_level_set(RX_TASK_TAG, ESP_LOG_INFO);
-    uint8_t* data = (uint8_t*) malloc(RX_BUF_SIZE + 1);
+    uint8_t *data = rx_buf;
 
     int servo_sel = 0;
     int servo_angle = 0;
@@ -100,7 +106,6 @@ static void rx_task(void *arg)
             
         }
     }
-    free(data);
 }
 
 void app_main()
@@ -118,7 +123,8 @@ void app_main()
     left_x = REAR_OFFSET/2;
     left_y = 20;
 
-    xTaskCreate(rx_task, "uart_rx_task", 1024 * 2, NULL, 10, NULL);
+    xTaskCreateStaticPinnedToCore(rx_task, "uart_rx_task", RX_TASK_STACK, NULL, 10, rx_task_stack, &rx_task_buffer,
+                                  RX_TASK_CORE);
     // xTaskCreate(uart_task, "uart_task", 2048, NULL, 10, NULL);
     ESP_LOGI("SYSTEM", "uart receive task started");
 
@@ -0,0 +1,58 @@
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+#include "mem_monitor.h"
+
+static const char *MEM_TAG = "Memory";
+
+MemMonitor::MemMonitor() {
+    stats = {};
+}
+
+esp_err_t MemMonitor::add_task(TaskHandle_t task, uint32_t stack_bytes) {
+    if (task == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (stats.tasks == MEM_MONITOR_TASKS) {
+        return ESP_ERR_NO_MEM;
+    }
+    mem_task_stats_t *t = &stats.task[stats.tasks++];
+    t->task = task;
+    t->stack_bytes = stack_bytes;
+    t->stack_free_min = stack_bytes;
+    return ESP_OK;
+}
+
+void MemMonitor::boot_done() {
+    stats.heap_boot = (uint32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+void MemMonitor::sample(mem_stats_t *out) {
+    stats.heap_free = (uint32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    stats.heap_free_min = (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    stats.heap_largest = (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    for (uint32_t i = 0; i < stats.tasks; i++) {
+        // ESP-IDF counts stack in bytes, so is the high-water mark
+        stats.task[i].stack_free_min = (uint32_t)uxTaskGetStackHighWaterMark(stats.task[i].task);
+    }
+    if (out != NULL) {
+        *out = stats;
+    }
+}
+
+void MemMonitor::log() {
+    sample(NULL);
+    ESP_LOGI(MEM_TAG, "heap free %" PRIu32 " min %" PRIu32 " largest %" PRIu32 " | at boot %" PRIu32,
+             stats.heap_free, stats.heap_free_min, stats.heap_largest, stats.heap_boot);
+    for (uint32_t i = 0; i < stats.tasks; i++) {
+        const mem_task_stats_t *t = &stats.task[i];
+        if (t->stack_free_min < MEM_MONITOR_STACK_WARN) {
+            ESP_LOGW(MEM_TAG, "%s stack: %" PRIu32 " of %" PRIu32 " used", pcTaskGetName(t->task),
+                     t->stack_bytes - t->stack_free_min, t->stack_bytes);
+        } else {
+            ESP_LOGI(MEM_TAG, "%s stack: %" PRIu32 " of %" PRIu32 " used", pcTaskGetName(t->task),
+                     t->stack_bytes - t->stack_free_min, t->stack_bytes);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef MEM_MONITOR_H
+#define MEM_MONITOR_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+
+#define MEM_MONITOR_TASKS       8
+#define MEM_MONITOR_PERIOD_MS   30000
+#define MEM_MONITOR_STACK_WARN  256     // bytes of stack never touched below this get a warning
+
+typedef struct {
+    TaskHandle_t task;
+    uint32_t stack_bytes;
+    uint32_t stack_free_min;    // high-water mark: least stack the task ever had left
+} mem_task_stats_t;
+
+// All sizes in bytes
+typedef struct {
+    uint32_t heap_free;
+    uint32_t heap_free_min;     // lowest since reset
+    uint32_t heap_largest;      // largest free block
+    uint32_t heap_boot;         // free when boot finished, 0 before boot_done()
+    uint32_t tasks;
+    mem_task_stats_t task[MEM_MONITOR_TASKS];
+} mem_stats_t;
+
+// Heap and stack high-water marks of the tasks it was given. Everything the
+// firmware owns is static, so after boot the heap should only move with
+// Wi-Fi and lwIP buffers: heap_boot against heap_free_min shows whether
+// anything else allocates. Read from one task only, the app_main loop.
+class MemMonitor {
+private:
+    mem_stats_t stats;
+
+public:
+    MemMonitor();
+
+    // stack_bytes as given to the task create call
+    esp_err_t add_task(TaskHandle_t task, uint32_t stack_bytes);
+
+    // Marks the end of boot, the heap level later readings are held against
+    void boot_done();
+
+    void sample(mem_stats_t *out);
+
+    void log();
+};
+
+#endif // MEM_MONITOR_H
@@ -0,0 +1,129 @@
+#include <inttypes.h>
+#include <string.h>
+#include "esp_log.h"
+
+#include "sched_monitor.h"
+
+static const char *SCHED_TAG = "Sched";
+
+SchedMonitor::SchedMonitor() {
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    prev_count = 0;
+    prev_total = 0;
+#endif
+    for (int c = 0; c < PROTO_SCHED_CORES; c++) {
+        latency_max[c].store(0, std::memory_order_relaxed);
+    }
+    lock = xSemaphoreCreateMutexStatic(&lock_buffer);
+}
+
+void SchedMonitor::note_latency(int core, uint32_t us) {
+    if (core < 0 || core >= PROTO_SCHED_CORES) {
+        return;
+    }
+    uint32_t seen = latency_max[core].load(std::memory_order_relaxed);
+    while (us > seen && !latency_max[core].compare_exchange_weak(seen, us, std::memory_order_relaxed)) {
+    }
+}
+
+int SchedMonitor::report(proto_sched_t *sched, proto_sched_task_t *tasks, int max) {
+    memset(sched, 0, sizeof(*sched));
+    for (int c = 0; c < PROTO_SCHED_CORES; c++) {
+        sched->latency_max_us[c] = latency_max[c].exchange(0, std::memory_order_relaxed);
+    }
+    int written = 0;
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    xSemaphoreTake(lock, portMAX_DELAY);
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t count = uxTaskGetSystemState(status, SCHED_MONITOR_TASKS, &total);
+    if (count == 0) {
+        xSemaphoreGive(lock);
+        ESP_LOGW(SCHED_TAG, "More than %d tasks, no report", SCHED_MONITOR_TASKS);
+        return 0;
+    }
+    // Run time counts esp_timer microseconds. The counters wrap after 71 minutes,
+    // unsigned differences are right as long as reports come more often.
+    uint32_t window = (uint32_t)(total - prev_total);
+    sched->window_us = window;
+
+    uint32_t delta[SCHED_MONITOR_TASKS];
+    for (UBaseType_t i = 0; i < count; i++) {
+        // A task created since the last report counts from its start
+        configRUN_TIME_COUNTER_TYPE before = 0;
+        for (UBaseType_t j = 0; j < prev_count; j++) {
+            if (prev_task[j] == status[i].xHandle) {
+                before = prev_runtime[j];
+                break;
+            }
+        }
+        delta[i] = (uint32_t)(status[i].ulRunTimeCounter - before);
+    }
+
+    // A core's load is whatever its idle task didn't get
+    for (int c = 0; c < PROTO_SCHED_CORES && window != 0; c++) {
+        TaskHandle_t idle = xTaskGetIdleTaskHandleForCore(c);
+        for (UBaseType_t i = 0; i < count; i++) {
+            if (status[i].xHandle == idle) {
+                uint32_t idle_permille = (uint32_t)((uint64_t)delta[i] * 1000 / window);
+                sched->load_permille[c] = (uint16_t)(idle_permille < 1000 ? 1000 - idle_permille : 0);
+            }
+        }
+    }
+
+    // Busiest first, by selection: a few dozen tasks at most
+    uint32_t taken = 0;
+    while (written < max && (UBaseType_t)written < count) {
+        UBaseType_t best = 0;
+        bool found = false;
+        for (UBaseType_t i = 0; i < count; i++) {
+            if (!(taken & (1u << i)) && (!found || delta[i] > delta[best])) {
+                best = i;
+                found = true;
+            }
+        }
+        taken |= 1u << best;
+        const TaskStatus_t *s = &status[best];
+        proto_sched_task_t *t = &tasks[written++];
+        strncpy(t->name, s->pcTaskName, PROTO_SCHED_NAME_LEN);
+        t->name[PROTO_SCHED_NAME_LEN] = 0;
+        BaseType_t core = xTaskGetCoreID(s->xHandle);
+        t->core = core == tskNO_AFFINITY ? PROTO_SCHED_ANY_CORE : (uint8_t)core;
+        t->prio = (uint8_t)s->uxCurrentPriority;
+        t->share_permille = window != 0 ? (uint16_t)((uint64_t)delta[best] * 1000 / window) : 0;
+        // Bytes on ESP-IDF
+        t->stack_free = s->usStackHighWaterMark > 0xFFFF ? 0xFFFF : (uint16_t)s->usStackHighWaterMark;
+    }
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        prev_task[i] = status[i].xHandle;
+        prev_runtime[i] = status[i].ulRunTimeCounter;
+    }
+    prev_count = count;
+    prev_total = total;
+    xSemaphoreGive(lock);
+#else
+    (void)tasks;
+    (void)max;
+#endif
+    return written;
+}
+
+void SchedMonitor::log() {
+    proto_sched_t sched;
+    proto_sched_task_t tasks[PROTO_MAX_SCHED_TASKS];
+    int count = report(&sched, tasks, PROTO_MAX_SCHED_TASKS);
+    ESP_LOGI(SCHED_TAG, "%" PRIu32 " ms | core 0 load %u.%u%% latency max %" PRIu32 " us | core 1 load %u.%u%%"
+             " latency max %" PRIu32 " us", sched.window_us / 1000, sched.load_permille[0] / 10,
+             sched.load_permille[0] % 10, sched.latency_max_us[0], sched.load_permille[1] / 10,
+             sched.load_permille[1] % 10, sched.latency_max_us[1]);
+    for (int i = 0; i < count; i++) {
+        const proto_sched_task_t *t = &tasks[i];
+        if (t->core == PROTO_SCHED_ANY_CORE) {
+            ESP_LOGI(SCHED_TAG, "%-12s any  prio %2u %3u.%u%% stack free %u", t->name, t->prio,
+                     t->share_permille / 10, t->share_permille % 10, t->stack_free);
+        } else {
+            ESP_LOGI(SCHED_TAG, "%-12s core %u prio %2u %3u.%u%% stack free %u", t->name, t->core, t->prio,
+                     t->share_permille / 10, t->share_permille % 10, t->stack_free);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef SCHED_MONITOR_H
+#define SCHED_MONITOR_H
+
+#include <atomic>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "protocol.h"
+
+#define SCHED_MONITOR_TASKS     32      // tasks tracked between reports, ESP-IDF with Wi-Fi runs about 20
+
+// CPU time of every task since the previous report, the load of each core and
+// the worst wakeup latency a task pinned there saw. Needs the FreeRTOS trace
+// facility and run time stats (esp_timer clock), without them reports are
+// empty apart from the latencies.
+//
+// A report covers the window since the one before it and restarts the
+// latency maxima, so the app_main log and a client asking over the network
+// each see part of the time. report() and log() may run in different tasks,
+// note_latency() from any task pinned to the core it names.
+class SchedMonitor {
+private:
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    TaskStatus_t status[SCHED_MONITOR_TASKS];
+    TaskHandle_t prev_task[SCHED_MONITOR_TASKS];
+    configRUN_TIME_COUNTER_TYPE prev_runtime[SCHED_MONITOR_TASKS];
+    UBaseType_t prev_count;
+    configRUN_TIME_COUNTER_TYPE prev_total;
+#endif
+    std::atomic<uint32_t> latency_max[PROTO_SCHED_CORES];
+    SemaphoreHandle_t lock;
+    StaticSemaphore_t lock_buffer;
+
+public:
+    SchedMonitor();
+
+    // Wakeup latency of a task pinned to core, e.g. interrupt to task running
+    void note_latency(int core, uint32_t us);
+
+    // Fills sched and up to max tasks, the busiest first. Returns the number
+    // of tasks written.
+    int report(proto_sched_t *sched, proto_sched_task_t *tasks, int max);
+
+    void log();
+};
+
+#endif // SCHED_MONITOR_H
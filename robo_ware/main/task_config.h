@@ -0,0 +1,53 @@
+#ifndef TASK_CONFIG_H
+#define TASK_CONFIG_H
+
+#include "freertos/FreeRTOS.h"
+
+/* Task topology. Everything that talks to the network stays on PRO_CPU with
+ * the Wi-Fi driver, everything on the servo frame's critical path owns
+ * APP_CPU, so neither a burst of Wi-Fi interrupts nor lwIP work can delay a
+ * servo update. Stacks are in bytes, and every task is created statically
+ * by its owner.
+ *
+ *   core 0, PRO_CPU                          prio
+ *     ipc0                    ESP-IDF         24
+ *     wifi                    ESP-IDF         23  CONFIG_ESP_WIFI_TASK_PINNED_TO_CORE_0
+ *     esp_timer               ESP-IDF         22  runs the telemetry timer callback
+ *     sys_evt                 ESP-IDF         20
+ *     tiT (lwIP)              ESP-IDF         18  CONFIG_LWIP_TCPIP_TASK_AFFINITY_CPU0
+ *     telemetry               TelemetryTask    6  packs a frame, then wakes net
+ *     net                     net_task         5  TCP commands, UDP teleop, telemetry out
+ *     main                    app_main         1  memory and CPU reports
+ *     Tmr Svc                 ESP-IDF          1  CONFIG_FREERTOS_TIMER_TASK_AFFINITY_CPU0
+ *
+ *   core 1, APP_CPU
+ *     ipc1                    ESP-IDF         24
+ *     control                 ControlLoop     23  woken by the servo TEZ, runs the gait
+ *                                                  engine, balance and motion profile
+ *     imu                     ImuReader       22  woken by data ready, preempted by control
+ *
+ * Control and IMU share their core on purpose: the IMU read is I2C wait time
+ * that control may preempt, and both finish well inside one servo frame.
+ * SchedMonitor reports the load of each core and the worst wakeup latency
+ * seen there (control: TEZ to task, telemetry: timer callback to task).
+ */
+#define PRO_CPU                 0
+#define APP_CPU                 1
+
+#define CONTROL_TASK_CORE       APP_CPU
+#define CONTROL_TASK_PRIO       (configMAX_PRIORITIES - 2)
+#define CONTROL_TASK_STACK      4096
+
+#define IMU_TASK_CORE           APP_CPU
+#define IMU_TASK_PRIO           (CONTROL_TASK_PRIO - 1)
+#define IMU_TASK_STACK          3072
+
+#define TELEMETRY_TASK_CORE     PRO_CPU
+#define TELEMETRY_TASK_PRIO     (NET_TASK_PRIO + 1)
+#define TELEMETRY_TASK_STACK    3072
+
+#define NET_TASK_CORE           PRO_CPU
+#define NET_TASK_PRIO           5
+#define NET_TASK_STACK          4096
+
+#endif // TASK_CONFIG_H
@@ -0,0 +1,102 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "telemetry_task.h"
+#include "wifi.h"
+
+static const char *TELEMETRY_TAG = "Telemetry";
+
+TelemetryTask::TelemetryTask(LegSystem *legs, ImuRing *imu, TelemetryBuffer *buffer) {
+    this->legs = legs;
+    this->imu = imu;
+    this->buffer = buffer;
+    feet = NULL;
+    timer = NULL;
+    task = NULL;
+    sched = NULL;
+    trace = NULL;
+    sample = 0;
+    fired = 0;
+}
+
+void TelemetryTask::on_timer(void *arg) {
+    TelemetryTask *self = (TelemetryTask *)arg;
+    self->fired = (uint32_t)esp_timer_get_time();
+    xTaskNotifyGive(self->task);
+}
+
+void TelemetryTask::task_entry(void *arg) {
+    ((TelemetryTask *)arg)->run();
+}
+
+void TelemetryTask::run() {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (sched != NULL) {
+            sched->note_latency(TELEMETRY_TASK_CORE, (uint32_t)esp_timer_get_time() - fired);
+        }
+
+        uint32_t t0 = trace_cycles();
+        uint8_t *frame = buffer->begin();
+        telemetry_put_header(frame, (uint32_t)esp_timer_get_time(), sample);
+
+        uint16_t ticks[TELEMETRY_SERVOS];
+        legs->get_servo_ticks(ticks);
+        telemetry_put_servos(frame, ticks);
+
+        foot_state_t state;
+        if (feet != NULL && feet->read(&state)) {
+            telemetry_put_feet(frame, state.x_q4, state.y_q4, state.height_q4, state.valid);
+        }
+
+        // Anything beyond TELEMETRY_MAX_IMU per frame stays in the ring for the next one
+        imu_sample_t s;
+        while (imu != NULL && imu->peek(&s) && telemetry_put_imu(frame, &s)) {
+            imu->pop(&s);
+        }
+
+        buffer->commit((uint16_t)sample);
+        sample++;
+        trace_record(trace, TRACE_TELEMETRY, t0);
+        net_wake();
+    }
+}
+
+void TelemetryTask::set_feet(const FootStateMailbox *feet) {
+    this->feet = feet;
+}
+
+void TelemetryTask::set_sched(SchedMonitor *sched) {
+    this->sched = sched;
+}
+
+void TelemetryTask::set_trace(Tracer *trace) {
+    this->trace = trace;
+}
+
+esp_err_t TelemetryTask::start(uint32_t rate_hz) {
+    if (rate_hz == 0 || rate_hz > 1000) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    task = xTaskCreateStaticPinnedToCore(task_entry, "telemetry", TELEMETRY_TASK_STACK, this, TELEMETRY_TASK_PRIO,
+                                         stack, &task_buffer, TELEMETRY_TASK_CORE);
+    if (task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_timer_create_args_t args = {};
+    args.callback = on_timer;
+    args.arg = this;
+    args.name = "telemetry";
+    esp_err_t ret = esp_timer_create(&args, &timer);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ESP_LOGI(TELEMETRY_TAG, "%u Hz, %u byte frames", (unsigned)rate_hz, (unsigned)TELEMETRY_FRAME_LEN);
+    return esp_timer_start_periodic(timer, 1000000 / rate_hz);
+}
+
+TaskHandle_t TelemetryTask::task_handle() const {
+    return task;
+}
@@ -0,0 +1,61 @@
+#ifndef TELEMETRY_TASK_H
+#define TELEMETRY_TASK_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+#include "control.h"
+#include "legs.h"
+#include "sched_monitor.h"
+#include "imu_sample.h"
+#include "task_config.h"
+#include "telemetry.h"
+#include "trace.h"
+
+
+// Packs servo state, the foot estimate and the IMU samples since the last
+// frame into the telemetry buffer at a fixed rate, then wakes the network task
+// which sends the frame from where it was packed. An esp_timer paces it, so
+// rates above the FreeRTOS tick (100Hz) work.
+class TelemetryTask {
+private:
+    LegSystem *legs;
+    ImuRing *imu;
+    const FootStateMailbox *feet;
+    TelemetryBuffer *buffer;
+    SchedMonitor *sched;
+    Tracer *trace;
+    esp_timer_handle_t timer;
+    TaskHandle_t task;
+    StaticTask_t task_buffer;
+    StackType_t stack[TELEMETRY_TASK_STACK];
+    uint32_t sample;
+    volatile uint32_t fired;    // esp_timer time of the last callback, low 32 bits
+
+    static void on_timer(void *arg);
+
+    static void task_entry(void *arg);
+
+    void run();
+
+public:
+    // imu may be NULL, frames then carry no IMU samples. The task becomes the
+    // ring's consumer.
+    TelemetryTask(LegSystem *legs, ImuRing *imu, TelemetryBuffer *buffer);
+
+    // Before start(). Frames carry the newest foot estimate of the control loop.
+    void set_feet(const FootStateMailbox *feet);
+
+    // Before start(). Timer callback to wakeup latency goes into the core's report.
+    void set_sched(SchedMonitor *sched);
+
+    // Before start(). Packing each frame is timed into trace.
+    void set_trace(Tracer *trace);
+
+    esp_err_t start(uint32_t rate_hz);
+
+    TaskHandle_t task_handle() const;
+};
+
+#endif // TELEMETRY_TASK_H
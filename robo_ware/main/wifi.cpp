@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -19,16 +20,25 @@
 #include "lwip/sys.h"
 #include "driver/gpio.h"
 
+#include "esp_timer.h"
+
 #include "wifi.h"
+#include "arbiter.h"
+#include "cmd_server.h"
+#include "protocol.h"
+#include "calib_store.h"
+#include "gait.h"
+#include "setpoint.h"
+#include "teleop.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "workspace.h"
 
 /* AP Configuration */  
 #define WIFI_AP_SSID                "WesleyNetwork"
 #define WIFI_AP_PASSWD              "WesleyNetwork5"
 #define WIFI_CHANNEL                 6
 #define PORT                         3333                    // TCP port number for the server
-#define KEEPALIVE_IDLE               240
-#define KEEPALIVE_INTERVAL           10
-#define KEEPALIVE_COUNT              5
 #define SERVER_IP                   "192.168.4.2"  
 #define WIFI_RETRY_COUNT            10  // After 10 connect attemps, unit resets
 /* The event group allows multiple bits for each event, but we only care about two events:
@@ -37,18 +47,18 @@
 #define WIFI_CONNECTED_BIT BIT0
 #define WIFI_FAIL_BIT      BIT1
 
-extern QueueHandle_t txQueue;
-extern QueueHandle_t rxQueue;
 
 static const char *TAG = "WIFI";
-static TaskHandle_t rxHandle = NULL;
-static TaskHandle_t txHandle = NULL;
 static bool wifi_connected = false;
-static bool l_sock_connected = false;
-static bool c_sock_connected = false;
+static CmdServer *net_server = NULL;
+static TraceDump trace_dump;            // network task only
 
 /* FreeRTOS event group to signal when we are connected/disconnected */
 static EventGroupHandle_t s_wifi_event_group;
+static StaticEventGroup_t s_wifi_event_group_buffer;
+
+static StaticTask_t net_task_buffer;
+static StackType_t net_task_stack[NET_TASK_STACK];
 
 static int s_retry_num = 0;
 
@@ -59,7 +69,6 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) { 
         if (s_retry_num < WIFI_RETRY_COUNT) {
             wifi_connected = false;
-            c_sock_connected = false;
             esp_wifi_connect();
             s_retry_num++;
             ESP_LOGI(TAG, "retry to connect to the AP");
@@ -79,7 +88,7 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
 
 void wifi_init_sta(void)
 {
-    s_wifi_event_group = xEventGroupCreate();
+    s_wifi_event_group = xEventGroupCreateStatic(&s_wifi_event_group_buffer);
 
     ESP_ERROR_CHECK(nvs_flash_init());
     ESP_ERROR_CHECK(esp_netif_init());
@@ -123,113 +132,234 @@ void wifi_init_sta(void)
     }
 }
 
-void tcp_server_task(void *pvParameters)
-{
-    char addr_str[128];
-    int addr_family = (int)pvParameters;
-    int ip_protocol = 0;
-    int keepAlive = 1;
-    int keepIdle = KEEPALIVE_IDLE;
-    int keepInterval = KEEPALIVE_INTERVAL;
-    int keepCount = KEEPALIVE_COUNT;
-    struct sockaddr_storage dest_addr;
-
-    if (addr_family == AF_INET) {
-        struct sockaddr_in *dest_addr_ip4 = (struct sockaddr_in *)&dest_addr;
-        dest_addr_ip4->sin_addr.s_addr = htonl(INADDR_ANY);
-        dest_addr_ip4->sin_family = AF_INET;
-        dest_addr_ip4->sin_port = htons(PORT);
-        ip_protocol = IPPROTO_IP;
-    }
-
-    int listen_sock = socket(addr_family, SOCK_STREAM, ip_protocol);
-    if (listen_sock < 0) {
-        ESP_LOGE(TAG, "Unable to create socket: errno %d", errno);
-        vTaskDelete(NULL);
+static_assert(PROTO_CALIB_POINTS == CALIB_POINTS, "calibration frame and table disagree");
+
+// Replaces one servo's curve in the table the control task reads, and in
+// flash when asked. The control task checks it against the servo model's
+// pulse limits again and writes the current pose through it next frame.
+static void on_calib_frame(net_context_t *net, const proto_frame_t *frame) {
+    proto_calib_t c;
+    if (proto_parse_calib(frame, &c) < 0 || c.servo >= CALIB_SERVOS) {
+        ESP_LOGW(TAG, "Malformed calibration frame, seq %u", frame->seq);
         return;
     }
-    int opt = 1;
-    setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-
-    ESP_LOGI(TAG, "Socket created");
+    // This task is the only writer once app_main is done, the read can't race
+    calib_table_t table;
+    net->calib->read(&table);
+    for (int i = 0; i < CALIB_POINTS; i++) {
+        table.servo[c.servo].pulse_us[i] = c.pulse_us[i];
+    }
+    if (!calib_valid(&table.servo[c.servo], SERVO_MIN_PULSEWIDTH_US, SERVO_MAX_PULSEWIDTH_US)) {
+        ESP_LOGW(TAG, "Calibration of servo %u out of range or not increasing", c.servo);
+        return;
+    }
+    net->calib->write(table);
+    if (c.flags & PROTO_CALIB_SAVE) {
+        esp_err_t ret = calib_store_save(&table);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Saving calibration failed: %s", esp_err_to_name(ret));
+        } else {
+            ESP_LOGI(TAG, "Calibration of servo %u saved", c.servo);
+        }
+    }
+}
 
-    int err = bind(listen_sock, (struct sockaddr *)&dest_addr, sizeof(dest_addr));
-    if (err != 0) {
-        ESP_LOGE(TAG, "Socket unable to bind: errno %d", errno);
-        ESP_LOGE(TAG, "IPPROTO: %d", addr_family);
-        goto CLEAN_UP;
+// Stage histograms go out at once, the ring dump follows from pull_tx_frame()
+// as the socket takes it. Recording stops until the dump is done.
+static void on_trace_request(net_context_t *net, const proto_frame_t *frame) {
+    uint8_t flags = frame->len > 0 ? frame->payload[0] : 0;
+    uint8_t reply[PROTO_MAX_FRAME];
+    size_t len = trace_encode_stats(frame->seq, net->trace, reply, sizeof(reply));
+    net->server->send(reply, len);
+    if (flags & PROTO_TRACE_CLEAR) {
+        net->trace->clear_histograms();
     }
-    ESP_LOGI(TAG, "Socket bound, port %d", PORT);
+    if (flags & PROTO_TRACE_EVENTS) {
+        trace_dump.start(net->trace, frame->seq);
+    }
+}
 
-    err = listen(listen_sock, 1);
-    if (err != 0) {
-        ESP_LOGE(TAG, "Error occurred during listen: errno %d", errno);
-        goto CLEAN_UP;
+// Moves an out of reach foot target onto the nearest reachable point, here on
+// the network core so the control task only gets targets it can write.
+// Counted, not logged: clients stream targets near the workspace edge.
+static void project_target(net_context_t *net, proto_leg_target_t *target) {
+    int32_t x = target->x_q4, y = target->y_q4;
+    if (workspace_project_q4(&x, &y) > 0) {
+        net->projected.fetch_add(1, std::memory_order_relaxed);
     }
+    target->x_q4 = (int16_t)x;
+    target->y_q4 = (int16_t)y;
+}
 
-    while (1) {
+// Into the arbiter source of the client the frame came from. A full ring
+// drops it, the arbiter counts those and the control task logs them.
+static void push_setpoint(net_context_t *net, const setpoint_t &sp) {
+    net->arbiter->push(net->tcp_source[net->server->current_client()], sp);
+}
 
-        ESP_LOGI(TAG, "Socket listening");
+// Turns every command record of a frame into a setpoint for the control task
+static void dispatch_command_frame(net_context_t *net, const proto_frame_t *frame) {
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    setpoint_t sp = {};
+    sp.timestamp_us = now;
 
-        struct sockaddr_storage source_addr; // Large enough for both IPv4 or IPv6
-        socklen_t addr_len = sizeof(source_addr);
-        int sock = accept(listen_sock, (struct sockaddr *)&source_addr, &addr_len);
-        if (sock < 0) {
-            ESP_LOGE(TAG, "Unable to accept connection: errno %d", errno);
-            break;
+    if (frame->type == PROTO_MSG_LEG_TARGETS) {
+        proto_leg_target_t targets[PROTO_MAX_LEG_TARGETS];
+        int count = proto_parse_leg_targets(frame, targets, PROTO_MAX_LEG_TARGETS);
+        sp.kind = SETPOINT_FOOT;
+        for (int i = 0; i < count; i++) {
+            project_target(net, &targets[i]);
+            sp.leg = targets[i].leg;
+            sp.x_q4 = targets[i].x_q4;
+            sp.y_q4 = targets[i].y_q4;
+            push_setpoint(net, sp);
         }
-
-        // Set tcp keepalive option
-        setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, &keepAlive, sizeof(int));
-        setsockopt(sock, IPPROTO_TCP, TCP_KEEPIDLE, &keepIdle, sizeof(int));
-        setsockopt(sock, IPPROTO_TCP, TCP_KEEPINTVL, &keepInterval, sizeof(int));
-        setsockopt(sock, IPPROTO_TCP, TCP_KEEPCNT, &keepCount, sizeof(int));
-        // Convert ip address to string
-        if (source_addr.ss_family == PF_INET) {
-            inet_ntoa_r(((struct sockaddr_in *)&source_addr)->sin_addr, addr_str, sizeof(addr_str) - 1);
+    } else if (frame->type == PROTO_MSG_SERVO_ANGLES) {
+        proto_servo_angle_t angles[PROTO_MAX_SERVO_ANGLES];
+        int count = proto_parse_servo_angles(frame, angles, PROTO_MAX_SERVO_ANGLES);
+        sp.kind = SETPOINT_SERVO;
+        for (int i = 0; i < count; i++) {
+            sp.leg = angles[i].servo;
+            sp.angle = angles[i].angle;
+            push_setpoint(net, sp);
         }
-        ESP_LOGI(TAG, "Socket accepted ip address: %s", addr_str);
-
-        // Trigger TODO
-
-        shutdown(sock, 0);
-        close(sock);
+    } else if (frame->type == PROTO_MSG_GAIT && net->gait != NULL) {
+        // Range and reach are checked by the control task when it builds the table
+        proto_gait_t g;
+        if (proto_parse_gait(frame, &g) < 0) {
+            ESP_LOGW(TAG, "Malformed gait frame, seq %u", frame->seq);
+            return;
+        }
+        gait_params_t params;
+        params.period_us = g.period_ms * 1000u;
+        params.step_length_q4 = g.step_length_q4;
+        params.step_height_q4 = g.step_height_q4;
+        params.center_x_q4 = g.center_x_q4;
+        params.stand_y_q4 = g.stand_y_q4;
+        params.phase_offset = g.phase_offset;
+        params.stance_pct = g.stance_pct;
+        net->gait->write(params);
+    } else if (frame->type == PROTO_MSG_CALIB) {
+        on_calib_frame(net, frame);
+    } else if (frame->type == PROTO_MSG_SCHED_REQ && net->sched != NULL) {
+        // Collected here, on the network core: the control core never pays for it
+        proto_sched_t sched;
+        proto_sched_task_t tasks[PROTO_MAX_SCHED_TASKS];
+        int count = net->sched->report(&sched, tasks, PROTO_MAX_SCHED_TASKS);
+        uint8_t reply[PROTO_MAX_FRAME];
+        size_t len = proto_encode_sched(frame->seq, &sched, tasks, (size_t)count, reply, sizeof(reply));
+        net->server->send(reply, len);
+    } else if (frame->type == PROTO_MSG_TRACE_REQ && net->trace != NULL) {
+        on_trace_request(net, frame);
+    } else if (frame->type == PROTO_MSG_PING) {
+        // Echo for round trip measurements, goes out in the same select() round
+        uint8_t reply[PROTO_MAX_FRAME];
+        size_t len = proto_encode(PROTO_MSG_PONG, frame->seq, frame->payload, frame->len, reply, sizeof(reply));
+        net->server->send(reply, len);
+    } else {
+        ESP_LOGW(TAG, "Unknown frame type 0x%02x, seq %u", frame->type, frame->seq);
     }
+}
 
-CLEAN_UP:
-    close(listen_sock);
-    vTaskDelete(NULL);
+static void on_command_frame(const proto_frame_t *frame, void *ctx) {
+    net_context_t *net = (net_context_t *)ctx;
+    uint32_t t0 = trace_cycles();
+    dispatch_command_frame(net, frame);
+    trace_record(net->trace, TRACE_RX, t0, frame->type);
 }
 
-void tcp_tx_task(void* pvParameters) {
-    int sock = (int)pvParameters;
-    char msg_buffer[256];
-    while(1) {
-        BaseType_t que_err = xQueueReceive(txQueue, &msg_buffer, (TickType_t)0); // TODO: add catch for queue failure
-        int written = send(sock, msg_buffer, sizeof(msg_buffer)-1, 0);
-        if(written < 0) {
-            ESP_LOGE(TAG, "Error occurred during sending over socket: errno %d", errno);
-            c_sock_connected = false;
-            vTaskDelete(NULL);
+#ifdef CONFIG_BIPED_UDP_TELEOP
+// Newest teleop datagram, goes to the mailbox instead of the setpoint queue
+static void on_teleop_frame(const proto_frame_t *frame, void *ctx) {
+    net_context_t *net = (net_context_t *)ctx;
+    uint32_t t0 = trace_cycles();
+    proto_leg_target_t targets[PROTO_MAX_LEG_TARGETS];
+    int count = proto_parse_leg_targets(frame, targets, PROTO_MAX_LEG_TARGETS);
+    if (count <= 0) {
+        return;
+    }
+    teleop_cmd_t cmd = {};
+    cmd.timestamp_us = (uint32_t)esp_timer_get_time();
+    cmd.seq = frame->seq;
+    for (int i = 0; i < count; i++) {
+        if (targets[i].leg <= LEG_RIGHT) {
+            project_target(net, &targets[i]);
+            cmd.legs |= 1 << targets[i].leg;
+            cmd.x_q4[targets[i].leg] = targets[i].x_q4;
+            cmd.y_q4[targets[i].leg] = targets[i].y_q4;
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
     }
+    net->teleop->publish(cmd);
+    trace_record(net->trace, TRACE_RX, t0, frame->type);
+}
+#endif
+
+// Hands one frame from txQueue to the server, or the next one of a trace
+// dump once the queue is empty. Never blocks.
+static size_t pull_tx_frame(uint8_t *buf, size_t size, void *ctx) {
+    static tx_frame_t frame;
+    if (xQueueReceive(((net_context_t *)ctx)->tx_queue, &frame, 0) != pdTRUE) {
+        return trace_dump.next(buf, size);
+    }
+    if (frame.len > size) {
+        return 0;
+    }
+    memcpy(buf, frame.data, frame.len);
+    return frame.len;
 }
 
-void tcp_rx_task(void* pvParameters) {
-    int sock = (int)pvParameters;
-    char msg_buffer[256];
-    while(1) {
-        int received = recv(sock, msg_buffer, sizeof(msg_buffer)-1, 0);
-        if(received < 0) {
-            ESP_LOGE(TAG, "Error occurred during sending over socket: errno %d", errno);
-            c_sock_connected = false;
-            vTaskDelete(NULL);
+#ifdef CONFIG_BIPED_TELEMETRY
+// Telemetry frames are sent straight out of the telemetry buffer
+static const uint8_t *acquire_telemetry(size_t *len, void *ctx) {
+    *len = TELEMETRY_FRAME_LEN;
+    return ((TelemetryBuffer *)ctx)->acquire();
+}
+
+static void release_telemetry(const uint8_t *frame, void *ctx) {
+    ((TelemetryBuffer *)ctx)->release(frame);
+}
+#endif
+
+static void net_task(void *pvParameters) {
+    net_context_t *net = (net_context_t *)pvParameters;
+    static CmdServer server(PORT, on_command_frame, net, pull_tx_frame, net);
+#ifdef CONFIG_BIPED_TELEMETRY
+    if (net->telemetry != NULL) {
+        server.set_stream(acquire_telemetry, release_telemetry, net->telemetry);
+    }
+#endif
+    net->server = &server;
+    net_server = &server;
+
+    while (1) {
+        if (server.open() != 0) {
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            continue;
         }
-        BaseType_t que_err = xQueueSend(rxQueue, &msg_buffer, (TickType_t)0); // TODO: add catch for queue failure
-        if(que_err != pdPASS) {
-            ESP_LOGE(TAG, "Push to queue failed with error: %i", que_err);
+#ifdef CONFIG_BIPED_UDP_TELEOP
+        if (net->teleop != NULL) {
+            server.open_udp(CONFIG_BIPED_UDP_TELEOP_PORT, on_teleop_frame, net);
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
+#endif
+        // Sleeps in select() until a client connects, data arrives or net_wake()
+        while (server.poll(-1) == 0) {
+        }
+        ESP_LOGE(TAG, "Command server failed, reopening");
+    }
+}
+
+TaskHandle_t net_start(net_context_t *ctx) {
+    return xTaskCreateStaticPinnedToCore(net_task, "net", NET_TASK_STACK, ctx, NET_TASK_PRIO, net_task_stack,
+                                         &net_task_buffer, NET_TASK_CORE);
+}
+
+void net_wake(void) {
+    if (net_server != NULL) {
+        net_server->wake();
     }
 }
+
+void net_log(const net_context_t *ctx) {
+    ESP_LOGI(TAG, "Targets out of reach, moved onto the workspace: %" PRIu32,
+             ctx->projected.load(std::memory_order_relaxed));
+}
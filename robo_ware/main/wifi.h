@@ -1,12 +1,57 @@
 #ifndef WIFI_H
 #define WIFI_H
 
+#include <atomic>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "arbiter.h"
+#include "cmd_server.h"
+#include "gait.h"
+#include "protocol.h"
+#include "sched_monitor.h"
+#include "servo_calib.h"
+#include "task_config.h"
+#include "teleop.h"
+#include "telemetry.h"
+#include "trace.h"
+
+
+// txQueue item, one encoded frame. Only len bytes go on the wire.
+typedef struct {
+    uint16_t len;
+    uint8_t data[PROTO_MAX_FRAME];
+} tx_frame_t;
+
+// Everything the network task hands commands to or sends from, owned by
+// app_main. Optional parts are NULL when their feature is off.
+typedef struct {
+    CommandArbiter *arbiter;
+    int tcp_source[CMD_SERVER_MAX_CLIENTS];     // arbiter source of each client slot
+    QueueHandle_t tx_queue;         // tx_frame_t
+    CalibMailbox *calib;
+    GaitMailbox *gait;
+    TeleopMailbox *teleop;
+    TelemetryBuffer *telemetry;
+    SchedMonitor *sched;
+    Tracer *trace;
+    CmdServer *server;              // set by the task
+    std::atomic<uint32_t> projected;    // TCP and teleop foot targets moved onto the workspace edge
+} net_context_t;
+
 void wifi_init_sta(void);
 
-void tcp_server_task(void *pvParameters);
+// Starts the only network task, in static memory: accepts the controllers,
+// decodes their command frames into ctx and sends whatever is queued on
+// ctx->tx_queue. ctx must outlive the task. NULL if the task wasn't created.
+TaskHandle_t net_start(net_context_t *ctx);
 
-void tcp_tx_task(void *pvParameters);
+// Call after putting a frame on the tx queue so the network task sends it right away
+void net_wake(void);
 
-void tcp_rx_task(void *pvParameters);
+// The network task's counters, with the periodic reports. Any task.
+void net_log(const net_context_t *ctx);
 
 #endif // WIFI_H
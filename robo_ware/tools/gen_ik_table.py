@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+"""Generate components/kinematics/include/ik_table.h, workspace_table.h, fk_table.h
+
+The table holds the left leg servo compare ticks (Q4, 1/16 tick) for every
+grid point of the reachable (x, y) workspace. ik_lut.h interpolates between
+cells. The workspace table is the signed distance (Q4 mm, positive inside)
+of every grid point to the edge of what ik_lookup_ticks() accepts with this
+very table, for workspace.h. The forward table goes the other way, foot
+position (Q4 mm) per grid point of left leg compare ticks, for fk_lut.h.
+Rerun this whenever the leg geometry in kinematics.h changes:
+
+    python3 tools/gen_ik_table.py
+"""
+import argparse
+import math
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+KIN_DIR = os.path.join(ROOT, "components", "kinematics", "include")
+
+# Grid bounds in mm, a little wider than the reachable workspace so that
+# interpolation works right up to the edge
+X_MIN, X_MAX = -36, 58
+Y_MIN, Y_MAX = 12, 64
+
+TICK_FRAC_BITS = 4
+INVALID = 0xFFFF
+IK_FRAC_BITS = 4
+FK_INVALID = -32768
+
+# The lookup is sampled this many times per mm to find the workspace edge
+EDGE_SAMPLES_PER_MM = 4
+
+
+def read_defines(path):
+    defines = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"#define\s+(\w+)\s+(-?\d+)\b", line)
+            if m:
+                defines[m.group(1)] = int(m.group(2))
+    return defines
+
+
+def ik_ticks(d, x, y):
+    """Same math as ik_solve_deg() + ik_deg_to_ticks()"""
+    upper, lower, rear = d["UPPER_LEG_LEN"], d["LOWER_LEG_LEN"], d["REAR_OFFSET"]
+    hypo1 = math.hypot(x, y)
+    hypo2 = math.hypot(x - rear, y)
+    if hypo1 == 0 or hypo2 == 0:
+        return None
+    k = upper * upper - lower * lower
+    c1 = (k - hypo1 * hypo1) / (-2 * lower * hypo1)
+    c2 = (k - hypo2 * hypo2) / (-2 * lower * hypo2)
+    if abs(c1) > 1 or abs(c2) > 1:
+        return None
+    front = math.degrees(math.acos(x / hypo1) + math.acos(c1))
+    rear_deg = math.degrees(math.acos((rear - x) / hypo2) + math.acos(c2))
+
+    def to_ticks(angle):
+        return ((angle - d["SERVO_MIN_DEGREE"])
+                * (d["SERVO_MAX_PULSEWIDTH_US"] - d["SERVO_MIN_PULSEWIDTH_US"])
+                / (d["SERVO_MAX_DEGREE"] - d["SERVO_MIN_DEGREE"])
+                + d["SERVO_MIN_PULSEWIDTH_US"])
+
+    return (to_ticks(front - d["SERVO_HORN_OFFSET"]),
+            to_ticks(d["SERVO_HORN_OFFSET"] - rear_deg))
+
+
+def quantize(ticks):
+    # Out of servo range values are kept (clamped) so interpolation stays
+    # smooth near the limits, the lookup rejects them afterwards
+    q = int(round(ticks * (1 << TICK_FRAC_BITS)))
+    return max(0, min(INVALID - 1, q))
+
+
+def fk_foot(d, front_ticks, rear_ticks):
+    """Same math as ik_ticks_to_deg() + fk_solve_deg(), None if the knees can't meet"""
+    upper, lower, rear = d["UPPER_LEG_LEN"], d["LOWER_LEG_LEN"], d["REAR_OFFSET"]
+    deg_per_tick = ((d["SERVO_MAX_DEGREE"] - d["SERVO_MIN_DEGREE"])
+                    / (d["SERVO_MAX_PULSEWIDTH_US"] - d["SERVO_MIN_PULSEWIDTH_US"]))
+    horn = d["SERVO_HORN_OFFSET"]
+    a1 = math.radians((front_ticks - d["SERVO_MIN_PULSEWIDTH_US"]) * deg_per_tick + d["SERVO_MIN_DEGREE"] + horn)
+    a2 = math.radians(horn - ((rear_ticks - d["SERVO_MIN_PULSEWIDTH_US"]) * deg_per_tick + d["SERVO_MIN_DEGREE"]))
+    kx1, ky1 = lower * math.cos(a1), lower * math.sin(a1)
+    kx2, ky2 = rear - lower * math.cos(a2), lower * math.sin(a2)
+    dx, dy = kx2 - kx1, ky2 - ky1
+    d2 = dx * dx + dy * dy
+    h2 = upper * upper - d2 / 4
+    if d2 == 0 or h2 < 0:
+        return None
+    k = math.sqrt(h2 / d2)
+    mx, my = (kx1 + kx2) / 2, (ky1 + ky2) / 2
+    f = (mx - dy * k, my + dx * k)
+    g = (mx + dy * k, my - dx * k)
+    return f if f[1] >= g[1] else g
+
+
+def fk_cell(d, front_ticks, rear_ticks):
+    """Foot for the ticks, None unless ik_ticks() solves it back to them. The
+    folded poses the IK never commands flip branch between neighbouring
+    cells, interpolating across them would be meaningless"""
+    foot = fk_foot(d, front_ticks, rear_ticks)
+    if foot is None:
+        return None
+    back = ik_ticks(d, foot[0], foot[1])
+    if back is None or abs(back[0] - front_ticks) > 1 or abs(back[1] - rear_ticks) > 1:
+        return None
+    return foot
+
+
+def write_fk(path, d, shift):
+    """Forward table over the servo pulse range, cropped to the cells in use"""
+    step = 1 << shift
+    lo, hi = d["SERVO_MIN_PULSEWIDTH_US"], d["SERVO_MAX_PULSEWIDTH_US"]
+    # One point past the top of the range so every pulse has four corners
+    n = (hi - lo + step - 1) // step + 1
+    grid = [[fk_cell(d, lo + c * step, lo + r * step) for c in range(n)] for r in range(n)]
+    used_c = [c for c in range(n) if any(grid[r][c] for r in range(n))]
+    used_r = [r for r in range(n) if any(grid[r])]
+    c0, c1, r0, r1 = used_c[0], used_c[-1], used_r[0], used_r[-1]
+    f_min, r_min = lo + c0 * step, lo + r0 * step
+    cols, rows = c1 - c0 + 1, r1 - r0 + 1
+
+    cells = []
+    valid = 0
+    for r in range(r0, r1 + 1):
+        for c in range(c0, c1 + 1):
+            foot = grid[r][c]
+            if foot is None:
+                cells.append("{%d,%d}" % (FK_INVALID, FK_INVALID))
+            else:
+                valid += 1
+                cells.append("{%d,%d}" % (int(round(foot[0] * 16)), int(round(foot[1] * 16))))
+    lines = []
+    for i in range(0, len(cells), 8):
+        lines.append("    " + ",".join(cells[i:i + 8]) + ",")
+
+    with open(path, "w") as f:
+        f.write("""// Generated by tools/gen_ik_table.py, do not edit by hand.
+#ifndef FK_TABLE_H
+#define FK_TABLE_H
+
+#include <stdint.h>
+#include "kinematics.h"
+
+static_assert(UPPER_LEG_LEN == {upper} && LOWER_LEG_LEN == {lower} && REAR_OFFSET == {rear} &&
+              SERVO_HORN_OFFSET == {horn}, "fk_table.h is stale, rerun tools/gen_ik_table.py");
+
+#define FK_TABLE_FRONT_MIN      {f_min}
+#define FK_TABLE_REAR_MIN       {r_min}
+#define FK_TABLE_STEP_SHIFT     {shift}
+#define FK_TABLE_COLS           {cols}     // front ticks
+#define FK_TABLE_ROWS           {rows}     // rear ticks
+#define FK_TABLE_INVALID        ({invalid})
+
+// Foot position (Q4 mm) per grid point of left leg compare ticks, {valid} of {total} cells are poses the IK
+// solves back to, the rest FK_TABLE_INVALID
+typedef struct {{
+    int16_t x_q4;
+    int16_t y_q4;
+}} fk_cell_t;
+
+static const fk_cell_t fk_table[FK_TABLE_ROWS * FK_TABLE_COLS] = {{
+{body}
+}};
+
+#endif // FK_TABLE_H
+""".format(upper=d["UPPER_LEG_LEN"], lower=d["LOWER_LEG_LEN"], rear=d["REAR_OFFSET"],
+           horn=d["SERVO_HORN_OFFSET"], f_min=f_min, r_min=r_min, shift=shift, cols=cols, rows=rows,
+           invalid=FK_INVALID, valid=valid, total=cols * rows, body="\n".join(lines)))
+    print("wrote %s: %dx%d cells, %d bytes" % (path, cols, rows, cols * rows * 4))
+
+
+def lookup_ok(d, table, cols, rows, shift, x_q4, y_q4):
+    """ik_lookup_ticks() accepting the Q4 mm target, same integer math"""
+    grid_frac = IK_FRAC_BITS + shift
+    one = 1 << grid_frac
+    interp_shift = 2 * grid_frac + TICK_FRAC_BITS
+    gx = x_q4 - X_MIN * (1 << IK_FRAC_BITS)
+    gy = y_q4 - Y_MIN * (1 << IK_FRAC_BITS)
+    if gx < 0 or gy < 0:
+        return False
+    col, row = gx >> grid_frac, gy >> grid_frac
+    fx, fy = gx & (one - 1), gy & (one - 1)
+    nc, nr = int(fx != 0), int(fy != 0)
+    if col + nc >= cols or row + nr >= rows:
+        return False
+    c00 = table[row * cols + col]
+    c01 = table[row * cols + col + nc]
+    c10 = table[(row + nr) * cols + col]
+    c11 = table[(row + nr) * cols + col + nc]
+    if INVALID in (c00[0], c01[0], c10[0], c11[0]):
+        return False
+    rnd = 1 << (interp_shift - 1)
+    lo, hi = d["SERVO_MIN_PULSEWIDTH_US"], d["SERVO_MAX_PULSEWIDTH_US"]
+    for i in (0, 1):
+        top = c00[i] * (one - fx) + c01[i] * fx
+        bot = c10[i] * (one - fx) + c11[i] * fx
+        v = (top * (one - fy) + bot * fy + rnd) >> interp_shift
+        if v < lo or v > hi:
+            return False
+    return True
+
+
+def workspace_sdf(d, table, cols, rows, shift):
+    """Signed distance in mm of every grid point to the lookup's edge"""
+    step = 1 << shift
+    n = EDGE_SAMPLES_PER_MM
+    q4 = (1 << IK_FRAC_BITS) // n
+    sx = (cols - 1) * step * n + 1
+    sy = (rows - 1) * step * n + 1
+    inside = [[lookup_ok(d, table, cols, rows, shift,
+                         X_MIN * (1 << IK_FRAC_BITS) + i * q4, Y_MIN * (1 << IK_FRAC_BITS) + j * q4)
+               for i in range(sx)] for j in range(sy)]
+
+    # Samples with a neighbour on the other side, split by side
+    edge_in, edge_out = [], []
+    for j in range(sy):
+        for i in range(sx):
+            v = inside[j][i]
+            for di, dj in ((1, 0), (-1, 0), (0, 1), (0, -1)):
+                a, b = i + di, j + dj
+                if 0 <= a < sx and 0 <= b < sy and inside[b][a] != v:
+                    (edge_in if v else edge_out).append((X_MIN + i / n, Y_MIN + j / n))
+                    break
+
+    sdf = []
+    for r in range(rows):
+        for c in range(cols):
+            x, y = X_MIN + c * step, Y_MIN + r * step
+            if inside[r * step * n][c * step * n]:
+                sdf.append(min(math.hypot(x - ex, y - ey) for ex, ey in edge_out))
+            else:
+                sdf.append(-min(math.hypot(x - ex, y - ey) for ex, ey in edge_in))
+    return sdf
+
+
+def write_workspace(path, d, sdf, cols, rows, shift):
+    q = [max(-32768, min(32767, int(round(v * (1 << IK_FRAC_BITS))))) for v in sdf]
+    lines = []
+    for i in range(0, len(q), 12):
+        lines.append("    " + ",".join("%6d" % v for v in q[i:i + 12]) + ",")
+    with open(path, "w") as f:
+        f.write("""// Generated by tools/gen_ik_table.py, do not edit by hand.
+#ifndef WORKSPACE_TABLE_H
+#define WORKSPACE_TABLE_H
+
+#include <stdint.h>
+#include "ik_table.h"
+
+static_assert(IK_TABLE_X_MIN == {x_min} && IK_TABLE_Y_MIN == {y_min} && IK_TABLE_STEP_SHIFT == {shift} &&
+              IK_TABLE_COLS == {cols} && IK_TABLE_ROWS == {rows},
+              "workspace_table.h is stale, rerun tools/gen_ik_table.py");
+
+// Signed distance (Q4 mm, positive inside) of every ik_table grid point to
+// the edge of the targets ik_lookup_ticks() accepts
+static const int16_t workspace_table[IK_TABLE_ROWS * IK_TABLE_COLS] = {{
+{body}
+}};
+
+#endif // WORKSPACE_TABLE_H
+""".format(x_min=X_MIN, y_min=Y_MIN, shift=shift, cols=cols, rows=rows, body="\n".join(lines)))
+    print("wrote %s: %dx%d cells, %d bytes" % (path, cols, rows, cols * rows * 2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--step-shift", type=int, default=0,
+                        help="grid step is 1 << shift mm (default 1mm)")
+    parser.add_argument("-o", "--output", default=os.path.join(KIN_DIR, "ik_table.h"))
+    parser.add_argument("--workspace-output", default=os.path.join(KIN_DIR, "workspace_table.h"))
+    parser.add_argument("--fk-step-shift", type=int, default=6,
+                        help="forward table step is 1 << shift ticks (default 64)")
+    parser.add_argument("--fk-output", default=os.path.join(KIN_DIR, "fk_table.h"))
+    args = parser.parse_args()
+
+    d = read_defines(os.path.join(KIN_DIR, "kinematics.h"))
+    step = 1 << args.step_shift
+    cols = (X_MAX - X_MIN) // step + 1
+    rows = (Y_MAX - Y_MIN) // step + 1
+
+    lines = []
+    table = []
+    valid = 0
+    for r in range(rows):
+        cells = []
+        for c in range(cols):
+            t = ik_ticks(d, X_MIN + c * step, Y_MIN + r * step)
+            if t is None:
+                table.append((INVALID, INVALID))
+                cells.append("{0x%04X,0x%04X}" % (INVALID, INVALID))
+            else:
+                valid += 1
+                table.append((quantize(t[0]), quantize(t[1])))
+                cells.append("{%5d,%5d}" % table[-1])
+        for i in range(0, len(cells), 8):
+            lines.append("    " + ",".join(cells[i:i + 8]) + ",")
+
+    with open(args.output, "w") as f:
+        f.write("""// Generated by tools/gen_ik_table.py, do not edit by hand.
+#ifndef IK_TABLE_H
+#define IK_TABLE_H
+
+#include <stdint.h>
+#include "kinematics.h"
+
+static_assert(UPPER_LEG_LEN == {upper} && LOWER_LEG_LEN == {lower} && REAR_OFFSET == {rear} &&
+              SERVO_HORN_OFFSET == {horn}, "ik_table.h is stale, rerun tools/gen_ik_table.py");
+
+#define IK_TABLE_X_MIN          {x_min}
+#define IK_TABLE_Y_MIN          {y_min}
+#define IK_TABLE_STEP_SHIFT     {shift}
+#define IK_TABLE_COLS           {cols}
+#define IK_TABLE_ROWS           {rows}
+#define IK_TABLE_TICK_FRAC_BITS {frac}
+#define IK_TABLE_INVALID        0x{invalid:04X}
+
+// Left leg compare ticks (Q{frac}) per grid point, {valid} of {total} cells reachable
+typedef struct {{
+    uint16_t front;
+    uint16_t rear;
+}} ik_cell_t;
+
+static const ik_cell_t ik_table[IK_TABLE_ROWS * IK_TABLE_COLS] = {{
+{body}
+}};
+
+#endif // IK_TABLE_H
+""".format(upper=d["UPPER_LEG_LEN"], lower=d["LOWER_LEG_LEN"], rear=d["REAR_OFFSET"],
+           horn=d["SERVO_HORN_OFFSET"], x_min=X_MIN, y_min=Y_MIN, shift=args.step_shift,
+           cols=cols, rows=rows, frac=TICK_FRAC_BITS, invalid=INVALID, valid=valid,
+           total=cols * rows, body="\n".join(lines)))
+    print("wrote %s: %dx%d cells, %d bytes" % (args.output, cols, rows, cols * rows * 4))
+
+    write_workspace(args.workspace_output, d, workspace_sdf(d, table, cols, rows, args.step_shift),
+                    cols, rows, args.step_shift)
+    write_fk(args.fk_output, d, args.fk_step_shift)
+
+
+if __name__ == "__main__":
+    main()